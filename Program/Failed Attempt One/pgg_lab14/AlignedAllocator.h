@@ -0,0 +1,127 @@
+/*!
+*  \brief     Aligned Allocation Helpers.
+*  \details   This file is to give SIMD types, their arrays and std containers of them the same alignment everywhere
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <vector>
+#include "Platform.h"
+
+/// Alignment used by everything that holds SSE data
+const size_t SIMD_ALIGNMENT = 16;
+
+/// Base class that gives a type aligned operator new / delete for single objects and arrays
+/// Usage: class alignas(16) Camera : public AlignedObject<16>
+template <size_t Alignment>
+class AlignedObject
+{
+public:
+	static void* operator new(size_t size)
+	{
+		return allocate(size, Alignment);
+	}
+
+	static void* operator new[](size_t size)
+	{
+		return allocate(size, Alignment);
+	}
+
+	static void operator delete(void* memory)
+	{
+		pggAlignedFree(memory);
+	}
+
+	static void operator delete[](void* memory)
+	{
+		pggAlignedFree(memory);
+	}
+
+	// Placement new still has to work for containers and arenas
+	static void* operator new(size_t, void* place) { return place; }
+	static void operator delete(void*, void*) {}
+
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+	// C++17 picks these for over-aligned types, keep them going through the same path
+	static void* operator new(size_t size, std::align_val_t alignment)
+	{
+		return allocate(size, (size_t)alignment > Alignment ? (size_t)alignment : Alignment);
+	}
+
+	static void* operator new[](size_t size, std::align_val_t alignment)
+	{
+		return allocate(size, (size_t)alignment > Alignment ? (size_t)alignment : Alignment);
+	}
+
+	static void operator delete(void* memory, std::align_val_t)
+	{
+		pggAlignedFree(memory);
+	}
+
+	static void operator delete[](void* memory, std::align_val_t)
+	{
+		pggAlignedFree(memory);
+	}
+#endif
+
+private:
+	static void* allocate(size_t size, size_t alignment)
+	{
+		void* memory = pggAlignedMalloc(size ? size : 1, alignment);
+		if (!memory)
+			throw std::bad_alloc();
+		return memory;
+	}
+};
+
+/// std allocator that hands out memory on an Alignment boundary
+template <typename T, size_t Alignment = (alignof(T) > SIMD_ALIGNMENT ? alignof(T) : SIMD_ALIGNMENT)>
+class AlignedAllocator
+{
+public:
+	typedef T value_type;
+
+	template <typename U>
+	struct rebind
+	{
+		typedef AlignedAllocator<U, Alignment> other;
+	};
+
+	AlignedAllocator() noexcept {}
+
+	template <typename U>
+	AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+	T* allocate(size_t count)
+	{
+		if (count > std::numeric_limits<size_t>::max() / sizeof(T))
+			throw std::bad_alloc();
+
+		void* memory = pggAlignedMalloc(count * sizeof(T), Alignment);
+		if (!memory)
+			throw std::bad_alloc();
+		return static_cast<T*>(memory);
+	}
+
+	void deallocate(T* memory, size_t) noexcept
+	{
+		pggAlignedFree(memory);
+	}
+
+	template <typename U>
+	bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept { return true; }
+
+	template <typename U>
+	bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept { return false; }
+};
+
+/// std::vector whose storage is always SIMD aligned
+template <typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
@@ -0,0 +1,104 @@
+/*!
+*  \brief     AlignedArena Class.
+*  \details   This class is to hand out aligned memory from big blocks and throw it all away at once
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "AlignedArena.h"
+
+#include <stdint.h>
+
+AlignedArena::AlignedArena(size_t blockSize)
+{
+	this->blockSize = blockSize;
+	currentBlock = 0;
+	offset = 0;
+	bytesUsed = 0;
+}
+
+AlignedArena::~AlignedArena()
+{
+	release();
+}
+
+void* AlignedArena::allocate(size_t size, size_t alignment)
+{
+	if (size == 0)
+		size = 1;
+
+	// Try the current block, then any later ones kept from a previous frame
+	while (currentBlock < blocks.size())
+	{
+		Block& block = blocks[currentBlock];
+		uintptr_t address = (uintptr_t)(block.memory + offset);
+		size_t padding = (size_t)((alignment - (address & (alignment - 1))) & (alignment - 1));
+
+		if (offset + padding + size <= block.size)
+		{
+			void* result = block.memory + offset + padding;
+			offset += padding + size;
+			bytesUsed += padding + size;
+			return result;
+		}
+
+		// Doesn't fit - move on
+		currentBlock++;
+		offset = 0;
+	}
+
+	// Out of blocks, get a new one big enough for this and the worst case padding
+	addBlock(size + alignment);
+	return allocate(size, alignment);
+}
+
+void AlignedArena::reset()
+{
+	// If last time needed more than one block, swap them for one that holds it all
+	// so the next time round never has to go to the heap
+	if (blocks.size() > 1)
+	{
+		size_t total = getBytesReserved();
+		release();
+		addBlock(total);
+	}
+
+	currentBlock = 0;
+	offset = 0;
+	bytesUsed = 0;
+}
+
+void AlignedArena::release()
+{
+	for (Block& block : blocks)
+		pggAlignedFree(block.memory);
+
+	blocks.clear();
+	currentBlock = 0;
+	offset = 0;
+	bytesUsed = 0;
+}
+
+size_t AlignedArena::getBytesReserved() const
+{
+	size_t total = 0;
+	for (const Block& block : blocks)
+		total += block.size;
+	return total;
+}
+
+void AlignedArena::addBlock(size_t minimumSize)
+{
+	Block block;
+	block.size = minimumSize > blockSize ? minimumSize : blockSize;
+	block.memory = static_cast<char*>(pggAlignedMalloc(block.size, SIMD_ALIGNMENT));
+
+	if (!block.memory)
+		throw std::bad_alloc();
+
+	blocks.push_back(block);
+	currentBlock = blocks.size() - 1;
+	offset = 0;
+}
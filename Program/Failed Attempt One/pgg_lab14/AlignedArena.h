@@ -0,0 +1,71 @@
+/*!
+*  \brief     AlignedArena Class.
+*  \details   This class is to hand out aligned memory from big blocks and throw it all away at once
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+#include "AlignedAllocator.h"
+
+class AlignedArena
+{
+public:
+	/// Constructor and Destructor
+	explicit AlignedArena(size_t blockSize = 64 * 1024);
+	~AlignedArena();
+
+	AlignedArena(const AlignedArena&) = delete;
+	AlignedArena& operator=(const AlignedArena&) = delete;
+
+	/// Get memory on an alignment boundary (power of two)
+	void* allocate(size_t size, size_t alignment = SIMD_ALIGNMENT);
+
+	/// Get room for count T's (not constructed)
+	template <typename T>
+	T* allocateArray(size_t count)
+	{
+		return static_cast<T*>(allocate(sizeof(T) * count, alignof(T) > SIMD_ALIGNMENT ? alignof(T) : SIMD_ALIGNMENT));
+	}
+
+	/// Build a T in the arena - destructors are never run so only put plain data (glm vectors, matrices) in here
+	template <typename T, typename... Args>
+	T* create(Args&&... args)
+	{
+		return ::new (allocateArray<T>(1)) T(std::forward<Args>(args)...);
+	}
+
+	/// Forget everything allocated so far but keep the memory for next time
+	void reset();
+
+	/// Give every block back to the heap
+	void release();
+
+	/// Getters
+	size_t getBytesUsed() const { return bytesUsed; }
+	size_t getBytesReserved() const;
+	size_t getBlockCount() const { return blocks.size(); }
+
+private:
+	struct Block
+	{
+		char* memory;
+		size_t size;
+	};
+
+	// Add a block that can hold at least minimumSize bytes
+	void addBlock(size_t minimumSize);
+
+	std::vector<Block> blocks;
+	size_t currentBlock;
+	size_t offset;
+	size_t blockSize;
+	size_t bytesUsed;
+};
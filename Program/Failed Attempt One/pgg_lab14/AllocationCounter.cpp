@@ -0,0 +1,136 @@
+/*!
+*  \brief     Allocation Counter.
+*  \details   This file is to count every global operator new in debug builds so we can check frames don't touch the heap
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "AllocationCounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include "Platform.h"
+
+#if PGG_COUNT_ALLOCATIONS
+
+// Counted from every thread, and by each thread on its own (plain size_t, so no constructor runs inside operator new)
+static std::atomic<size_t> globalAllocationCount(0);
+static thread_local size_t threadAllocationCount = 0;
+
+static void* countedMalloc(size_t size)
+{
+	globalAllocationCount.fetch_add(1, std::memory_order_relaxed);
+	threadAllocationCount++;
+	return malloc(size ? size : 1);
+}
+
+static void* countedAlignedMalloc(size_t size, size_t alignment)
+{
+	globalAllocationCount.fetch_add(1, std::memory_order_relaxed);
+	threadAllocationCount++;
+	return pggAlignedMalloc(size ? size : 1, alignment);
+}
+
+bool isAllocationCountingEnabled()
+{
+	return true;
+}
+
+size_t getGlobalAllocationCount()
+{
+	return globalAllocationCount.load(std::memory_order_relaxed);
+}
+
+size_t getThreadAllocationCount()
+{
+	return threadAllocationCount;
+}
+
+// Replacement global operators
+void* operator new(size_t size)
+{
+	void* memory = countedMalloc(size);
+	if (!memory)
+		throw std::bad_alloc();
+	return memory;
+}
+
+void* operator new[](size_t size)
+{
+	void* memory = countedMalloc(size);
+	if (!memory)
+		throw std::bad_alloc();
+	return memory;
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+	return countedMalloc(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+	return countedMalloc(size);
+}
+
+void operator delete(void* memory) noexcept { free(memory); }
+void operator delete[](void* memory) noexcept { free(memory); }
+void operator delete(void* memory, size_t) noexcept { free(memory); }
+void operator delete[](void* memory, size_t) noexcept { free(memory); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { free(memory); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { free(memory); }
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+	void* memory = countedAlignedMalloc(size, (size_t)alignment);
+	if (!memory)
+		throw std::bad_alloc();
+	return memory;
+}
+
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+	void* memory = countedAlignedMalloc(size, (size_t)alignment);
+	if (!memory)
+		throw std::bad_alloc();
+	return memory;
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	return countedAlignedMalloc(size, (size_t)alignment);
+}
+
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	return countedAlignedMalloc(size, (size_t)alignment);
+}
+
+void operator delete(void* memory, std::align_val_t) noexcept { pggAlignedFree(memory); }
+void operator delete[](void* memory, std::align_val_t) noexcept { pggAlignedFree(memory); }
+void operator delete(void* memory, size_t, std::align_val_t) noexcept { pggAlignedFree(memory); }
+void operator delete[](void* memory, size_t, std::align_val_t) noexcept { pggAlignedFree(memory); }
+void operator delete(void* memory, std::align_val_t, const std::nothrow_t&) noexcept { pggAlignedFree(memory); }
+void operator delete[](void* memory, std::align_val_t, const std::nothrow_t&) noexcept { pggAlignedFree(memory); }
+
+#else
+
+bool isAllocationCountingEnabled()
+{
+	return false;
+}
+
+size_t getGlobalAllocationCount()
+{
+	return 0;
+}
+
+size_t getThreadAllocationCount()
+{
+	return 0;
+}
+
+#endif
@@ -0,0 +1,30 @@
+/*!
+*  \brief     Allocation Counter.
+*  \details   This file is to count every global operator new in debug builds so we can check frames don't touch the heap
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#pragma once
+
+#include <cstddef>
+
+/// Debug builds count by default, define PGG_COUNT_ALLOCATIONS=1 to count in release too
+#if !defined(PGG_COUNT_ALLOCATIONS)
+#if defined(NDEBUG)
+#define PGG_COUNT_ALLOCATIONS 0
+#else
+#define PGG_COUNT_ALLOCATIONS 1
+#endif
+#endif
+
+/// True if the global operator new has been replaced with the counting one
+bool isAllocationCountingEnabled();
+
+/// Number of global operator new calls since the program started (0 if counting is off)
+size_t getGlobalAllocationCount();
+
+/// Same, but only the calls made on the thread asking - so the streamer and simulation threads don't count against a frame
+size_t getThreadAllocationCount();
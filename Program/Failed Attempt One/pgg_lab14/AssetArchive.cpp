@@ -0,0 +1,265 @@
+/*!
+*  \brief     AssetArchive Class.
+*  \details   This class is to map one packed file of assets and hand out each one by name, without opening them one by one
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "AssetArchive.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#include "Lz4Codec.h"
+#include "MeshCache.h"
+
+// Every entry starts on a boundary this big, so cooked files keep their own 16 byte alignment inside the mapping
+static const size_t ENTRY_ALIGNMENT = 16;
+
+// Sanity limit so a damaged file can't ask for a huge table
+static const uint32_t MAX_ENTRIES = 1 << 20;
+
+static size_t AlignUp(size_t offset)
+{
+	return (offset + ENTRY_ALIGNMENT - 1) & ~(ENTRY_ALIGNMENT - 1);
+}
+
+// Byte order, the same order the table is sorted in
+static int CompareNames(const char* a, size_t aLength, const char* b, size_t bLength)
+{
+	int order = memcmp(a, b, aLength < bLength ? aLength : bLength);
+	if (order != 0)
+		return order;
+	return aLength < bLength ? -1 : (aLength > bLength ? 1 : 0);
+}
+
+AssetArchive::AssetArchive()
+{
+	entryCount = 0;
+	entries = nullptr;
+	strings = nullptr;
+}
+
+AssetArchive::~AssetArchive()
+{
+
+}
+
+std::string AssetArchive::NormaliseName(const std::string& fileName)
+{
+	std::string name = fileName;
+	std::replace(name.begin(), name.end(), '\\', '/');
+	while (name.compare(0, 2, "./") == 0)
+		name = name.substr(2);
+	return name;
+}
+
+bool AssetArchive::Write(const std::string& archiveFileName, const std::vector<ArchiveSource>& sources)
+{
+	// Sorted by name, so Find can binary search the table straight out of the mapping
+	std::vector<ArchiveSource> sorted = sources;
+	for (ArchiveSource& source : sorted)
+		source.name = NormaliseName(source.name);
+	std::sort(sorted.begin(), sorted.end(), [](const ArchiveSource& a, const ArchiveSource& b)
+	{
+		return CompareNames(a.name.data(), a.name.size(), b.name.data(), b.name.size()) < 0;
+	});
+	for (size_t i = 1; i < sorted.size(); i++)
+	{
+		if (sorted[i].name == sorted[i - 1].name)
+		{
+			printf("%s is in the archive twice\n", sorted[i].name.c_str());
+			return false;
+		}
+	}
+
+	ArchiveHeader header;
+	memset(&header, 0, sizeof(header));
+	header.magic = MAGIC;
+	header.version = VERSION;
+	header.entryCount = (uint32_t)sorted.size();
+	header.stringsOffset = sizeof(header) + sorted.size() * sizeof(ArchiveEntry);
+
+	std::vector<ArchiveEntry> table(sorted.size());
+	std::string stringBlock;
+	for (size_t i = 0; i < sorted.size(); i++)
+	{
+		memset(&table[i], 0, sizeof(ArchiveEntry));
+		table[i].nameOffset = (uint32_t)stringBlock.size();
+		table[i].nameLength = (uint32_t)sorted[i].name.size();
+		stringBlock += sorted[i].name;
+	}
+	header.stringsSize = stringBlock.size();
+
+	// Every entry's bytes, compressed where it's worth it, and where each one goes
+	std::vector<std::vector<uint8_t> > stored(sorted.size());
+	size_t offset = AlignUp((size_t)header.stringsOffset + stringBlock.size());
+	for (size_t i = 0; i < sorted.size(); i++)
+	{
+		MappedFile source;
+		if (!source.Open(sorted[i].fileName))
+		{
+			printf("Could not read %s\n", sorted[i].fileName.c_str());
+			return false;
+		}
+
+		const uint8_t* data = source.GetData();
+		size_t size = source.GetSize();
+		table[i].size = size;
+		if (!sorted[i].sourceFileName.empty())
+			MeshCache::GetSourceStamp(sorted[i].sourceFileName, table[i].sourceSize, table[i].sourceTime);
+		table[i].compression = (uint32_t)ArchiveCompression::None;
+		stored[i].assign(data, data + size);
+
+		if (sorted[i].compress)
+		{
+			std::vector<uint8_t> compressed;
+			Lz4Codec::Compress(data, size, compressed);
+			if (compressed.size() < size - size / 8)
+			{
+				table[i].compression = (uint32_t)ArchiveCompression::Lz4;
+				stored[i].swap(compressed);
+			}
+		}
+
+		table[i].offset = offset;
+		table[i].storedSize = stored[i].size();
+		offset = AlignUp(offset + stored[i].size());
+	}
+
+	FILE* file = fopen(archiveFileName.c_str(), "wb");
+	if (file == NULL)
+		return false;
+
+	static const uint8_t padding[ENTRY_ALIGNMENT] = {};
+	bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+			  (table.empty() || fwrite(table.data(), sizeof(ArchiveEntry), table.size(), file) == table.size()) &&
+			  fwrite(stringBlock.data(), 1, stringBlock.size(), file) == stringBlock.size();
+	size_t written = (size_t)header.stringsOffset + stringBlock.size();
+
+	for (size_t i = 0; ok && i < sorted.size(); i++)
+	{
+		size_t gap = (size_t)table[i].offset - written;
+		ok = (gap == 0 || fwrite(padding, 1, gap, file) == gap) &&
+			 (stored[i].empty() || fwrite(stored[i].data(), 1, stored[i].size(), file) == stored[i].size());
+		written = (size_t)table[i].offset + stored[i].size();
+	}
+
+	ok = (fclose(file) == 0) && ok;
+
+	// Don't leave half an archive behind to be picked up next time
+	if (!ok)
+		remove(archiveFileName.c_str());
+	return ok;
+}
+
+bool AssetArchive::Open(const std::string& archiveFileName)
+{
+	Close();
+	if (!file.Open(archiveFileName))
+		return false;
+
+	const uint8_t* data = file.GetData();
+	size_t size = file.GetSize();
+
+	ArchiveHeader header;
+	if (size < sizeof(header))
+	{
+		Close();
+		return false;
+	}
+	memcpy(&header, data, sizeof(header));
+
+	if (header.magic != MAGIC || header.version != VERSION || header.entryCount > MAX_ENTRIES ||
+		header.stringsOffset != sizeof(header) + (uint64_t)header.entryCount * sizeof(ArchiveEntry) ||
+		header.stringsOffset > size || header.stringsSize > size - header.stringsOffset)
+	{
+		Close();
+		return false;
+	}
+
+	// The table is read in place (it's 8 byte aligned right after the header), so check every entry once now
+	const ArchiveEntry* table = (const ArchiveEntry*)(data + sizeof(header));
+	for (uint32_t i = 0; i < header.entryCount; i++)
+	{
+		const ArchiveEntry& entry = table[i];
+		bool inside = (uint64_t)entry.nameOffset + entry.nameLength <= header.stringsSize &&
+					  entry.offset <= size && entry.storedSize <= size - entry.offset &&
+					  (entry.compression == (uint32_t)ArchiveCompression::Lz4 ||
+					   (entry.compression == (uint32_t)ArchiveCompression::None && entry.storedSize == entry.size));
+		if (!inside)
+		{
+			Close();
+			return false;
+		}
+	}
+
+	entryCount = header.entryCount;
+	entries = table;
+	strings = (const char*)(data + header.stringsOffset);
+	return true;
+}
+
+void AssetArchive::Close()
+{
+	file.Close();
+	entryCount = 0;
+	entries = nullptr;
+	strings = nullptr;
+}
+
+const ArchiveEntry* AssetArchive::Find(const std::string& name) const
+{
+	std::string normalised = NormaliseName(name);
+	size_t low = 0, high = entryCount;
+	while (low < high)
+	{
+		size_t middle = (low + high) / 2;
+		const ArchiveEntry& entry = entries[middle];
+		int order = CompareNames(strings + entry.nameOffset, entry.nameLength, normalised.data(), normalised.size());
+		if (order == 0)
+			return &entry;
+		if (order < 0)
+			low = middle + 1;
+		else
+			high = middle;
+	}
+	return nullptr;
+}
+
+bool AssetArchive::IsUpToDate(const ArchiveEntry& entry, const std::string& sourceFileName)
+{
+	// Nothing recorded when it was packed, or nothing there now to compare with
+	uint64_t size;
+	int64_t time;
+	MeshCache::GetSourceStamp(sourceFileName, size, time);
+	if ((entry.sourceSize == 0 && entry.sourceTime == 0) || size == 0)
+		return true;
+
+	return size == entry.sourceSize && time == entry.sourceTime;
+}
+
+bool AssetArchive::Read(const ArchiveEntry& entry, const uint8_t*& data, size_t& size, std::vector<uint8_t>& buffer) const
+{
+	if (!IsOpen())
+		return false;
+
+	const uint8_t* stored = file.GetData() + entry.offset;
+	if (entry.compression == (uint32_t)ArchiveCompression::None)
+	{
+		data = stored;
+		size = (size_t)entry.size;
+		return true;
+	}
+
+	buffer.resize((size_t)entry.size);
+	if (!Lz4Codec::Decompress(stored, (size_t)entry.storedSize, buffer.data(), buffer.size()))
+		return false;
+
+	data = buffer.data();
+	size = buffer.size();
+	return true;
+}
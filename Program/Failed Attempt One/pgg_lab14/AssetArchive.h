@@ -0,0 +1,108 @@
+/*!
+*  \brief     AssetArchive Class.
+*  \details   This class is to map one packed file of assets and hand out each one by name, without opening them one by one
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "MappedFile.h"
+
+/// How an entry's bytes are stored
+enum class ArchiveCompression : uint32_t
+{
+	None = 0,	///< As they are, so they can be used straight out of the mapping
+	Lz4 = 1		///< One Lz4Codec block, unpacked when read
+};
+
+/// File layout - a header, the table of contents sorted by name, the names, then each entry on a 16 byte boundary
+/// (all little endian)
+struct ArchiveHeader
+{
+	uint32_t magic;
+	uint32_t version;
+	uint32_t entryCount;
+	uint32_t reserved;
+	uint64_t stringsOffset;
+	uint64_t stringsSize;
+};
+
+/// sourceSize and sourceTime are the stamp of the file the entry was cooked from when it was packed (both 0 if none)
+struct ArchiveEntry
+{
+	uint32_t nameOffset;
+	uint32_t nameLength;
+	uint64_t offset;
+	uint64_t storedSize;
+	uint64_t size;
+	uint64_t sourceSize;
+	int64_t sourceTime;
+	uint32_t compression;
+	uint32_t reserved;
+};
+
+/// One file to pack - name is what it will be found by, fileName where it is now
+/// sourceFileName is what it was cooked from, if anything, so the entry can be skipped once that has been edited
+struct ArchiveSource
+{
+	std::string name;
+	std::string fileName;
+	bool compress;
+	std::string sourceFileName;
+};
+
+class AssetArchive
+{
+public:
+	/// "PPAK" then a version, bump the version whenever the layout above changes
+	static const uint32_t MAGIC = 0x4B415050;
+	static const uint32_t VERSION = 2;
+
+	///ctor / dtor (unmaps the archive)
+	AssetArchive();
+	~AssetArchive();
+
+	AssetArchive(const AssetArchive&) = delete;
+	AssetArchive& operator=(const AssetArchive&) = delete;
+
+	/// Pack the sources into one archive - ones asked to be compressed are only kept compressed if it saves an eighth
+	/// False if a source can't be read, two have the same name, or the archive couldn't be written
+	static bool Write(const std::string& archiveFileName, const std::vector<ArchiveSource>& sources);
+
+	/// The name a file is packed and found under - forward slashes, no leading "./"
+	static std::string NormaliseName(const std::string& fileName);
+
+	/// Map an archive and check its table over, false if it is missing, from an older version or cut short
+	bool Open(const std::string& archiveFileName);
+	void Close();
+	bool IsOpen() const { return file.IsOpen(); }
+
+	/// Entries are in name order
+	size_t GetEntryCount() const { return entryCount; }
+	const ArchiveEntry& GetEntry(size_t index) const { return entries[index]; }
+	std::string GetEntryName(const ArchiveEntry& entry) const { return std::string(strings + entry.nameOffset, entry.nameLength); }
+
+	/// Binary search of the table, null if there's no entry by that name
+	const ArchiveEntry* Find(const std::string& name) const;
+
+	/// False if the file the entry was cooked from has changed since it was packed, so it has to be loaded from that instead
+	/// (a source that isn't there is fine - shipping without them is what the archive is for)
+	static bool IsUpToDate(const ArchiveEntry& entry, const std::string& sourceFileName);
+
+	/// An entry's bytes - straight out of the mapping when stored as they are, unpacked into buffer when compressed
+	/// Safe to call from several threads at once, each with its own buffer
+	bool Read(const ArchiveEntry& entry, const uint8_t*& data, size_t& size, std::vector<uint8_t>& buffer) const;
+
+private:
+	MappedFile file;
+	size_t entryCount;
+	const ArchiveEntry* entries;
+	const char* strings;
+};
@@ -0,0 +1,279 @@
+/*!
+*  \brief     AssetCooker Class.
+*  \details   This class is to turn every mesh and image in a folder into the cooked files the game loads without parsing
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "AssetCooker.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+
+#include "BmpLoader.h"
+#include "MappedFile.h"
+#include "MaterialLibrary.h"
+#include "MeshFile.h"
+#include "ObjLoader.h"
+#include "TangentGenerator.h"
+#include "TextParser.h"
+#include "TextureConverter.h"
+#include "TextureFile.h"
+
+const char* const AssetCooker::MANIFEST_FILE_NAME = "assets.manifest";
+
+// Goes into every hash, so changing how things are cooked (not just the file layout) cooks everything again
+static const uint32_t COOK_SETTINGS_VERSION = 1;
+
+static const char* GetTypeName(CookedAssetType type)
+{
+	return type == CookedAssetType::Mesh ? "mesh" : "texture";
+}
+
+static std::string GetLowerExtension(const std::filesystem::path& path)
+{
+	std::string extension = path.extension().string();
+	std::transform(extension.begin(), extension.end(), extension.begin(), [](char c) { return (char)tolower((unsigned char)c); });
+	return extension;
+}
+
+AssetCooker::AssetCooker(JobSystem* jobSystem)
+{
+	this->jobSystem = jobSystem;
+}
+
+AssetCooker::~AssetCooker()
+{
+
+}
+
+uint64_t AssetCooker::HashBytes(const void* data, size_t size, uint64_t hash)
+{
+	const uint8_t* bytes = (const uint8_t*)data;
+	for (size_t i = 0; i < size; i++)
+		hash = (hash ^ bytes[i]) * HASH_PRIME;
+	return hash;
+}
+
+uint64_t AssetCooker::HashSource(const std::string& sourceFileName, CookedAssetType type)
+{
+	MappedFile source;
+	if (!source.Open(sourceFileName))
+		return 0;
+
+	uint32_t versions[2] = { COOK_SETTINGS_VERSION, type == CookedAssetType::Mesh ? MeshFile::VERSION : TextureFile::VERSION };
+	uint64_t hash = HashBytes(versions, sizeof(versions));
+	hash = HashBytes(source.GetData(), source.GetSize(), hash);
+	if (type != CookedAssetType::Mesh)
+		return hash;
+
+	// The materials are cooked into the mesh, so a changed MTL has to cook it again too
+	std::string directory = MaterialLibrary::GetDirectory(sourceFileName);
+	const char* text = (const char*)source.GetData();
+	const char* end = text + source.GetSize();
+	while (text < end)
+	{
+		const char* lineEnd = TextParser::LineEnd(text, end);
+		const char* keyword = TextParser::SkipSpaces(text, lineEnd);
+		const char* keywordEnd = TextParser::WordEnd(keyword, lineEnd);
+		text = TextParser::NextLine(lineEnd, end);
+		if (!TextParser::IsWord(keyword, keywordEnd, "mtllib"))
+			continue;
+
+		const char* name = TextParser::SkipSpaces(keywordEnd, lineEnd);
+		const char* nameEnd = lineEnd;
+		while (nameEnd > name && (nameEnd[-1] == ' ' || nameEnd[-1] == '\t'))
+			nameEnd--;
+
+		MappedFile mtlFile;
+		if (mtlFile.Open(directory + std::string(name, nameEnd)))
+			hash = HashBytes(mtlFile.GetData(), mtlFile.GetSize(), hash);
+		else
+			hash = HashBytes("missing", 7, hash);
+	}
+	return hash;
+}
+
+bool AssetCooker::Cook(const std::string& directory, bool force)
+{
+	assets.clear();
+
+	// Only the folder itself - the Visual Studio build folders are full of compiler .obj files
+	std::error_code error;
+	std::vector<std::filesystem::path> sources;
+	for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(directory, error))
+	{
+		std::string extension = GetLowerExtension(entry.path());
+		if (entry.is_regular_file(error) && (extension == ".obj" || extension == ".bmp"))
+			sources.push_back(entry.path());
+	}
+	if (error)
+	{
+		printf("Could not read asset folder %s\n", directory.c_str());
+		return false;
+	}
+	std::sort(sources.begin(), sources.end());
+
+	for (const std::filesystem::path& source : sources)
+	{
+		CookedAsset asset;
+		asset.sourceFileName = source.string();
+		asset.type = GetLowerExtension(source) == ".obj" ? CookedAssetType::Mesh : CookedAssetType::Texture;
+		asset.cookedFileName = asset.type == CookedAssetType::Mesh ? MeshFile::GetCookedFileName(asset.sourceFileName)
+																   : TextureFile::GetCookedFileName(asset.sourceFileName);
+		asset.hash = 0;
+		asset.cookedSize = 0;
+		asset.result = CookResult::Failed;
+		asset.milliseconds = 0.0;
+		assets.push_back(asset);
+	}
+
+	std::string manifestFileName = (std::filesystem::path(directory) / MANIFEST_FILE_NAME).string();
+	std::unordered_map<std::string, uint64_t> previous;
+	if (!force)
+		LoadManifest(manifestFileName, previous);
+
+	// Every file is independent of the others - one job each, biggest meshes and images alike
+	if (jobSystem)
+	{
+		jobSystem->parallelFor(assets.size(), 1, [&](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; i++)
+				CookAsset(assets[i], previous, force);
+		});
+	}
+	else
+	{
+		for (CookedAsset& asset : assets)
+			CookAsset(asset, previous, force);
+	}
+
+	bool ok = SaveManifest(manifestFileName);
+	if (!ok)
+		printf("Could not write %s\n", manifestFileName.c_str());
+
+	for (const CookedAsset& asset : assets)
+		ok = ok && asset.result != CookResult::Failed;
+	return ok;
+}
+
+void AssetCooker::CookAsset(CookedAsset& asset, const std::unordered_map<std::string, uint64_t>& previous, bool force) const
+{
+	auto start = std::chrono::steady_clock::now();
+	asset.hash = HashSource(asset.sourceFileName, asset.type);
+
+	std::error_code error;
+	std::string name = std::filesystem::path(asset.sourceFileName).filename().string();
+	std::unordered_map<std::string, uint64_t>::const_iterator found = previous.find(name);
+	bool upToDate = !force && asset.hash != 0 && found != previous.end() && found->second == asset.hash &&
+					std::filesystem::exists(asset.cookedFileName, error);
+
+	if (upToDate)
+	{
+		// Only the date changed - move the cooked file's on too, so the game's date check keeps using it
+		std::filesystem::file_time_type sourceTime = std::filesystem::last_write_time(asset.sourceFileName, error);
+		if (!error && std::filesystem::last_write_time(asset.cookedFileName, error) < sourceTime)
+			std::filesystem::last_write_time(asset.cookedFileName, sourceTime, error);
+		asset.result = CookResult::UpToDate;
+	}
+	else if (asset.hash == 0)
+		asset.result = CookResult::Failed;
+	else if (asset.type == CookedAssetType::Mesh)
+		asset.result = CookMesh(asset.sourceFileName, asset.cookedFileName) ? CookResult::Cooked : CookResult::Failed;
+	else
+		asset.result = CookTexture(asset.sourceFileName, asset.cookedFileName) ? CookResult::Cooked : CookResult::Failed;
+
+	uintmax_t size = std::filesystem::file_size(asset.cookedFileName, error);
+	asset.cookedSize = error ? 0 : (uint64_t)size;
+	asset.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+bool AssetCooker::CookMesh(const std::string& sourceFileName, const std::string& cookedFileName)
+{
+	ObjLoader loader;
+	if (!loader.Load(sourceFileName))
+		return false;
+
+	// Everything the game would otherwise do after loading
+	MeshData& mesh = loader.GetMeshData();
+	if (TangentGenerator::IsNeeded(mesh))
+		TangentGenerator().Generate(mesh);
+
+	return MeshFile::Save(mesh, cookedFileName);
+}
+
+bool AssetCooker::CookTexture(const std::string& sourceFileName, const std::string& cookedFileName)
+{
+	BmpLoader loader;
+	if (!loader.Load(sourceFileName))
+		return false;
+
+	// The same as pgg_cook_textures with no options - every image the game loads is keyed on cyan
+	loader.ApplyColourKey(0, 0xFF, 0xFF);
+
+	TextureConverter converter;
+	converter.Convert(loader.GetImage(), TextureFormat::Bc1, true, true);
+	return converter.Save(cookedFileName);
+}
+
+void AssetCooker::LoadManifest(const std::string& manifestFileName, std::unordered_map<std::string, uint64_t>& hashes)
+{
+	MappedFile manifest;
+	if (!manifest.Open(manifestFileName))
+		return;
+
+	// hash <tab> type <tab> source <tab> cooked file <tab> cooked bytes, anything after a '#' is a comment
+	const char* text = (const char*)manifest.GetData();
+	const char* end = text + manifest.GetSize();
+	while (text < end)
+	{
+		const char* lineEnd = TextParser::LineEnd(text, end);
+		const char* line = text;
+		text = TextParser::NextLine(lineEnd, end);
+		if (line == lineEnd || *line == '#')
+			continue;
+
+		const char* typeStart = (const char*)memchr(line, '\t', lineEnd - line);
+		const char* sourceStart = typeStart ? (const char*)memchr(typeStart + 1, '\t', lineEnd - typeStart - 1) : nullptr;
+		const char* sourceEnd = sourceStart ? (const char*)memchr(sourceStart + 1, '\t', lineEnd - sourceStart - 1) : nullptr;
+		if (!sourceEnd || typeStart - line != 16)
+			continue;
+
+		char hashText[17];
+		memcpy(hashText, line, 16);
+		hashText[16] = '\0';
+		hashes[std::string(sourceStart + 1, sourceEnd)] = strtoull(hashText, nullptr, 16);
+	}
+}
+
+bool AssetCooker::SaveManifest(const std::string& manifestFileName) const
+{
+	FILE* file = fopen(manifestFileName.c_str(), "wb");
+	if (file == NULL)
+		return false;
+
+	// Failed files are left out, so they're tried again next time
+	bool ok = fprintf(file, "# hash\ttype\tsource\tcooked\tbytes\n") > 0;
+	for (const CookedAsset& asset : assets)
+	{
+		if (asset.result == CookResult::Failed)
+			continue;
+
+		std::string source = std::filesystem::path(asset.sourceFileName).filename().string();
+		std::string cooked = std::filesystem::path(asset.cookedFileName).filename().string();
+		ok = ok && fprintf(file, "%016llx\t%s\t%s\t%s\t%llu\n", (unsigned long long)asset.hash, GetTypeName(asset.type),
+						   source.c_str(), cooked.c_str(), (unsigned long long)asset.cookedSize) > 0;
+	}
+
+	ok = (fclose(file) == 0) && ok;
+	if (!ok)
+		remove(manifestFileName.c_str());
+	return ok;
+}
@@ -0,0 +1,87 @@
+/*!
+*  \brief     AssetCooker Class.
+*  \details   This class is to turn every mesh and image in a folder into the cooked files the game loads without parsing
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "JobSystem.h"
+
+/// What a source file is cooked into
+enum class CookedAssetType
+{
+	Mesh,		///< .obj (and its .mtl) -> MeshFile .pmdl
+	Texture		///< .bmp -> TextureFile .ptex, BC1 with mips and the cyan key
+};
+
+/// What happened to a source file this time round
+enum class CookResult
+{
+	UpToDate,	///< Same hash as last time and the cooked file is still there
+	Cooked,
+	Failed
+};
+
+/// One source file and what it was cooked into
+struct CookedAsset
+{
+	std::string sourceFileName;
+	std::string cookedFileName;
+	CookedAssetType type;
+	uint64_t hash;
+	uint64_t cookedSize;
+	CookResult result;
+	double milliseconds;
+};
+
+class AssetCooker
+{
+public:
+	/// The manifest lives in the folder it describes, one line per source file
+	static const char* const MANIFEST_FILE_NAME;
+
+	/// FNV-1a, 64 bit
+	static const uint64_t HASH_OFFSET_BASIS = 14695981039346656037ull;
+	static const uint64_t HASH_PRIME = 1099511628211ull;
+
+	/// Constructor - with a JobSystem each file is cooked as its own job, so several cook at once
+	AssetCooker(JobSystem* jobSystem = nullptr);
+	~AssetCooker();
+
+	/// Cook every .obj and .bmp directly in directory whose content has changed since the manifest there was written
+	/// (or all of them when forced), then write the manifest again - false if any of them failed
+	bool Cook(const std::string& directory, bool force = false);
+
+	/// Every file found by the last Cook, in name order
+	const std::vector<CookedAsset>& GetAssets() const { return assets; }
+
+	/// Carry a hash on over more bytes
+	static uint64_t HashBytes(const void* data, size_t size, uint64_t hash = HASH_OFFSET_BASIS);
+
+	/// Hash of everything the cooked file is made from - the source, any MTL it names and the cooked format's version
+	/// (zero if the source can't be read)
+	static uint64_t HashSource(const std::string& sourceFileName, CookedAssetType type);
+
+private:
+	// Hash one file, cook it if the hash isn't the one it had last time
+	void CookAsset(CookedAsset& asset, const std::unordered_map<std::string, uint64_t>& previous, bool force) const;
+
+	static bool CookMesh(const std::string& sourceFileName, const std::string& cookedFileName);
+	static bool CookTexture(const std::string& sourceFileName, const std::string& cookedFileName);
+
+	// Source file name (without the folder) -> hash, from the last manifest written
+	static void LoadManifest(const std::string& manifestFileName, std::unordered_map<std::string, uint64_t>& hashes);
+	bool SaveManifest(const std::string& manifestFileName) const;
+
+	JobSystem* jobSystem;
+	std::vector<CookedAsset> assets;
+};
@@ -0,0 +1,351 @@
+/*!
+*  \brief     AssetStreamer Class.
+*  \details   This class is to load and decode meshes and images on a background thread and hand them back to the render thread
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "AssetStreamer.h"
+
+#include <algorithm>
+
+#include "MappedFile.h"
+#include "MaterialLibrary.h"
+#include "MeshFile.h"
+#include "MeshPipeline.h"
+#include "ObjLoader.h"
+#include "TangentGenerator.h"
+#include "TextureFile.h"
+
+// Most requests the worker takes in one go, when it has a JobSystem to share them with
+// (never more than there are threads, so a high priority request doesn't wait behind a long batch)
+static const size_t MAX_BATCH_SIZE = 16;
+
+// A cooked file's bytes out of the archive, if there is one, the file is in it and the source hasn't been edited since
+static bool ReadFromArchive(const AssetArchive* archive, const std::string& cookedFileName, const std::string& sourceFileName,
+							const uint8_t*& data, size_t& size, std::vector<uint8_t>& buffer)
+{
+	const ArchiveEntry* entry = archive ? archive->Find(cookedFileName) : nullptr;
+	return entry && AssetArchive::IsUpToDate(*entry, sourceFileName) && archive->Read(*entry, data, size, buffer);
+}
+
+// The cooked texture - from the archive, or loose if there's an up to date one (mapped, already keyed, no BMP to decode)
+// - otherwise the BMP
+static bool LoadKeyedImage(const std::string& fileName, ImageData& image, const AssetArchive* archive)
+{
+	std::string cookedFileName = TextureFile::GetCookedFileName(fileName);
+	const uint8_t* data = nullptr;
+	size_t size = 0;
+	std::vector<uint8_t> buffer;
+	if (ReadFromArchive(archive, cookedFileName, fileName, data, size, buffer))
+	{
+		TextureFile texture;
+		if (texture.Open(data, size) && texture.DecodeLevel(0, image))
+			return true;
+	}
+
+	if (TextureFile::IsCookedUpToDate(cookedFileName, fileName))
+	{
+		TextureFile texture;
+		if (texture.Open(cookedFileName) && texture.DecodeLevel(0, image))
+			return true;
+	}
+
+	BmpLoader loader;
+	bool loaded = loader.Load(fileName);
+
+	// Transparent for all of the cyan images
+	loader.ApplyColourKey(0, 0xFF, 0xFF);
+	image = std::move(loader.GetImage());
+	return loaded;
+}
+
+// The cooked mesh - from the archive, or loose if there's an up to date one (tangents and all, nothing to parse)
+// - otherwise the OBJ
+static bool LoadMesh(const std::string& fileName, MeshData& mesh, bool generateTangents, JobSystem* jobSystem,
+					 const AssetArchive* archive)
+{
+	std::string cookedFileName = MeshFile::GetCookedFileName(fileName);
+	const uint8_t* data = nullptr;
+	size_t size = 0;
+	std::vector<uint8_t> buffer;
+	if (ReadFromArchive(archive, cookedFileName, fileName, data, size, buffer))
+	{
+		MeshFile cooked;
+		if (cooked.Open(data, size, MaterialLibrary::GetDirectory(fileName)) && cooked.Read(mesh))
+			return true;
+	}
+
+	if (MeshFile::IsCookedUpToDate(cookedFileName, fileName))
+	{
+		MeshFile cooked;
+		if (cooked.Open(cookedFileName) && cooked.Read(mesh))
+			return true;
+	}
+
+	ObjLoader loader;
+	bool loaded = loader.Load(fileName);
+	mesh = std::move(loader.GetMeshData());
+
+	// Done once here, so normal mapped materials cost nothing a frame
+	if (generateTangents && TangentGenerator::IsNeeded(mesh))
+		TangentGenerator(jobSystem).Generate(mesh);
+	return loaded;
+}
+
+AssetStreamer::AssetStreamer(JobSystem* jobSystem, const AssetArchive* archive)
+	: running(true), pending(0)
+{
+	nextTicket = 1;
+	this->jobSystem = jobSystem;
+	this->archive = archive;
+
+	// Start loading straight away
+	worker = std::thread(&AssetStreamer::workerLoop, this);
+}
+
+AssetStreamer::~AssetStreamer()
+{
+	stop();
+
+	// Free anything that was finished but never collected
+	StreamedAsset* asset = nullptr;
+	while (completed.pop(asset))
+		delete asset;
+}
+
+uint32_t AssetStreamer::requestMesh(const std::string& fileName, AssetPriority priority, MeshProcessing processing)
+{
+	return request(AssetType::Mesh, fileName, priority, processing);
+}
+
+uint32_t AssetStreamer::requestImage(const std::string& fileName, AssetPriority priority)
+{
+	return request(AssetType::Image, fileName, priority);
+}
+
+uint32_t AssetStreamer::requestAtlas(const std::vector<std::string>& fileNames, AssetPriority priority)
+{
+	return request(AssetType::Atlas, fileNames.empty() ? std::string() : fileNames[0], priority, MeshProcessing::None, fileNames);
+}
+
+uint32_t AssetStreamer::requestText(const std::string& fileName, AssetPriority priority)
+{
+	return request(AssetType::Text, fileName, priority);
+}
+
+uint32_t AssetStreamer::reloadMesh(const std::string& fileName, MeshProcessing processing)
+{
+	// Someone is waiting to see the change, so it goes ahead of anything still streaming in
+	return request(AssetType::Mesh, fileName, AssetPriority::High, processing, std::vector<std::string>(), true);
+}
+
+uint32_t AssetStreamer::request(AssetType type, const std::string& fileName, AssetPriority priority, MeshProcessing processing,
+								const std::vector<std::string>& atlasFiles, bool fromSource)
+{
+	Request newRequest;
+	newRequest.type = type;
+	newRequest.fileName = fileName;
+	newRequest.processing = processing;
+	newRequest.fromSource = fromSource;
+	newRequest.atlasFiles = atlasFiles;
+
+	{
+		std::lock_guard<std::mutex> lock(requestMutex);
+		newRequest.ticket = nextTicket++;
+
+		if (priority == AssetPriority::High)
+			highPriorityRequests.push_back(newRequest);
+		else
+			lowPriorityRequests.push_back(newRequest);
+	}
+
+	pending.fetch_add(1, std::memory_order_acq_rel);
+	requestReady.notify_one();
+	return newRequest.ticket;
+}
+
+bool AssetStreamer::pollCompleted(std::unique_ptr<StreamedAsset>& asset)
+{
+	StreamedAsset* finished = nullptr;
+	if (!completed.pop(finished))
+		return false;
+
+	pending.fetch_sub(1, std::memory_order_acq_rel);
+	asset.reset(finished);
+
+	// Under the lock, so a worker that has just found the queue full can't miss it (only costs anything per asset, not per poll)
+	{
+		std::lock_guard<std::mutex> lock(requestMutex);
+	}
+	completedTaken.notify_one();
+	return true;
+}
+
+void AssetStreamer::stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(requestMutex);
+		running.store(false, std::memory_order_release);
+	}
+	requestReady.notify_all();
+	completedTaken.notify_all();
+
+	if (worker.joinable())
+		worker.join();
+}
+
+void AssetStreamer::workerLoop()
+{
+	// Only if there's room for another thread, otherwise it just loads one at a time as before
+	bool useJobs = jobSystem && jobSystem->getWorkerCount() > 0 && jobSystem->registerThread();
+	size_t maxBatch = useJobs ? std::min(MAX_BATCH_SIZE, (size_t)jobSystem->getWorkerCount() + 1) : 1;
+
+	std::vector<Request> batch;
+	std::vector<StreamedAsset*> assets;
+	while (true)
+	{
+		// Sleep until there is something to do
+		{
+			std::unique_lock<std::mutex> lock(requestMutex);
+			requestReady.wait(lock, [this]
+			{
+				return !running.load(std::memory_order_acquire) ||
+					   !highPriorityRequests.empty() || !lowPriorityRequests.empty();
+			});
+
+			if (!running.load(std::memory_order_acquire))
+				return;
+
+			takeRequests(batch, maxBatch);
+		}
+
+		// Do the slow part without holding the lock - each file on its own job, or one after another here
+		assets.assign(batch.size(), nullptr);
+		if (useJobs && batch.size() > 1)
+		{
+			Job* root = jobSystem->createJob(nullptr);
+			for (size_t i = 0; i < batch.size(); i++)
+			{
+				LoadJobData data = { this, &batch[i], &assets[i] };
+				jobSystem->run(jobSystem->createJob(&AssetStreamer::loadAssetJob, data, root));
+			}
+			jobSystem->run(root);
+			jobSystem->wait(root);
+		}
+		else
+		{
+			for (size_t i = 0; i < batch.size(); i++)
+				assets[i] = loadAsset(batch[i]);
+		}
+
+		// Hand them back in the order they were taken, sleeping until there's room rather than dropping any
+		for (size_t i = 0; i < assets.size(); i++)
+		{
+			if (completed.push(assets[i]))
+				continue;
+
+			bool pushed = false;
+			std::unique_lock<std::mutex> lock(requestMutex);
+			completedTaken.wait(lock, [this, &assets, &pushed, i]
+			{
+				pushed = completed.push(assets[i]);
+				return pushed || !running.load(std::memory_order_acquire);
+			});
+
+			if (!pushed)
+			{
+				for (size_t j = i; j < assets.size(); j++)
+					delete assets[j];
+				return;
+			}
+		}
+	}
+}
+
+size_t AssetStreamer::takeRequests(std::vector<Request>& batch, size_t maxBatch)
+{
+	// Called with the lock held - the high priority ones always come first
+	batch.clear();
+	while (batch.size() < maxBatch && (!highPriorityRequests.empty() || !lowPriorityRequests.empty()))
+	{
+		std::deque<Request>& queue = highPriorityRequests.empty() ? lowPriorityRequests : highPriorityRequests;
+		batch.push_back(queue.front());
+		queue.pop_front();
+	}
+	return batch.size();
+}
+
+void AssetStreamer::loadAssetJob(Job& job, const void* data)
+{
+	const LoadJobData& load = *(const LoadJobData*)data;
+	*load.asset = load.streamer->loadAsset(*load.request);
+}
+
+StreamedAsset* AssetStreamer::loadAsset(const Request& request) const
+{
+	StreamedAsset* asset = new StreamedAsset();
+	asset->ticket = request.ticket;
+	asset->type = request.type;
+	asset->fileName = request.fileName;
+	asset->loaded = false;
+
+	if (request.type == AssetType::Mesh && request.processing == MeshProcessing::GenerateLods)
+	{
+		// Simplifying is slow, but it only happens the first time (or when the OBJ changes)
+		// The levels themselves aren't cooked or packed, only the full detail mesh they're made from comes out of the archive
+		MeshPipeline pipeline;
+		asset->loaded = pipeline.LoadFromCache(request.fileName);
+		if (!asset->loaded)
+		{
+			MeshData mesh;
+			asset->loaded = LoadMesh(request.fileName, mesh, false, jobSystem, request.fromSource ? nullptr : archive);
+			if (asset->loaded)
+				pipeline.Build(request.fileName, mesh);
+		}
+		asset->lods = std::move(pipeline.GetLods());
+	}
+	else if (request.type == AssetType::Mesh)
+	{
+		asset->loaded = LoadMesh(request.fileName, asset->mesh, request.processing != MeshProcessing::SliceTerrain, jobSystem,
+								 request.fromSource ? nullptr : archive);
+
+		// Slice the level here so the render thread only ever uploads
+		if (request.processing == MeshProcessing::SliceTerrain)
+		{
+			TerrainChunker chunker;
+			chunker.Slice(asset->mesh, asset->chunks);
+			asset->mesh.Clear();
+		}
+	}
+	else if (request.type == AssetType::Atlas)
+	{
+		// Every image loaded the same as on its own, then packed so they can share one texture
+		TextureAtlas atlas;
+		asset->loaded = true;
+		for (const std::string& fileName : request.atlasFiles)
+		{
+			ImageData image;
+			asset->loaded &= LoadKeyedImage(fileName, image, archive);
+			atlas.AddImage(fileName, std::move(image));
+		}
+
+		asset->loaded &= atlas.Build();
+		asset->image = std::move(atlas.GetImage());
+		asset->regions = std::move(atlas.GetRegions());
+	}
+	else if (request.type == AssetType::Text)
+	{
+		MappedFile file;
+		asset->loaded = file.Open(request.fileName);
+		if (asset->loaded)
+			asset->text.assign((const char*)file.GetData(), file.GetSize());
+	}
+	else
+	{
+		asset->loaded = LoadKeyedImage(request.fileName, asset->image, archive);
+	}
+	return asset;
+}
@@ -0,0 +1,158 @@
+/*!
+*  \brief     AssetStreamer Class.
+*  \details   This class is to load and decode meshes and images on a background thread and hand them back to the render thread
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <stdint.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "AssetArchive.h"
+#include "BmpLoader.h"
+#include "JobSystem.h"
+#include "MeshData.h"
+#include "SpscQueue.h"
+#include "TerrainChunker.h"
+#include "TextureAtlas.h"
+
+/// What kind of file a request is for
+enum class AssetType
+{
+	Mesh,
+	Image,
+	Atlas,	///< Several images packed into one, handed back in image with a region for each
+	Text	///< A file as it is (shader source), handed back in text
+};
+
+/// Extra work done to a mesh on the worker after it has been loaded
+enum class MeshProcessing
+{
+	None,
+	GenerateLods,	///< MeshPipeline levels of detail, handed back in lods
+	SliceTerrain	///< TerrainChunker slices along the track, handed back in chunks
+};
+
+/// High priority requests jump the queue (menu images, the player's Rocket)
+enum class AssetPriority
+{
+	High,
+	Low
+};
+
+/// A finished request, decoded into CPU memory and ready for upload
+struct StreamedAsset
+{
+	uint32_t ticket;
+	AssetType type;
+	std::string fileName;
+	bool loaded;
+
+	MeshData mesh;
+	ImageData image;
+	std::string text;
+
+	/// Levels of detail, finest first - only filled in when they were asked for
+	std::vector<MeshLod> lods;
+
+	/// Terrain slices, start of the track first - only filled in when they were asked for
+	std::vector<TerrainChunk> chunks;
+
+	/// Where each image is in an atlas, in the order they were asked for
+	std::vector<AtlasRegion> regions;
+};
+
+class AssetStreamer
+{
+public:
+	/// Constructor starts the worker thread, Destructor stops it
+	/// With a JobSystem the worker hands each file in a batch to it, so several load at once
+	/// With an open AssetArchive cooked files are taken from it first (it has to outlive the streamer)
+	AssetStreamer(JobSystem* jobSystem = nullptr, const AssetArchive* archive = nullptr);
+	~AssetStreamer();
+
+	AssetStreamer(const AssetStreamer&) = delete;
+	AssetStreamer& operator=(const AssetStreamer&) = delete;
+
+	/// Queue a file for loading, the ticket comes back with the finished asset
+	/// Meshes can be processed further on the worker, the result comes back instead of mesh
+	uint32_t requestMesh(const std::string& fileName, AssetPriority priority = AssetPriority::Low,
+						 MeshProcessing processing = MeshProcessing::None);
+	uint32_t requestImage(const std::string& fileName, AssetPriority priority = AssetPriority::High);
+	uint32_t requestAtlas(const std::vector<std::string>& fileNames, AssetPriority priority = AssetPriority::High);
+	uint32_t requestText(const std::string& fileName, AssetPriority priority = AssetPriority::High);
+
+	/// Load a mesh again after it has changed on disk - always from the OBJ, the archive is older than the change
+	uint32_t reloadMesh(const std::string& fileName, MeshProcessing processing = MeshProcessing::None);
+
+	/// Render thread only - take one finished asset if there is one, never blocks
+	bool pollCompleted(std::unique_ptr<StreamedAsset>& asset);
+
+	/// Requests that haven't been taken back with pollCompleted yet
+	size_t getPendingCount() const { return pending.load(std::memory_order_acquire); }
+
+	/// Stop the worker (anything not started yet is dropped)
+	void stop();
+
+private:
+	struct Request
+	{
+		uint32_t ticket;
+		AssetType type;
+		std::string fileName;
+		MeshProcessing processing;
+
+		/// Skip the archive (loose cooked files are still used if they are newer than the source)
+		bool fromSource;
+
+		/// Only for atlases - every image that goes in it
+		std::vector<std::string> atlasFiles;
+	};
+
+	uint32_t request(AssetType type, const std::string& fileName, AssetPriority priority,
+					 MeshProcessing processing = MeshProcessing::None,
+					 const std::vector<std::string>& atlasFiles = std::vector<std::string>(), bool fromSource = false);
+
+	/// One file in a batch, loaded by whichever thread picks the job up
+	struct LoadJobData
+	{
+		const AssetStreamer* streamer;
+		const Request* request;
+		StreamedAsset** asset;
+	};
+
+	// Worker thread
+	void workerLoop();
+	size_t takeRequests(std::vector<Request>& batch, size_t maxBatch);
+	StreamedAsset* loadAsset(const Request& request) const;
+	static void loadAssetJob(Job& job, const void* data);
+
+	// Requests in (render thread -> worker), only touched under the mutex
+	std::mutex requestMutex;
+	std::condition_variable requestReady;
+	std::deque<Request> highPriorityRequests;
+	std::deque<Request> lowPriorityRequests;
+
+	// Finished assets out (worker -> render thread), lock-free
+	// When it's full the worker sleeps on completedTaken until pollCompleted makes room
+	SpscQueue<StreamedAsset*, 64> completed;
+	std::condition_variable completedTaken;
+
+	std::atomic<bool> running;
+	std::atomic<size_t> pending;
+	uint32_t nextTicket;
+	JobSystem* jobSystem;
+	const AssetArchive* archive;
+	std::thread worker;
+};
@@ -0,0 +1,67 @@
+/*!
+*  \brief     AlignedArena Benchmark.
+*  \details   This file is to time aligned allocation against plain new
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "Benchmark.h"
+
+#include <vector>
+
+#include "AlignedArena.h"
+#include "Camera.h"
+
+void benchmarkAlignedAllocation(const std::string&)
+{
+	const int rounds = 1000;
+	const size_t transforms = 1024;
+	size_t misaligned = 0;
+
+	// One heap allocation per transform
+	auto start = std::chrono::steady_clock::now();
+	for (int round = 0; round < rounds; round++)
+	{
+		std::vector<Camera*> cameras;
+		cameras.reserve(transforms);
+		for (size_t i = 0; i < transforms; i++)
+			cameras.push_back(new Camera());
+		for (Camera* camera : cameras)
+		{
+			misaligned += ((uintptr_t)camera & (SIMD_ALIGNMENT - 1)) != 0;
+			delete camera;
+		}
+	}
+	double heapSeconds = secondsSince(start);
+
+	// Same transforms out of an aligned vector
+	start = std::chrono::steady_clock::now();
+	for (int round = 0; round < rounds; round++)
+	{
+		AlignedVector<glm::mat4> matrices(transforms, glm::mat4(1.0f));
+		misaligned += ((uintptr_t)matrices.data() & (SIMD_ALIGNMENT - 1)) != 0;
+	}
+	double vectorSeconds = secondsSince(start);
+
+	// And out of an arena that is reset every round
+	AlignedArena arena;
+	start = std::chrono::steady_clock::now();
+	for (int round = 0; round < rounds; round++)
+	{
+		arena.reset();
+		for (size_t i = 0; i < transforms; i++)
+		{
+			glm::mat4* matrix = arena.create<glm::mat4>(1.0f);
+			misaligned += ((uintptr_t)matrix & (SIMD_ALIGNMENT - 1)) != 0;
+		}
+	}
+	double arenaSeconds = secondsSince(start);
+
+	const double perTransform = 1.0e9 / (double)(rounds * transforms);
+	printf("%-30s %10zu %12.1f ns / transform\n", "new Camera (AlignedObject)", transforms, heapSeconds * perTransform);
+	printf("%-30s %10zu %12.1f ns / transform\n", "AlignedVector<mat4>", transforms, vectorSeconds * perTransform);
+	printf("%-30s %10zu %12.1f ns / transform\n", "AlignedArena::create<mat4>", transforms, arenaSeconds * perTransform);
+	printf("%-30s %10zu  (%s)\n", "misaligned allocations", misaligned, benchmarkCheck(misaligned == 0, "ok", "FAILED"));
+}
@@ -0,0 +1,115 @@
+/*!
+*  \brief     AssetArchive Benchmark.
+*  \details   This file is to time reading assets from the archive against loose files
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "Benchmark.h"
+
+#include <filesystem>
+#include <stdint.h>
+#include <vector>
+
+#include "AssetArchive.h"
+#include "AssetCooker.h"
+#include "MappedFile.h"
+
+// Add up every byte so nothing can be skipped
+static uint32_t touchBytes(const uint8_t* data, size_t size)
+{
+	uint32_t sum = 0;
+	for (size_t i = 0; i < size; i++)
+		sum += data[i];
+	return sum;
+}
+
+void benchmarkAssetArchive(const std::string& assetDir)
+{
+	const int rounds = 20;
+
+	// Cook the whole asset folder into a scratch copy, then pack it both ways
+	std::filesystem::path scratch = std::filesystem::temp_directory_path() / "pgg_archive_assets";
+	std::filesystem::remove_all(scratch);
+	std::filesystem::create_directories(scratch);
+	std::error_code error;
+	for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(assetDir))
+	{
+		std::string extension = entry.path().extension().string();
+		if (entry.is_regular_file() && (extension == ".obj" || extension == ".bmp" || extension == ".mtl"))
+			std::filesystem::copy_file(entry.path(), scratch / entry.path().filename(), error);
+	}
+	AssetCooker cooker;
+	cooker.Cook(scratch.string());
+
+	std::vector<ArchiveSource> sources;
+	for (const CookedAsset& asset : cooker.GetAssets())
+	{
+		ArchiveSource source = { std::filesystem::path(asset.cookedFileName).filename().string(), asset.cookedFileName, false,
+								   asset.sourceFileName };
+		sources.push_back(source);
+	}
+	std::string storedArchive = (scratch / "stored.pak").string();
+	std::string compressedArchive = (scratch / "lz4.pak").string();
+	AssetArchive::Write(storedArchive, sources);
+	for (ArchiveSource& source : sources)
+		source.compress = true;
+	auto start = std::chrono::steady_clock::now();
+	AssetArchive::Write(compressedArchive, sources);
+	double packSeconds = secondsSince(start);
+
+	// Every file opened and mapped on its own, the way they're loaded loose
+	uint32_t looseSum = 0;
+	uint64_t bytes = 0;
+	start = std::chrono::steady_clock::now();
+	for (int round = 0; round < rounds; round++)
+	{
+		for (const ArchiveSource& source : sources)
+		{
+			MappedFile file;
+			file.Open(source.fileName);
+			looseSum += touchBytes(file.GetData(), file.GetSize());
+			bytes += round == 0 ? file.GetSize() : 0;
+		}
+	}
+	double looseSeconds = secondsSince(start) / rounds;
+
+	// One archive mapped once, every entry looked up by name
+	double archiveSeconds[2] = { 0.0, 0.0 };
+	uint32_t archiveSums[2] = { 0, 0 };
+	uint64_t archiveSizes[2] = { 0, 0 };
+	const std::string* archives[2] = { &storedArchive, &compressedArchive };
+	for (int a = 0; a < 2; a++)
+	{
+		archiveSizes[a] = std::filesystem::file_size(*archives[a]);
+		std::vector<uint8_t> buffer;
+		start = std::chrono::steady_clock::now();
+		for (int round = 0; round < rounds; round++)
+		{
+			AssetArchive archive;
+			archive.Open(*archives[a]);
+			for (const ArchiveSource& source : sources)
+			{
+				const uint8_t* data = nullptr;
+				size_t size = 0;
+				const ArchiveEntry* entry = archive.Find(source.name);
+				if (entry && archive.Read(*entry, data, size, buffer))
+					archiveSums[a] += touchBytes(data, size);
+			}
+		}
+		archiveSeconds[a] = secondsSince(start) / rounds;
+	}
+	benchmarkSink = (float)(looseSum + archiveSums[0] + archiveSums[1]);
+
+	printf("%-30s %10s %12s %12s\n", "AssetArchive", "files", "bytes", "ms / load");
+	printf("%-30s %10zu %12llu %12.3f\n", "loose cooked files", sources.size(), (unsigned long long)bytes, looseSeconds * 1000.0);
+	printf("%-30s %10zu %12llu %12.3f  (%s)\n", "archive, stored", sources.size(), (unsigned long long)archiveSizes[0],
+		   archiveSeconds[0] * 1000.0, benchmarkCheck(archiveSums[0] == looseSum, "same bytes"));
+	printf("%-30s %10zu %12llu %12.3f  (%s, %.0f MB/s unpacked, packed in %.1f ms)\n", "archive, lz4", sources.size(),
+		   (unsigned long long)archiveSizes[1], archiveSeconds[1] * 1000.0, benchmarkCheck(archiveSums[1] == looseSum, "same bytes"),
+		   bytes / archiveSeconds[1] / 1.0e6, packSeconds * 1000.0);
+
+	std::filesystem::remove_all(scratch);
+}
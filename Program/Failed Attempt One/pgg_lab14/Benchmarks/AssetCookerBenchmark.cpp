@@ -0,0 +1,100 @@
+/*!
+*  \brief     AssetCooker Benchmark.
+*  \details   This file is to time cooking the assets, from nothing and when nothing changed
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <thread>
+
+#include "AssetCooker.h"
+#include "JobSystem.h"
+#include "MeshFile.h"
+#include "ObjLoader.h"
+#include "TangentGenerator.h"
+#include "TextureConverter.h"
+
+void benchmarkAssetCooker(const std::string& assetDir)
+{
+	const char* meshes[] = { "Rocket.obj", "Level Final.obj", "Rock_big_single_b_LOD0.obj", "airboat.obj",
+							 "cessna.obj", "teapot.obj", "Duhduhduh.obj" };
+	const char* images[] = { "MenuBackground.bmp", "DestinationOrigin.bmp", "NewGameSelected.bmp", "ExitSelected.bmp" };
+	const int repeats = 5;
+
+	// A scratch copy of some of the assets, so cooking doesn't write next to the real ones
+	std::filesystem::path scratch = std::filesystem::temp_directory_path() / "pgg_cooked_assets";
+	std::filesystem::remove_all(scratch);
+	std::filesystem::create_directories(scratch);
+	for (const char* mesh : meshes)
+		std::filesystem::copy_file(std::filesystem::path(assetDir) / mesh, scratch / mesh);
+	for (const char* image : images)
+		std::filesystem::copy_file(std::filesystem::path(assetDir) / image, scratch / image);
+	std::error_code error;
+	std::filesystem::copy_file(std::filesystem::path(assetDir) / "Duhduhduh.mtl", scratch / "Duhduhduh.mtl", error);
+
+	int workers = (int)std::max(1u, std::thread::hardware_concurrency()) - 1;
+	JobSystem jobSystem(workers);
+	AssetCooker cooker(&jobSystem);
+
+	auto start = std::chrono::steady_clock::now();
+	bool cooked = cooker.Cook(scratch.string());
+	double fullSeconds = secondsSince(start);
+
+	start = std::chrono::steady_clock::now();
+	cooker.Cook(scratch.string());
+	double incrementalSeconds = secondsSince(start);
+	size_t upToDate = 0;
+	for (const CookedAsset& asset : cooker.GetAssets())
+		upToDate += asset.result == CookResult::UpToDate;
+
+	printf("%-30s %10s %12s\n", "AssetCooker", "files", "ms");
+	printf("%-30s %10zu %12.2f  (%s)\n", "everything", cooker.GetAssets().size(), fullSeconds * 1000.0,
+		   benchmarkCheck(cooked, "ok", "FAILED"));
+	printf("%-30s %10zu %12.2f  (%zu up to date, %s)\n", "nothing changed", cooker.GetAssets().size(), incrementalSeconds * 1000.0,
+		   upToDate, benchmarkCheck(upToDate == cooker.GetAssets().size(), "ok", "FAILED"));
+
+	// What the game pays to get each mesh into memory, parsed against mapped
+	printf("%-30s %10s %12s %12s\n", "Mesh load", "triangles", "OBJ ms", "cooked ms");
+	for (const char* mesh : meshes)
+	{
+		std::string source = (scratch / mesh).string();
+		MeshData parsed;
+		start = std::chrono::steady_clock::now();
+		for (int i = 0; i < repeats; i++)
+		{
+			ObjLoader loader;
+			loader.Load(source);
+			parsed = std::move(loader.GetMeshData());
+			if (TangentGenerator::IsNeeded(parsed))
+				TangentGenerator().Generate(parsed);
+		}
+		double objSeconds = secondsSince(start) / repeats;
+
+		MeshData read;
+		start = std::chrono::steady_clock::now();
+		for (int i = 0; i < repeats; i++)
+		{
+			MeshFile cookedMesh;
+			cookedMesh.Open(MeshFile::GetCookedFileName(source));
+			cookedMesh.Read(read);
+		}
+		double cookedSeconds = secondsSince(start) / repeats;
+
+		bool same = read.vertices == parsed.vertices && read.normals == parsed.normals && read.texCoords == parsed.texCoords &&
+					read.tangents == parsed.tangents && read.subsets.size() == parsed.subsets.size() &&
+					read.materials.size() == parsed.materials.size();
+		for (size_t i = 0; same && i < read.materials.size(); i++)
+			same = read.materials[i].name == parsed.materials[i].name && read.materials[i].diffuseMap == parsed.materials[i].diffuseMap;
+
+		printf("%-30s %10zu %12.3f %12.3f  (%s)\n", mesh, parsed.GetVertexCount() / 3, objSeconds * 1000.0, cookedSeconds * 1000.0,
+			   benchmarkCheck(same, "same mesh"));
+	}
+
+	std::filesystem::remove_all(scratch);
+}
@@ -0,0 +1,160 @@
+/*!
+*  \brief     AssetStreamer Benchmark.
+*  \details   This file is to time streaming meshes in the background and loading them again when they change
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "Benchmark.h"
+
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+#include "AssetStreamer.h"
+#include "FileWatcher.h"
+#include "JobSystem.h"
+#include "ObjLoader.h"
+#include "TangentGenerator.h"
+#include "TextureConverter.h"
+
+void benchmarkAssetStreamer(const std::string& assetDir)
+{
+	const char* images[] = { "MenuBackground.bmp", "DestinationOrigin.bmp", "NewGameSelected.bmp", "NewGameUnselected.bmp",
+							 "OptionsSelected.bmp", "OptionsUnselected.bmp", "ExitSelected.bmp", "ExitUnselected.bmp" };
+	const char* meshes[] = { "Rocket.obj", "Level Final.obj" };
+
+	// Everything on this thread, like the game used to
+	auto start = std::chrono::steady_clock::now();
+	for (const char* image : images)
+	{
+		BmpLoader loader;
+		loader.Load(assetDir + "/" + image);
+	}
+	for (const char* mesh : meshes)
+	{
+		ObjLoader loader;
+		loader.Load(assetDir + "/" + mesh);
+	}
+	double syncSeconds = secondsSince(start);
+
+	// Streamed - how long until the first thing could be shown, and until it has all arrived
+	start = std::chrono::steady_clock::now();
+	AssetStreamer streamer;
+	double requestSeconds = 0.0;
+	double firstSeconds = -1.0;
+	size_t arrived = 0;
+
+	for (const char* image : images)
+		streamer.requestImage(assetDir + "/" + image);
+	for (const char* mesh : meshes)
+		streamer.requestMesh(assetDir + "/" + mesh);
+	requestSeconds = secondsSince(start);
+
+	std::unique_ptr<StreamedAsset> asset;
+	while (streamer.getPendingCount() > 0)
+	{
+		if (streamer.pollCompleted(asset))
+		{
+			if (firstSeconds < 0.0)
+				firstSeconds = secondsSince(start);
+			arrived += asset->loaded ? 1 : 0;
+		}
+		else
+		{
+			std::this_thread::yield();
+		}
+	}
+	double streamedSeconds = secondsSince(start);
+
+	printf("%-30s %10zu %12.3f ms\n", "synchronous load", sizeof(images) / sizeof(images[0]) + 2, syncSeconds * 1000.0);
+	printf("%-30s %10zu %12.3f ms  (%s)\n", "streamed: requests queued", arrived, requestSeconds * 1000.0,
+		   benchmarkCheck(arrived == sizeof(images) / sizeof(images[0]) + 2, "all loaded", "FAILED"));
+	printf("%-30s %10s %12.3f ms\n", "streamed: first asset", "", firstSeconds * 1000.0);
+	printf("%-30s %10s %12.3f ms\n", "streamed: all assets", "", streamedSeconds * 1000.0);
+}
+
+// Wait for one streamed request, false if it didn't load
+static bool waitForStreamed(AssetStreamer& streamer)
+{
+	std::unique_ptr<StreamedAsset> asset;
+	while (!streamer.pollCompleted(asset))
+		std::this_thread::yield();
+	return asset->loaded;
+}
+
+void benchmarkHotReload(const std::string& assetDir)
+{
+	const int rounds = 5;
+
+	// Scratch copies to edit, so the real assets are never touched
+	std::filesystem::path scratch = std::filesystem::temp_directory_path() / "pgg_hot_reload";
+	std::filesystem::remove_all(scratch);
+	std::filesystem::create_directories(scratch / "Shaders");
+	std::error_code error;
+	std::filesystem::copy_file(std::filesystem::path(assetDir) / "Rocket.obj", scratch / "Rocket.obj", error);
+	std::filesystem::copy_file(std::filesystem::path(assetDir) / "Shaders" / "Lit.frag", scratch / "Shaders" / "Lit.frag", error);
+	std::string meshFileName = (scratch / "Rocket.obj").string();
+	std::string shaderFileName = (scratch / "Shaders" / "Lit.frag").string();
+
+	FileWatcher watcher;
+	watcher.Watch(meshFileName);
+	watcher.Watch(shaderFileName);
+
+	JobSystem jobs(std::thread::hardware_concurrency() > 1 ? std::thread::hardware_concurrency() - 1 : 1);
+	AssetStreamer streamer(&jobs);
+	std::vector<std::string> changed;
+
+	double noticeSeconds = 0.0, meshSeconds = 0.0, lodSeconds = 0.0, shaderSeconds = 0.0;
+	size_t noticed = 0, reloaded = 0;
+	for (int round = 0; round < rounds; round++)
+	{
+		// Save both files the way an editor would, then see how long until the game knows
+		for (const std::string& fileName : { meshFileName, shaderFileName })
+		{
+			std::ofstream edit(fileName, std::ios::app);
+			edit << "\n// edit " << round << "\n";
+		}
+		auto start = std::chrono::steady_clock::now();
+		size_t seen = 0;
+		while (seen < 2 && secondsSince(start) < 2.0)
+		{
+			watcher.Poll(changed);
+			seen += changed.size();
+			if (changed.empty())
+				std::this_thread::yield();
+		}
+		noticeSeconds += secondsSince(start);
+		noticed += seen;
+
+		// Everything the game does before the swap - parse on the worker, hand it back
+		start = std::chrono::steady_clock::now();
+		streamer.reloadMesh(meshFileName);
+		reloaded += waitForStreamed(streamer) ? 1 : 0;
+		meshSeconds += secondsSince(start);
+
+		start = std::chrono::steady_clock::now();
+		streamer.reloadMesh(meshFileName, MeshProcessing::GenerateLods);
+		reloaded += waitForStreamed(streamer) ? 1 : 0;
+		lodSeconds += secondsSince(start);
+
+		start = std::chrono::steady_clock::now();
+		streamer.requestText(shaderFileName);
+		reloaded += waitForStreamed(streamer) ? 1 : 0;
+		shaderSeconds += secondsSince(start);
+	}
+
+	printf("%-30s %10s %12s\n", "HotReload", watcher.IsNotified() ? "inotify" : "polled", "ms / save");
+	printf("%-30s %10zu %12.3f  (%s)\n", "change noticed", noticed, noticeSeconds * 1000.0 / rounds,
+		   benchmarkCheck(noticed == 2 * rounds, "ok", "FAILED"));
+	printf("%-30s %10zu %12.3f  (%s)\n", "Rocket.obj parsed", reloaded, meshSeconds * 1000.0 / rounds,
+		   benchmarkCheck(reloaded == 3 * rounds, "ok", "FAILED"));
+	printf("%-30s %10s %12.3f\n", "Rocket.obj parsed + LODs", "", lodSeconds * 1000.0 / rounds);
+	printf("%-30s %10s %12.3f\n", "Lit.frag read", "", shaderSeconds * 1000.0 / rounds);
+
+	streamer.stop();
+	std::filesystem::remove_all(scratch);
+}
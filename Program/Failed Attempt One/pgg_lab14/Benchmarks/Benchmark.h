@@ -0,0 +1,50 @@
+/*!
+*  \brief     Core Benchmark.
+*  \details   This file is to time the headless core (loading, simulation and camera) with no window or GPU, one file per module
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+/// Stop the optimiser throwing away results we never look at
+extern volatile float benchmarkSink;
+
+/// Benchmarks check their own answers as they go - a wrong one is counted (failing the run) and printed as failText
+const char* benchmarkCheck(bool passed, const char* passText, const char* failText = "MISMATCH");
+
+inline double secondsSince(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/// Benchmarks, each in Benchmarks/<Module>Benchmark.cpp and run by name, given the folder the sample assets are in
+void benchmarkObjLoader(const std::string& assetDir);
+void benchmarkNumberParsing(const std::string& assetDir);
+void benchmarkFaceParsing(const std::string& assetDir);
+void benchmarkNormalGenerator(const std::string& assetDir);
+void benchmarkTangentGenerator(const std::string& assetDir);
+void benchmarkSimulation(const std::string& assetDir);
+void benchmarkSimulationThread(const std::string& assetDir);
+void benchmarkJobSystem(const std::string& assetDir);
+void benchmarkCamera(const std::string& assetDir);
+void benchmarkAlignedAllocation(const std::string& assetDir);
+void benchmarkFrameArena(const std::string& assetDir);
+void benchmarkAssetStreamer(const std::string& assetDir);
+void benchmarkHotReload(const std::string& assetDir);
+void benchmarkTextureAtlas(const std::string& assetDir);
+void benchmarkCookedTextures(const std::string& assetDir);
+void benchmarkAssetCooker(const std::string& assetDir);
+void benchmarkAssetArchive(const std::string& assetDir);
+void benchmarkLodSelection(const std::string& assetDir);
+void benchmarkFrustumCulling(const std::string& assetDir);
+void benchmarkOcclusionCulling(const std::string& assetDir);
+void benchmarkTerrainChunks(const std::string& assetDir);
+void benchmarkEndlessTrack(const std::string& assetDir);
+void benchmarkMeshSimplifier(const std::string& assetDir);
@@ -0,0 +1,106 @@
+/*!
+*  \brief     Core Benchmark.
+*  \details   This file is to run the core benchmarks, all of them or the ones named, and fail if any came out wrong
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "Benchmark.h"
+
+#include <cstring>
+#include <vector>
+
+#include "MeshCache.h"
+
+struct BenchmarkEntry
+{
+	const char* name;
+	void (*run)(const std::string& assetDir);
+
+	// Benchmarks in the same group print together, a blank line between groups
+	int group;
+};
+
+// Every benchmark, in the order they run when none are named
+static const BenchmarkEntry benchmarks[] =
+{
+	{ "ObjLoader", benchmarkObjLoader, 0 },
+	{ "NumberParsing", benchmarkNumberParsing, 0 },
+	{ "FaceParsing", benchmarkFaceParsing, 0 },
+	{ "NormalGenerator", benchmarkNormalGenerator, 0 },
+	{ "TangentGenerator", benchmarkTangentGenerator, 0 },
+	{ "Simulation", benchmarkSimulation, 1 },
+	{ "SimulationThread", benchmarkSimulationThread, 1 },
+	{ "JobSystem", benchmarkJobSystem, 1 },
+	{ "Camera", benchmarkCamera, 1 },
+	{ "AlignedAllocation", benchmarkAlignedAllocation, 2 },
+	{ "FrameArena", benchmarkFrameArena, 3 },
+	{ "AssetStreamer", benchmarkAssetStreamer, 4 },
+	{ "HotReload", benchmarkHotReload, 4 },
+	{ "TextureAtlas", benchmarkTextureAtlas, 4 },
+	{ "CookedTextures", benchmarkCookedTextures, 4 },
+	{ "AssetCooker", benchmarkAssetCooker, 4 },
+	{ "AssetArchive", benchmarkAssetArchive, 4 },
+	{ "LodSelection", benchmarkLodSelection, 5 },
+	{ "FrustumCulling", benchmarkFrustumCulling, 6 },
+	{ "OcclusionCulling", benchmarkOcclusionCulling, 6 },
+	{ "TerrainChunks", benchmarkTerrainChunks, 7 },
+	{ "EndlessTrack", benchmarkEndlessTrack, 8 },
+	{ "MeshSimplifier", benchmarkMeshSimplifier, 9 },
+};
+
+volatile float benchmarkSink;
+static int benchmarkFailures = 0;
+
+const char* benchmarkCheck(bool passed, const char* passText, const char* failText)
+{
+	if (!passed)
+		benchmarkFailures++;
+	return passed ? passText : failText;
+}
+
+// pgg_core_benchmark [--assets folder] [benchmark...]
+int main(int argc, char** argv)
+{
+	// Assets live next to the source unless told otherwise, anything built from them goes in the build folder
+	std::string assetDir = PGG_ASSET_DIR;
+	MeshCache::SetCacheDirectory(PGG_CACHE_DIR);
+
+	std::vector<const BenchmarkEntry*> selected;
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--assets") == 0 && i + 1 < argc)
+		{
+			assetDir = argv[++i];
+			continue;
+		}
+
+		const BenchmarkEntry* found = nullptr;
+		for (const BenchmarkEntry& benchmark : benchmarks)
+			found = strcmp(benchmark.name, argv[i]) == 0 ? &benchmark : found;
+		if (!found)
+		{
+			printf("No benchmark called %s\n", argv[i]);
+			return 2;
+		}
+		selected.push_back(found);
+	}
+	if (selected.empty())
+	{
+		for (const BenchmarkEntry& benchmark : benchmarks)
+			selected.push_back(&benchmark);
+	}
+
+	for (size_t i = 0; i < selected.size(); i++)
+	{
+		if (i > 0 && selected[i]->group != selected[i - 1]->group)
+			printf("\n");
+		selected[i]->run(assetDir);
+	}
+
+	if (benchmarkFailures > 0)
+		printf("\n%d checks FAILED\n", benchmarkFailures);
+	return benchmarkFailures == 0 ? 0 : 1;
+}
@@ -0,0 +1,33 @@
+/*!
+*  \brief     Camera Benchmark.
+*  \details   This file is to time the camera following the Rocket
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "Benchmark.h"
+
+#include "Camera.h"
+
+void benchmarkCamera(const std::string&)
+{
+	const int steps = 1000000;
+	Camera* camera = new Camera();
+	float total = 0.0f;
+
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < steps; i++)
+	{
+		camera->followRocket(glm::vec3(0.0f, 0.0f, -(float)i * 0.01f));
+		camera->update();
+		total += camera->getView()[3][2];
+	}
+	double seconds = secondsSince(start);
+
+	benchmarkSink = total;
+	printf("%-30s %10d %12.1f ns / step\n", "Camera::update", steps, seconds * 1.0e9 / steps);
+
+	delete camera;
+}
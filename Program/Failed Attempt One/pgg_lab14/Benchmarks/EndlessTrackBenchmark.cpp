@@ -0,0 +1,67 @@
+/*!
+*  \brief     EndlessTrack Benchmark.
+*  \details   This file is to time generating track segments ahead of the Rocket
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "Benchmark.h"
+
+#include <thread>
+
+#include "EndlessTrack.h"
+#include "Simulation.h"
+#include "TrackGenerator.h"
+
+void benchmarkEndlessTrack(const std::string&)
+{
+	// Same seed, same segment, whatever order they are made in
+	TrackGenerator generator(1234);
+	TrackSegment first, second;
+	generator.generate(50, first);
+	generator.generate(3, second);
+	generator.generate(50, second);
+	bool repeatable = first.rowCount == second.rowCount;
+	for (size_t i = 0; repeatable && i < first.rowCount; i++)
+		repeatable = first.rows[i].z == second.rows[i].z && first.rows[i].obstacles.size() == second.rows[i].obstacles.size();
+
+	// Fly much faster than the Rocket can, the generator still has to keep up
+	EndlessTrack track(1234);
+	const float speed = 5.0f;
+	const int frames = 20000;
+	size_t missing = 0, mostActive = 0;
+	double totalUpdate = 0.0, slowestUpdate = 0.0;
+
+	// The game sits in the menu first, give the worker the same head start
+	track.update(0.0f);
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+	for (int frame = 0; frame < frames; frame++)
+	{
+		float rocketZ = -frame * speed;
+
+		auto updateStart = std::chrono::steady_clock::now();
+		track.update(rocketZ);
+		double updateSeconds = secondsSince(updateStart);
+		totalUpdate += updateSeconds;
+		slowestUpdate = updateSeconds > slowestUpdate ? updateSeconds : slowestUpdate;
+
+		// Is the ground under the Rocket there yet?
+		bool found = false;
+		for (const TrackSegment* segment : track.getSegments())
+			found = found || (rocketZ <= segment->topZ && rocketZ >= segment->bottomZ);
+		missing += found ? 0 : 1;
+		mostActive = track.getSegments().size() > mostActive ? track.getSegments().size() : mostActive;
+
+		// Roughly a 60Hz frame at 5 units, so this is 300 units a second
+		if (frame % 64 == 0)
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	printf("%-30s %10s\n", "TrackGenerator repeatable", benchmarkCheck(repeatable, "yes", "NO"));
+	printf("%-30s %10zu %12.2f us / frame (slowest %.1f us)\n", "EndlessTrack::update", track.getSegmentsGenerated(),
+		   totalUpdate * 1.0e6 / frames, slowestUpdate * 1.0e6);
+	printf("%-30s %10zu of %d frames, at most %zu segments alive\n", "Segment missing under Rocket", missing, frames, mostActive);
+}
@@ -0,0 +1,73 @@
+/*!
+*  \brief     FrameArena Benchmark.
+*  \details   This file is to time building a frame's temporaries in the frame arena
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "Benchmark.h"
+
+#include <vector>
+
+#include "AllocationCounter.h"
+#include "FrameArena.h"
+#include "SDKS/glm/glm.hpp"
+
+// A frame's worth of temporaries - a draw list, a contact list and a status string
+template <typename DrawList, typename ContactList, typename Text>
+static size_t buildFrame(DrawList& drawList, ContactList& contacts, Text& status, int frame)
+{
+	for (int i = 0; i < 512; i++)
+		drawList.push_back(glm::vec4((float)i, (float)frame, 0.0f, 1.0f));
+	for (int i = 0; i < 64; i++)
+		contacts.push_back(i * frame);
+
+	status += "-------Tries-------- frame ";
+	status += std::to_string(frame % 10);
+	return drawList.size() + contacts.size() + status.size();
+}
+
+void benchmarkFrameArena(const std::string&)
+{
+	const int frames = 20000;
+	size_t total = 0;
+
+	// Global heap every frame
+	size_t allocationsBefore = getGlobalAllocationCount();
+	auto start = std::chrono::steady_clock::now();
+	for (int frame = 0; frame < frames; frame++)
+	{
+		std::vector<glm::vec4> drawList;
+		std::vector<int> contacts;
+		std::string status;
+		total += buildFrame(drawList, contacts, status, frame);
+	}
+	double heapSeconds = secondsSince(start);
+	size_t heapAllocations = getGlobalAllocationCount() - allocationsBefore;
+
+	// Frame arena, reset at the start of every frame
+	FrameArena frameArena;
+	allocationsBefore = getGlobalAllocationCount();
+	start = std::chrono::steady_clock::now();
+	for (int frame = 0; frame < frames; frame++)
+	{
+		frameArena.beginFrame();
+		FrameVector<glm::vec4> drawList(&frameArena);
+		FrameVector<int> contacts(&frameArena);
+		FrameString status(&frameArena);
+		total += buildFrame(drawList, contacts, status, frame);
+	}
+	double arenaSeconds = secondsSince(start);
+	size_t arenaAllocations = getGlobalAllocationCount() - allocationsBefore;
+
+	benchmarkSink = (float)total;
+	printf("%-30s %10d %12.1f ns / frame", "std heap temporaries", frames, heapSeconds * 1.0e9 / frames);
+	if (isAllocationCountingEnabled())
+		printf("  (%.1f allocations / frame)", (double)heapAllocations / frames);
+	printf("\n%-30s %10d %12.1f ns / frame", "FrameArena temporaries", frames, arenaSeconds * 1.0e9 / frames);
+	if (isAllocationCountingEnabled())
+		printf("  (%.1f allocations / frame)", (double)arenaAllocations / frames);
+	printf("\n%-30s %10zu\n", "FrameArena peak bytes", frameArena.getPeakBytesUsed());
+}
@@ -0,0 +1,64 @@
+/*!
+*  \brief     Frustum Benchmark.
+*  \details   This file is to time culling the level against the view frustum
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "Benchmark.h"
+
+#include <vector>
+
+#include "Camera.h"
+#include "Frustum.h"
+#include "ObjLoader.h"
+
+void benchmarkFrustumCulling(const std::string& assetDir)
+{
+	ObjLoader rock;
+	rock.Load(assetDir + "/Rock_big_single_b_LOD0.obj");
+	const MeshBounds& bounds = rock.GetMeshData().bounds;
+
+	// The same rock field as the LOD test, each rock a quarter of its full size
+	const float scale = 0.25f;
+	std::vector<glm::vec3> centres, boxMins, boxMaxs;
+	for (int row = 0; row < 256; row++)
+	{
+		for (int column = 0; column < 8; column++)
+		{
+			glm::vec3 position(-112.0f + column * 32.0f, -15.0f, -10.0f * row);
+			centres.push_back(position + bounds.centre * scale);
+			boxMins.push_back(position + bounds.min * scale);
+			boxMaxs.push_back(position + bounds.max * scale);
+		}
+	}
+	float radius = bounds.radius * scale;
+
+	// Fly the real Camera down the field
+	Camera* camera = new Camera();
+	Frustum frustum;
+	const int frames = 2000;
+	size_t visible = 0, tests = 0;
+
+	auto start = std::chrono::steady_clock::now();
+	for (int frame = 0; frame < frames; frame++)
+	{
+		camera->followRocket(glm::vec3(0.0f, 0.0f, -frame * 0.5f));
+		camera->update();
+		frustum.extractPlanes(camera->getProjection() * camera->getView());
+
+		for (size_t i = 0; i < centres.size(); i++)
+		{
+			if (frustum.isSphereVisible(centres[i], radius) && frustum.isBoxVisible(boxMins[i], boxMaxs[i]))
+				visible++;
+			tests++;
+		}
+	}
+	double seconds = secondsSince(start);
+	delete camera;
+
+	printf("%-30s %10zu %12.1f ns / instance\n", "Frustum sphere + box", centres.size(), seconds * 1.0e9 / tests);
+	printf("%-30s %10zu drawn / frame, %zu culled\n", "Frustum culling", visible / frames, (tests - visible) / frames);
+}
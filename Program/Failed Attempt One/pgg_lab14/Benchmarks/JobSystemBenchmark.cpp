@@ -0,0 +1,123 @@
+/*!
+*  \brief     JobSystem Benchmark.
+*  \details   This file is to time spreading jobs over the worker threads
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "Benchmark.h"
+
+#include <atomic>
+#include <stdint.h>
+#include <thread>
+#include <vector>
+
+#include "JobSystem.h"
+#include "TangentGenerator.h"
+
+// Busy work standing in for a job - iterations of a cheap hash
+static uint32_t spinWork(uint32_t seed, int iterations)
+{
+	for (int i = 0; i < iterations; i++)
+		seed = seed * 1664525u + 1013904223u;
+	return seed;
+}
+
+struct SpinJobData
+{
+	int iterations;
+	std::atomic<uint32_t>* sink;
+	std::atomic<int>* runs;
+};
+
+static void spinJob(Job& job, const void* data)
+{
+	const SpinJobData& spin = *(const SpinJobData*)data;
+	spin.sink->fetch_add(spinWork((uint32_t)(uintptr_t)&job, spin.iterations), std::memory_order_relaxed);
+	spin.runs->fetch_add(1, std::memory_order_relaxed);
+}
+
+void benchmarkJobSystem(const std::string&)
+{
+	int cores = (int)std::thread::hardware_concurrency();
+	const int workerCounts[] = { 0, 1, 3, 7 };
+
+	for (int workers : workerCounts)
+	{
+		JobSystem jobSystem(workers);
+		std::atomic<uint32_t> sink(0);
+
+		// Lots of tiny jobs (mostly overhead) and fewer big ones, all children of one root
+		const int taskSizes[] = { 16, 16384 };
+		for (int iterations : taskSizes)
+		{
+			const int jobs = iterations < 1000 ? 20000 : 2000;
+			std::atomic<int> runs(0);
+			SpinJobData data = { iterations, &sink, &runs };
+
+			auto start = std::chrono::steady_clock::now();
+			Job* root = jobSystem.createJob(nullptr);
+			for (int i = 0; i < jobs; i++)
+				jobSystem.run(jobSystem.createJob(&spinJob, data, root));
+			jobSystem.run(root);
+			jobSystem.wait(root);
+			double seconds = secondsSince(start);
+
+			char label[64];
+			snprintf(label, sizeof(label), "Jobs x%d, %d workers", iterations, workers);
+			printf("%-30s %10d %12.1f ns / job  (%s)\n", label, jobs, seconds * 1.0e9 / jobs,
+				   benchmarkCheck(runs.load() == jobs, "all ran"));
+		}
+
+		// The same work split up with parallelFor, at a few batch sizes
+		const size_t count = 1 << 20;
+		std::vector<float> values(count, 1.0f);
+		const size_t batchSizes[] = { 256, 4096, 65536 };
+		for (size_t batchSize : batchSizes)
+		{
+			auto start = std::chrono::steady_clock::now();
+			jobSystem.parallelFor(count, batchSize, [&](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; i++)
+					values[i] = values[i] * 0.5f + 1.0f;
+			});
+			double seconds = secondsSince(start);
+
+			char label[64];
+			snprintf(label, sizeof(label), "parallelFor /%zu, %d workers", batchSize, workers);
+			printf("%-30s %10zu %12.2f ms\n", label, count, seconds * 1.0e3);
+		}
+		// Three passes of x * 0.5 + 1 from 1 is 1.875 exactly, unless an index was skipped or done twice
+		size_t wrong = 0;
+		for (float value : values)
+			wrong += value != 1.875f;
+		printf("%-30s %10zu  (%s)\n", "parallelFor wrong values", wrong, benchmarkCheck(wrong == 0, "ok", "FAILED"));
+		benchmarkSink = values[count / 2];
+
+		// A chain where each job only starts once the one before it has finished
+		const int chainLength = 1000;
+		std::atomic<int> runs(0);
+		SpinJobData data = { 16, &sink, &runs };
+		auto start = std::chrono::steady_clock::now();
+		Job* first = jobSystem.createJob(&spinJob, data);
+		Job* previous = first;
+		for (int i = 1; i < chainLength; i++)
+		{
+			Job* next = jobSystem.createJob(&spinJob, data);
+			jobSystem.addContinuation(previous, next);
+			previous = next;
+		}
+		jobSystem.run(first);
+		jobSystem.wait(previous);
+		double seconds = secondsSince(start);
+
+		char label[64];
+		snprintf(label, sizeof(label), "Continuations, %d workers", workers);
+		printf("%-30s %10d %12.1f ns / job (%zu stolen, %d cores)  (%s)\n", label, chainLength,
+			   seconds * 1.0e9 / chainLength, jobSystem.getJobsStolen(), cores,
+			   benchmarkCheck(runs.load() == chainLength, "all ran"));
+		benchmarkSink = (float)sink.load();
+	}
+}
@@ -0,0 +1,66 @@
+/*!
+*  \brief     LodGroup Benchmark.
+*  \details   This file is to time choosing levels of detail
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "Benchmark.h"
+
+#include <vector>
+
+#include "LodGroup.h"
+#include "ObjLoader.h"
+
+void benchmarkLodSelection(const std::string& assetDir)
+{
+	ObjLoader lod0, lod3;
+	lod0.Load(assetDir + "/Rock_big_single_b_LOD0.obj");
+	lod3.Load(assetDir + "/Rock_big_single_b_LOD3.obj");
+	size_t triangles[2] = { lod0.GetMeshVertices().size() / 9, lod3.GetMeshVertices().size() / 9 };
+
+	LodGroup group;
+	group.addLevel(250.0f);
+	group.addLevel(1000.0f);
+	group.setHysteresis(0.1f);
+
+	// A dense field of rocks over twice the length of the level
+	std::vector<LodInstance> instances;
+	for (int row = 0; row < 256; row++)
+	{
+		for (int column = 0; column < 8; column++)
+		{
+			LodInstance instance;
+			instance.position = glm::vec3(-112.0f + column * 32.0f, 0.0f, -10.0f * row);
+			instance.scale = glm::vec3(1.0f);
+			instance.lodLevel = -1;
+			instances.push_back(instance);
+		}
+	}
+
+	// Fly the camera down the field
+	const int frames = 2000;
+	size_t allDetailed = 0, selected = 0, switches = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (int frame = 0; frame < frames; frame++)
+	{
+		glm::vec3 eye(0.0f, 3.25f, 6.5f - frame * 0.5f);
+		for (LodInstance& instance : instances)
+		{
+			int level = group.selectLevel(glm::length(instance.position - eye), instance.lodLevel);
+			switches += (instance.lodLevel >= 0 && level != instance.lodLevel) ? 1 : 0;
+			instance.lodLevel = level;
+
+			allDetailed += triangles[0];
+			selected += triangles[level];
+		}
+	}
+	double seconds = secondsSince(start);
+
+	printf("%-30s %10zu %12.1f ns / instance\n", "LodGroup::selectLevel", instances.size(),
+		   seconds * 1.0e9 / ((double)frames * instances.size()));
+	printf("%-30s %10zu triangles / frame\n", "LOD0 everywhere", allDetailed / frames);
+	printf("%-30s %10zu triangles / frame (%zu switches)\n", "LOD0 / LOD3 by distance", selected / frames, switches);
+}
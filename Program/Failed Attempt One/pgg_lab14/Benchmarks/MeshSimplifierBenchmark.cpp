@@ -0,0 +1,58 @@
+/*!
+*  \brief     MeshSimplifier Benchmark.
+*  \details   This file is to time simplifying meshes into levels of detail
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "Benchmark.h"
+
+#include <filesystem>
+#include <vector>
+
+#include "MeshCache.h"
+#include "MeshSimplifier.h"
+#include "ObjLoader.h"
+
+void benchmarkMeshSimplifier(const std::string& assetDir)
+{
+	const char* meshes[] = { "Rocket.obj", "airboat.obj", "cessna.obj", "teapot.obj" };
+	std::vector<float> ratios = { 1.0f, 0.5f, 0.25f, 0.1f };
+	std::string cacheFile = (std::filesystem::temp_directory_path() / "pgg_benchmark.pmesh").string();
+
+	printf("%-30s %10s %12s %12s\n", "MeshSimplifier", "triangles", "error", "ms");
+
+	for (const char* mesh : meshes)
+	{
+		ObjLoader loader;
+		loader.Load(assetDir + "/" + mesh);
+
+		std::vector<MeshLod> lods;
+		auto start = std::chrono::steady_clock::now();
+		MeshSimplifier simplifier;
+		simplifier.GenerateLods(loader.GetMeshData(), ratios, lods);
+		double simplifySeconds = secondsSince(start);
+
+		for (size_t i = 0; i < lods.size(); i++)
+		{
+			std::string name = std::string(mesh) + " LOD" + std::to_string(i);
+			printf("%-30s %10zu %12.4f\n", name.c_str(), lods[i].mesh.GetVertexCount() / 3, lods[i].error);
+		}
+		printf("%-30s %10s %12s %12.3f\n", "  simplified", "", "", simplifySeconds * 1000.0);
+
+		// What the cache saves next time round
+		MeshCache cache;
+		cache.SetSource(assetDir + "/" + mesh, ratios);
+		cache.GetLods() = lods;
+		cache.Save(cacheFile);
+
+		start = std::chrono::steady_clock::now();
+		MeshCache cached;
+		cached.Load(cacheFile);
+		printf("%-30s %10zu %12s %12.3f\n", "  from .pmesh cache", cached.GetLods().size(), "levels", secondsSince(start) * 1000.0);
+	}
+
+	std::remove(cacheFile.c_str());
+}
@@ -0,0 +1,46 @@
+/*!
+*  \brief     NormalGenerator Benchmark.
+*  \details   This file is to time building smooth normals for the meshes
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "Benchmark.h"
+
+#include "NormalGenerator.h"
+#include "ObjLoader.h"
+
+void benchmarkNormalGenerator(const std::string& assetDir)
+{
+	// None of these have any "vn", so the loader made every normal
+	const char* meshes[] = { "teapot.obj", "airboat.obj", "cessna.obj" };
+	const int repeats = 20;
+	NormalGenerator generator;
+
+	for (const char* name : meshes)
+	{
+		ObjLoader loader;
+		loader.Load(assetDir + "/" + name);
+		MeshData& mesh = loader.GetMeshData();
+		size_t triangles = mesh.GetVertexCount() / 3;
+		if (triangles == 0)
+			continue;
+
+		auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < repeats; i++)
+			generator.Generate(mesh, NormalMode::Smooth);
+		double smoothSeconds = secondsSince(start) / repeats;
+
+		start = std::chrono::steady_clock::now();
+		for (int i = 0; i < repeats; i++)
+			generator.Generate(mesh, NormalMode::Flat);
+		double flatSeconds = secondsSince(start) / repeats;
+
+		char label[64];
+		snprintf(label, sizeof(label), "Normals %s", name);
+		printf("%-30s %10zu %8.1f / %.1f ns / triangle (smooth / flat)\n", label, triangles,
+			   smoothSeconds * 1.0e9 / triangles, flatSeconds * 1.0e9 / triangles);
+	}
+}
@@ -0,0 +1,244 @@
+/*!
+*  \brief     ObjLoader Benchmark.
+*  \details   This file is to time loading OBJ files and reading their faces
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "Benchmark.h"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdint.h>
+#include <vector>
+
+#include "AllocationCounter.h"
+#include "ObjLoader.h"
+#include "PolygonTriangulator.h"
+#include "TextureConverter.h"
+
+void benchmarkObjLoader(const std::string& assetDir)
+{
+	const char* meshes[] = { "Rocket.obj", "Level Final.obj", "Rock_big_single_b_LOD0.obj",
+							 "Rock_big_single_b_LOD3.obj", "airboat.obj", "cessna.obj", "teapot.obj" };
+	const int repeats = 5;
+
+	printf("%-30s %10s %12s\n", "ObjLoader::Load", "triangles", "ms / load");
+
+	for (const char* mesh : meshes)
+	{
+		std::string path = assetDir + "/" + mesh;
+		size_t triangles = 0;
+
+		auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < repeats; i++)
+		{
+			ObjLoader loader;
+			loader.Load(path);
+			triangles = loader.GetMeshVertices().size() / 9;
+		}
+		double ms = secondsSince(start) * 1000.0 / repeats;
+
+		printf("%-30s %10zu %12.3f\n", mesh, triangles, ms);
+	}
+}
+
+// How ExtractFaceVertexData used to read a face - split on spaces with a stringstream, std::stoi on each substring, then fan
+static void parseFaceWithStrings(const std::string& line, std::vector<FaceVertexData>& faceVerts)
+{
+	std::stringstream stream(line.substr(2));
+	std::string token;
+	std::vector<FaceVertexData> corners;
+	while (stream >> token)
+	{
+		FaceVertexData corner;
+		size_t slash = token.find('/');
+		corner.Vertex = std::stoi(token.substr(0, slash));
+		if (slash != std::string::npos)
+		{
+			size_t secondSlash = token.find('/', slash + 1);
+			std::string texCoord = token.substr(slash + 1, secondSlash - slash - 1);
+			if (!texCoord.empty())
+				corner.TexCoord = std::stoi(texCoord);
+			if (secondSlash != std::string::npos)
+				corner.Normal = std::stoi(token.substr(secondSlash + 1));
+		}
+		corners.push_back(corner);
+	}
+
+	for (size_t i = 1; i + 1 < corners.size(); i++)
+	{
+		faceVerts.push_back(corners[0]);
+		faceVerts.push_back(corners[i]);
+		faceVerts.push_back(corners[i + 1]);
+	}
+}
+
+static void writeTextFile(const std::string& path, const std::string& text)
+{
+	FILE* file = fopen(path.c_str(), "wb");
+	fwrite(text.data(), 1, text.size(), file);
+	fclose(file);
+}
+
+static double timeObjLoad(const std::string& path, int repeats, size_t& allocations, std::vector<float>& vertices)
+{
+	size_t allocationsBefore = getGlobalAllocationCount();
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < repeats; i++)
+	{
+		ObjLoader loader;
+		loader.Load(path);
+		vertices = loader.GetMeshVertices();
+	}
+	double seconds = secondsSince(start) / repeats;
+	allocations = (getGlobalAllocationCount() - allocationsBefore) / repeats;
+	return seconds;
+}
+
+void benchmarkFaceParsing(const std::string& assetDir)
+{
+	// Level Final is all quads - its faces over and over make a file big enough to time
+	const int copies = 200;
+	const int repeats = 5;
+	std::string vertexLines, faceLines, relativeFaceLines;
+	size_t vertexCount = 0, normalCount = 0, faceCount = 0;
+
+	FILE* level = fopen((assetDir + "/Level Final.obj").c_str(), "rb");
+	if (!level)
+	{
+		printf("%-30s could not open Level Final.obj\n", "Face parsing");
+		return;
+	}
+
+	char line[1024];
+	while (fgets(line, sizeof(line), level))
+	{
+		std::string text(line);
+		if (text.compare(0, 2, "v ") == 0 || text.compare(0, 3, "vn ") == 0)
+		{
+			vertexLines += text;
+			(text[1] == 'n' ? normalCount : vertexCount)++;
+		}
+		else if (text.compare(0, 2, "f ") == 0)
+		{
+			faceLines += text;
+			faceCount++;
+		}
+	}
+	fclose(level);
+
+	// The same faces counting back from the last vertex and normal, as "f -8//-174 ..." (every face comes after them all here)
+	std::stringstream absoluteFaces(faceLines);
+	for (std::string faceLine; std::getline(absoluteFaces, faceLine); )
+	{
+		relativeFaceLines += "f";
+		std::stringstream stream(faceLine.substr(2));
+		for (std::string token; stream >> token; )
+		{
+			size_t slash = token.find("//");
+			relativeFaceLines += " " + std::to_string(std::stoi(token.substr(0, slash)) - (int)vertexCount - 1) +
+				"//" + std::to_string(std::stoi(token.substr(slash + 2)) - (int)normalCount - 1);
+		}
+		relativeFaceLines += "\n";
+	}
+
+	std::string vertexText = vertexLines, faceText = vertexLines, relativeText = vertexLines;
+	for (int i = 0; i < copies; i++)
+	{
+		faceText += faceLines;
+		relativeText += relativeFaceLines;
+	}
+	size_t totalFaces = faceCount * copies;
+
+	std::filesystem::path tempDir = std::filesystem::temp_directory_path();
+	std::string vertexFile = (tempDir / "pgg_benchmark_vertices.obj").string();
+	std::string faceFile = (tempDir / "pgg_benchmark_faces.obj").string();
+	std::string relativeFile = (tempDir / "pgg_benchmark_relative.obj").string();
+	writeTextFile(vertexFile, vertexText);
+	writeTextFile(faceFile, faceText);
+	writeTextFile(relativeFile, relativeText);
+
+	// Faces cost whatever the load takes over a file of just the same vertices
+	size_t vertexAllocations = 0, faceAllocations = 0, relativeAllocations = 0;
+	std::vector<float> vertexOnly, absolute, relative;
+	double vertexSeconds = timeObjLoad(vertexFile, repeats, vertexAllocations, vertexOnly);
+	double faceSeconds = timeObjLoad(faceFile, repeats, faceAllocations, absolute);
+	timeObjLoad(relativeFile, 1, relativeAllocations, relative);
+
+	std::remove(vertexFile.c_str());
+	std::remove(faceFile.c_str());
+	std::remove(relativeFile.c_str());
+
+	// The old way, on the face lines alone (so it doesn't pay for building the mesh at all)
+	std::vector<std::string> lines;
+	std::stringstream faceStream(faceText);
+	for (std::string faceLine; std::getline(faceStream, faceLine); )
+		if (faceLine.compare(0, 2, "f ") == 0)
+			lines.push_back(faceLine);
+
+	std::vector<FaceVertexData> faceVerts;
+	faceVerts.reserve(totalFaces * 6);
+	size_t allocationsBefore = getGlobalAllocationCount();
+	auto start = std::chrono::steady_clock::now();
+	for (const std::string& faceLine : lines)
+		parseFaceWithStrings(faceLine, faceVerts);
+	double stringSeconds = secondsSince(start);
+	size_t stringAllocations = getGlobalAllocationCount() - allocationsBefore;
+	benchmarkSink = (float)faceVerts.size();
+
+	printf("%-30s %10s %12s\n", "Face parsing (quads)", "faces", "ns / face");
+	printf("%-30s %10zu %12.1f", "stringstream + std::stoi", totalFaces, stringSeconds * 1.0e9 / totalFaces);
+	if (isAllocationCountingEnabled())
+		printf("  (%.1f allocations / face)", (double)stringAllocations / totalFaces);
+	printf("\n");
+	printf("%-30s %10zu %12.1f", "ObjLoader, whole load", totalFaces, (faceSeconds - vertexSeconds) * 1.0e9 / totalFaces);
+	if (isAllocationCountingEnabled())
+		printf("  (%.3f allocations / face)", (double)(faceAllocations - vertexAllocations) / totalFaces);
+	printf("\n");
+	printf("%-30s %10zu %12s\n", "  negative indices", totalFaces, benchmarkCheck(relative == absolute, "same mesh"));
+
+	// Bigger and concave polygons, for the ear clipper
+	for (const char* mesh : { "airboat.obj", "cessna.obj" })
+	{
+		ObjLoader loader;
+		loader.Load(assetDir + "/" + mesh);
+
+		PolygonTriangulator triangulator;
+		std::vector<uint32_t> triangles;
+		std::vector<glm::vec3> corners;
+		size_t polygons = 0;
+
+		std::ifstream file(assetDir + "/" + mesh);
+		std::vector<glm::vec3> positions;
+		for (std::string objLine; std::getline(file, objLine); )
+		{
+			std::stringstream stream(objLine);
+			std::string keyword;
+			stream >> keyword;
+			if (keyword == "v")
+			{
+				glm::vec3 position;
+				stream >> position.x >> position.y >> position.z;
+				positions.push_back(position);
+			}
+			else if (keyword == "f")
+			{
+				corners.clear();
+				for (std::string token; stream >> token; )
+					corners.push_back(positions[std::stoi(token) - 1]);
+				if (corners.size() > 3)
+				{
+					triangulator.Triangulate(&corners[0], corners.size(), triangles);
+					polygons++;
+				}
+			}
+		}
+
+		printf("%-30s %10zu %12s  (%zu of %zu polygons ear clipped)\n", mesh, loader.GetMeshVertices().size() / 9, "triangles",
+			   triangulator.GetEarClippedCount(), polygons);
+	}
+}
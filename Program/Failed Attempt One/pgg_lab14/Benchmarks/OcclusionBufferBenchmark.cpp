@@ -0,0 +1,95 @@
+/*!
+*  \brief     OcclusionBuffer Benchmark.
+*  \details   This file is to time culling the level against the occlusion buffer
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "Benchmark.h"
+
+#include <vector>
+
+#include "Camera.h"
+#include "Frustum.h"
+#include "ObjLoader.h"
+#include "OcclusionBuffer.h"
+#include "TrackGenerator.h"
+
+// Same solid middle of the rock as GameWorld's ROCK_OCCLUDER_LOW and ROCK_OCCLUDER_HIGH
+static const glm::vec3 ROCK_OCCLUDER_LOW(0.275f, 0.125f, 0.325f);
+static const glm::vec3 ROCK_OCCLUDER_HIGH(0.7f, 0.65f, 0.475f);
+
+void benchmarkOcclusionCulling(const std::string& assetDir)
+{
+	ObjLoader rock;
+	rock.Load(assetDir + "/Rock_big_single_b_LOD0.obj");
+	const MeshBounds& bounds = rock.GetMeshData().bounds;
+
+	// Rocks placed the way GameWorld does it, over forty segments of generated track
+	TrackGenerator generator(7);
+	TrackSegment segment;
+	float rowDepth = ObstacleField().getRowDepth();
+	std::vector<glm::vec3> boxMins, boxMaxs;
+	for (int index = 0; index < 40; index++)
+	{
+		generator.generate(index, segment);
+		for (size_t r = 0; r < segment.rowCount; r++)
+		{
+			for (const Obstacle& obstacle : segment.rows[r].obstacles)
+			{
+				float scale = obstacle.width / 130.0f;
+				glm::vec3 position(obstacle.x + obstacle.width * 0.5f, -15.0f, segment.rows[r].z + rowDepth * 0.5f);
+				glm::vec3 size(scale, scale * 0.5f, rowDepth / 130.0f);
+				boxMins.push_back(position + bounds.min * size);
+				boxMaxs.push_back(position + bounds.max * size);
+			}
+		}
+	}
+
+	Camera* camera = new Camera();
+	Frustum frustum;
+	OcclusionBuffer occlusion;
+	const int frames = 2000;
+	size_t onScreen = 0, occluded = 0, occluders = 0;
+	std::vector<size_t> visible;
+
+	auto start = std::chrono::steady_clock::now();
+	for (int frame = 0; frame < frames; frame++)
+	{
+		camera->followRocket(glm::vec3(0.0f, 0.0f, 100.0f - frame * 2.0f));
+		camera->update();
+		glm::mat4 viewProjection = camera->getProjection() * camera->getView();
+		frustum.extractPlanes(viewProjection);
+
+		visible.clear();
+		for (size_t i = 0; i < boxMins.size(); i++)
+		{
+			if (frustum.isBoxVisible(boxMins[i], boxMaxs[i]))
+				visible.push_back(i);
+		}
+
+		// The solid middle of every rock on screen blocks whatever is behind it
+		occlusion.clear(viewProjection);
+		for (size_t i : visible)
+		{
+			glm::vec3 innerMin, innerMax;
+			OcclusionBuffer::getInnerBox(boxMins[i], boxMaxs[i], ROCK_OCCLUDER_LOW, ROCK_OCCLUDER_HIGH, innerMin, innerMax);
+			occlusion.addOccluder(innerMin, innerMax);
+		}
+		occlusion.buildPyramid();
+		occluders += occlusion.getOccluderCount();
+
+		for (size_t i : visible)
+			occluded += occlusion.isBoxOccluded(boxMins[i], boxMaxs[i]) ? 1 : 0;
+		onScreen += visible.size();
+	}
+	double seconds = secondsSince(start);
+	delete camera;
+
+	printf("%-30s %10zu %12.1f us / frame (%dx%d, %d levels)\n", "Hi-Z occlusion", boxMins.size(), seconds * 1.0e6 / frames,
+		   occlusion.getWidth(), occlusion.getHeight(), occlusion.getLevelCount());
+	printf("%-30s %10.2f in frustum / frame, %.2f occluders, %.2f occluded\n", "Occlusion culling", (double)onScreen / frames,
+		   (double)occluders / frames, (double)occluded / frames);
+}
@@ -0,0 +1,78 @@
+/*!
+*  \brief     Simulation Benchmark.
+*  \details   This file is to time stepping the simulation on this thread and on its own thread
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <stdint.h>
+
+#include "Simulation.h"
+#include "SimulationThread.h"
+
+void benchmarkSimulation(const std::string&)
+{
+	const int steps = 1000000;
+	Simulation simulation;
+
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < steps; i++)
+	{
+		// Weave left and right so the collision checks see every row
+		if ((i / 240) % 2 == 0)
+			simulation.spinLeft();
+		else
+			simulation.spinRight();
+
+		simulation.update(1.0f / 60.0f);
+	}
+	double seconds = secondsSince(start);
+
+	benchmarkSink = simulation.getRocketPosition().z;
+	printf("%-30s %10d %12.1f ns / step  (%u crashes)\n", "Simulation::update", steps,
+		   seconds * 1.0e9 / steps, simulation.getNumberOfTries());
+}
+
+void benchmarkSimulationThread(const std::string&)
+{
+	// Simulate at 120 steps a second while a pretend renderer takes 8ms a frame
+	Simulation simulation;
+	SimulationThread simulationThread(simulation);
+	simulationThread.start(1.0f / 120.0f);
+
+	const double runSeconds = 0.5;
+	size_t frames = 0, freshFrames = 0, inputsSent = 0;
+	uint64_t oldestAge = 0, totalAge = 0;
+	auto start = std::chrono::steady_clock::now();
+	while (secondsSince(start) < runSeconds)
+	{
+		if (simulationThread.sendInput(frames % 2 == 0 ? SimulationInput::SpinLeft : SimulationInput::SpinRight))
+			inputsSent++;
+
+		freshFrames += simulationThread.updateSnapshot() ? 1 : 0;
+		const FrameSnapshot& snapshot = simulationThread.getSnapshot();
+		benchmarkSink = snapshot.rocketPosition.z;
+
+		// How many steps behind the simulation the frame being drawn is
+		uint64_t age = simulationThread.getStepsRun() - snapshot.step;
+		oldestAge = std::max(oldestAge, age);
+		totalAge += age;
+
+		auto frameStart = std::chrono::steady_clock::now();
+		while (secondsSince(frameStart) < 0.008)
+		{
+		}
+		frames++;
+	}
+	simulationThread.stop();
+
+	printf("%-30s %10zu frames, %llu steps, %zu with a new snapshot\n", "SimulationThread", frames,
+		   (unsigned long long)simulationThread.getStepsRun(), freshFrames);
+	printf("%-30s %10.2f steps behind on average, %llu at most (%zu inputs)\n", "Snapshot age", (double)totalAge / frames,
+		   (unsigned long long)oldestAge, inputsSent);
+}
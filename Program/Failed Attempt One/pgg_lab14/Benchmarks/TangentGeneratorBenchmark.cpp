@@ -0,0 +1,52 @@
+/*!
+*  \brief     TangentGenerator Benchmark.
+*  \details   This file is to time building tangents for the meshes
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdint.h>
+
+#include "JobSystem.h"
+#include "ObjLoader.h"
+#include "TangentGenerator.h"
+
+void benchmarkTangentGenerator(const std::string& assetDir)
+{
+	ObjLoader loader;
+	loader.Load(assetDir + "/Rocket.obj");
+	MeshData& mesh = loader.GetMeshData();
+	const int repeats = 20;
+
+	const int workerCounts[] = { 0, 3 };
+	for (int workers : workerCounts)
+	{
+		JobSystem jobSystem(workers);
+		TangentGenerator generator(workers > 0 ? &jobSystem : nullptr);
+
+		auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < repeats; i++)
+			generator.Generate(mesh);
+		double seconds = secondsSince(start) / repeats;
+
+		char label[64];
+		snprintf(label, sizeof(label), "TangentGenerator, %d workers", workers);
+		printf("%-30s %10zu %12.1f ns / vertex\n", label, mesh.GetVertexCount(), seconds * 1.0e9 / mesh.GetVertexCount());
+	}
+
+	// How square the packed tangents are to their normals once unpacked again
+	float worstDot = 0.0f;
+	for (size_t i = 0; i < mesh.tangents.size(); i++)
+	{
+		glm::vec3 normal = glm::normalize(glm::vec3(mesh.normals[i * 3], mesh.normals[i * 3 + 1], mesh.normals[i * 3 + 2]));
+		glm::vec3 tangent = glm::normalize(glm::vec3(TangentGenerator::UnpackTangent(mesh.tangents[i])));
+		worstDot = std::max(worstDot, std::fabs(glm::dot(normal, tangent)));
+	}
+	printf("%-30s %10zu bytes, worst |t.n| %.4f\n", "Packed tangents", mesh.tangents.size() * sizeof(uint32_t), worstDot);
+}
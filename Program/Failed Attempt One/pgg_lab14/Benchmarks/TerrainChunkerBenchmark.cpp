@@ -0,0 +1,76 @@
+/*!
+*  \brief     TerrainChunker Benchmark.
+*  \details   This file is to time cutting the level into chunks and picking the visible ones
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "Benchmark.h"
+
+#include <vector>
+
+#include "ObjLoader.h"
+#include "TerrainChunker.h"
+#include "TerrainWindow.h"
+#include "TextureConverter.h"
+
+void benchmarkTerrainChunks(const std::string& assetDir)
+{
+	ObjLoader level;
+	level.Load(assetDir + "/Level Final.obj");
+	const MeshData& original = level.GetMeshData();
+	const float levelLength = original.bounds.max.z - original.bounds.min.z;
+	const float terrainZ = -180.0f;
+
+	printf("%-30s %10s %12s %12s %12s\n", "TerrainChunker", "chunks", "resident", "tris / frame", "whole level");
+
+	// The real level, then the same level repeated to make longer and longer tracks
+	for (int repeats = 1; repeats <= 8; repeats *= 2)
+	{
+		MeshData track;
+		for (int r = 0; r < repeats; r++)
+		{
+			for (size_t i = 0; i < original.vertices.size(); i += 3)
+			{
+				track.vertices.push_back(original.vertices[i]);
+				track.vertices.push_back(original.vertices[i + 1]);
+				track.vertices.push_back(original.vertices[i + 2] - r * levelLength);
+			}
+			track.normals.insert(track.normals.end(), original.normals.begin(), original.normals.end());
+		}
+		track.ComputeBounds();
+
+		std::vector<TerrainChunk> chunks;
+		TerrainChunker chunker;
+		chunker.Slice(track, chunks);
+
+		// Fly from the start of the track to the end and see what has to be on the GPU
+		TerrainWindow window;
+		const int frames = 1000;
+		float startZ = track.bounds.max.z + terrainZ;
+		float endZ = track.bounds.min.z + terrainZ;
+		size_t resident = 0, residentTriangles = 0, mostResident = 0;
+		for (int frame = 0; frame < frames; frame++)
+		{
+			float eyeZ = startZ + (endZ - startZ) * frame / (frames - 1);
+			size_t residentThisFrame = 0;
+			for (const TerrainChunk& chunk : chunks)
+			{
+				if (window.contains(chunk.minZ + terrainZ, chunk.maxZ + terrainZ, eyeZ))
+				{
+					residentThisFrame++;
+					residentTriangles += chunk.mesh.GetVertexCount() / 3;
+				}
+			}
+			resident += residentThisFrame;
+			mostResident = residentThisFrame > mostResident ? residentThisFrame : mostResident;
+		}
+
+		std::string name = "Level Final.obj x" + std::to_string(repeats);
+		printf("%-30s %10zu %8zu max %12zu %12zu\n", name.c_str(), chunks.size(), mostResident,
+			   residentTriangles / frames, track.GetVertexCount() / 3);
+		benchmarkSink = (float)resident;
+	}
+}
@@ -0,0 +1,97 @@
+/*!
+*  \brief     TextParser Benchmark.
+*  \details   This file is to time reading the numbers an OBJ is made of
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "Benchmark.h"
+
+#include <stdint.h>
+#include <vector>
+
+#include "TextParser.h"
+
+void benchmarkNumberParsing(const std::string&)
+{
+	// The sort of numbers an OBJ is made of - six decimal places, mostly small
+	const int valueCount = 300000;
+	std::string text;
+	uint32_t seed = 12345;
+	for (int i = 0; i < valueCount; i++)
+	{
+		seed = seed * 1664525u + 1013904223u;
+		char number[32];
+		snprintf(number, sizeof(number), "%.6f ", ((int)(seed >> 8) % 2000000 - 1000000) / (i % 4 == 0 ? 1000.0 : 1000000.0));
+		text += number;
+	}
+	const char* end = text.data() + text.size();
+
+	// What the loader used to do - fscanf straight from the file
+	FILE* file = tmpfile();
+	fwrite(text.data(), 1, text.size(), file);
+	rewind(file);
+	float sum = 0.0f, value = 0.0f;
+	auto start = std::chrono::steady_clock::now();
+	while (fscanf(file, "%f", &value) == 1)
+		sum += value;
+	double fscanfSeconds = secondsSince(start);
+	fclose(file);
+
+	start = std::chrono::steady_clock::now();
+	for (const char* p = text.c_str(); *p; )
+	{
+		char* next = nullptr;
+		value = strtof(p, &next);
+		if (next == p)
+			break;
+		sum += value;
+		p = next;
+	}
+	double strtofSeconds = secondsSince(start);
+
+	float check = 0.0f;
+	start = std::chrono::steady_clock::now();
+	for (const char* p = text.data(); p < end; )
+	{
+		const char* next = TextParser::ParseFloat(p, end, value);
+		if (next == p)
+			break;
+		check += value;
+		p = next;
+	}
+	double parserSeconds = secondsSince(start);
+	benchmarkSink = sum + check;
+
+	printf("%-30s %10s %12s\n", "Number parsing", "values", "ns / value");
+	printf("%-30s %10d %12.1f\n", "fscanf %f", valueCount, fscanfSeconds * 1.0e9 / valueCount);
+	printf("%-30s %10d %12.1f\n", "strtof", valueCount, strtofSeconds * 1.0e9 / valueCount);
+	printf("%-30s %10d %12.1f\n", "TextParser::ParseFloat", valueCount, parserSeconds * 1.0e9 / valueCount);
+
+	// Face indices - std::stoi on substrings against parsing in place
+	std::vector<std::string> indices;
+	for (int i = 0; i < valueCount; i++)
+		indices.push_back(std::to_string(i % 50000 + 1));
+
+	int intSum = 0;
+	start = std::chrono::steady_clock::now();
+	for (const std::string& index : indices)
+		intSum += std::stoi(index.substr(0));
+	double stoiSeconds = secondsSince(start);
+
+	start = std::chrono::steady_clock::now();
+	for (const std::string& index : indices)
+	{
+		int parsed = 0;
+		TextParser::ParseInt(index.data(), index.data() + index.size(), parsed);
+		intSum -= parsed;
+	}
+	double parseIntSeconds = secondsSince(start);
+	benchmarkSink = (float)intSum;
+
+	printf("%-30s %10d %12.1f\n", "std::stoi(substr)", valueCount, stoiSeconds * 1.0e9 / valueCount);
+	printf("%-30s %10d %12.1f  (%s)\n", "TextParser::ParseInt", valueCount, parseIntSeconds * 1.0e9 / valueCount,
+		   benchmarkCheck(intSum == 0, "same values"));
+}
@@ -0,0 +1,35 @@
+/*!
+*  \brief     TextureAtlas Benchmark.
+*  \details   This file is to time packing the menu images into one atlas
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "Benchmark.h"
+
+#include "TextureAtlas.h"
+
+void benchmarkTextureAtlas(const std::string& assetDir)
+{
+	const char* images[] = { "MenuBackground.bmp", "DestinationOrigin.bmp", "NewGameSelected.bmp", "NewGameUnselected.bmp",
+							 "OptionsSelected.bmp", "OptionsUnselected.bmp", "ExitSelected.bmp", "ExitUnselected.bmp" };
+
+	// Decoding is the same as loading them one by one, this is just the packing on top
+	TextureAtlas atlas;
+	for (const char* image : images)
+	{
+		BmpLoader loader;
+		loader.Load(assetDir + "/" + image);
+		atlas.AddImage(image, std::move(loader.GetImage()));
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	bool built = atlas.Build();
+	double seconds = secondsSince(start);
+
+	printf("%-30s %10zu %12.3f ms\n", "TextureAtlas::Build", atlas.GetRegions().size(), seconds * 1000.0);
+	printf("%-30s %10s %5d x %d, %.0f%% filled\n", "Menu atlas", benchmarkCheck(built, "1 texture", "FAILED"),
+		   atlas.GetImage().width, atlas.GetImage().height, atlas.GetFillRatio() * 100.0f);
+}
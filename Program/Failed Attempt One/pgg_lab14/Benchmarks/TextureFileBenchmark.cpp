@@ -0,0 +1,109 @@
+/*!
+*  \brief     TextureFile Benchmark.
+*  \details   This file is to time loading cooked textures against decoding the source images
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "Benchmark.h"
+
+#include <cmath>
+#include <filesystem>
+#include <stdint.h>
+#include <vector>
+
+#include "TextureConverter.h"
+#include "TextureFile.h"
+
+void benchmarkCookedTextures(const std::string& assetDir)
+{
+	const char* images[] = { "MenuBackground.bmp", "DestinationOrigin.bmp", "NewGameSelected.bmp", "NewGameUnselected.bmp",
+							 "OptionsSelected.bmp", "OptionsUnselected.bmp", "ExitSelected.bmp", "ExitUnselected.bmp" };
+	const TextureFormat formats[] = { TextureFormat::Rgba8, TextureFormat::Bc1 };
+	const char* formatNames[] = { "RGBA8", "BC1" };
+	const int rounds = 10;
+
+	// Cook every image both ways into a scratch folder, with no mips as the menu only ever draws them 1:1
+	std::filesystem::path scratch = std::filesystem::temp_directory_path() / "pgg_cooked_textures";
+	std::filesystem::create_directories(scratch);
+
+	uintmax_t bmpBytes = 0, cookedBytes[2] = { 0, 0 };
+	double squaredError = 0.0;
+	size_t solidPixels = 0;
+	for (const char* image : images)
+	{
+		BmpLoader loader;
+		loader.Load(assetDir + "/" + image);
+		loader.ApplyColourKey(0, 0xFF, 0xFF);
+		bmpBytes += std::filesystem::file_size(assetDir + "/" + image);
+
+		for (int f = 0; f < 2; f++)
+		{
+			TextureConverter converter;
+			converter.Convert(loader.GetImage(), formats[f], false, true);
+			std::string cookedFileName = (scratch / (std::string(formatNames[f]) + "_" + image)).string();
+			converter.Save(TextureFile::GetCookedFileName(cookedFileName));
+			cookedBytes[f] += std::filesystem::file_size(TextureFile::GetCookedFileName(cookedFileName));
+		}
+
+		// How far BC1 is from the original, over the pixels that are actually shown
+		TextureFile bc1;
+		ImageData decoded;
+		bc1.Open(TextureFile::GetCookedFileName((scratch / (std::string("BC1_") + image)).string()));
+		bc1.DecodeLevel(0, decoded);
+		const std::vector<uint8_t>& original = loader.GetImage().pixels;
+		for (size_t i = 0; i + 3 < original.size() && i + 3 < decoded.pixels.size(); i += 4)
+		{
+			if (original[i + 3] == 0)
+				continue;
+			for (int channel = 0; channel < 3; channel++)
+			{
+				double difference = (double)original[i + channel] - decoded.pixels[i + channel];
+				squaredError += difference * difference;
+			}
+			solidPixels++;
+		}
+	}
+
+	// What the menu does at start up - BMP decode and key, against mapping the cooked file
+	auto start = std::chrono::steady_clock::now();
+	for (int round = 0; round < rounds; round++)
+	{
+		for (const char* image : images)
+		{
+			BmpLoader loader;
+			loader.Load(assetDir + "/" + image);
+			loader.ApplyColourKey(0, 0xFF, 0xFF);
+			benchmarkSink = loader.GetImage().pixels[0];
+		}
+	}
+	double bmpSeconds = secondsSince(start) / rounds;
+	printf("%-30s %10llu bytes %8.3f ms\n", "BMP load + colour key", (unsigned long long)bmpBytes, bmpSeconds * 1000.0);
+
+	for (int f = 0; f < 2; f++)
+	{
+		start = std::chrono::steady_clock::now();
+		for (int round = 0; round < rounds; round++)
+		{
+			for (const char* image : images)
+			{
+				TextureFile texture;
+				ImageData decoded;
+				texture.Open(TextureFile::GetCookedFileName((scratch / (std::string(formatNames[f]) + "_" + image)).string()));
+				texture.DecodeLevel(0, decoded);
+				benchmarkSink = decoded.pixels[0];
+			}
+		}
+		double cookedSeconds = secondsSince(start) / rounds;
+
+		char label[64];
+		snprintf(label, sizeof(label), "Cooked %s map + unpack", formatNames[f]);
+		printf("%-30s %10llu bytes %8.3f ms\n", label, (unsigned long long)cookedBytes[f], cookedSeconds * 1000.0);
+	}
+	printf("%-30s %10.2f RMS error over %zu shown pixels\n", "BC1 quality", std::sqrt(squaredError / (solidPixels * 3.0)), solidPixels);
+
+	std::error_code error;
+	std::filesystem::remove_all(scratch, error);
+}
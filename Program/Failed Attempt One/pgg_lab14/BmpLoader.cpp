@@ -0,0 +1,151 @@
+/*!
+*  \brief     BmpLoader Class.
+*  \details   This class is to decode BMP files into RGBA pixels without needing SDL or a renderer
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "BmpLoader.h"
+
+#include <cstdio>
+#include <cstring>
+
+// BMP headers are little endian whatever the machine is
+static uint16_t readU16(const uint8_t* p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+static uint32_t readU32(const uint8_t* p) { return (uint32_t)(p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24)); }
+
+BmpLoader::BmpLoader()
+{
+
+}
+
+BmpLoader::~BmpLoader()
+{
+
+}
+
+bool BmpLoader::Load(std::string bmpFileName)
+{
+	FILE* bmpFile = fopen(bmpFileName.c_str(), "rb");
+
+	if (NULL == bmpFile)
+	{
+		printf("Could not open bmp file: %s\n", bmpFileName.c_str());
+		return false;
+	}
+
+	// Read the whole file in one go
+	std::vector<uint8_t> data;
+	fseek(bmpFile, 0, SEEK_END);
+	long size = ftell(bmpFile);
+	fseek(bmpFile, 0, SEEK_SET);
+
+	if (size > 0)
+	{
+		data.resize((size_t)size);
+		data.resize(fread(&data[0], 1, data.size(), bmpFile));
+	}
+	fclose(bmpFile);
+
+	if (!Decode(data.data(), data.size()))
+	{
+		printf("Could not decode bmp file: %s\n", bmpFileName.c_str());
+		return false;
+	}
+	return true;
+}
+
+bool BmpLoader::Decode(const uint8_t* data, size_t size)
+{
+	image = ImageData();
+
+	// File header (14 bytes) + at least the BITMAPINFOHEADER (40 bytes)
+	if (size < 54 || data[0] != 'B' || data[1] != 'M')
+		return false;
+
+	uint32_t pixelOffset = readU32(data + 10);
+	uint32_t headerSize = readU32(data + 14);
+	int32_t width = (int32_t)readU32(data + 18);
+	int32_t height = (int32_t)readU32(data + 22);
+	uint16_t bitsPerPixel = readU16(data + 28);
+	uint32_t compression = readU32(data + 30);
+	uint32_t paletteCount = readU32(data + 46);
+
+	// Only uncompressed (BI_RGB) or 32 bit BI_BITFIELDS in the usual BGRA order
+	if (compression != 0 && !(compression == 3 && bitsPerPixel == 32))
+		return false;
+	if (bitsPerPixel != 8 && bitsPerPixel != 24 && bitsPerPixel != 32)
+		return false;
+	if (width <= 0 || height == 0)
+		return false;
+
+	// Negative height means the rows are stored top first
+	bool topDown = height < 0;
+	if (topDown)
+		height = -height;
+
+	// Palette sits straight after the info header as BGRX
+	const uint8_t* palette = data + 14 + headerSize;
+	if (bitsPerPixel == 8)
+	{
+		if (paletteCount == 0)
+			paletteCount = 256;
+		if (14 + headerSize + paletteCount * 4 > size)
+			return false;
+	}
+
+	// Rows are padded to four bytes
+	size_t rowSize = (((size_t)width * bitsPerPixel + 31) / 32) * 4;
+	if (pixelOffset + rowSize * (size_t)height > size)
+		return false;
+
+	image.width = width;
+	image.height = height;
+	image.pixels.resize((size_t)width * height * 4);
+
+	for (int32_t y = 0; y < height; y++)
+	{
+		const uint8_t* row = data + pixelOffset + rowSize * (size_t)(topDown ? y : height - 1 - y);
+		uint8_t* out = &image.pixels[(size_t)y * width * 4];
+
+		for (int32_t x = 0; x < width; x++, out += 4)
+		{
+			if (bitsPerPixel == 8)
+			{
+				uint8_t index = row[x];
+				const uint8_t* entry = palette + (index < paletteCount ? index : 0) * 4;
+				out[0] = entry[2];
+				out[1] = entry[1];
+				out[2] = entry[0];
+				out[3] = 255;
+			}
+			else if (bitsPerPixel == 24)
+			{
+				out[0] = row[x * 3 + 2];
+				out[1] = row[x * 3 + 1];
+				out[2] = row[x * 3 + 0];
+				out[3] = 255;
+			}
+			else
+			{
+				out[0] = row[x * 4 + 2];
+				out[1] = row[x * 4 + 1];
+				out[2] = row[x * 4 + 0];
+				out[3] = 255;
+			}
+		}
+	}
+	return true;
+}
+
+void BmpLoader::ApplyColourKey(uint8_t red, uint8_t green, uint8_t blue)
+{
+	for (size_t i = 0; i + 3 < image.pixels.size(); i += 4)
+	{
+		uint8_t* pixel = &image.pixels[i];
+		if (pixel[0] == red && pixel[1] == green && pixel[2] == blue)
+			pixel[3] = 0;
+	}
+}
@@ -0,0 +1,48 @@
+/*!
+*  \brief     BmpLoader Class.
+*  \details   This class is to decode BMP files into RGBA pixels without needing SDL or a renderer
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/// RGBA8 image, top row first
+struct ImageData
+{
+	int width = 0;
+	int height = 0;
+	std::vector<uint8_t> pixels;
+
+	/// True if there is nothing to show
+	bool IsEmpty() const { return pixels.empty(); }
+};
+
+class BmpLoader
+{
+public:
+	///ctor / dtor
+	BmpLoader();
+	~BmpLoader();
+
+	/// Load and decode the BMP, false if the file can't be read or isn't a BMP we understand
+	bool Load(std::string bmpFileName);
+
+	/// Decode a BMP that is already in memory
+	bool Decode(const uint8_t* data, size_t size);
+
+	/// Make every pixel of this colour see-through (the menu images use cyan)
+	void ApplyColourKey(uint8_t red, uint8_t green, uint8_t blue);
+
+	/// Get the decoded image (move it out to keep it after the loader is gone)
+	ImageData& GetImage() { return image; }
+
+private:
+	ImageData image;
+};
@@ -10,9 +10,10 @@
 #pragma once 
 #include "SDKS/glm/glm.hpp"
 #include "SDKS/glm/gtc/matrix_transform.hpp"
+#include "AlignedAllocator.h"
 
 
-__declspec(align(16)) class Camera
+class alignas(16) Camera : public AlignedObject<SIMD_ALIGNMENT>
 {
 public:
 	/// Constructor and Destructor
@@ -31,15 +32,8 @@ public:
 	glm::mat4 getProjection() { return projection; }
 	glm::mat4 getView() { return view; }
 
-	void* operator new(size_t i)
-	{
-		return _mm_malloc(i, 16);
-	}
-
-		void operator delete(void* p)
-	{
-		_mm_free(p);
-	}
+	/// Get where the eye is in the world (the view moves the world the other way)
+	glm::vec3 getPosition() { return -cameraPosition; }
 
 private:
 	glm::vec3 cameraPosition;
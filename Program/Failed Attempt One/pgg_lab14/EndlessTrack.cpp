@@ -0,0 +1,167 @@
+/*!
+*  \brief     EndlessTrack Class.
+*  \details   This class is to keep generated track segments coming ahead of the Rocket and recycle the ones it has passed
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "EndlessTrack.h"
+
+#include <algorithm>
+
+EndlessTrack::EndlessTrack(uint32_t seed)
+	: generator(seed), wantedUpTo(-1), restartIndex(0), epoch(0), running(true), segmentsGenerated(0)
+{
+	// Just behind the chase camera, out to the Camera's far plane
+	keepBehind = 50.0f;
+	loadAhead = 1000.0f;
+	rowDepth = ObstacleField().getRowDepth();
+
+	nextExpected = 0;
+
+	// Every segment starts out free for the worker to fill
+	for (int i = 0; i < MAX_SEGMENTS; i++)
+	{
+		pool[i].index = -1;
+		pool[i].epoch = 0;
+		pool[i].rowCount = 0;
+		freeSegments.push(&pool[i]);
+	}
+
+	worker = std::thread(&EndlessTrack::workerLoop, this);
+}
+
+EndlessTrack::~EndlessTrack()
+{
+	running.store(false, std::memory_order_release);
+	wakeWorker();
+
+	if (worker.joinable())
+		worker.join();
+}
+
+void EndlessTrack::update(float rocketZ)
+{
+	// Take what the worker has finished, throwing away anything from before a restart
+	// (the worker may be asleep waiting for a free segment, so anything given back has to wake it)
+	bool freed = false;
+	TrackSegment* segment = nullptr;
+	uint32_t currentEpoch = epoch.load(std::memory_order_relaxed);
+	while (readySegments.pop(segment))
+	{
+		if (segment->epoch != currentEpoch || segment->index != nextExpected)
+		{
+			recycle(segment);
+			freed = true;
+			continue;
+		}
+
+		active.push_back(segment);
+		nextExpected++;
+	}
+
+	// Give back the ones the camera has gone past
+	while (!active.empty() && active.front()->bottomZ > rocketZ + keepBehind)
+	{
+		recycle(active.front());
+		active.pop_front();
+		freed = true;
+	}
+
+	// Ask for everything out to the far plane
+	int wanted = generator.getSegmentIndex(rocketZ - loadAhead);
+	if (wanted != wantedUpTo.load(std::memory_order_relaxed) || freed)
+	{
+		wantedUpTo.store(wanted, std::memory_order_release);
+		wakeWorker();
+	}
+}
+
+void EndlessTrack::restart(float rocketZ)
+{
+	for (TrackSegment* segment : active)
+		recycle(segment);
+	active.clear();
+
+	// Start again from the segment the Rocket is now in (made the same as before, the seed hasn't changed)
+	nextExpected = std::max(0, generator.getSegmentIndex(rocketZ + keepBehind));
+	restartIndex.store(nextExpected, std::memory_order_relaxed);
+	epoch.fetch_add(1, std::memory_order_release);
+	wakeWorker();
+}
+
+CollisionResult EndlessTrack::checkCollisions(const glm::vec3& position) const
+{
+	for (const TrackSegment* segment : active)
+	{
+		// Rows never poke out of their segment
+		if (position.z > segment->topZ || position.z < segment->bottomZ)
+			continue;
+
+		for (size_t i = 0; i < segment->rowCount; i++)
+		{
+			if (hitsRow(segment->rows[i], rowDepth, position))
+				return CollisionResult::Crashed;
+		}
+	}
+	return CollisionResult::None;
+}
+
+void EndlessTrack::recycle(TrackSegment* segment)
+{
+	// There are never more segments than slots, so this can't fail
+	freeSegments.push(segment);
+}
+
+void EndlessTrack::wakeWorker()
+{
+	// Taking the lock makes sure the worker is either asleep or about to look at the new values
+	{
+		std::lock_guard<std::mutex> lock(wakeMutex);
+	}
+	wake.notify_one();
+}
+
+void EndlessTrack::workerLoop()
+{
+	int next = 0;
+	uint32_t workingEpoch = epoch.load(std::memory_order_acquire);
+
+	while (true)
+	{
+		// Sleep until there is a segment wanted and an empty one to put it in
+		{
+			std::unique_lock<std::mutex> lock(wakeMutex);
+			wake.wait(lock, [&]
+			{
+				return !running.load(std::memory_order_acquire) ||
+					   epoch.load(std::memory_order_acquire) != workingEpoch ||
+					   (next <= wantedUpTo.load(std::memory_order_acquire) && !freeSegments.empty());
+			});
+		}
+
+		if (!running.load(std::memory_order_acquire))
+			return;
+
+		// Restarted - go back to wherever the Rocket is now
+		uint32_t currentEpoch = epoch.load(std::memory_order_acquire);
+		if (currentEpoch != workingEpoch)
+		{
+			workingEpoch = currentEpoch;
+			next = restartIndex.load(std::memory_order_relaxed);
+		}
+
+		TrackSegment* segment = nullptr;
+		if (next > wantedUpTo.load(std::memory_order_acquire) || !freeSegments.pop(segment))
+			continue;
+
+		generator.generate(next, *segment);
+		segment->epoch = workingEpoch;
+		next++;
+
+		readySegments.push(segment);
+		segmentsGenerated.fetch_add(1, std::memory_order_relaxed);
+	}
+}
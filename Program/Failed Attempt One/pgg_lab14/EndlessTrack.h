@@ -0,0 +1,89 @@
+/*!
+*  \brief     EndlessTrack Class.
+*  \details   This class is to keep generated track segments coming ahead of the Rocket and recycle the ones it has passed
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <stdint.h>
+#include <thread>
+
+#include "SpscQueue.h"
+#include "TrackGenerator.h"
+
+class EndlessTrack
+{
+public:
+	/// Most segments alive at once - this is all the memory the track ever uses
+	static const int MAX_SEGMENTS = 8;
+
+	/// Constructor starts the generator thread, Destructor stops it
+	EndlessTrack(uint32_t seed);
+	~EndlessTrack();
+
+	EndlessTrack(const EndlessTrack&) = delete;
+	EndlessTrack& operator=(const EndlessTrack&) = delete;
+
+	/// How far behind the Rocket to keep segments and how far ahead to have them ready
+	void setRange(float behind, float ahead) { keepBehind = behind; loadAhead = ahead; }
+
+	/// Game thread, once a frame - collect finished segments, recycle passed ones, ask for more
+	/// Never waits for the generator, a segment that isn't ready yet just isn't there this frame
+	void update(float rocketZ);
+
+	/// The Rocket has been put back to rocketZ, everything is made again from there
+	void restart(float rocketZ);
+
+	/// Check a position against the rows of the segments that are here (there is no finish line)
+	CollisionResult checkCollisions(const glm::vec3& position) const;
+
+	/// Segments ready to use, nearest the start first
+	const std::deque<TrackSegment*>& getSegments() const { return active; }
+
+	/// Which pool slot a segment lives in (0 to MAX_SEGMENTS - 1), handy for keeping GPU copies
+	int getSlot(const TrackSegment* segment) const { return (int)(segment - pool); }
+
+	/// Getters
+	uint32_t getSeed() const { return generator.getSeed(); }
+	float getRowDepth() const { return rowDepth; }
+	size_t getSegmentsGenerated() const { return segmentsGenerated.load(std::memory_order_relaxed); }
+
+private:
+	void workerLoop();
+	void wakeWorker();
+	void recycle(TrackSegment* segment);
+
+	TrackGenerator generator;
+	TrackSegment pool[MAX_SEGMENTS];
+
+	// Empty segments to the worker, finished ones back - lock-free both ways
+	SpscQueue<TrackSegment*, 16> freeSegments;
+	SpscQueue<TrackSegment*, 16> readySegments;
+
+	// Game thread only
+	std::deque<TrackSegment*> active;
+	int nextExpected;
+	float keepBehind;
+	float loadAhead;
+	float rowDepth;
+
+	// Shared with the worker
+	std::atomic<int> wantedUpTo;
+	std::atomic<int> restartIndex;
+	std::atomic<uint32_t> epoch;
+	std::atomic<bool> running;
+	std::atomic<size_t> segmentsGenerated;
+
+	// Only for the worker to sleep on when it's ahead
+	std::mutex wakeMutex;
+	std::condition_variable wake;
+	std::thread worker;
+};
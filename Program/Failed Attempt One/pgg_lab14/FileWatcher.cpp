@@ -0,0 +1,143 @@
+/*!
+*  \brief     FileWatcher Class.
+*  \details   This class is to notice when files the game has loaded are changed on disk, so they can be loaded again
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "FileWatcher.h"
+
+#include <algorithm>
+#include <stdint.h>
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+// Written and closed, or renamed into the folder (how most editors save)
+#if defined(__linux__)
+static const uint32_t WATCH_EVENTS = IN_CLOSE_WRITE | IN_MOVED_TO;
+#endif
+
+// One save can be several events, each file only goes in once
+static void AddChanged(const std::string& fileName, std::vector<std::string>& changed)
+{
+	if (std::find(changed.begin(), changed.end(), fileName) == changed.end())
+		changed.push_back(fileName);
+}
+
+FileWatcher::FileWatcher()
+{
+#if defined(__linux__)
+	notifyHandle = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+#else
+	notifyHandle = -1;
+#endif
+	lastPoll = std::chrono::steady_clock::now();
+}
+
+FileWatcher::~FileWatcher()
+{
+#if defined(__linux__)
+	// Closing the handle drops every watch on it
+	if (notifyHandle != -1)
+		close(notifyHandle);
+#endif
+}
+
+bool FileWatcher::IsNotified() const
+{
+	return notifyHandle != -1;
+}
+
+bool FileWatcher::Watch(const std::string& fileName)
+{
+	for (const WatchedFile& file : files)
+	{
+		if (file.fileName == fileName)
+			return true;
+	}
+
+	// The folder is watched rather than the file, so a file that is replaced rather than written is still seen
+	std::filesystem::path path(fileName);
+	std::string directory = path.has_parent_path() ? path.parent_path().string() : std::string(".");
+
+	WatchedFile file;
+	file.fileName = fileName;
+	file.path = path;
+	file.name = path.filename().string();
+	file.watch = -1;
+
+	std::error_code error;
+	file.lastWriteTime = std::filesystem::last_write_time(path, error);
+
+#if defined(__linux__)
+	// Watching a folder twice hands back the same watch
+	if (notifyHandle != -1)
+	{
+		file.watch = inotify_add_watch(notifyHandle, directory.c_str(), WATCH_EVENTS);
+		if (file.watch == -1)
+			return false;
+	}
+#else
+	if (!std::filesystem::is_directory(directory, error))
+		return false;
+#endif
+
+	files.push_back(file);
+	return true;
+}
+
+void FileWatcher::Poll(std::vector<std::string>& changed)
+{
+	changed.clear();
+
+#if defined(__linux__)
+	if (notifyHandle != -1)
+	{
+		// Events are packed one after another, each with its name (if it has one) on the end
+		alignas(struct inotify_event) char buffer[4096];
+		for (;;)
+		{
+			ssize_t length = read(notifyHandle, buffer, sizeof(buffer));
+			if (length <= 0)
+				break;
+
+			for (ssize_t offset = 0; offset < length;)
+			{
+				const struct inotify_event* event = (const struct inotify_event*)(buffer + offset);
+				offset += sizeof(struct inotify_event) + event->len;
+				if (event->len == 0)
+					continue;
+
+				for (const WatchedFile& file : files)
+				{
+					if (file.watch == event->wd && file.name == event->name)
+						AddChanged(file.fileName, changed);
+				}
+			}
+		}
+		return;
+	}
+#endif
+
+	// No notifications - check the dates every so often instead
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	if (now - lastPoll < std::chrono::milliseconds(POLL_INTERVAL_MS))
+		return;
+	lastPoll = now;
+
+	for (WatchedFile& file : files)
+	{
+		std::error_code error;
+		std::filesystem::file_time_type writeTime = std::filesystem::last_write_time(file.path, error);
+		if (error || writeTime == file.lastWriteTime)
+			continue;
+
+		file.lastWriteTime = writeTime;
+		AddChanged(file.fileName, changed);
+	}
+}
@@ -0,0 +1,56 @@
+/*!
+*  \brief     FileWatcher Class.
+*  \details   This class is to notice when files the game has loaded are changed on disk, so they can be loaded again
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+/// On Linux the folders are watched with inotify, so Poll is one read that comes back straight away when nothing changed
+/// Everywhere else Poll checks each file's date, at most every POLL_INTERVAL_MS
+class FileWatcher
+{
+public:
+	static const int POLL_INTERVAL_MS = 250;
+
+	///ctor / dtor (stops watching)
+	FileWatcher();
+	~FileWatcher();
+
+	FileWatcher(const FileWatcher&) = delete;
+	FileWatcher& operator=(const FileWatcher&) = delete;
+
+	/// Start watching a file (watching the same one twice does nothing), false if its folder can't be watched
+	bool Watch(const std::string& fileName);
+
+	/// Replace changed with every watched file written since the last Poll, each one once, never blocks
+	/// Editors that save to a new file and rename it over the old one count as a write
+	void Poll(std::vector<std::string>& changed);
+
+	/// True when changes come from the OS rather than from checking dates
+	bool IsNotified() const;
+
+private:
+	struct WatchedFile
+	{
+		std::string fileName;
+		std::filesystem::path path;
+		std::string name;
+		int watch;
+		std::filesystem::file_time_type lastWriteTime;
+	};
+
+	std::vector<WatchedFile> files;
+	std::chrono::steady_clock::time_point lastPoll;
+
+	// inotify's handle (-1 everywhere else), each file keeps the watch on its folder
+	int notifyHandle;
+};
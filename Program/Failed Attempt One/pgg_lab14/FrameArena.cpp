@@ -0,0 +1,47 @@
+/*!
+*  \brief     FrameArena Class.
+*  \details   This class is to hold the memory for one frame's temporary data and throw it away at the start of the next
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "FrameArena.h"
+
+FrameArena::FrameArena(size_t blockSize)
+	: arena(blockSize)
+{
+	frameNumber = 0;
+	peakBytesUsed = 0;
+}
+
+FrameArena::~FrameArena()
+{
+
+}
+
+void FrameArena::beginFrame()
+{
+	// Remember the busiest frame so far
+	if (arena.getBytesUsed() > peakBytesUsed)
+		peakBytesUsed = arena.getBytesUsed();
+
+	arena.reset();
+	frameNumber++;
+}
+
+void* FrameArena::do_allocate(size_t bytes, size_t alignment)
+{
+	return arena.allocate(bytes, alignment);
+}
+
+void FrameArena::do_deallocate(void*, size_t, size_t)
+{
+	// Nothing to do - it all goes at the start of the next frame
+}
+
+bool FrameArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+	return this == &other;
+}
@@ -0,0 +1,47 @@
+/*!
+*  \brief     FrameArena Class.
+*  \details   This class is to hold the memory for one frame's temporary data and throw it away at the start of the next
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#pragma once
+
+#include <memory_resource>
+#include <string>
+#include <vector>
+#include "AlignedArena.h"
+
+/// Containers that live for one frame - build them with the FrameArena as their resource
+template <typename T>
+using FrameVector = std::pmr::vector<T>;
+typedef std::pmr::string FrameString;
+
+class FrameArena : public std::pmr::memory_resource
+{
+public:
+	/// Constructor and Destructor
+	explicit FrameArena(size_t blockSize = 256 * 1024);
+	~FrameArena();
+
+	/// Throw away last frame's data, keeps the memory
+	void beginFrame();
+
+	/// Getters
+	size_t getFrameNumber() const { return frameNumber; }
+	size_t getBytesUsed() const { return arena.getBytesUsed(); }
+	size_t getBytesReserved() const { return arena.getBytesReserved(); }
+	size_t getPeakBytesUsed() const { return peakBytesUsed; }
+
+private:
+	// std::pmr::memory_resource
+	void* do_allocate(size_t bytes, size_t alignment) override;
+	void do_deallocate(void* memory, size_t bytes, size_t alignment) override;
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+	AlignedArena arena;
+	size_t frameNumber;
+	size_t peakBytesUsed;
+};
@@ -0,0 +1,56 @@
+/*!
+*  \brief     FrameStats Struct.
+*  \details   This struct is to count what the renderer did in a frame so performance changes can be measured
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#pragma once
+
+#include <cstddef>
+
+/// Most levels of detail counted separately
+const int MAX_LOD_LEVELS = 4;
+
+struct FrameStats
+{
+	/// Models that made it to GameModel::Draw
+	size_t modelsDrawn;
+
+	/// Models the frustum test stopped before they got there
+	size_t modelsCulled;
+
+	/// Models on screen but hidden behind nearer rocks
+	size_t modelsOccluded;
+
+	/// Terrain chunks with buffers on the GPU
+	size_t terrainChunksResident;
+
+	/// Triangles those draws submitted
+	size_t trianglesDrawn;
+
+	/// Fragments the lit pass shaded and the pixels they landed on (only counted in the overdraw view)
+	size_t fragmentsShaded;
+	size_t pixelsCovered;
+
+	/// Instances drawn at each level of detail
+	size_t lodInstances[MAX_LOD_LEVELS];
+
+	FrameStats() { reset(); }
+
+	/// Zero everything for the next frame
+	void reset()
+	{
+		modelsDrawn = 0;
+		modelsCulled = 0;
+		modelsOccluded = 0;
+		terrainChunksResident = 0;
+		trianglesDrawn = 0;
+		fragmentsShaded = 0;
+		pixelsCovered = 0;
+		for (int i = 0; i < MAX_LOD_LEVELS; i++)
+			lodInstances[i] = 0;
+	}
+};
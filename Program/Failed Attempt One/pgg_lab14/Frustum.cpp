@@ -0,0 +1,131 @@
+/*!
+*  \brief     Frustum Class.
+*  \details   This class is to test bounding volumes against what the Camera can see so hidden models are never drawn
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "Frustum.h"
+
+#include <cfloat>
+#include <cmath>
+#include "Platform.h"
+
+#if PGG_USE_SSE
+#include <xmmintrin.h>
+#endif
+
+Frustum::Frustum()
+{
+	// Planes that pass everything until the first extractPlanes
+	for (int i = 0; i < 8; i++)
+	{
+		planeX[i] = planeY[i] = planeZ[i] = 0.0f;
+		planeW[i] = FLT_MAX;
+	}
+}
+
+Frustum::~Frustum()
+{
+
+}
+
+void Frustum::extractPlanes(const glm::mat4& viewProjection)
+{
+	// Gribb / Hartmann - each plane is the last row plus or minus one of the others
+	// glm is column major so row r is m[0][r], m[1][r], m[2][r], m[3][r]
+	const glm::mat4& m = viewProjection;
+	for (int i = 0; i < 6; i++)
+	{
+		int row = i / 2;
+		float sign = (i % 2 == 0) ? 1.0f : -1.0f;
+
+		glm::vec4 plane(m[0][3] + sign * m[0][row],
+						m[1][3] + sign * m[1][row],
+						m[2][3] + sign * m[2][row],
+						m[3][3] + sign * m[3][row]);
+
+		// Normalise so distances come out in world units and can be compared to a radius
+		float length = sqrtf(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+		if (length > 0.0f)
+			plane /= length;
+
+		planeX[i] = plane.x;
+		planeY[i] = plane.y;
+		planeZ[i] = plane.z;
+		planeW[i] = plane.w;
+	}
+}
+
+bool Frustum::isSphereVisible(const glm::vec3& centre, float radius) const
+{
+#if PGG_USE_SSE
+	__m128 x = _mm_set1_ps(centre.x);
+	__m128 y = _mm_set1_ps(centre.y);
+	__m128 z = _mm_set1_ps(centre.z);
+	__m128 negativeRadius = _mm_set1_ps(-radius);
+
+	// Distance to four planes at a time, out if it's further than the radius behind any of them
+	int outside = 0;
+	for (int i = 0; i < 8; i += 4)
+	{
+		__m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, _mm_load_ps(planeX + i)),
+												_mm_mul_ps(y, _mm_load_ps(planeY + i))),
+									 _mm_add_ps(_mm_mul_ps(z, _mm_load_ps(planeZ + i)),
+												_mm_load_ps(planeW + i)));
+		outside |= _mm_movemask_ps(_mm_cmplt_ps(distance, negativeRadius));
+	}
+	return outside == 0;
+#else
+	for (int i = 0; i < 6; i++)
+	{
+		float distance = planeX[i] * centre.x + planeY[i] * centre.y + planeZ[i] * centre.z + planeW[i];
+		if (distance < -radius)
+			return false;
+	}
+	return true;
+#endif
+}
+
+bool Frustum::isBoxVisible(const glm::vec3& boxMin, const glm::vec3& boxMax) const
+{
+#if PGG_USE_SSE
+	__m128 zero = _mm_setzero_ps();
+	__m128 minX = _mm_set1_ps(boxMin.x), maxX = _mm_set1_ps(boxMax.x);
+	__m128 minY = _mm_set1_ps(boxMin.y), maxY = _mm_set1_ps(boxMax.y);
+	__m128 minZ = _mm_set1_ps(boxMin.z), maxZ = _mm_set1_ps(boxMax.z);
+
+	// Test the corner furthest along each plane's normal, if even that is behind the box is out
+	int outside = 0;
+	for (int i = 0; i < 8; i += 4)
+	{
+		__m128 px = _mm_load_ps(planeX + i);
+		__m128 py = _mm_load_ps(planeY + i);
+		__m128 pz = _mm_load_ps(planeZ + i);
+
+		__m128 maskX = _mm_cmpgt_ps(px, zero);
+		__m128 maskY = _mm_cmpgt_ps(py, zero);
+		__m128 maskZ = _mm_cmpgt_ps(pz, zero);
+		__m128 cornerX = _mm_or_ps(_mm_and_ps(maskX, maxX), _mm_andnot_ps(maskX, minX));
+		__m128 cornerY = _mm_or_ps(_mm_and_ps(maskY, maxY), _mm_andnot_ps(maskY, minY));
+		__m128 cornerZ = _mm_or_ps(_mm_and_ps(maskZ, maxZ), _mm_andnot_ps(maskZ, minZ));
+
+		__m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(cornerX, px), _mm_mul_ps(cornerY, py)),
+									 _mm_add_ps(_mm_mul_ps(cornerZ, pz), _mm_load_ps(planeW + i)));
+		outside |= _mm_movemask_ps(_mm_cmplt_ps(distance, zero));
+	}
+	return outside == 0;
+#else
+	for (int i = 0; i < 6; i++)
+	{
+		float x = planeX[i] > 0.0f ? boxMax.x : boxMin.x;
+		float y = planeY[i] > 0.0f ? boxMax.y : boxMin.y;
+		float z = planeZ[i] > 0.0f ? boxMax.z : boxMin.z;
+		if (planeX[i] * x + planeY[i] * y + planeZ[i] * z + planeW[i] < 0.0f)
+			return false;
+	}
+	return true;
+#endif
+}
@@ -0,0 +1,41 @@
+/*!
+*  \brief     Frustum Class.
+*  \details   This class is to test bounding volumes against what the Camera can see so hidden models are never drawn
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#pragma once
+
+#include "SDKS/glm/glm.hpp"
+#include "AlignedAllocator.h"
+
+class alignas(16) Frustum : public AlignedObject<SIMD_ALIGNMENT>
+{
+public:
+	/// Constructor and Destructor (starts out letting everything through)
+	Frustum();
+	~Frustum();
+
+	/// Pull the six planes out of projection * view (world space, pointing inwards)
+	void extractPlanes(const glm::mat4& viewProjection);
+
+	/// True if any part of the sphere could be on screen
+	bool isSphereVisible(const glm::vec3& centre, float radius) const;
+
+	/// True if any part of the box could be on screen (may let through a few boxes just off a corner)
+	bool isBoxVisible(const glm::vec3& boxMin, const glm::vec3& boxMax) const;
+
+	/// Get a plane as (normal, distance) - left, right, bottom, top, near, far
+	glm::vec4 getPlane(int plane) const { return glm::vec4(planeX[plane], planeY[plane], planeZ[plane], planeW[plane]); }
+
+private:
+	// Planes stored one component per array so four planes go through SSE at once
+	// Padded to eight with planes everything is in front of
+	alignas(16) float planeX[8];
+	alignas(16) float planeY[8];
+	alignas(16) float planeZ[8];
+	alignas(16) float planeW[8];
+};
@@ -10,6 +10,11 @@
 #include "GameModel.h"
 
 #include <iostream>
+#include <unordered_map>
+#include "BmpLoader.h"
+#include "MappedFile.h"
+#include "MeshFile.h"
+#include "TangentGenerator.h"
 #include "SDKS/glm/gtc/type_ptr.hpp"
 #include "SDKS/glm/gtc/matrix_transform.hpp"
 
@@ -39,403 +44,808 @@ bool CheckShaderCompiled( GLint shader )
 	return true;
 }
 
-GameModel::GameModel(std::string objFileName)
+GLuint BuildShaderProgram(const GLchar* vertexText, const GLchar* fragmentText)
 {
-	// Initialise variables
-	_VAO = 0;
-	_program = 0;
-	_shaderModelMatLocation = _shaderViewMatLocation = _shaderProjMatLocation = 0;
-	_numVertices = 0;
-
-	numberOfTries = 0;
-
-	// Row 1 Position
-	row1Positions[0] = { -116.10f, 0, -165 };
-	row1Positions[1] = { -57, 0, -165 };
-	row1Positions[2] = { -22, 0, -165 };
-	row1Positions[3] = { 11, 0, -165 };
-	row1Positions[4] = { 84, 0, -165 };
+	// The 'program' stores the shaders
+	GLuint program = glCreateProgram();
 
-	// Row 2 Position
-	row2Positions[0] = { -83, 0, -255};
-	row2Positions[1] = { 43, 0, -255 };
+	// Create the vertex shader
+	GLuint vShader = glCreateShader( GL_VERTEX_SHADER );
+	// Give GL the source for it
+	glShaderSource( vShader, 1, &vertexText, NULL );
+	// Compile the shader
+	glCompileShader( vShader );
+	// Check it compiled and give useful output if it didn't work!
+	if( !CheckShaderCompiled( vShader ) )
+	{
+		glDeleteShader( vShader );
+		glDeleteProgram( program );
+		return 0;
+	}
+	// This links the shader to the program
+	glAttachShader( program, vShader );
 
-	// Row 3 Position
-	row3Positions[0] = { -116.10f, 0, -333 };
-	row3Positions[1] = { -59, 0, -333 };
-	row3Positions[2] = { 59.50f, 0, -333 };
+	// Same for the fragment shader
+	GLuint fShader = glCreateShader( GL_FRAGMENT_SHADER );
+	glShaderSource( fShader, 1, &fragmentText, NULL );
+	glCompileShader( fShader );
+	if( !CheckShaderCompiled( fShader ) )
+	{
+		glDeleteShader( vShader );
+		glDeleteShader( fShader );
+		glDeleteProgram( program );
+		return 0;
+	}
+	glAttachShader( program, fShader );
 
-	// Row 4 Position
-	row4Positions[0] = { -99, 0, -420 };
-	row4Positions[1] = { 9, 0, -420 };
+	// This makes sure the vertex and fragment shaders connect together
+	glLinkProgram( program );
 
-	// Row 5 Position
-	row5Positions[0] = { -116.10f, 0, -510 };
-	row5Positions[1] = { 68, 0, -510 };
+	// The program keeps what it needs, the shaders go when it does
+	glDeleteShader( vShader );
+	glDeleteShader( fShader );
 
-	// Row 6 Position
-	row6Positions[0] = { -116.10f, 0, -606 };
-	row6Positions[1] = { 60, 0, -606 };
+	// Check this worked
+	GLint linked;
+	glGetProgramiv( program, GL_LINK_STATUS, &linked );
+	if ( !linked )
+	{
+		GLsizei len;
+		glGetProgramiv( program, GL_INFO_LOG_LENGTH, &len );
 
-	// Row 7 Position
-	row7Positions[0] = { -116.10f, 0, -716 };
-	row7Positions[1] = { 23, 0, -716 };
+		GLchar* log = new GLchar[len+1];
+		glGetProgramInfoLog( program, len, &len, log );
+		std::cerr << "ERROR: Shader linking failed: " << log << std::endl;
+		delete [] log;
 
-	// Row 8 Position
-	row8Positions[0] = { -116.10f, 0, -815 };
-	row8Positions[1] = { 68, 0, -815 };
+		glDeleteProgram( program );
+		return 0;
+	}
+	return program;
+}
 
-	// Row 9 Position
-	row9Positions[0] = { -116.10f, 0, -940 };
+GLuint CreateTexture(const TextureFile& texture)
+{
+	if (texture.GetLevelCount() == 0)
+		return 0;
 
-	// Row 10 Position
-	row10Positions[0] = { -116.10f, 0, -1070 };
-	row10Positions[1] = { 41, 0, -1070 };
+	GLuint textureID = 0;
+	glGenTextures(1, &textureID);
+	glBindTexture(GL_TEXTURE_2D, textureID);
 
-	// Row 11 Position
-	row11Positions[0] = { -116.10f, 0, -1190 };
-	row11Positions[1] = { 6, 0, -1190 };
+	// Rows of odd sized levels aren't padded out to 4 bytes
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 
-	// Load Object
-	objLoader.Load(objFileName);
+	bool compressed = texture.GetFormat() == TextureFormat::Bc1 && GLEW_EXT_texture_compression_s3tc;
+	ImageData unpacked;
+	for (int i = 0; i < texture.GetLevelCount(); i++)
+	{
+		const TextureLevel& level = texture.GetLevel(i);
+		if (compressed)
+		{
+			glCompressedTexImage2D(GL_TEXTURE_2D, i, GL_COMPRESSED_RGBA_S3TC_DXT1_EXT, level.width, level.height, 0,
+								   (GLsizei)level.size, level.data);
+		}
+		else if (texture.GetFormat() == TextureFormat::Rgba8)
+		{
+			glTexImage2D(GL_TEXTURE_2D, i, GL_RGBA8, level.width, level.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, level.data);
+		}
+		else
+		{
+			texture.DecodeLevel(i, unpacked);
+			glTexImage2D(GL_TEXTURE_2D, i, GL_RGBA8, level.width, level.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, &unpacked.pixels[0]);
+		}
+	}
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
 
-	// Create the model
-	InitialiseVAO();
+	// Only the levels that are there
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, texture.GetLevelCount() - 1);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, texture.GetLevelCount() > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
 
-	// Create the shaders
-	InitialiseShaders();
+	glBindTexture(GL_TEXTURE_2D, 0);
+	return textureID;
 }
 
-GameModel::~GameModel()
+// MTL ambient (Ka) is how much of this the surface gives back
+static const float AMBIENT_LIGHT = 0.2f;
+
+// Read a uniform's starting value, leaving the default alone if the shader compiled it out
+static void ReadUniform(GLuint program, GLint location, float* value)
 {
-	// TODO: destroy VAO, shaders etc
-	glDeleteVertexArrays(1, &_VAO);
-	glDeleteBuffers(1, &positionBuffer);
-	glDeleteShader(_program);
+	if (location != -1)
+		glGetUniformfv(program, location, value);
 }
 
-void GameModel::InitialiseVAO()
+/// A program every model shares for a pass that doesn't need lighting
+struct SharedPassProgram
 {
-	// Creates one VAO and binds it
-	glGenVertexArrays( 1, &_VAO );
-	glBindVertexArray( _VAO );
-
-	// Finds vertex amount
-	_numVertices = objLoader.GetMeshVertices().size() / 3;
-
-	// Variable for storing a VBO
-	GLuint positionBuffer = 0;
-
-	// Create a generic 'buffer'
-	glGenBuffers(1, &positionBuffer);
-
-	// Tell OpenGL that we want to activate the buffer and that it's a VBO
-	glBindBuffer(GL_ARRAY_BUFFER, positionBuffer);
+	GLuint program;
+	GLint modelMatLocation, viewMatLocation, projMatLocation;
+	bool built;
+};
 
-	// Draw Verts
-	glBufferData(GL_ARRAY_BUFFER, sizeof(float) * _numVertices * 3, &objLoader.GetMeshVertices()[0], GL_STATIC_DRAW);
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, 0 );
-	glEnableVertexAttribArray(0);
-
-	// Variable for storing a VBO
-	GLuint normalBuffer = 0;
-
-	// Create a generic 'buffer'
-	glGenBuffers(1, &normalBuffer);
+// Same position maths as the lit shader and marked invariant in both, so the depth pre-pass matches it exactly
+static const GLchar* passVertexText = "#version 430 core\n\
+						 layout(location = 0) in vec4 vPosition;\n\
+						 \n\
+						 uniform mat4 modelMat;\n\
+						 uniform mat4 viewMat;\n\
+						 uniform mat4 projMat;\n\
+						 \n\
+						 invariant gl_Position;\n\
+						 \n\
+						 void main()\n\
+						 {\n\
+								gl_Position = projMat * viewMat * modelMat * vPosition;\n\
+						 }";
 
-	// Tell OpenGL that we want to activate the buffer and that it's a VBO
-	glBindBuffer(GL_ARRAY_BUFFER, normalBuffer);
+// Nothing to shade, only depth is written
+static const GLchar* depthOnlyFragmentText = "#version 430 core\n\
+								void main()\n\
+								{\n\
+								}";
 
-	// With this buffer active, we can now send our data to OpenGL
-	glBufferData(GL_ARRAY_BUFFER, sizeof(float) * _numVertices * 3, &objLoader.GetMeshNormals()[0], GL_STATIC_DRAW);
+// Runs after the depth test, so it counts exactly the fragments the lit shader would have shaded
+static const GLchar* overdrawFragmentText = "#version 430 core\n\
+								layout(early_fragment_tests) in;\n\
+								layout(r32ui, binding = 0) uniform coherent uimage2D overdrawCounts;\n\
+								\n\
+								out vec4 fragColour;\n\
+								\n\
+								void main()\n\
+								{\n\
+									imageAtomicAdd( overdrawCounts, ivec2(gl_FragCoord.xy), 1u );\n\
+									fragColour = vec4(0);\n\
+								}";
 
-	// This tells OpenGL how we link the vertex data to the shader
-	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 0, 0 );
-	glEnableVertexAttribArray(1);
-	
-	// Bind the buffer
-	glBindBuffer(GL_ARRAY_BUFFER, 0);
-	glBindVertexArray( 0 );
+// Built the first time a pass is drawn (there has to be a GL context by then)
+static const SharedPassProgram& GetPassProgram(DrawPass pass)
+{
+	static SharedPassProgram depthOnly = { 0, -1, -1, -1, false };
+	static SharedPassProgram overdraw = { 0, -1, -1, -1, false };
 
-	// Technically we can do this, because the enabled / disabled state is stored in the VAO
-	glDisableVertexAttribArray(0);
+	SharedPassProgram& shared = pass == DrawPass::Overdraw ? overdraw : depthOnly;
+	if (!shared.built)
+	{
+		shared.program = BuildShaderProgram(passVertexText, pass == DrawPass::Overdraw ? overdrawFragmentText : depthOnlyFragmentText);
+		shared.modelMatLocation = glGetUniformLocation( shared.program, "modelMat" );
+		shared.viewMatLocation = glGetUniformLocation( shared.program, "viewMat" );
+		shared.projMatLocation = glGetUniformLocation( shared.program, "projMat" );
+		shared.built = true;
+	}
+	return shared;
 }
 
-void GameModel::InitialiseShaders()
+const char* const GameModel::VERTEX_SHADER_FILE_NAME = "Shaders/Lit.vert";
+const char* const GameModel::FRAGMENT_SHADER_FILE_NAME = "Shaders/Lit.frag";
+
+/// The lit program every model shares - one set of uniform locations, and the material the uniforms hold now
+struct SharedLitProgram
 {
-	// This is the vertex shader
-	const GLchar *vShaderText = "#version 430 core\n\
+	GLuint program;
+	GLint modelMatLocation, viewMatLocation, projMatLocation;
+	GLint ambientLocation, diffuseLocation, specularLocation, emissiveLocation;
+	GLint shininessLocation, alphaLocation, hasDiffuseMapLocation, hasNormalMapLocation;
+
+	// What the shader draws with when there is no material (read back from the shader's own defaults)
+	Material defaultMaterial;
+
+	// Whose material the uniforms were last set for, so a model drawn twice in a row doesn't set them again
+	const GameModel* appliedModel;
+	int appliedMaterial;
+	bool built;
+};
+
+// Built in, for when Shaders/Lit.* can't be read or don't build the first time - plain diffuse lighting with the
+// same inputs and uniforms (no normal maps), so the game still draws and the files can be fixed while it runs
+static const GLchar* fallbackVertexText = "#version 430 core\n\
 						 layout(location = 0) in vec4 vPosition;\n\
 						 layout(location = 1) in vec3 vNormalIn;\n\
+						 layout(location = 2) in vec2 vTexCoordIn;\n\
 						 \n\
 						 uniform mat4 modelMat;\n\
-						 uniform mat4 invModelMat;\n\
 						 uniform mat4 viewMat;\n\
 						 uniform mat4 projMat;\n\
-						 \n\
-						 uniform vec4 worldSpaceLightPos = {1000,400,-3000,0};\n\
+						 uniform vec4 worldSpaceLightPos = vec4(1000, 400, -3000, 0);\n\
 						 \n\
 						 out vec3 vNormalV;\n\
 						 out vec3 lightDirV;\n\
+						 out vec2 vTexCoordV;\n\
+						 \n\
+						 invariant gl_Position;\n\
 						 \n\
 						 void main()\n\
 						 {\n\
 								gl_Position = projMat * viewMat * modelMat * vPosition;\n\
-								\n\
 								vec4 eyeSpaceVertPos = viewMat * modelMat * vPosition;\n\
-								vec4 eyeSpaceLightPos = viewMat * worldSpaceLightPos;\n\
-								\n\
-								lightDirV =  normalize( vec3(eyeSpaceLightPos) - vec3(eyeSpaceVertPos) );\n\
-								\n\
+								lightDirV = vec3(viewMat * worldSpaceLightPos) - vec3(eyeSpaceVertPos);\n\
 								vNormalV = mat3(viewMat * modelMat) * vNormalIn;\n\
+								vTexCoordV = vTexCoordIn;\n\
 						 }";
 
-	// This is the fragment shader
-	const GLchar *fShaderText = "#version 430 core\n\
-								in vec3 lightDirV;\n\
+static const GLchar* fallbackFragmentText = "#version 430 core\n\
 								in vec3 vNormalV;\n\
+								in vec3 lightDirV;\n\
+								in vec2 vTexCoordV;\n\
 								\n\
-								uniform vec3 lightColour = {1,1,1};\n\
-								uniform vec3 emissiveColour = {0.0,0,0.1};\n\
-								uniform vec3 ambientColour  = {0.1f,0.3f,0.2f};\n\
-								uniform vec3 diffuseColour  = {0.2f,0.6f,0.5f};\n\
-								uniform vec3 specularColour = {0.3f,0.3f,0.3f};\n\
-								uniform float shininess     = 200.0f;\n\
-								uniform float alpha         = 2.0f;\n\
+								uniform vec3 emissiveColour = vec3(0.0, 0.0, 0.1);\n\
+								uniform vec3 ambientColour = vec3(0.1, 0.3, 0.2);\n\
+								uniform vec3 diffuseColour = vec3(0.2, 0.6, 0.5);\n\
+								uniform float alpha = 1.0;\n\
+								uniform sampler2D diffuseMap;\n\
+								uniform bool hasDiffuseMap = false;\n\
 								\n\
 								out vec4 fragColour;\n\
 								\n\
 								void main()\n\
 								{\n\
-									vec3 lightDir = normalize( lightDirV );\n\
-									vec3 vNormal = normalize( vNormalV );\n\
-									\n\
-										vec3 diffuse = diffuseColour * lightColour * max( dot( vNormal, lightDir ), 0);\n\
-										\n\
-										fragColour = vec4( emissiveColour + ambientColour + diffuse, alpha);\n\
+									vec3 surface = hasDiffuseMap ? texture( diffuseMap, vTexCoordV ).rgb : vec3(1);\n\
+									float light = max( dot( normalize(vNormalV), normalize(lightDirV) ), 0.0 );\n\
+									fragColour = vec4( emissiveColour + (ambientColour + diffuseColour * light) * surface, alpha );\n\
 								}";
 
-	// The 'program' stores the shaders
-	_program = glCreateProgram();
+// Render thread only, like the pass programs
+static SharedLitProgram litProgram = { 0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, Material(), nullptr, -1, false };
 
-	// Create the vertex shader
-	GLuint vShader = glCreateShader( GL_VERTEX_SHADER );
-	// Give GL the source for it
-	glShaderSource( vShader, 1, &vShaderText, NULL );
-	// Compile the shader
-	glCompileShader( vShader );
-	// Check it compiled and give useful output if it didn't work!
-	if( !CheckShaderCompiled( vShader ) )
-	{
-		return;
-	}
-	// This links the shader to the program
-	glAttachShader( _program, vShader );
+// Built the first time a model is drawn lit, then again whenever the source changes
+static const SharedLitProgram& GetLitProgram()
+{
+	if (!litProgram.built)
+		GameModel::InitialiseShaders();
+	return litProgram;
+}
 
-	// Same for the fragment shader
-	GLuint fShader = glCreateShader( GL_FRAGMENT_SHADER );
-	glShaderSource( fShader, 1, &fShaderText, NULL );
-	glCompileShader( fShader );
-	if( !CheckShaderCompiled( fShader ) )
-	{
-		return ;
-	}
-	glAttachShader( _program, fShader );
+// The lit shader's source by file name, render thread only
+static std::unordered_map<std::string, std::string> shaderSources;
 
-	// This makes sure the vertex and fragment shaders connect together
-	glLinkProgram( _program );
-	// Check this worked
-	GLint linked;
-	glGetProgramiv( _program, GL_LINK_STATUS, &linked );
-	if ( !linked )
-	{
-		GLsizei len;
-		glGetProgramiv( _program, GL_INFO_LOG_LENGTH, &len );
+static const std::string& GetShaderSource(const std::string& fileName)
+{
+	std::unordered_map<std::string, std::string>::iterator found = shaderSources.find(fileName);
+	if (found != shaderSources.end())
+		return found->second;
+
+	MappedFile file;
+	std::string& text = shaderSources[fileName];
+	if (file.Open(fileName))
+		text.assign((const char*)file.GetData(), file.GetSize());
+	else
+		std::cerr << "ERROR: Could not read shader " << fileName << std::endl;
+	return text;
+}
 
-		GLchar* log = new GLchar[len+1];
-		glGetProgramInfoLog( _program, len, &len, log );
-		std::cerr << "ERROR: Shader linking failed: " << log << std::endl;
-		delete [] log;
+void GameModel::SetShaderSource(const std::string& fileName, const std::string& text)
+{
+	shaderSources[fileName] = text;
+}
 
-		return;
+GameModel::GameModel(std::string objFileName)
+{
+	// Initialise variables
+	InitialiseMembers();
+
+	// Load Object - cooked if it has been, so there's nothing to parse
+	MeshData mesh;
+	std::string cookedFileName = MeshFile::GetCookedFileName(objFileName);
+	MeshFile cooked;
+	if (!MeshFile::IsCookedUpToDate(cookedFileName, objFileName) || !cooked.Open(cookedFileName) || !cooked.Read(mesh))
+	{
+		ObjLoader objLoader;
+		objLoader.Load(objFileName);
+		mesh = std::move(objLoader.GetMeshData());
+
+		// Tangents only if a material is going to sample a normal map with them
+		if (TangentGenerator::IsNeeded(mesh))
+			TangentGenerator().Generate(mesh);
 	}
 
-	// We need to get the location of the uniforms in the shaders
-	// This is so that we can send the values to them from the application
-	// We do this in the following way: 
-	_shaderModelMatLocation = glGetUniformLocation( _program, "modelMat" );
-	_shaderViewMatLocation = glGetUniformLocation( _program, "viewMat" );
-	_shaderProjMatLocation = glGetUniformLocation( _program, "projMat" );
+	// Create the model (the shaders are shared, built the first time any model is drawn)
+	LoadMesh(mesh);
+}
 
+GameModel::GameModel()
+{
+	// Initialise variables, the mesh comes later
+	InitialiseMembers();
 }
 
-void GameModel::Update( float deltaTs )
+GameModel::~GameModel()
 {
+	for (MeshBuffers& buffers : _lods)
+		DestroyVAO(buffers);
+	DestroyTextures();
 
+	// Another model could be made at the same address
+	if (litProgram.appliedModel == this)
+		litProgram.appliedModel = nullptr;
 }
 
-void GameModel::Draw(glm::mat4& viewMatrix, glm::mat4& projMatrix)
+void GameModel::InitialiseMembers()
 {
-	// Next, we translate this matrix according to the object's _position vector:
-	_modelMatrix = glm::translate(glm::mat4(1.0f), _position);
+	_lodLevel = 0;
+	_hasBounds = false;
 
-	// Next, we rotate this matrix in the x-axis by the object's x-rotation:
-	_modelMatrix = glm::rotate(_modelMatrix, _rotation.x, glm::vec3(1, 0, 0));
-	// Next, we rotate this matrix in the y-axis by the object's y-rotation:
-	_modelMatrix = glm::rotate(_modelMatrix, _rotation.y, glm::vec3(0, 1, 0));
-	// Next, we rotate this matrix in the z-axis by the object's z-rotation:
-	_modelMatrix = glm::rotate(_modelMatrix, _rotation.z, glm::vec3(0, 0, 1));
-	// Activate the shader program
-	glUseProgram( _program );
+	_position = glm::vec3(0, 0, 0);
+	_rotation = glm::vec3(0, 0, 0);
+	_scale = glm::vec3(1, 1, 1);
+}
 
-		// Activate the VAO
-		glBindVertexArray( _VAO );
+void GameModel::LoadMesh(const MeshData& mesh, int lodLevel)
+{
+	if (lodLevel < 0)
+		return;
 
-			// Send matrices to the shader as uniforms like this:
-			glUniformMatrix4fv(_shaderModelMatLocation, 1, GL_FALSE, glm::value_ptr(_modelMatrix) );
-			glUniformMatrix4fv(_shaderViewMatLocation, 1, GL_FALSE, glm::value_ptr(viewMatrix) );
-			glUniformMatrix4fv(_shaderProjMatLocation, 1, GL_FALSE, glm::value_ptr(projMatrix) );
+	// Make room for this level
+	if ((int)_lods.size() <= lodLevel)
+		_lods.resize(lodLevel + 1);
 
+	// Throw away the old one first
+	DestroyVAO(_lods[lodLevel]);
+	InitialiseVAO(mesh, _lods[lodLevel]);
 
-			// Tell OpenGL to draw it
-			// Must specify the type of geometry to draw and the number of vertices
-			glDrawArrays(GL_TRIANGLES, 0, _numVertices);
-			
-		// Unbind VAO
-		glBindVertexArray( 0 );
-	
-	// Technically we can do this, but it makes no real sense because we must always have a valid shader program to draw geometry
-	glUseProgram( 0 );
+	// A mesh that brings materials replaces the model's
+	if (!mesh.materials.empty())
+	{
+		DestroyTextures();
+		_materials = mesh.materials;
+		TextureInit();
+
+		// Whatever the uniforms hold now belonged to the old materials
+		if (litProgram.appliedModel == this)
+			litProgram.appliedModel = nullptr;
+	}
+
+	// Grow the bounds so whichever level is drawn stays inside them
+	if (mesh.IsEmpty())
+		return;
+
+	if (!_hasBounds)
+	{
+		_bounds = mesh.bounds;
+		_hasBounds = true;
+	}
+	else
+	{
+		_bounds.min = glm::min(_bounds.min, mesh.bounds.min);
+		_bounds.max = glm::max(_bounds.max, mesh.bounds.max);
+		float reach = glm::length(mesh.bounds.centre - _bounds.centre) + mesh.bounds.radius;
+		_bounds.radius = glm::max(_bounds.radius, reach);
+	}
 }
 
-void GameModel::SetForwardVelocity(float velocity, float deltaTime)
+bool GameModel::GetWorldBounds(glm::vec3& boxMin, glm::vec3& boxMax, glm::vec3& centre, float& radius)
 {
-	_position.z -= velocity * deltaTime;
+	if (!_hasBounds)
+		return false;
+
+	UpdateModelMatrix();
+
+	// Sphere - move the centre, grow the radius by the biggest scale
+	centre = glm::vec3(_modelMatrix * glm::vec4(_bounds.centre, 1.0f));
+	radius = _bounds.radius * glm::max(glm::abs(_scale.x), glm::max(glm::abs(_scale.y), glm::abs(_scale.z)));
+
+	// Box - rotating it makes it bigger, so take the extent of each axis of the rotated box (Arvo)
+	glm::vec3 translation(_modelMatrix[3]);
+	boxMin = boxMax = translation;
+	for (int column = 0; column < 3; column++)
+	{
+		for (int row = 0; row < 3; row++)
+		{
+			float a = _modelMatrix[column][row] * _bounds.min[column];
+			float b = _modelMatrix[column][row] * _bounds.max[column];
+			boxMin[row] += glm::min(a, b);
+			boxMax[row] += glm::max(a, b);
+		}
+	}
+	return true;
 }
 
-void GameModel::SetSidewaysVelocity(float velocity, float deltaTime)
+bool GameModel::GetLocalBounds(MeshBounds& bounds) const
 {
-	// Times the velocity by delta to get sideways speed up
-	_position.x -= velocity * deltaTime;
+	if (!_hasBounds)
+		return false;
 
-	// Set Boundries of the Level
-	if (_position.x > 110.01f)
-		_position.x = 110.00f;
-	if (_position.x < -116.01f)
-		_position.x = -116.00f;
+	bounds = _bounds;
+	return true;
 }
 
-void GameModel::CollisionCheck(float RowXPosition, float Width)
+void GameModel::UnloadMesh()
 {
-	// Have you hit?
-	if (_position.x > RowXPosition && _position.x < RowXPosition + Width)
-	{
-		// If you crash, Increment Tries
-		numberOfTries++;
+	for (MeshBuffers& buffers : _lods)
+		DestroyVAO(buffers);
+}
 
-		// Move to start
-		_position.z = 100;
+bool GameModel::HasMesh() const
+{
+	return GetDrawLod() != nullptr;
+}
 
-		// Output to Console to show how well/bad they're doing
-		std::cout << "-------Tries--------" << std::endl;
-		std::cout << "-------- " << numberOfTries << " ---------" << std::endl;
-	}
+size_t GameModel::GetTriangleCount() const
+{
+	const MeshBuffers* buffers = GetDrawLod();
+	return buffers ? (size_t)buffers->numVertices / 3 : 0;
 }
 
-void GameModel::CheckCollisionsWithEnviroment()
+const MeshBuffers* GameModel::GetDrawLod() const
 {
-	// ROW 1 COLLISION CHECK
-	if (_position.z > row1Positions[0].z && _position.z < row1Positions[0].z + 10)
-	{
-		CollisionCheck(row1Positions[0].x, 43);
-		CollisionCheck(row1Positions[1].x, 15);
-		CollisionCheck(row1Positions[2].x, 15);
-		CollisionCheck(row1Positions[3].x, 49);
-		CollisionCheck(row1Positions[4].x, 16);
-	}
+	if (_lods.empty())
+		return nullptr;
 
-	// ROW 2 COLLISION CHECK
-	if (_position.z > row2Positions[0].z && _position.z < row2Positions[0].z + 10)
-	{
-		CollisionCheck(row2Positions[0].x, 76);
-		CollisionCheck(row2Positions[1].x, 76);
-	}
+	int wanted = _lodLevel < 0 ? 0 : (_lodLevel >= (int)_lods.size() ? (int)_lods.size() - 1 : _lodLevel);
 
-	// ROW 3 COLLISION CHECK
-	if (_position.z > row3Positions[0].z && _position.z < row3Positions[0].z + 10)
+	// Closest loaded level, preferring the coarser one when streaming
+	for (int offset = 0; offset < (int)_lods.size(); offset++)
 	{
-		CollisionCheck(row3Positions[0].x, 22);
-		CollisionCheck(row3Positions[1].x, 84);
-		CollisionCheck(row3Positions[2].x, 84);
+		if (wanted + offset < (int)_lods.size() && _lods[wanted + offset].numVertices > 0)
+			return &_lods[wanted + offset];
+		if (wanted - offset >= 0 && _lods[wanted - offset].numVertices > 0)
+			return &_lods[wanted - offset];
 	}
+	return nullptr;
+}
+
+void GameModel::DestroyVAO(MeshBuffers& buffers)
+{
+	glDeleteVertexArrays(1, &buffers.VAO);
+	glDeleteBuffers(1, &buffers.positionBuffer);
+	glDeleteBuffers(1, &buffers.normalBuffer);
+	glDeleteBuffers(1, &buffers.texCoordBuffer);
+	glDeleteBuffers(1, &buffers.tangentBuffer);
+
+	buffers.VAO = 0;
+	buffers.positionBuffer = 0;
+	buffers.normalBuffer = 0;
+	buffers.texCoordBuffer = 0;
+	buffers.tangentBuffer = 0;
+	buffers.numVertices = 0;
+	buffers.subsets.clear();
+}
 
-	// ROW 4 COLLISION CHECK
-	if (_position.z > row4Positions[0].z && _position.z < row4Positions[0].z + 10)
+void GameModel::TextureInit()
+{
+	_materialTextures.assign(_materials.size(), 0);
+	_materialNormalTextures.assign(_materials.size(), 0);
+
+	// Materials often share an image, each one is only uploaded once
+	std::unordered_map<std::string, GLuint> uploaded;
+	for (size_t i = 0; i < _materials.size(); i++)
 	{
-		CollisionCheck(row4Positions[0].x, 74);
-		CollisionCheck(row4Positions[1].x, 76);
+		const std::string* fileNames[2] = { &_materials[i].diffuseMap, &_materials[i].normalMap };
+		GLuint* textures[2] = { &_materialTextures[i], &_materialNormalTextures[i] };
+		for (int map = 0; map < 2; map++)
+		{
+			if (fileNames[map]->empty())
+				continue;
+
+			std::unordered_map<std::string, GLuint>::iterator found = uploaded.find(*fileNames[map]);
+			if (found == uploaded.end())
+				found = uploaded.insert(std::make_pair(*fileNames[map], LoadTexture(*fileNames[map]))).first;
+			*textures[map] = found->second;
+		}
 	}
+}
 
-	// ROW 5 COLLISION CHECK
-	if (_position.z > row5Positions[0].z && _position.z < row5Positions[0].z + 10)
+GLuint GameModel::LoadTexture(const std::string& fileName)
+{
+	std::string cookedFileName = TextureFile::GetCookedFileName(fileName);
+	TextureFile cooked;
+	if (TextureFile::IsCookedUpToDate(cookedFileName, fileName) && cooked.Open(cookedFileName))
+		return CreateTexture(cooked);
+
+	BmpLoader loader;
+	if (!loader.Load(fileName))
+		return 0;
+
+	const ImageData& image = loader.GetImage();
+	GLuint textureID = 0;
+	glGenTextures(1, &textureID);
+	glBindTexture(GL_TEXTURE_2D, textureID);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, image.width, image.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, &image.pixels[0]);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+	// Cooking builds the chain offline, a raw BMP has to have it made here
+	glGenerateMipmap(GL_TEXTURE_2D);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	return textureID;
+}
+
+void GameModel::DestroyTextures()
+{
+	// Shared names come up more than once, GL skips the ones already gone in the same call
+	if (!_materialTextures.empty())
+		glDeleteTextures((GLsizei)_materialTextures.size(), &_materialTextures[0]);
+	if (!_materialNormalTextures.empty())
+		glDeleteTextures((GLsizei)_materialNormalTextures.size(), &_materialNormalTextures[0]);
+	_materialTextures.clear();
+	_materialNormalTextures.clear();
+	_materials.clear();
+}
+
+void GameModel::ApplyMaterial(int material)
+{
+	// The uniforms stay set in the shared program, so only a change of model or material costs anything
+	SharedLitProgram& lit = litProgram;
+	if (lit.appliedModel == this && material == lit.appliedMaterial)
+		return;
+	lit.appliedModel = this;
+	lit.appliedMaterial = material;
+
+	if (material < 0 || material >= (int)_materials.size())
 	{
-		CollisionCheck(row5Positions[0].x, 116);
-		CollisionCheck(row5Positions[1].x, 90);
+		glUniform3fv(lit.ambientLocation, 1, glm::value_ptr(lit.defaultMaterial.ambient));
+		glUniform3fv(lit.diffuseLocation, 1, glm::value_ptr(lit.defaultMaterial.diffuse));
+		glUniform3fv(lit.specularLocation, 1, glm::value_ptr(lit.defaultMaterial.specular));
+		glUniform3fv(lit.emissiveLocation, 1, glm::value_ptr(lit.defaultMaterial.emissive));
+		glUniform1f(lit.shininessLocation, lit.defaultMaterial.shininess);
+		glUniform1f(lit.alphaLocation, lit.defaultMaterial.opacity);
+		glUniform1i(lit.hasDiffuseMapLocation, 0);
+		glUniform1i(lit.hasNormalMapLocation, 0);
+		return;
 	}
 
-	// ROW 6 COLLISION CHECK
-	if (_position.z > row6Positions[0].z && _position.z < row6Positions[0].z + 10)
+	const Material& current = _materials[material];
+	glUniform3fv(lit.ambientLocation, 1, glm::value_ptr(current.ambient * AMBIENT_LIGHT));
+	glUniform3fv(lit.diffuseLocation, 1, glm::value_ptr(current.diffuse));
+	glUniform3fv(lit.specularLocation, 1, glm::value_ptr(current.specular));
+	glUniform3fv(lit.emissiveLocation, 1, glm::value_ptr(current.emissive));
+	glUniform1f(lit.shininessLocation, current.shininess);
+	glUniform1f(lit.alphaLocation, current.opacity);
+	glUniform1i(lit.hasDiffuseMapLocation, _materialTextures[material] != 0);
+	glUniform1i(lit.hasNormalMapLocation, _materialNormalTextures[material] != 0);
+}
+
+void GameModel::InitialiseVAO(const MeshData& mesh, MeshBuffers& buffers)
+{
+	// Nothing to upload (file missing or empty)
+	if (mesh.IsEmpty())
+		return;
+
+	// Creates one VAO and binds it
+	glGenVertexArrays( 1, &buffers.VAO );
+	glBindVertexArray( buffers.VAO );
+
+	// Finds vertex amount
+	buffers.numVertices = (GLsizei)mesh.GetVertexCount();
+
+	// Create a generic 'buffer'
+	glGenBuffers(1, &buffers.positionBuffer);
+
+	// Tell OpenGL that we want to activate the buffer and that it's a VBO
+	glBindBuffer(GL_ARRAY_BUFFER, buffers.positionBuffer);
+
+	// Draw Verts
+	glBufferData(GL_ARRAY_BUFFER, sizeof(float) * buffers.numVertices * 3, &mesh.vertices[0], GL_STATIC_DRAW);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, 0 );
+	glEnableVertexAttribArray(0);
+
+	// Create a generic 'buffer'
+	glGenBuffers(1, &buffers.normalBuffer);
+
+	// Tell OpenGL that we want to activate the buffer and that it's a VBO
+	glBindBuffer(GL_ARRAY_BUFFER, buffers.normalBuffer);
+
+	// With this buffer active, we can now send our data to OpenGL
+	glBufferData(GL_ARRAY_BUFFER, sizeof(float) * buffers.numVertices * 3, &mesh.normals[0], GL_STATIC_DRAW);
+
+	// This tells OpenGL how we link the vertex data to the shader
+	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 0, 0 );
+	glEnableVertexAttribArray(1);
+
+	// Texture coordinates if the mesh has them, otherwise the shader gets (0, 0) for every vertex
+	if (mesh.HasTexCoords())
 	{
-		CollisionCheck(row6Positions[0].x, 136);
-		CollisionCheck(row6Positions[1].x, 90);
+		glGenBuffers(1, &buffers.texCoordBuffer);
+		glBindBuffer(GL_ARRAY_BUFFER, buffers.texCoordBuffer);
+		glBufferData(GL_ARRAY_BUFFER, sizeof(float) * buffers.numVertices * 2, &mesh.texCoords[0], GL_STATIC_DRAW);
+		glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 0, 0 );
+		glEnableVertexAttribArray(2);
 	}
 
-	// ROW 7 COLLISION CHECK
-	if (_position.z > row7Positions[0].z && _position.z < row7Positions[0].z + 10)
+	// Tangents packed four to a word, the bitangent is rebuilt from the normal in the shader
+	if (mesh.HasTangents())
 	{
-		CollisionCheck(row7Positions[0].x, 65);
-		CollisionCheck(row7Positions[1].x, 90);
+		glGenBuffers(1, &buffers.tangentBuffer);
+		glBindBuffer(GL_ARRAY_BUFFER, buffers.tangentBuffer);
+		glBufferData(GL_ARRAY_BUFFER, sizeof(uint32_t) * buffers.numVertices, &mesh.tangents[0], GL_STATIC_DRAW);
+		glVertexAttribPointer(3, 4, GL_INT_2_10_10_10_REV, GL_TRUE, 0, 0 );
+		glEnableVertexAttribArray(3);
 	}
+
+	buffers.subsets = mesh.subsets;
 	
-	// ROW 8 COLLISION CHECK
-	if (_position.z > row8Positions[0].z && _position.z < row8Positions[0].z + 10)
-	{
-		CollisionCheck(row8Positions[0].x, 126);
-		CollisionCheck(row8Positions[1].x, 90);
-	}
+	// Bind the buffer
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glBindVertexArray( 0 );
 
-	// ROW 9 COLLISION CHECK
-	if (_position.z > row9Positions[0].z && _position.z < row9Positions[0].z + 10)
-	{
-		CollisionCheck(row9Positions[0].x, 189);
-	}
+	// Technically we can do this, because the enabled / disabled state is stored in the VAO
+	glDisableVertexAttribArray(0);
+}
 
-	// ROW 10 COLLISION CHECK
-	if (_position.z > row10Positions[0].z && _position.z < row10Positions[0].z + 10)
+bool GameModel::InitialiseShaders()
+{
+	// Tried once, a first build that fails isn't tried again every draw
+	litProgram.built = true;
+
+	// Every model shares the one copy of the source, read the first time a model is drawn
+	const std::string& vertexText = GetShaderSource(VERTEX_SHADER_FILE_NAME);
+	const std::string& fragmentText = GetShaderSource(FRAGMENT_SHADER_FILE_NAME);
+	GLuint program = 0;
+	if (!vertexText.empty() && !fragmentText.empty())
+		program = BuildShaderProgram(vertexText.c_str(), fragmentText.c_str());
+
+	// The 'program' stores the shaders - a new one that doesn't build leaves the last good one drawing,
+	// and with nothing to fall back on yet the built in one draws instead
+	SharedLitProgram& lit = litProgram;
+	bool built = program != 0;
+	if (!program)
 	{
-		CollisionCheck(row10Positions[0].x, 80);
-		CollisionCheck(row10Positions[1].x, 90);
+		if (lit.program)
+		{
+			std::cerr << "WARNING: Lit shader did not build, keeping the one already drawing" << std::endl;
+			return false;
+		}
+
+		std::cerr << "WARNING: Lit shader did not build, drawing with the built in one until it does" << std::endl;
+		program = BuildShaderProgram(fallbackVertexText, fallbackFragmentText);
+		if (!program)
+			return false;
 	}
+	glDeleteProgram(lit.program);
+	lit.program = program;
 
-	// ROW 11 COLLISION CHECK
-	if (_position.z > row11Positions[0].z && _position.z < row11Positions[0].z + 10)
-	{
-		CollisionCheck(row11Positions[0].x, 98);
-		CollisionCheck(row11Positions[1].x, 108);
-	}
+	// Whatever the old program's uniforms held is gone with it
+	lit.appliedModel = nullptr;
 
-	// HAVE YOU WON COLLISION CHECK
-	if (_position.z < -1280)
+	// We need to get the location of the uniforms in the shaders
+	// This is so that we can send the values to them from the application
+	// We do this in the following way: 
+	lit.modelMatLocation = glGetUniformLocation( program, "modelMat" );
+	lit.viewMatLocation = glGetUniformLocation( program, "viewMat" );
+	lit.projMatLocation = glGetUniformLocation( program, "projMat" );
+
+	lit.ambientLocation = glGetUniformLocation( program, "ambientColour" );
+	lit.diffuseLocation = glGetUniformLocation( program, "diffuseColour" );
+	lit.specularLocation = glGetUniformLocation( program, "specularColour" );
+	lit.emissiveLocation = glGetUniformLocation( program, "emissiveColour" );
+	lit.shininessLocation = glGetUniformLocation( program, "shininess" );
+	lit.alphaLocation = glGetUniformLocation( program, "alpha" );
+	lit.hasDiffuseMapLocation = glGetUniformLocation( program, "hasDiffuseMap" );
+	lit.hasNormalMapLocation = glGetUniformLocation( program, "hasNormalMap" );
+
+	// Diffuse maps go on unit 0, normal maps on unit 1
+	glUseProgram( program );
+	glUniform1i( glGetUniformLocation( program, "diffuseMap" ), 0 );
+	glUniform1i( glGetUniformLocation( program, "normalMap" ), 1 );
+	glUseProgram( 0 );
+
+	// Parts of a mesh without a material go back to whatever the shader started with
+	lit.defaultMaterial = Material();
+	ReadUniform( program, lit.ambientLocation, glm::value_ptr(lit.defaultMaterial.ambient) );
+	ReadUniform( program, lit.diffuseLocation, glm::value_ptr(lit.defaultMaterial.diffuse) );
+	ReadUniform( program, lit.specularLocation, glm::value_ptr(lit.defaultMaterial.specular) );
+	ReadUniform( program, lit.emissiveLocation, glm::value_ptr(lit.defaultMaterial.emissive) );
+	ReadUniform( program, lit.shininessLocation, &lit.defaultMaterial.shininess );
+	ReadUniform( program, lit.alphaLocation, &lit.defaultMaterial.opacity );
+
+	return built;
+}
+
+void GameModel::Update( float deltaTs )
+{
+
+}
+
+void GameModel::Draw(const glm::mat4& viewMatrix, const glm::mat4& projMatrix, DrawPass pass)
+{
+	// Still streaming in
+	const MeshBuffers* buffers = GetDrawLod();
+	if (!buffers)
+		return;
+
+	UpdateModelMatrix();
+
+	// Every model shares one program per pass, so switching model is only a change of uniforms
+	const SharedLitProgram& lit = GetLitProgram();
+	GLuint program = lit.program;
+	GLint modelMatLocation = lit.modelMatLocation, viewMatLocation = lit.viewMatLocation, projMatLocation = lit.projMatLocation;
+	if (pass != DrawPass::Shaded)
 	{
-		std::cout << "YOU WIN" << std::endl; 
-		_position.z = 0;
+		const SharedPassProgram& shared = GetPassProgram(pass);
+		program = shared.program;
+		modelMatLocation = shared.modelMatLocation;
+		viewMatLocation = shared.viewMatLocation;
+		projMatLocation = shared.projMatLocation;
 	}
+
+	// Activate the shader program
+	glUseProgram( program );
+
+		// Activate the VAO
+		glBindVertexArray( buffers->VAO );
+
+			// Send matrices to the shader as uniforms like this:
+			glUniformMatrix4fv(modelMatLocation, 1, GL_FALSE, glm::value_ptr(_modelMatrix) );
+			glUniformMatrix4fv(viewMatLocation, 1, GL_FALSE, glm::value_ptr(viewMatrix) );
+			glUniformMatrix4fv(projMatLocation, 1, GL_FALSE, glm::value_ptr(projMatrix) );
+
+
+			if (pass != DrawPass::Shaded || (buffers->subsets.empty() && _materials.empty()))
+			{
+				// Tell OpenGL to draw it
+				// Must specify the type of geometry to draw and the number of vertices
+				glDrawArrays(GL_TRIANGLES, 0, buffers->numVertices);
+			}
+			else if (buffers->subsets.empty())
+			{
+				// A level without materials on a model that has them (e.g. a simplified one)
+				ApplyMaterial(-1);
+				glDrawArrays(GL_TRIANGLES, 0, buffers->numVertices);
+			}
+			else
+			{
+				// One draw per material, the subsets are already grouped so each material is set once
+				GLuint boundTexture = 0, boundNormalTexture = 0;
+				for (const MeshSubset& subset : buffers->subsets)
+				{
+					ApplyMaterial(subset.material);
+
+					bool hasMaterial = subset.material >= 0 && subset.material < (int)_materialTextures.size();
+					GLuint texture = hasMaterial ? _materialTextures[subset.material] : 0;
+					if (texture != 0 && texture != boundTexture)
+					{
+						glBindTexture(GL_TEXTURE_2D, texture);
+						boundTexture = texture;
+					}
+
+					GLuint normalTexture = hasMaterial ? _materialNormalTextures[subset.material] : 0;
+					if (normalTexture != 0 && normalTexture != boundNormalTexture)
+					{
+						glActiveTexture(GL_TEXTURE1);
+						glBindTexture(GL_TEXTURE_2D, normalTexture);
+						glActiveTexture(GL_TEXTURE0);
+						boundNormalTexture = normalTexture;
+					}
+
+					glDrawArrays(GL_TRIANGLES, (GLint)subset.firstVertex, (GLsizei)subset.vertexCount);
+				}
+
+				if (boundNormalTexture != 0)
+				{
+					glActiveTexture(GL_TEXTURE1);
+					glBindTexture(GL_TEXTURE_2D, 0);
+					glActiveTexture(GL_TEXTURE0);
+				}
+				if (boundTexture != 0)
+					glBindTexture(GL_TEXTURE_2D, 0);
+			}
+			
+		// Unbind VAO
+		glBindVertexArray( 0 );
+	
+	// Technically we can do this, but it makes no real sense because we must always have a valid shader program to draw geometry
+	glUseProgram( 0 );
 }
 
-void GameModel::SetRoll(float angle, float deltaTime)
+void GameModel::UpdateModelMatrix()
 {
-	// update the rotation angle of our cube
-	_rotation.y += deltaTime * angle;
+	// Next, we translate this matrix according to the object's _position vector:
+	_modelMatrix = glm::translate(glm::mat4(1.0f), _position);
+
+	// Next, we rotate this matrix in the x-axis by the object's x-rotation:
+	_modelMatrix = glm::rotate(_modelMatrix, _rotation.x, glm::vec3(1, 0, 0));
+	// Next, we rotate this matrix in the y-axis by the object's y-rotation:
+	_modelMatrix = glm::rotate(_modelMatrix, _rotation.y, glm::vec3(0, 1, 0));
+	// Next, we rotate this matrix in the z-axis by the object's z-rotation:
+	_modelMatrix = glm::rotate(_modelMatrix, _rotation.z, glm::vec3(0, 0, 1));
+	// Finally scale it
+	_modelMatrix = glm::scale(_modelMatrix, _scale);
 }
 
 void GameModel::SetRotation(float posX, float posY, float posZ)
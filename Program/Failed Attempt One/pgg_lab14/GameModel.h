@@ -9,109 +9,167 @@
 
 #pragma once
 #include "SDKS/glm/glm.hpp"
-#include "SDKS/SDL2-2.0.3/include/SDL.h"
+#include <SDL.h>
 #include <string>
+#include <vector>
 #include "glew.h"
 #include "ObjLoader.h"
+#include "MeshData.h"
+#include "TextureFile.h"
+#include "AlignedAllocator.h"
+
+/// What a Draw writes
+enum class DrawPass
+{
+	Shaded,		///< Lit colour and depth, the normal pass
+	DepthOnly,	///< Depth with the cheapest possible fragment shader, for the pre-pass
+	Overdraw	///< Add one to the OverdrawCounter for every fragment that passes the depth test
+};
+
+/// Compile and link a vertex and fragment shader, 0 if either fails (the log goes to std::cerr)
+GLuint BuildShaderProgram(const GLchar* vertexText, const GLchar* fragmentText);
+
+/// Upload every level of a cooked texture straight from its mapped file, 0 if it can't be
+/// BC1 goes up compressed when the driver takes S3TC, otherwise it is unpacked a level at a time
+GLuint CreateTexture(const TextureFile& texture);
+
+/// One uploaded mesh (a model has one per level of detail)
+struct MeshBuffers
+{
+	GLuint VAO;
+	GLuint positionBuffer;
+	GLuint normalBuffer;
+	GLuint texCoordBuffer;
+	GLuint tangentBuffer;
+	GLsizei numVertices;
+
+	/// Runs drawn with one material each, grouped by material (empty draws the lot in the model's own colours)
+	std::vector<MeshSubset> subsets;
+
+	MeshBuffers() : VAO(0), positionBuffer(0), normalBuffer(0), texCoordBuffer(0), tangentBuffer(0), numVertices(0) {}
+};
 
 /// Class to store and display a model
-__declspec(align(16)) class GameModel
+class alignas(16) GameModel : public AlignedObject<SIMD_ALIGNMENT>
 {
 public:
 
-	/// Constructor calls InitialiseVAO and InitialiseShaders
+	/// Constructor calls InitialiseVAO (the lit shader is shared, see InitialiseShaders)
 	GameModel(std::string objFileName);
+
+	/// Constructor for a model whose mesh arrives later (see LoadMesh)
+	GameModel();
 	~GameModel();
 
 	/// Loads object model into OpenGL
-	void InitialiseVAO();
+	void InitialiseVAO(const MeshData& mesh, MeshBuffers& buffers);
+
+	/// Swap in a mesh that was loaded somewhere else (e.g. by the AssetStreamer)
+	/// lodLevel 0 is the full detail mesh, higher levels are coarser
+	void LoadMesh(const MeshData& mesh, int lodLevel = 0);
+
+	/// Give every level's buffers back to OpenGL, the model keeps its bounds and can be loaded again
+	void UnloadMesh();
+
+	/// False until a mesh has been given to the model
+	bool HasMesh() const;
+
+	/// Level of detail to use for the next Draw (falls back to the nearest loaded level)
+	void SetLodLevel(int lodLevel) { _lodLevel = lodLevel; }
+	int GetLodLevel() const { return _lodLevel; }
+	int GetLodCount() const { return (int)_lods.size(); }
 
-	/// Loads shaders for the object into OpenGL
-	void InitialiseShaders();
+	/// Triangles the next Draw will submit
+	size_t GetTriangleCount() const;
+
+	/// Builds the lit shader every model draws with - the first draw does it, call it again after the source has
+	/// changed, a new shader that doesn't build is reported and the old one kept, so a mistake while editing doesn't blank the models
+	/// If the files are missing or broken before anything has built, a plain built in shader draws until they're fixed
+	/// False unless the files themselves built
+	static bool InitialiseShaders();
+
+	/// Where the lit shader's source is read from (relative to the working folder, like the models)
+	static const char* const VERTEX_SHADER_FILE_NAME;
+	static const char* const FRAGMENT_SHADER_FILE_NAME;
+
+	/// Replace the source every model builds the lit shader from (e.g. a shader file that has just been saved)
+	static void SetShaderSource(const std::string& fileName, const std::string& text);
 
 	/// Currently just updates rotation to make the model rotate
 	void Update( float deltaTs );
 
 	/// Draws object using the given camera view and projection matrices
-	void Draw(glm::mat4& viewMatrix, glm::mat4& projMatrix);
+	void Draw(const glm::mat4& viewMatrix, const glm::mat4& projMatrix, DrawPass pass = DrawPass::Shaded);
 
 	/// For setting the position of the model
 	void SetPosition( float posX, float posY, float posZ ) {_position.x = posX; _position.y = posY; _position.z = posZ;}
 
 	void SetRotation(float posX, float posY, float posZ);
-	
-	void SetForwardVelocity(float velocity, float deltaTime);
-
-	void SetSidewaysVelocity(float velocity, float deltaTime);
-
-	void CollisionCheck(float RowXPosition, float Width);
 
-	void CheckCollisionsWithEnviroment();
-
-	void SetRoll(float angle, float deltaTime);
+	void SetScale(float scaleX, float scaleY, float scaleZ) { _scale = glm::vec3(scaleX, scaleY, scaleZ); }
 
 	glm::vec3 GetModelPosition() {	return _position; }
 
-	void* operator new(size_t i)
-	{
-		return _mm_malloc(i, 16);
-	}
+	/// Box and sphere around the model where it is now, false until a mesh has been loaded
+	bool GetWorldBounds(glm::vec3& boxMin, glm::vec3& boxMax, glm::vec3& centre, float& radius);
 
-		void operator delete(void* p)
-	{
-		_mm_free(p);
-	}
+	/// Bounds in model space, false until a mesh has been loaded (const, so any thread can read it)
+	bool GetLocalBounds(MeshBounds& bounds) const;
 
 protected:
 
-	ObjLoader objLoader;
-
 	/// Object position vector
 	glm::vec3 _position;
 
 	/// Euler angles for rotation
 	glm::vec3 _rotation;
 
-	glm::vec3 row1Positions[5];
-	glm::vec3 row2Positions[2];
-	glm::vec3 row3Positions[3];
-	glm::vec3 row4Positions[2];
-	glm::vec3 row5Positions[2];
-	glm::vec3 row6Positions[2];
-	glm::vec3 row7Positions[2];
-	glm::vec3 row8Positions[2];
-	glm::vec3 row9Positions[1];
-	glm::vec3 row10Positions[2];
-	glm::vec3 row11Positions[2];
+	/// Scale on each axis
+	glm::vec3 _scale;
 
-	/// Vertex Array Object for model in OpenGL
-	GLuint _VAO;
+	/// Vertex Array Object and buffers for each level of detail in OpenGL
+	std::vector<MeshBuffers> _lods;
 
-	/// Shader program
-	GLuint _program;
+	/// Level of detail the next Draw uses
+	int _lodLevel;
 
-	/// Uniform locations
-	GLint _shaderModelMatLocation, _shaderViewMatLocation, _shaderProjMatLocation;
+	/// Bounds in model space, loose enough to cover every level
+	MeshBounds _bounds;
+	bool _hasBounds;
 
 	/// Object's model matrix
 	/// This is rebuilt in the update function
 	glm::mat4 _modelMatrix;
 
-	/// Number of vertices in the model
-	GLsizei _numVertices;
-	uint16_t numberOfTries = 0;
-
-	GLuint diffuseTexID;
-	GLuint normalTexID;
+	/// Materials the subsets point at, and each one's diffuse and normal texture (0 if it hasn't got one)
+	std::vector<Material> _materials;
+	std::vector<GLuint> _materialTextures;
+	std::vector<GLuint> _materialNormalTextures;
 
 private:
+	/// Upload the diffuse and normal maps of every material (cooked .ptex if there is an up to date one, otherwise the BMP)
 	void TextureInit();
 
-	GLuint positionBuffer;
-	GLuint normalBuffer;
-	GLuint texCoordBuffer;
-	GLuint tangentBuffer;
-	GLuint biTangentBuffer;
+	/// Upload one image with its mip chain, 0 if it couldn't be loaded
+	GLuint LoadTexture(const std::string& fileName);
+
+	/// Give the material textures back to OpenGL
+	void DestroyTextures();
+
+	/// Set the lit shader's uniforms for a material, -1 for the model's own colours
+	void ApplyMaterial(int material);
+
+	/// Set everything to a safe empty state
+	void InitialiseMembers();
+
+	/// Give the VAO and buffers back to OpenGL
+	void DestroyVAO(MeshBuffers& buffers);
+
+	/// The loaded level closest to _lodLevel, null if nothing is loaded yet
+	const MeshBuffers* GetDrawLod() const;
+
+	/// Rebuild _modelMatrix from position, rotation and scale
+	void UpdateModelMatrix();
 
 	//SDL_Surface* surface;
 
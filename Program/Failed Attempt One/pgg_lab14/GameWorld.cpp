@@ -9,16 +9,54 @@
 
 #include "GameWorld.h"
 
+#include <algorithm>
+
+// Part of a rock's bounds that is solid all the way through (inside both Rock_big_single_b LODs), so it can hide what's behind it
+// Only a slab in z - it is the face towards the camera that does the hiding
+static const glm::vec3 ROCK_OCCLUDER_LOW(0.275f, 0.125f, 0.325f);
+static const glm::vec3 ROCK_OCCLUDER_HIGH(0.7f, 0.65f, 0.475f);
+
+// Rocks handed to each job when they're spread over the JobSystem
+static const size_t ROCK_BATCH_SIZE = 64;
+
+// Same as GameModel::GetWorldBounds, but without touching the shared model (rock instances are never rotated)
+static void getRockBounds(const MeshBounds& bounds, const LodInstance& instance, glm::vec3& boxMin, glm::vec3& boxMax,
+						  glm::vec3& centre, float& radius)
+{
+	glm::vec3 scaledMin = bounds.min * instance.scale;
+	glm::vec3 scaledMax = bounds.max * instance.scale;
+	boxMin = instance.position + glm::min(scaledMin, scaledMax);
+	boxMax = instance.position + glm::max(scaledMin, scaledMax);
+
+	centre = instance.position + bounds.centre * instance.scale;
+	glm::vec3 absScale = glm::abs(instance.scale);
+	radius = bounds.radius * glm::max(absScale.x, glm::max(absScale.y, absScale.z));
+}
+
 GameWorld::GameWorld()
+	: simulationThread(simulation), assetStreamer(&jobSystem, &assetArchive)
 {
+	// Packed assets if there are any (made with pgg_pack_assets), otherwise the loose files are loaded one by one
+	if (assetArchive.Open("assets.pak"))
+		std::cout << "Loading assets from assets.pak (" << assetArchive.GetEntryCount() << " files)" << std::endl;
+
 	winPosX = 360;
 	winPosY = 100;
 	winWidth = 1280;
 	winHeight = 720;
 
-	MAX_SPINAMOUNT = 27.0f;
-	SPIN_ACCELERATION = 1.3f;
-	MAX_SPEED = 38.5f;
+	deltaTime = 0.0f;
+	allocatingFrames = 0;
+	showFrameStats = false;
+	occlusionCulling = true;
+	depthPrepass = false;
+	frontToBack = true;
+	showOverdraw = false;
+	lastStatsTime = 0;
+
+	pipelineSimulation = true;
+	shownTries = 0;
+	shownFinishes = 0;
 
 	// Initialise the Pointers to NULL
 	window = nullptr;
@@ -26,6 +64,16 @@ GameWorld::GameWorld()
 	glContext = NULL;
 
 	camera = new Camera();
+	overdrawCounter = nullptr;
+	terrainTicket = 0;
+
+	endlessTrack = nullptr;
+	for (int i = 0; i < EndlessTrack::MAX_SEGMENTS; i++)
+	{
+		segmentModels[i] = nullptr;
+		segmentUploaded[i] = -1;
+		segmentEpoch[i] = 0;
+	}
 
 	// The game is looping
 	go = true;
@@ -37,10 +85,25 @@ GameWorld::GameWorld()
 
 GameWorld::~GameWorld()
 {
+	if (allocatingFrames > 0)
+		std::cout << "WARNING: " << allocatingFrames << " frames allocated from the heap" << std::endl;
+
+	// Nothing else may touch the simulation while its thread is going
+	simulationThread.stop();
+
 	// Delete Pointers!
 	delete camera;
+	delete overdrawCounter;
 	delete playerRocket;
-	delete Terrain;
+	delete Rocks;
+	for (GameModel* chunk : terrainModels)
+		delete chunk;
+
+	// Stop the simulation using the track before it goes
+	simulation.setEndlessTrack(nullptr);
+	delete endlessTrack;
+	for (GameModel* segment : segmentModels)
+		delete segment;
 	
 	// Destroy SDL Specific Stuff
 	SDL_DestroyRenderer(renderer);
@@ -111,31 +174,73 @@ bool GameWorld::initialiseOpenGL()
 
 void GameWorld::initialiseScene()
 {
-	// Setup Models
-	playerRocket = new GameModel("Rocket.obj");
-	Terrain = new GameModel("Level Final.obj");
+	// Setup Models - the meshes stream in, the Rocket first as you can't play without it
+	playerRocket = new GameModel();
+	Rocks = new GameModel();
+
+	StreamingTarget rocket = { playerRocket, 0 };
+	StreamingTarget level = { nullptr, 0 };
+	StreamingTarget rocksFar = { Rocks, 1 };
+	StreamingTarget rocksNear = { Rocks, 0 };
+
+	// The Rocket gets its levels of detail made for it by the MeshPipeline
+	streamMesh("Rocket.obj", AssetPriority::High, MeshProcessing::GenerateLods, rocket);
+
+	// The level is sliced on the worker, see createTerrainChunks
+	terrainTicket = streamMesh("Level Final.obj", AssetPriority::Low, MeshProcessing::SliceTerrain, level);
+
+	// The far rocks are the ones you see first so they come in before the detailed ones
+	streamMesh("Rock_big_single_b_LOD3.obj", AssetPriority::Low, MeshProcessing::None, rocksFar);
+	streamMesh("Rock_big_single_b_LOD0.obj", AssetPriority::Low, MeshProcessing::None, rocksNear);
+
+	// Every model builds the lit shader from these, saving either one rebuilds it
+	fileWatcher.Watch(GameModel::VERTEX_SHADER_FILE_NAME);
+	fileWatcher.Watch(GameModel::FRAGMENT_SHADER_FILE_NAME);
+
+	// LOD0 up close, LOD3 for everything past ROCK_LOD_DISTANCE (10% either way before it swaps)
+	const float ROCK_LOD_DISTANCE = 250.0f;
+	rockLod.addLevel(ROCK_LOD_DISTANCE);
+	rockLod.addLevel(1000.0f);
+	rockLod.setHysteresis(0.1f);
+
+	// One band per MeshPipeline level (full, half, quarter, tenth)
+	generatedLod.addLevel(100.0f);
+	generatedLod.addLevel(300.0f);
+	generatedLod.addLevel(800.0f);
+	generatedLod.addLevel(2000.0f);
+	generatedLod.setHysteresis(0.1f);
+
+	createRockInstances();
 
 	// Position Terrain
-	Terrain->SetPosition(0, -15 ,-180);
+	terrainPosition = glm::vec3(0, -15, -180);
 
-	// Set object's position like this:
-	playerRocket->SetPosition(0, 0, 0);
-	playerRocket->SetRotation(-1.57f, 0, 0);
+	// Place the Rocket where the simulation starts it
+	glm::vec3 rocketPosition = simulation.getRocketPosition();
+	glm::vec3 rocketRotation = simulation.getRocketRotation();
+	playerRocket->SetPosition(rocketPosition.x, rocketPosition.y, rocketPosition.z);
+	playerRocket->SetRotation(rocketRotation.x, rocketRotation.y, rocketRotation.z);
 }
 
 void GameWorld::render2DImages(SDL_Texture* Image, SDL_Rect Location, bool Update)
 {
-	// Tell it wherer to render
-	SDL_QueryTexture(Image, NULL, NULL, &Location.w, &Location.h);
-	SDL_RenderCopy(renderer, Image, NULL, &Location);
-
-	if (Update)
+	// Tell it wherer to render (images still streaming in are skipped)
+	if (Image)
 	{
-		// Get Renderer
-		SDL_RenderPresent(renderer);
-		// Clear the entire screen to our selected colour
-		SDL_RenderClear(renderer);
+		SDL_QueryTexture(Image, NULL, NULL, &Location.w, &Location.h);
+		SDL_RenderCopy(renderer, Image, NULL, &Location);
 	}
+
+	if (Update)
+		present2DImages();
+}
+
+void GameWorld::present2DImages()
+{
+	// Get Renderer
+	SDL_RenderPresent(renderer);
+	// Clear the entire screen to our selected colour
+	SDL_RenderClear(renderer);
 }
 
 SDL_Texture* GameWorld::createImage(std::string filename)
@@ -164,6 +269,153 @@ SDL_Texture* GameWorld::createImage(std::string filename)
 	return temp;
 }
 
+SDL_Texture* GameWorld::createImage(const ImageData& image)
+{
+	if (image.IsEmpty())
+		return nullptr;
+
+	// RGBA bytes in memory, already colour keyed by the loader
+	SDL_Texture* temp = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ABGR8888, SDL_TEXTUREACCESS_STATIC,
+										  image.width, image.height);
+	if (temp)
+	{
+		SDL_UpdateTexture(temp, NULL, &image.pixels[0], image.width * 4);
+		SDL_SetTextureBlendMode(temp, SDL_BLENDMODE_BLEND);
+	}
+	return temp;
+}
+
+uint32_t GameWorld::requestImage(std::string filename)
+{
+	return assetStreamer.requestImage(filename, AssetPriority::High);
+}
+
+uint32_t GameWorld::requestAtlas(const std::vector<std::string>& filenames)
+{
+	return assetStreamer.requestAtlas(filenames, AssetPriority::High);
+}
+
+SDL_Texture* GameWorld::getStreamedImage(uint32_t ticket)
+{
+	std::unordered_map<uint32_t, SDL_Texture*>::iterator found = streamedImages.find(ticket);
+	return found != streamedImages.end() ? found->second : nullptr;
+}
+
+SDL_Texture* GameWorld::getStreamedAtlas(uint32_t ticket, std::vector<AtlasRegion>& regions)
+{
+	std::unordered_map<uint32_t, std::vector<AtlasRegion> >::iterator found = streamedAtlasRegions.find(ticket);
+	if (found == streamedAtlasRegions.end())
+		return nullptr;
+
+	regions = found->second;
+	return getStreamedImage(ticket);
+}
+
+uint32_t GameWorld::streamMesh(const std::string& fileName, AssetPriority priority, MeshProcessing processing, StreamingTarget target)
+{
+	uint32_t ticket = assetStreamer.requestMesh(fileName, priority, processing);
+	if (target.model)
+		streamingModels[ticket] = target;
+
+	WatchedMesh watched = { fileName, processing, target };
+	watchedMeshes.push_back(watched);
+	fileWatcher.Watch(fileName);
+	return ticket;
+}
+
+void GameWorld::processFileChanges()
+{
+	// Nothing changed is one read that comes straight back, so this is cheap enough to do every frame
+	fileWatcher.Poll(changedFiles);
+	for (const std::string& fileName : changedFiles)
+	{
+		std::cout << "Reloading " << fileName << std::endl;
+
+		if (fileName == GameModel::VERTEX_SHADER_FILE_NAME || fileName == GameModel::FRAGMENT_SHADER_FILE_NAME)
+		{
+			assetStreamer.requestText(fileName);
+			continue;
+		}
+
+		// Parsed again on the worker, the old mesh keeps drawing until the new one is swapped in
+		for (const WatchedMesh& watched : watchedMeshes)
+		{
+			if (watched.fileName != fileName)
+				continue;
+
+			uint32_t ticket = assetStreamer.reloadMesh(fileName, watched.processing);
+			if (watched.target.model)
+				streamingModels[ticket] = watched.target;
+			else
+				terrainTicket = ticket;
+		}
+	}
+}
+
+void GameWorld::processStreamedAssets()
+{
+	std::unique_ptr<StreamedAsset> asset;
+	bool shadersChanged = false;
+
+	// Upload everything that has finished - this is the only place the GPU sees streamed data
+	while (assetStreamer.pollCompleted(asset))
+	{
+		if (!asset->loaded)
+			std::cout << "Couldn't stream in " << asset->fileName << std::endl;
+
+		if (asset->type == AssetType::Mesh && asset->ticket == terrainTicket)
+		{
+			createTerrainChunks(asset->chunks);
+		}
+		else if (asset->type == AssetType::Mesh)
+		{
+			std::unordered_map<uint32_t, StreamingTarget>::iterator target = streamingModels.find(asset->ticket);
+			if (target != streamingModels.end())
+			{
+				// Generated levels fill in from the target level down
+				if (asset->lods.empty())
+					target->second.model->LoadMesh(asset->mesh, target->second.lodLevel);
+				for (size_t i = 0; i < asset->lods.size(); i++)
+					target->second.model->LoadMesh(asset->lods[i].mesh, target->second.lodLevel + (int)i);
+				streamingModels.erase(target);
+			}
+		}
+		else if (asset->type == AssetType::Text)
+		{
+			// A saved shader - the shared program is built again below, once however many files came in
+			if (asset->loaded)
+			{
+				GameModel::SetShaderSource(asset->fileName, asset->text);
+				shadersChanged = true;
+			}
+		}
+		else
+		{
+			// An atlas is one texture too, it just keeps its regions alongside
+			streamedImages[asset->ticket] = createImage(asset->image);
+			if (asset->type == AssetType::Atlas)
+				streamedAtlasRegions[asset->ticket] = std::move(asset->regions);
+		}
+	}
+
+	// Here, between frames, so no frame draws half the models with the old shader and half with the new
+	// (every model shares the one program, so it is built once however many there are)
+	if (shadersChanged)
+		GameModel::InitialiseShaders();
+}
+
+void GameWorld::resizeOverdrawCounter()
+{
+	// The window is fullscreen desktop (and may be high DPI), so winWidth x winHeight is only what was asked for
+	int drawableWidth, drawableHeight;
+	SDL_GL_GetDrawableSize(window, &drawableWidth, &drawableHeight);
+	if (overdrawCounter->isAvailable() && overdrawCounter->getWidth() == drawableWidth && overdrawCounter->getHeight() == drawableHeight)
+		return;
+
+	if (!overdrawCounter->initialise(drawableWidth, drawableHeight))
+		showOverdraw = false;
+}
+
 void GameWorld::keyInputHandler()
 {
 	switch (incomingEvent.type)
@@ -171,6 +423,11 @@ void GameWorld::keyInputHandler()
 	case SDL_QUIT:
 		go = false;
 		break;
+	// Resized (or made fullscreen) - the overdraw counts have to cover every pixel again
+	case SDL_WINDOWEVENT:
+		if (incomingEvent.window.event == SDL_WINDOWEVENT_SIZE_CHANGED && overdrawCounter && overdrawCounter->isAvailable())
+			resizeOverdrawCounter();
+		break;
 	// When Key is pressed
 	case SDL_KEYDOWN:
 		switch (incomingEvent.key.keysym.sym)
@@ -183,12 +440,51 @@ void GameWorld::keyInputHandler()
 
 		// A - Spin Left
 		case SDLK_a:
-			spinAmount -= SPIN_ACCELERATION;
+			simulationThread.sendInput(SimulationInput::SpinLeft);
 			break;
 
 		// D - Spin Right
 		case SDLK_d:
-			spinAmount += SPIN_ACCELERATION;
+			simulationThread.sendInput(SimulationInput::SpinRight);
+			break;
+
+		// F1 - Frame Stats on / off
+		case SDLK_F1:
+			showFrameStats = !showFrameStats;
+			break;
+
+		// F2 - Occlusion Culling on / off
+		case SDLK_F2:
+			occlusionCulling = !occlusionCulling;
+			break;
+
+		// F3 - Depth Pre-pass on / off
+		case SDLK_F3:
+			depthPrepass = !depthPrepass;
+			break;
+
+		// F4 - Front to Back Sorting on / off
+		case SDLK_F4:
+			frontToBack = !frontToBack;
+			break;
+
+		// F5 - Overdraw View on / off (made the first time it's asked for)
+		case SDLK_F5:
+			if (!overdrawCounter)
+			{
+				overdrawCounter = new OverdrawCounter();
+				resizeOverdrawCounter();
+			}
+			showOverdraw = !showOverdraw && overdrawCounter->isAvailable();
+			break;
+
+		// F6 - Simulation on its own thread on / off
+		case SDLK_F6:
+			pipelineSimulation = !pipelineSimulation;
+			if (pipelineSimulation && !endlessTrack)
+				simulationThread.start();
+			else
+				simulationThread.stop();
 			break;
 		}
 		break;
@@ -204,30 +500,35 @@ void GameWorld::updateObjects()
 	// Now that we've done this we can use the current time as the next frame's previous time
 	lastTime = current;
 
-	// Limit Speed
-	if (spinAmount > MAX_SPINAMOUNT)
-		spinAmount = MAX_SPINAMOUNT - 0.10f;
-	if (spinAmount < -MAX_SPINAMOUNT)
-		spinAmount = -MAX_SPINAMOUNT + 0.10f;
+	// Move the Rocket and check it against the level - the thread has already done it if it's running
+	if (!simulationThread.isRunning())
+		simulationThread.step(deltaTime);
 
-	// Update the model, to make it rotate
-	playerRocket->SetRoll(spinAmount, deltaTime);
+	// Newest finished step, the simulation may already be working on the next one
+	simulationThread.updateSnapshot();
+	const FrameSnapshot& snapshot = simulationThread.getSnapshot();
 
-	// DONT ROLL TERRAIN
-	Terrain->SetRoll(0, 0);
-
-	// Accelerate to MAX SPEED!
-	if (currentSpeed < MAX_SPEED)
+	if (snapshot.numberOfTries != shownTries)
 	{
-		currentSpeed += 0.1f;
+		// Output to Console to show how well/bad they're doing
+		shownTries = snapshot.numberOfTries;
+		std::cout << "-------Tries--------" << std::endl;
+		std::cout << "-------- " << shownTries << " ---------" << std::endl;
+	}
+	if (snapshot.finishes != shownFinishes)
+	{
+		shownFinishes = snapshot.finishes;
+		std::cout << "YOU WIN" << std::endl;
 	}
 
-	// Send the Velocity to the Rocket!
-	playerRocket->SetForwardVelocity(currentSpeed, deltaTime);
-	playerRocket->SetSidewaysVelocity((-spinAmount / 1.3f), deltaTime);
+	// Copy the simulated transform onto the model
+	glm::vec3 rocketPosition = snapshot.rocketPosition;
+	glm::vec3 rocketRotation = snapshot.rocketRotation;
+	playerRocket->SetPosition(rocketPosition.x, rocketPosition.y, rocketPosition.z);
+	playerRocket->SetRotation(rocketRotation.x, rocketRotation.y, rocketRotation.z);
 
 	// Set the camera to follow the Rocket
-	camera->followRocket(playerRocket->GetModelPosition());
+	camera->followRocket(rocketPosition);
 
 	// Specify the colour to clear the framebuffer to
 	glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
@@ -241,10 +542,184 @@ void GameWorld::drawObjects()
 	// Update the Camera
 	camera->update();
 
-	// Update the Objects
-	playerRocket->CheckCollisionsWithEnviroment();
-	playerRocket->Draw(camera->getView(), camera->getProjection());
-	Terrain->Draw(camera->getView(), camera->getProjection());
+	frameStats.reset();
+	glm::vec3 eyePosition = camera->getPosition();
+	glm::mat4 viewProjection = camera->getProjection() * camera->getView();
+	frustum.extractPlanes(viewProjection);
+
+	// Endless mode has its own track, otherwise just the level chunks near the camera
+	if (!endlessTrack)
+		updateTerrainChunks(eyePosition.z);
+
+	// Build this frame's draw list in the frame arena
+	FrameVector<DrawItem> drawList(&frameArena);
+	DrawItem rocketItem = { playerRocket, nullptr };
+	drawList.push_back(rocketItem);
+
+	if (endlessTrack)
+		addEndlessSegments(drawList);
+
+	// Only the chunks that are on the GPU, the rest are out of range
+	for (GameModel* chunk : terrainModels)
+	{
+		if (chunk->HasMesh())
+		{
+			DrawItem terrainItem = { chunk, nullptr };
+			drawList.push_back(terrainItem);
+		}
+	}
+
+	// Anything off screen never gets to Draw (sphere first as it's cheaper, then the tighter box)
+	size_t visibleCount = 0;
+	for (DrawItem& item : drawList)
+	{
+		if (item.instance)
+		{
+			item.model->SetPosition(item.instance->position.x, item.instance->position.y, item.instance->position.z);
+			item.model->SetScale(item.instance->scale.x, item.instance->scale.y, item.instance->scale.z);
+		}
+
+		glm::vec3 centre;
+		float radius;
+		item.hasBounds = item.model->GetWorldBounds(item.boxMin, item.boxMax, centre, radius);
+		if (item.hasBounds && (!frustum.isSphereVisible(centre, radius) || !frustum.isBoxVisible(item.boxMin, item.boxMax)))
+		{
+			frameStats.modelsCulled++;
+			continue;
+		}
+
+		drawList[visibleCount++] = item;
+	}
+	drawList.resize(visibleCount);
+
+	// Every rock picks its level of detail and does its frustum test on whichever thread is free
+	// Each one only writes its own instance and slot, culled ones are left without a model
+	MeshBounds rockBounds;
+	bool rocksHaveBounds = Rocks->GetLocalBounds(rockBounds);
+	FrameVector<DrawItem> rockItems(rockInstances.size(), &frameArena);
+	jobSystem.parallelFor(rockInstances.size(), ROCK_BATCH_SIZE, [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			LodInstance& instance = rockInstances[i];
+			instance.lodLevel = rockLod.selectLevel(glm::length(instance.position - eyePosition), instance.lodLevel);
+
+			DrawItem& rockItem = rockItems[i];
+			rockItem.model = Rocks;
+			rockItem.instance = &instance;
+			rockItem.hasBounds = rocksHaveBounds;
+			if (!rocksHaveBounds)
+				continue;
+
+			glm::vec3 centre;
+			float radius;
+			getRockBounds(rockBounds, instance, rockItem.boxMin, rockItem.boxMax, centre, radius);
+			if (!frustum.isSphereVisible(centre, radius) || !frustum.isBoxVisible(rockItem.boxMin, rockItem.boxMax))
+				rockItem.model = nullptr;
+		}
+	});
+
+	for (const DrawItem& rockItem : rockItems)
+	{
+		if (rockItem.model)
+			drawList.push_back(rockItem);
+		else
+			frameStats.modelsCulled++;
+	}
+
+	// Rocks are the big blockers - draw the solid middle of each one on screen into the occlusion buffer
+	if (occlusionCulling)
+	{
+		occlusionBuffer.clear(viewProjection);
+		for (const DrawItem& item : drawList)
+		{
+			if (item.instance && item.hasBounds)
+			{
+				glm::vec3 innerMin, innerMax;
+				OcclusionBuffer::getInnerBox(item.boxMin, item.boxMax, ROCK_OCCLUDER_LOW, ROCK_OCCLUDER_HIGH, innerMin, innerMax);
+				occlusionBuffer.addOccluder(innerMin, innerMax);
+			}
+		}
+		occlusionBuffer.buildPyramid();
+	}
+
+	// Drop what's hidden behind the rocks, then pick levels and see how far away the rest start
+	glm::vec3 forward(-camera->getView()[0][2], -camera->getView()[1][2], -camera->getView()[2][2]);
+	size_t drawCount = 0;
+	for (DrawItem& item : drawList)
+	{
+		if (occlusionCulling && item.hasBounds && occlusionBuffer.isBoxOccluded(item.boxMin, item.boxMax))
+		{
+			frameStats.modelsOccluded++;
+			continue;
+		}
+
+		if (!item.instance && item.model->GetLodCount() > 1)
+		{
+			float distance = glm::length(item.model->GetModelPosition() - eyePosition);
+			item.model->SetLodLevel(generatedLod.selectLevel(distance, item.model->GetLodLevel()));
+		}
+
+		// Nearest corner of the box along the view direction
+		if (item.hasBounds)
+		{
+			glm::vec3 centre = (item.boxMin + item.boxMax) * 0.5f;
+			glm::vec3 halfSize = (item.boxMax - item.boxMin) * 0.5f;
+			item.viewDepth = glm::dot(forward, centre - eyePosition) - glm::dot(glm::abs(forward), halfSize);
+		}
+		else
+		{
+			item.viewDepth = glm::dot(forward, item.model->GetModelPosition() - eyePosition);
+		}
+
+		drawList[drawCount++] = item;
+	}
+	drawList.resize(drawCount);
+
+	// Nearest first, so the depth test throws away what's behind before it gets shaded
+	if (frontToBack)
+	{
+		std::sort(drawList.begin(), drawList.end(), [](const DrawItem& a, const DrawItem& b) { return a.viewDepth < b.viewDepth; });
+	}
+
+	// Depth only first, then the lit pass only shades the fragments that end up on screen
+	if (depthPrepass)
+	{
+		glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+		for (DrawItem& item : drawList)
+			drawItem(item, DrawPass::DepthOnly);
+		glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+
+		glDepthFunc(GL_LEQUAL);
+		glDepthMask(GL_FALSE);
+	}
+
+	// Draw the Objects (or count their fragments instead)
+	if (showOverdraw)
+		overdrawCounter->begin();
+
+	for (DrawItem& item : drawList)
+	{
+		drawItem(item, showOverdraw ? DrawPass::Overdraw : DrawPass::Shaded);
+
+		if (item.instance && item.instance->lodLevel < MAX_LOD_LEVELS)
+			frameStats.lodInstances[item.instance->lodLevel]++;
+
+		frameStats.modelsDrawn++;
+		frameStats.trianglesDrawn += item.model->GetTriangleCount();
+	}
+
+	if (showOverdraw)
+	{
+		overdrawCounter->end();
+		frameStats.fragmentsShaded = overdrawCounter->getFragmentCount();
+		frameStats.pixelsCovered = overdrawCounter->getCoveredPixels();
+	}
+
+	glDepthFunc(GL_LESS);
+	glDepthMask(GL_TRUE);
+
+	reportFrameStats();
 
 	// Double Buffering Stuff Yes!
 	SDL_GL_SwapWindow(window);
@@ -256,11 +731,37 @@ void GameWorld::drawObjects()
 	}
 }
 
+void GameWorld::drawItem(DrawItem& item, DrawPass pass)
+{
+	// Instances share one model, so put this one back where it goes
+	if (item.instance)
+	{
+		item.model->SetPosition(item.instance->position.x, item.instance->position.y, item.instance->position.z);
+		item.model->SetScale(item.instance->scale.x, item.instance->scale.y, item.instance->scale.z);
+		item.model->SetLodLevel(item.instance->lodLevel);
+	}
+
+	item.model->Draw(camera->getView(), camera->getProjection(), pass);
+}
+
 bool GameWorld::updateGame()
 {
+	// The endless track's segments are read by the renderer, so that mode keeps the simulation on this thread
+	if (pipelineSimulation && !endlessTrack)
+		simulationThread.start();
+
 	// While the game loop is going
 	while (go == true)
 	{
+		// Last frame's temporaries are all thrown away here
+		frameArena.beginFrame();
+		// Only this thread's - the streamer, the jobs and the simulation thread allocate whenever they like
+		size_t allocationsAtFrameStart = getThreadAllocationCount();
+
+		// Pick up any meshes that finished loading, and start reloading any files that were saved
+		processFileChanges();
+		processStreamedAssets();
+
 		// Keyboard input 
 		while (SDL_PollEvent(&incomingEvent))
 		{
@@ -270,7 +771,166 @@ bool GameWorld::updateGame()
 	updateObjects();
 	drawObjects();
 
+	checkFrameAllocations(getThreadAllocationCount() - allocationsAtFrameStart);
 	}
+	simulationThread.stop();
+
 	// Exit out
 	return false;
 }
+
+void GameWorld::checkFrameAllocations(size_t allocations)
+{
+	// Give the game a couple of seconds to fill its caches and the arena to find its size
+	const size_t WARM_UP_FRAMES = 120;
+
+	if (!isAllocationCountingEnabled() || allocations == 0 || frameArena.getFrameNumber() < WARM_UP_FRAMES)
+		return;
+
+	// Only shout about the first one, the destructor gives the total
+	if (allocatingFrames == 0)
+	{
+		std::cout << "WARNING: frame " << frameArena.getFrameNumber() << " made " << allocations
+				  << " heap allocations" << std::endl;
+	}
+	allocatingFrames++;
+}
+
+void GameWorld::createRockInstances()
+{
+	ObstacleField& obstacles = simulation.getObstacleField();
+	rockInstances.clear();
+
+	for (const ObstacleRow& row : obstacles.getRows())
+		addRockInstances(row, obstacles.getRowDepth(), rockInstances);
+}
+
+void GameWorld::addRockInstances(const ObstacleRow& row, float rowDepth, std::vector<LodInstance>& instances)
+{
+	// Size of Rock_big_single_b across X and Z
+	const float ROCK_SIZE = 130.0f;
+	const float TERRAIN_HEIGHT = -15.0f;
+
+	for (const Obstacle& obstacle : row.obstacles)
+	{
+		// Scale the rock to cover the obstacle, but keep it from towering over the track
+		float scale = obstacle.width / ROCK_SIZE;
+
+		LodInstance instance;
+		instance.position = glm::vec3(obstacle.x + obstacle.width * 0.5f, TERRAIN_HEIGHT, row.z + rowDepth * 0.5f);
+		instance.scale = glm::vec3(scale, scale * 0.5f, rowDepth / ROCK_SIZE);
+		instance.lodLevel = -1;
+		instances.push_back(instance);
+	}
+}
+
+void GameWorld::enableEndlessMode(uint32_t seed)
+{
+	if (endlessTrack)
+		return;
+
+	std::cout << "Endless mode, seed " << seed << std::endl;
+
+	// The hand placed rocks and level chunks aren't used any more
+	rockInstances.clear();
+	for (GameModel* chunk : terrainModels)
+		chunk->UnloadMesh();
+
+	endlessTrack = new EndlessTrack(seed);
+	simulation.setEndlessTrack(endlessTrack);
+
+	for (int i = 0; i < EndlessTrack::MAX_SEGMENTS; i++)
+	{
+		segmentModels[i] = new GameModel();
+		segmentRocks[i].reserve(16);
+	}
+}
+
+void GameWorld::addEndlessSegments(FrameVector<DrawItem>& drawList)
+{
+	for (TrackSegment* segment : endlessTrack->getSegments())
+	{
+		int slot = endlessTrack->getSlot(segment);
+
+		// A slot that has been given a new segment since last time needs its floor and rocks redone
+		if (segmentUploaded[slot] != segment->index || segmentEpoch[slot] != segment->epoch)
+		{
+			segmentModels[slot]->LoadMesh(segment->mesh);
+			segmentRocks[slot].clear();
+			for (size_t i = 0; i < segment->rowCount; i++)
+				addRockInstances(segment->rows[i], endlessTrack->getRowDepth(), segmentRocks[slot]);
+
+			segmentUploaded[slot] = segment->index;
+			segmentEpoch[slot] = segment->epoch;
+		}
+
+		DrawItem floorItem = { segmentModels[slot], nullptr };
+		drawList.push_back(floorItem);
+
+		for (LodInstance& instance : segmentRocks[slot])
+		{
+			instance.lodLevel = rockLod.selectLevel(glm::length(instance.position - camera->getPosition()), instance.lodLevel);
+
+			DrawItem rockItem = { Rocks, &instance };
+			drawList.push_back(rockItem);
+		}
+	}
+}
+
+void GameWorld::createTerrainChunks(std::vector<TerrainChunk>& chunks)
+{
+	terrainChunks = std::move(chunks);
+
+	// A level that has been loaded again replaces every chunk of the old one
+	for (GameModel* chunk : terrainModels)
+		delete chunk;
+	terrainModels.clear();
+
+	// Models are made up front, their buffers come and go with updateTerrainChunks
+	terrainModels.reserve(terrainChunks.size());
+	for (size_t i = 0; i < terrainChunks.size(); i++)
+	{
+		GameModel* chunk = new GameModel();
+		chunk->SetPosition(terrainPosition.x, terrainPosition.y, terrainPosition.z);
+		terrainModels.push_back(chunk);
+	}
+}
+
+void GameWorld::updateTerrainChunks(float eyeZ)
+{
+	for (size_t i = 0; i < terrainChunks.size(); i++)
+	{
+		const TerrainChunk& chunk = terrainChunks[i];
+		GameModel* model = terrainModels[i];
+
+		bool wanted = terrainWindow.contains(chunk.minZ + terrainPosition.z, chunk.maxZ + terrainPosition.z, eyeZ);
+		if (wanted && !model->HasMesh())
+			model->LoadMesh(chunk.mesh);
+		else if (!wanted && model->HasMesh())
+			model->UnloadMesh();
+
+		if (wanted)
+			frameStats.terrainChunksResident++;
+	}
+}
+
+void GameWorld::reportFrameStats()
+{
+	if (!showFrameStats || current - lastStatsTime < 1000)
+		return;
+
+	lastStatsTime = current;
+	std::cout << "Drawn: " << frameStats.modelsDrawn << " models, " << frameStats.trianglesDrawn << " triangles | Culled: "
+			  << frameStats.modelsCulled << " models | Occluded: " << frameStats.modelsOccluded << " models | Terrain: "
+			  << frameStats.terrainChunksResident << "/" << terrainChunks.size() << " chunks | LOD";
+	for (int level = 0; level < rockLod.getLevelCount() && level < MAX_LOD_LEVELS; level++)
+		std::cout << " " << level << ":" << frameStats.lodInstances[level];
+
+	// Fragments shaded per pixel covered - 1.0 means nothing was shaded and then drawn over
+	if (showOverdraw && frameStats.pixelsCovered > 0)
+	{
+		std::cout << " | Overdraw: " << (float)frameStats.fragmentsShaded / frameStats.pixelsCovered
+				  << (depthPrepass ? " (pre-pass" : " (no pre-pass") << (frontToBack ? ", sorted)" : ", unsorted)");
+	}
+	std::cout << std::endl;
+}
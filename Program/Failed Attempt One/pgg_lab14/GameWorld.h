@@ -9,8 +9,9 @@
 
 #pragma once
 
-#include "SDKS/SDL2-2.0.3/include/SDL.h"
+#include <SDL.h>
 #include <iostream>
+#include <unordered_map>
 #include "SDKS/glm/glm.hpp"
 #include "SDKS/glm/gtc/matrix_transform.hpp"
 
@@ -19,6 +20,51 @@
 #include "GameModel.h"
 #include "Controller.h"
 #include "Camera.h"
+#include "Simulation.h"
+#include "SimulationThread.h"
+#include "FrameArena.h"
+#include "AllocationCounter.h"
+#include "AssetArchive.h"
+#include "AssetStreamer.h"
+#include "JobSystem.h"
+#include "FrameStats.h"
+#include "Frustum.h"
+#include "OcclusionBuffer.h"
+#include "OverdrawCounter.h"
+#include "LodGroup.h"
+#include "TerrainWindow.h"
+#include "EndlessTrack.h"
+#include "FileWatcher.h"
+
+/// One thing to draw this frame - instance is null for models that keep their own transform
+struct DrawItem
+{
+	GameModel* model;
+	LodInstance* instance;
+
+	/// World bounds, filled in by the frustum test
+	glm::vec3 boxMin;
+	glm::vec3 boxMax;
+	bool hasBounds;
+
+	/// How far in front of the camera the nearest part is, for sorting
+	float viewDepth;
+};
+
+/// Where a streamed mesh should go once it arrives
+struct StreamingTarget
+{
+	GameModel* model;
+	int lodLevel;
+};
+
+/// A mesh that is loaded again whenever its file changes, and where it goes
+struct WatchedMesh
+{
+	std::string fileName;
+	MeshProcessing processing;
+	StreamingTarget target;
+};
 
 class GameWorld
 {
@@ -36,8 +82,35 @@ public:
 	/// Render 2D images on the screen
 	void render2DImages(SDL_Texture* Image, SDL_Rect Location, bool Update);
 
+	/// Show everything rendered in 2D so far and clear for the next frame
+	void present2DImages();
+
+	/// For drawing 2D straight to the window (a SpriteBatch)
+	SDL_Renderer* getRenderer() const { return renderer; }
+
 	/// Image Convertor
 	SDL_Texture* createImage(std::string filename);
+	SDL_Texture* createImage(const ImageData& image);
+
+	/// Background loading - ask for an image now, collect the texture once it has arrived
+	uint32_t requestImage(std::string filename);
+	SDL_Texture* getStreamedImage(uint32_t ticket);
+
+	/// Same for several images packed into one texture, regions are filled in once it has arrived
+	uint32_t requestAtlas(const std::vector<std::string>& filenames);
+	SDL_Texture* getStreamedAtlas(uint32_t ticket, std::vector<AtlasRegion>& regions);
+
+	/// Ask the AssetStreamer for a mesh, and again whenever its file changes (a null target model is the level)
+	uint32_t streamMesh(const std::string& fileName, AssetPriority priority, MeshProcessing processing, StreamingTarget target);
+
+	/// Upload anything the AssetStreamer has finished since last time
+	void processStreamedAssets();
+
+	/// True while anything asked for hasn't been uploaded yet
+	bool isStreaming() const { return assetStreamer.getPendingCount() > 0; }
+
+	/// Queue a reload for every watched mesh or shader that has been saved since last frame
+	void processFileChanges();
 
 	/// In Game Loop
 	void keyInputHandler();
@@ -45,6 +118,34 @@ public:
 	void updateObjects();
 	void drawObjects();
 
+	/// (Re)make the OverdrawCounter's image the size of what is actually drawn, turning the view off if it can't be
+	void resizeOverdrawCounter();
+
+	/// Put an instance's transform and level back on its shared model and draw it
+	void drawItem(DrawItem& item, DrawPass pass);
+
+	/// Debug check that steady state frames do no heap allocations on the render thread
+	void checkFrameAllocations(size_t allocations);
+
+	/// Place a rock on every obstacle in the level
+	void createRockInstances();
+	void addRockInstances(const ObstacleRow& row, float rowDepth, std::vector<LodInstance>& instances);
+
+	/// Swap the level for a generated track that never ends (call before the game loop starts)
+	void enableEndlessMode(uint32_t seed);
+
+	/// Upload endless segments the generator has finished and add them and their rocks to the draw list
+	void addEndlessSegments(FrameVector<DrawItem>& drawList);
+
+	/// Take the sliced level from the AssetStreamer, one model per chunk
+	void createTerrainChunks(std::vector<TerrainChunk>& chunks);
+
+	/// Upload the chunks near the camera, free the ones it has left behind
+	void updateTerrainChunks(float eyeZ);
+
+	/// Print the frame stats once a second while they are switched on (F1)
+	void reportFrameStats();
+
 private:
 	// SDL Specific Stuffs
 	SDL_Window *window;
@@ -55,10 +156,79 @@ private:
 
 	// Models
 	GameModel* playerRocket;
-	GameModel* Terrain;
-
-	// 3D Camera
+	GameModel* Rocks;
+
+	// The level, sliced along the track - only the chunks near the camera are kept on the GPU
+	std::vector<TerrainChunk> terrainChunks;
+	std::vector<GameModel*> terrainModels;
+	TerrainWindow terrainWindow;
+	glm::vec3 terrainPosition;
+	uint32_t terrainTicket;
+
+	// Endless mode - one model and set of rocks per segment slot, reused as the track recycles them
+	EndlessTrack* endlessTrack;
+	GameModel* segmentModels[EndlessTrack::MAX_SEGMENTS];
+	std::vector<LodInstance> segmentRocks[EndlessTrack::MAX_SEGMENTS];
+	int segmentUploaded[EndlessTrack::MAX_SEGMENTS];
+	uint32_t segmentEpoch[EndlessTrack::MAX_SEGMENTS];
+
+	// Rock dressing for the obstacles and how it picks LOD0 / LOD3
+	std::vector<LodInstance> rockInstances;
+	LodGroup rockLod;
+
+	// Distances for models using the MeshPipeline's generated levels
+	LodGroup generatedLod;
+
+	// 3D Camera and what it can see this frame
 	Camera* camera;
+	Frustum frustum;
+
+	// Depth of the rocks in front, so the ones behind them can be skipped
+	OcclusionBuffer occlusionBuffer;
+	bool occlusionCulling;
+
+	// Draw order and overdraw - nearest first, optionally laying down depth before shading anything
+	bool depthPrepass;
+	bool frontToBack;
+	bool showOverdraw;
+	OverdrawCounter* overdrawCounter;
+
+	// Rocket movement and collisions
+	Simulation simulation;
+
+	// Runs the simulation a frame ahead of the renderer, or steps it here when pipelining is off
+	SimulationThread simulationThread;
+	bool pipelineSimulation;
+	uint16_t shownTries;
+	uint32_t shownFinishes;
+
+	// Memory for the current frame's temporaries (draw lists, contact lists, strings)
+	FrameArena frameArena;
+
+	// Frames that went to the heap after the game had warmed up
+	size_t allocatingFrames;
+
+	// What the last frame drew
+	FrameStats frameStats;
+	bool showFrameStats;
+	uint32_t lastStatsTime;
+
+	// Every cooked asset packed into one mapped file, when the game ships with one (has to outlive the AssetStreamer)
+	AssetArchive assetArchive;
+
+	// Worker threads for anything that splits up (has to be made before the AssetStreamer that uses it)
+	JobSystem jobSystem;
+
+	// Background mesh and image loading
+	AssetStreamer assetStreamer;
+	std::unordered_map<uint32_t, StreamingTarget> streamingModels;
+	std::unordered_map<uint32_t, SDL_Texture*> streamedImages;
+	std::unordered_map<uint32_t, std::vector<AtlasRegion> > streamedAtlasRegions;
+
+	// Hot reloading - files are parsed again on the AssetStreamer and swapped in by processStreamedAssets between frames
+	FileWatcher fileWatcher;
+	std::vector<WatchedMesh> watchedMeshes;
+	std::vector<std::string> changedFiles;
 
 	// Boolean to keep the loop going
 	bool go;
@@ -68,16 +238,9 @@ private:
 
 	// Timings
 	float deltaTime;
-	float spinAmount;
 	uint32_t lastTime;
 	uint32_t current;
 
-	// Rocket Speed
-	float MAX_SPINAMOUNT;
-	float SPIN_ACCELERATION;
-	float MAX_SPEED;
-	float currentSpeed;
-
 	// Window Specific Attributes
 	uint16_t winPosX;
 	uint16_t winPosY;
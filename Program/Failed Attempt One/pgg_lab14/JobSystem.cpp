@@ -0,0 +1,365 @@
+/*!
+*  \brief     JobSystem Class.
+*  \details   This class is to spread small pieces of work over every core, with idle threads stealing work from busy ones
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "JobSystem.h"
+
+#include <algorithm>
+
+// Tries at finding work before an idle worker goes to sleep
+static const int IDLE_SPINS = 64;
+
+// Busy jobs createJob steps over before it helps run some
+static const size_t POOL_HELP_INTERVAL = 16;
+
+// Which JobSystem the calling thread has a slot in, and which one
+static thread_local const JobSystem* threadSystem = nullptr;
+static thread_local int threadSlot = -1;
+
+JobDeque::JobDeque(size_t capacity)
+	: top(0), bottom(0), jobs(new std::atomic<Job*>[capacity])
+{
+	mask = (int64_t)capacity - 1;
+	for (size_t i = 0; i < capacity; i++)
+		jobs[i].store(nullptr, std::memory_order_relaxed);
+}
+
+bool JobDeque::push(Job* job)
+{
+	int64_t currentBottom = bottom.load(std::memory_order_relaxed);
+	int64_t currentTop = top.load(std::memory_order_acquire);
+	if (currentBottom - currentTop > mask)
+		return false;
+
+	jobs[currentBottom & mask].store(job, std::memory_order_relaxed);
+
+	// The job has to be there before a thief can see the new bottom (a release store rather than a fence,
+	// the same on x86 and something race checkers can follow)
+	bottom.store(currentBottom + 1, std::memory_order_release);
+	return true;
+}
+
+Job* JobDeque::pop()
+{
+	int64_t currentBottom = bottom.load(std::memory_order_relaxed) - 1;
+	bottom.store(currentBottom, std::memory_order_relaxed);
+
+	// Thieves must see the smaller bottom before we look at top
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	int64_t currentTop = top.load(std::memory_order_relaxed);
+
+	if (currentTop > currentBottom)
+	{
+		// Empty - put it back
+		bottom.store(currentBottom + 1, std::memory_order_relaxed);
+		return nullptr;
+	}
+
+	Job* job = jobs[currentBottom & mask].load(std::memory_order_relaxed);
+	if (currentTop == currentBottom)
+	{
+		// Last one - race any thief for it
+		if (!top.compare_exchange_strong(currentTop, currentTop + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+			job = nullptr;
+		bottom.store(currentBottom + 1, std::memory_order_relaxed);
+	}
+	return job;
+}
+
+Job* JobDeque::steal()
+{
+	int64_t currentTop = top.load(std::memory_order_acquire);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	int64_t currentBottom = bottom.load(std::memory_order_acquire);
+
+	if (currentTop >= currentBottom)
+		return nullptr;
+
+	Job* job = jobs[currentTop & mask].load(std::memory_order_relaxed);
+
+	// Someone else (the owner or another thief) may have taken it since
+	if (!top.compare_exchange_strong(currentTop, currentTop + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+		return nullptr;
+	return job;
+}
+
+JobSystem::JobSystem(int workerCount)
+	: slotCount(0), running(true), jobsStolen(0), wakeSignal(0), sleepingWorkers(0)
+{
+	if (workerCount < 0)
+		workerCount = std::max(0, (int)std::thread::hardware_concurrency() - 1);
+	workerCount = std::min(workerCount, MAX_THREADS - 2);
+
+	// The thread making it gets a slot first
+	registerThread();
+
+	for (int i = 0; i < workerCount; i++)
+		workers.push_back(std::thread(&JobSystem::workerLoop, this, addSlot()));
+}
+
+JobSystem::~JobSystem()
+{
+	running.store(false, std::memory_order_seq_cst);
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+	}
+	wake.notify_all();
+
+	for (std::thread& worker : workers)
+		worker.join();
+
+	if (threadSystem == this)
+	{
+		threadSystem = nullptr;
+		threadSlot = -1;
+	}
+}
+
+int JobSystem::addSlot()
+{
+	std::lock_guard<std::mutex> lock(slotMutex);
+
+	int slot = slotCount.load(std::memory_order_relaxed);
+	if (slot >= MAX_THREADS)
+		return -1;
+
+	// Build it before anyone can see it
+	slots[slot].reset(new ThreadSlot());
+	slotCount.store(slot + 1, std::memory_order_release);
+	return slot;
+}
+
+bool JobSystem::registerThread()
+{
+	if (isThreadRegistered())
+		return true;
+
+	int slot = addSlot();
+	if (slot < 0)
+		return false;
+
+	threadSystem = this;
+	threadSlot = slot;
+	return true;
+}
+
+bool JobSystem::isThreadRegistered() const
+{
+	return threadSystem == this;
+}
+
+JobSystem::ThreadSlot* JobSystem::currentSlot() const
+{
+	return threadSystem == this ? slots[threadSlot].get() : nullptr;
+}
+
+Job* JobSystem::createJob(JobFunction function, Job* parent)
+{
+	// Each thread makes its jobs from its own ring, so there's nothing to lock
+	// Anything still going (a parallelFor's root, say) is stepped over rather than reused
+	ThreadSlot* slot = currentSlot();
+	uint32_t random = (uint32_t)threadSlot * 2654435761u + 1;
+	Job* job = nullptr;
+	size_t checked = 0;
+	while (!job)
+	{
+		Job* candidate = &slot->jobs[slot->jobsMade++ & (MAX_JOBS_PER_THREAD - 1)];
+		if (candidate->unfinishedJobs.load(std::memory_order_acquire) == 0)
+		{
+			job = candidate;
+			break;
+		}
+
+		// A run of ones still going - help finish some rather than hand out one that's in use
+		// Usually that frees the very one that was run, which saves going all the way round the ring
+		if (++checked % POOL_HELP_INTERVAL == 0)
+		{
+			Job* next = findJob(slot, random);
+			if (next)
+			{
+				execute(next);
+				if (isOwnJob(slot, next) && isFinished(next))
+					job = next;
+			}
+			else if (checked >= MAX_JOBS_PER_THREAD)
+			{
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	job->function = function;
+	job->parent = parent;
+	job->unfinishedJobs.store(1, std::memory_order_relaxed);
+	job->continuationCount.store(0, std::memory_order_relaxed);
+
+	if (parent)
+		parent->unfinishedJobs.fetch_add(1, std::memory_order_relaxed);
+	return job;
+}
+
+bool JobSystem::isOwnJob(const ThreadSlot* slot, const Job* job) const
+{
+	uintptr_t first = (uintptr_t)slot->jobs.get();
+	uintptr_t address = (uintptr_t)job;
+	return address >= first && address < first + MAX_JOBS_PER_THREAD * sizeof(Job);
+}
+
+bool JobSystem::addContinuation(Job* job, Job* continuation)
+{
+	int index = job->continuationCount.fetch_add(1, std::memory_order_relaxed);
+	if (index >= Job::MAX_CONTINUATIONS)
+	{
+		job->continuationCount.fetch_sub(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	job->continuations[index] = continuation;
+	return true;
+}
+
+void JobSystem::run(Job* job)
+{
+	// Not one of our threads, or no room left - do it now rather than lose it
+	ThreadSlot* slot = currentSlot();
+	if (!slot || !slot->deque.push(job))
+	{
+		execute(job);
+		return;
+	}
+
+	wakeWorkers();
+}
+
+void JobSystem::wait(const Job* job)
+{
+	ThreadSlot* slot = currentSlot();
+	uint32_t random = (uint32_t)threadSlot * 2654435761u + 1;
+
+	// Help out rather than sit there
+	while (!isFinished(job))
+	{
+		Job* next = findJob(slot, random);
+		if (next)
+			execute(next);
+		else
+			std::this_thread::yield();
+	}
+}
+
+void JobSystem::wakeWorkers()
+{
+	wakeSignal.fetch_add(1, std::memory_order_seq_cst);
+
+	// Only take the lock if somebody is actually asleep
+	if (sleepingWorkers.load(std::memory_order_seq_cst) > 0)
+	{
+		{
+			std::lock_guard<std::mutex> lock(sleepMutex);
+		}
+		wake.notify_one();
+	}
+}
+
+Job* JobSystem::findJob(ThreadSlot* slot, uint32_t& random)
+{
+	// Own work first, newest first as it's most likely still in the cache
+	Job* job = slot->deque.pop();
+	if (job)
+		return job;
+
+	// Then steal the oldest job of somebody else, starting somewhere random so thieves spread out
+	int count = slotCount.load(std::memory_order_acquire);
+	random = random * 1664525u + 1013904223u;
+	int start = (int)((random >> 16) % (uint32_t)count);
+	for (int i = 0; i < count; i++)
+	{
+		ThreadSlot* victim = slots[(start + i) % count].get();
+		if (victim == slot)
+			continue;
+
+		job = victim->deque.steal();
+		if (job)
+		{
+			jobsStolen.fetch_add(1, std::memory_order_relaxed);
+			return job;
+		}
+	}
+	return nullptr;
+}
+
+void JobSystem::execute(Job* job)
+{
+	// No function is fine - the job is just there to wait on its children
+	if (job->function)
+		job->function(*job, job->data);
+	finish(job);
+}
+
+void JobSystem::finish(Job* job)
+{
+	// Everything needed is read first - once the count reaches zero the job can be reused straight away
+	Job* parent = job->parent;
+	Job* continuations[Job::MAX_CONTINUATIONS];
+	int continuationCount = job->continuationCount.load(std::memory_order_acquire);
+	if (continuationCount > Job::MAX_CONTINUATIONS)
+		continuationCount = Job::MAX_CONTINUATIONS;
+	for (int i = 0; i < continuationCount; i++)
+		continuations[i] = job->continuations[i];
+
+	if (job->unfinishedJobs.fetch_sub(1, std::memory_order_acq_rel) != 1)
+		return;
+
+	// Done, and so are all its children - start whatever was waiting on it, then tell the parent
+	for (int i = 0; i < continuationCount; i++)
+		run(continuations[i]);
+
+	if (parent)
+		finish(parent);
+}
+
+void JobSystem::workerLoop(int slot)
+{
+	threadSystem = this;
+	threadSlot = slot;
+
+	ThreadSlot* ownSlot = slots[slot].get();
+	uint32_t random = (uint32_t)slot * 2654435761u + 1;
+	int idleSpins = 0;
+
+	while (running.load(std::memory_order_acquire))
+	{
+		uint32_t seenSignal = wakeSignal.load(std::memory_order_seq_cst);
+
+		Job* job = findJob(ownSlot, random);
+		if (job)
+		{
+			execute(job);
+			idleSpins = 0;
+			continue;
+		}
+
+		if (++idleSpins < IDLE_SPINS)
+		{
+			std::this_thread::yield();
+			continue;
+		}
+
+		// Nothing anywhere - sleep until a job is run
+		sleepingWorkers.fetch_add(1, std::memory_order_seq_cst);
+		{
+			std::unique_lock<std::mutex> lock(sleepMutex);
+			wake.wait(lock, [&]
+			{
+				return !running.load(std::memory_order_acquire) || wakeSignal.load(std::memory_order_seq_cst) != seenSignal;
+			});
+		}
+		sleepingWorkers.fetch_sub(1, std::memory_order_seq_cst);
+		idleSpins = 0;
+	}
+}
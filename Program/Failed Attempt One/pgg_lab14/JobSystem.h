@@ -0,0 +1,216 @@
+/*!
+*  \brief     JobSystem Class.
+*  \details   This class is to spread small pieces of work over every core, with idle threads stealing work from busy ones
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <stdint.h>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+struct Job;
+
+/// What a job runs - data is the copy made when the job was created
+typedef void (*JobFunction)(Job& job, const void* data);
+
+/// One piece of work, made with JobSystem::createJob
+/// Its memory can be handed out again as soon as it has finished, so don't keep it after that
+struct alignas(64) Job
+{
+	static const int MAX_CONTINUATIONS = 4;
+	static const size_t DATA_SIZE = 64;
+
+	/// Starts out finished, so the pool can hand it out
+	Job() : function(nullptr), parent(nullptr), unfinishedJobs(0), continuationCount(0) {}
+
+	JobFunction function;
+	Job* parent;
+
+	/// Itself plus any children that haven't finished yet
+	std::atomic<int> unfinishedJobs;
+
+	/// Jobs to start once this one (and its children) are done
+	std::atomic<int> continuationCount;
+	Job* continuations[MAX_CONTINUATIONS];
+
+	alignas(16) unsigned char data[DATA_SIZE];
+};
+
+/// Fixed size Chase-Lev deque - the owner pushes and pops at the bottom, any other thread steals from the top
+class JobDeque
+{
+public:
+	/// Capacity must be a power of two
+	explicit JobDeque(size_t capacity);
+
+	/// Owner only - false if it is full
+	bool push(Job* job);
+
+	/// Owner only - newest job, null if there isn't one
+	Job* pop();
+
+	/// Any thread - oldest job, null if there isn't one (or another thread got it first)
+	Job* steal();
+
+private:
+	alignas(64) std::atomic<int64_t> top;
+	alignas(64) std::atomic<int64_t> bottom;
+	std::unique_ptr<std::atomic<Job*>[]> jobs;
+	int64_t mask;
+};
+
+class JobSystem
+{
+public:
+	/// Jobs each thread can have on the go, and the most threads that can use one JobSystem
+	static const size_t MAX_JOBS_PER_THREAD = 4096;
+	static const int MAX_THREADS = 32;
+
+	/// Constructor starts workerCount threads (-1 for one per core, less the thread making it)
+	/// The thread making it can use it straight away
+	explicit JobSystem(int workerCount = -1);
+	~JobSystem();
+
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+
+	/// Let the calling thread make, run and wait for jobs too (false if there are already MAX_THREADS)
+	bool registerThread();
+	bool isThreadRegistered() const;
+
+	/// Make a job, it doesn't start until run - a parent isn't finished until all its children are
+	/// function can be null for a job that only groups its children together
+	/// createJob, run and wait are for registered threads and jobs only
+	Job* createJob(JobFunction function, Job* parent = nullptr);
+
+	/// Same, with a copy of data for the job to use (it has to fit in Job::DATA_SIZE)
+	template <typename T>
+	Job* createJob(JobFunction function, const T& data, Job* parent = nullptr)
+	{
+		static_assert(sizeof(T) <= Job::DATA_SIZE, "Job data is too big");
+		static_assert(std::is_trivially_copyable<T>::value, "Job data is copied with memcpy");
+
+		Job* job = createJob(function, parent);
+		memcpy(job->data, &data, sizeof(T));
+		return job;
+	}
+
+	/// Start continuation once job has finished - add them all before job is run
+	bool addContinuation(Job* job, Job* continuation);
+
+	/// Queue a job on the calling thread, any idle thread may steal it
+	void run(Job* job);
+
+	/// Do other jobs until this one (and its children) have finished
+	void wait(const Job* job);
+	bool isFinished(const Job* job) const { return job->unfinishedJobs.load(std::memory_order_acquire) == 0; }
+
+	/// Call function(begin, end) over [0, count) in ranges of at most batchSize, returns once they've all been done
+	template <typename Function>
+	void parallelFor(size_t count, size_t batchSize, const Function& function);
+
+	/// Getters
+	int getWorkerCount() const { return (int)workers.size(); }
+	size_t getJobsStolen() const { return jobsStolen.load(std::memory_order_relaxed); }
+
+private:
+	/// A deque and a pool of jobs for each thread that uses the system
+	struct ThreadSlot
+	{
+		ThreadSlot() : deque(MAX_JOBS_PER_THREAD), jobs(new Job[MAX_JOBS_PER_THREAD]), jobsMade(0) {}
+
+		JobDeque deque;
+		std::unique_ptr<Job[]> jobs;
+		size_t jobsMade;
+	};
+
+	template <typename Function>
+	struct ParallelForRange
+	{
+		JobSystem* system;
+		const Function* function;
+		size_t begin;
+		size_t end;
+		size_t batchSize;
+	};
+
+	template <typename Function>
+	static void parallelForJob(Job& job, const void* data);
+
+	void workerLoop(int slot);
+	int addSlot();
+	ThreadSlot* currentSlot() const;
+	bool isOwnJob(const ThreadSlot* slot, const Job* job) const;
+	Job* findJob(ThreadSlot* slot, uint32_t& random);
+	void execute(Job* job);
+	void finish(Job* job);
+	void wakeWorkers();
+
+	std::unique_ptr<ThreadSlot> slots[MAX_THREADS];
+	std::atomic<int> slotCount;
+	std::mutex slotMutex;
+
+	std::vector<std::thread> workers;
+	std::atomic<bool> running;
+	std::atomic<size_t> jobsStolen;
+
+	// Workers with nothing to do sleep here, the lock is only taken when one of them is asleep
+	std::atomic<uint32_t> wakeSignal;
+	std::atomic<int> sleepingWorkers;
+	std::mutex sleepMutex;
+	std::condition_variable wake;
+};
+
+template <typename Function>
+void JobSystem::parallelFor(size_t count, size_t batchSize, const Function& function)
+{
+	if (count == 0)
+		return;
+
+	if (batchSize == 0)
+		batchSize = 1;
+
+	// Small enough, or nothing to share it with - just do it here
+	if (count <= batchSize || workers.empty() || !isThreadRegistered())
+	{
+		function((size_t)0, count);
+		return;
+	}
+
+	ParallelForRange<Function> range = { this, &function, 0, count, batchSize };
+	Job* root = createJob(&JobSystem::parallelForJob<Function>, range);
+	run(root);
+	wait(root);
+}
+
+template <typename Function>
+void JobSystem::parallelForJob(Job& job, const void* data)
+{
+	ParallelForRange<Function> range = *(const ParallelForRange<Function>*)data;
+
+	// Keep giving away the top half so thieves get big pieces, then do what's left
+	while (range.end - range.begin > range.batchSize)
+	{
+		size_t middle = range.begin + (range.end - range.begin) / 2;
+
+		ParallelForRange<Function> upper = range;
+		upper.begin = middle;
+		range.system->run(range.system->createJob(&JobSystem::parallelForJob<Function>, upper, &job));
+
+		range.end = middle;
+	}
+
+	(*range.function)(range.begin, range.end);
+}
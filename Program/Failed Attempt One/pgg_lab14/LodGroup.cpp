@@ -0,0 +1,50 @@
+/*!
+*  \brief     LodGroup Class.
+*  \details   This class is to pick which level of detail an instance should draw from how far away it is
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "LodGroup.h"
+
+LodGroup::LodGroup()
+{
+	hysteresis = 0.0f;
+}
+
+LodGroup::~LodGroup()
+{
+
+}
+
+void LodGroup::addLevel(float maxDistance)
+{
+	thresholds.push_back(maxDistance);
+}
+
+int LodGroup::selectLevel(float distance, int currentLevel) const
+{
+	int lastLevel = (int)thresholds.size() - 1;
+	if (lastLevel <= 0)
+		return 0;
+
+	// New instances just take whatever band they are in
+	if (currentLevel < 0 || currentLevel > lastLevel)
+	{
+		int level = 0;
+		while (level < lastLevel && distance >= thresholds[level])
+			level++;
+		return level;
+	}
+
+	// Otherwise only move once it's well past the edge of the band
+	int level = currentLevel;
+	while (level < lastLevel && distance >= thresholds[level] * (1.0f + hysteresis))
+		level++;
+	while (level > 0 && distance < thresholds[level - 1] * (1.0f - hysteresis))
+		level--;
+
+	return level;
+}
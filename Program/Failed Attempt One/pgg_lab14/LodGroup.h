@@ -0,0 +1,52 @@
+/*!
+*  \brief     LodGroup Class.
+*  \details   This class is to pick which level of detail an instance should draw from how far away it is
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#pragma once
+
+#include <vector>
+#include "SDKS/glm/glm.hpp"
+
+/// One copy of a model placed in the world, remembers the level it drew last frame
+struct LodInstance
+{
+	glm::vec3 position;
+	glm::vec3 scale;
+	int lodLevel;
+};
+
+class LodGroup
+{
+public:
+	/// Constructor and Destructor
+	LodGroup();
+	~LodGroup();
+
+	/// Add the next coarser level, used from the previous level's distance out to maxDistance
+	/// The last level added is used for everything further away than that
+	void addLevel(float maxDistance);
+
+	/// Fraction of a threshold an instance has to move past before it switches (0 = pop straight away)
+	void setHysteresis(float fraction) { hysteresis = fraction; }
+
+	/// Pick a level for something this far from the camera
+	/// Pass the level it drew last frame (or -1 for a new instance) so hysteresis can stop it flickering
+	int selectLevel(float distance, int currentLevel = -1) const;
+
+	/// Getters
+	int getLevelCount() const { return (int)thresholds.size(); }
+	float getThreshold(int level) const { return thresholds[level]; }
+	float getHysteresis() const { return hysteresis; }
+
+private:
+	// Distance each level stops being used at
+	std::vector<float> thresholds;
+
+	// How far past a threshold to go before switching
+	float hysteresis;
+};
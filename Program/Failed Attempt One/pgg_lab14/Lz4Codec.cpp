@@ -0,0 +1,189 @@
+/*!
+*  \brief     Lz4Codec Class.
+*  \details   This class is to compress and decompress blocks in the LZ4 block format, fast enough to unpack while loading
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "Lz4Codec.h"
+
+#include <cstring>
+
+// Format rules - matches are at least 4 bytes, the last 5 bytes are always literals
+// and no match starts in the last 12 (so a decoder can copy 8 bytes at a time without checking)
+static const size_t MIN_MATCH = 4;
+static const size_t LAST_LITERALS = 5;
+static const size_t MATCH_FIND_LIMIT = 12;
+static const size_t MAX_OFFSET = 65535;
+
+// 4096 entries of where each 4 byte sequence was last seen
+static const int HASH_BITS = 12;
+
+static uint32_t Read32(const uint8_t* data)
+{
+	uint32_t value;
+	memcpy(&value, data, sizeof(value));
+	return value;
+}
+
+static uint32_t Hash(uint32_t sequence)
+{
+	return (sequence * 2654435761u) >> (32 - HASH_BITS);
+}
+
+// 15 goes in the token, the rest as 255s and whatever is left over
+static void WriteLength(std::vector<uint8_t>& out, size_t length)
+{
+	for (; length >= 255; length -= 255)
+		out.push_back(255);
+	out.push_back((uint8_t)length);
+}
+
+static void WriteSequence(std::vector<uint8_t>& out, const uint8_t* literals, size_t literalCount, size_t offset, size_t matchLength)
+{
+	size_t matchCode = matchLength ? matchLength - MIN_MATCH : 0;
+	uint8_t token = (uint8_t)(((literalCount < 15 ? literalCount : 15) << 4) | (matchCode < 15 ? matchCode : 15));
+	out.push_back(token);
+	if (literalCount >= 15)
+		WriteLength(out, literalCount - 15);
+	out.insert(out.end(), literals, literals + literalCount);
+
+	// The last sequence stops after its literals
+	if (matchLength == 0)
+		return;
+
+	out.push_back((uint8_t)(offset & 0xFF));
+	out.push_back((uint8_t)(offset >> 8));
+	if (matchCode >= 15)
+		WriteLength(out, matchCode - 15);
+}
+
+void Lz4Codec::Compress(const uint8_t* data, size_t size, std::vector<uint8_t>& compressed)
+{
+	compressed.clear();
+	compressed.reserve(GetMaxCompressedSize(size));
+
+	size_t anchor = 0;
+	if (size > MATCH_FIND_LIMIT)
+	{
+		// Positions plus one, so zero means nothing seen yet
+		std::vector<uint32_t> table((size_t)1 << HASH_BITS, 0);
+		size_t limit = size - MATCH_FIND_LIMIT;
+		size_t position = 0;
+		size_t misses = 0;
+
+		while (position < limit)
+		{
+			uint32_t sequence = Read32(data + position);
+			uint32_t hash = Hash(sequence);
+			size_t candidate = table[hash];
+			table[hash] = (uint32_t)(position + 1);
+
+			if (candidate == 0 || position + 1 - candidate > MAX_OFFSET || Read32(data + candidate - 1) != sequence)
+			{
+				// Skip ahead faster the longer it goes without a match, so data that won't compress is quick to get through
+				position += 1 + (misses++ >> 6);
+				continue;
+			}
+
+			size_t match = candidate - 1;
+			size_t length = MIN_MATCH;
+			while (position + length < size - LAST_LITERALS && data[match + length] == data[position + length])
+				length++;
+
+			// Grow it backwards over literals that match too
+			while (position > anchor && match > 0 && data[position - 1] == data[match - 1])
+			{
+				position--;
+				match--;
+				length++;
+			}
+
+			WriteSequence(compressed, data + anchor, position - anchor, position - match, length);
+			position += length;
+			anchor = position;
+			misses = 0;
+
+			// Remember a spot inside the match, so the next one has something to find
+			if (position - 2 < limit)
+				table[Hash(Read32(data + position - 2))] = (uint32_t)(position - 1);
+		}
+	}
+
+	WriteSequence(compressed, data + anchor, size - anchor, 0, 0);
+}
+
+bool Lz4Codec::Decompress(const uint8_t* block, size_t blockSize, uint8_t* output, size_t outputSize)
+{
+	const uint8_t* in = block;
+	const uint8_t* inEnd = block + blockSize;
+	uint8_t* out = output;
+	uint8_t* outEnd = output + outputSize;
+
+	while (in < inEnd)
+	{
+		uint8_t token = *in++;
+
+		size_t literalCount = token >> 4;
+		if (literalCount == 15)
+		{
+			uint8_t extra;
+			do
+			{
+				if (in >= inEnd)
+					return false;
+				extra = *in++;
+				literalCount += extra;
+			} while (extra == 255);
+		}
+
+		if (literalCount > (size_t)(inEnd - in) || literalCount > (size_t)(outEnd - out))
+			return false;
+		memcpy(out, in, literalCount);
+		in += literalCount;
+		out += literalCount;
+
+		// Literals with nothing after them end the block
+		if (in == inEnd)
+			break;
+
+		if (inEnd - in < 2)
+			return false;
+		size_t offset = (size_t)in[0] | ((size_t)in[1] << 8);
+		in += 2;
+		if (offset == 0 || offset > (size_t)(out - output))
+			return false;
+
+		size_t matchLength = token & 15;
+		if (matchLength == 15)
+		{
+			uint8_t extra;
+			do
+			{
+				if (in >= inEnd)
+					return false;
+				extra = *in++;
+				matchLength += extra;
+			} while (extra == 255);
+		}
+		matchLength += MIN_MATCH;
+		if (matchLength > (size_t)(outEnd - out))
+			return false;
+
+		// Overlapping copies repeat the bytes just written (an offset of 1 is a run), so they go a byte at a time
+		const uint8_t* match = out - offset;
+		if (offset >= matchLength)
+		{
+			memcpy(out, match, matchLength);
+			out += matchLength;
+		}
+		else
+		{
+			for (size_t i = 0; i < matchLength; i++)
+				*out++ = match[i];
+		}
+	}
+	return out == outEnd;
+}
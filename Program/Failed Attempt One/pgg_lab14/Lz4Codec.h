@@ -0,0 +1,29 @@
+/*!
+*  \brief     Lz4Codec Class.
+*  \details   This class is to compress and decompress blocks in the LZ4 block format, fast enough to unpack while loading
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+/// A block is a run of sequences - a token (literal count, match length), the literals, then a 16 bit offset back
+/// to copy the match from. The last sequence is literals only. Anything a real LZ4 decoder unpacks, this unpacks too
+class Lz4Codec
+{
+public:
+	/// Most a block of size bytes can grow to if none of it compresses
+	static size_t GetMaxCompressedSize(size_t size) { return size + size / 255 + 16; }
+
+	/// Replace compressed with the block for [data, data + size)
+	static void Compress(const uint8_t* data, size_t size, std::vector<uint8_t>& compressed);
+
+	/// Unpack a block into exactly outputSize bytes - false if it is damaged or doesn't come out that size
+	static bool Decompress(const uint8_t* block, size_t blockSize, uint8_t* output, size_t outputSize);
+};
@@ -1,11 +1,27 @@
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
 #include "GameWorld.h"
 #include "Menu.h"
 
-int main(int, char**)
+int main(int argc, char** argv)
 {
 	// Initialise Menu
 	Menu* gameMenu = new Menu();
 
+	// "--endless" plays a generated track, add a seed after it to play the same one again
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--endless") == 0)
+		{
+			uint32_t seed = (uint32_t)time(nullptr);
+			if (i + 1 < argc && argv[i + 1][0] >= '0' && argv[i + 1][0] <= '9')
+				seed = (uint32_t)strtoul(argv[++i], nullptr, 10);
+
+			gameMenu->enableEndlessMode(seed);
+		}
+	}
+
 	// Go to the Menu Input Handler
 	gameMenu->inputHandler();
 
@@ -0,0 +1,108 @@
+/*!
+*  \brief     MappedFile Class.
+*  \details   This class is to map a whole file into memory read only, so it can be used in place without reading it in
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "MappedFile.h"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile()
+{
+	data = nullptr;
+	size = 0;
+	fileHandle = nullptr;
+	mappingHandle = nullptr;
+}
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+bool MappedFile::Open(const std::string& fileName)
+{
+	Close();
+
+#if defined(_WIN32)
+	HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+	{
+		CloseHandle(file);
+		return false;
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+	if (!view)
+	{
+		if (mapping)
+			CloseHandle(mapping);
+		CloseHandle(file);
+		return false;
+	}
+
+	fileHandle = file;
+	mappingHandle = mapping;
+	data = (const uint8_t*)view;
+	size = (size_t)fileSize.QuadPart;
+#else
+	int file = open(fileName.c_str(), O_RDONLY);
+	if (file < 0)
+		return false;
+
+	struct stat status;
+	if (fstat(file, &status) != 0 || status.st_size == 0)
+	{
+		close(file);
+		return false;
+	}
+
+	void* view = mmap(nullptr, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+
+	// The mapping keeps the file alive on its own
+	close(file);
+	if (view == MAP_FAILED)
+		return false;
+
+	data = (const uint8_t*)view;
+	size = (size_t)status.st_size;
+#endif
+	return true;
+}
+
+void MappedFile::Close()
+{
+	if (!data)
+		return;
+
+#if defined(_WIN32)
+	UnmapViewOfFile(data);
+	CloseHandle((HANDLE)mappingHandle);
+	CloseHandle((HANDLE)fileHandle);
+#else
+	munmap((void*)data, size);
+#endif
+
+	data = nullptr;
+	size = 0;
+	fileHandle = nullptr;
+	mappingHandle = nullptr;
+}
@@ -0,0 +1,43 @@
+/*!
+*  \brief     MappedFile Class.
+*  \details   This class is to map a whole file into memory read only, so it can be used in place without reading it in
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <stdint.h>
+#include <string>
+
+class MappedFile
+{
+public:
+	///ctor / dtor (unmaps the file)
+	MappedFile();
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	/// Map the file, false if it can't be opened or is empty
+	bool Open(const std::string& fileName);
+	void Close();
+
+	bool IsOpen() const { return data != nullptr; }
+
+	/// The file's bytes, only valid until Close
+	const uint8_t* GetData() const { return data; }
+	size_t GetSize() const { return size; }
+
+private:
+	const uint8_t* data;
+	size_t size;
+
+	// Platform handles (the file and, on Windows, its mapping)
+	void* fileHandle;
+	void* mappingHandle;
+};
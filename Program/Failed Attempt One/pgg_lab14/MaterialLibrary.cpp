@@ -0,0 +1,151 @@
+/*!
+*  \brief     MaterialLibrary Class.
+*  \details   This class is to read the materials an OBJ uses out of its MTL files
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "MaterialLibrary.h"
+
+#include <cstdio>
+#include <mutex>
+#include <unordered_set>
+#include "MappedFile.h"
+#include "TextParser.h"
+
+// Last word on the line - map statements can have options (-bm 1.0 ...) before the file name
+static std::string ReadMapFileName(const char* text, const char* end)
+{
+	const char* nameStart = text;
+	const char* nameEnd = text;
+	while (true)
+	{
+		text = TextParser::SkipSpaces(text, end);
+		if (text == end || TextParser::WordEnd(text, end) == text)
+			break;
+		nameStart = text;
+		nameEnd = text = TextParser::WordEnd(text, end);
+	}
+	return std::string(nameStart, nameEnd);
+}
+
+// Every mesh that names a missing MTL would say so on every load (and meshes load on several threads, from copies
+// in other folders), so once for each name
+static void ReportMissingLibrary(const std::string& mtlFileName)
+{
+	static std::mutex reportedMutex;
+	static std::unordered_set<std::string> reported;
+
+	std::string name = mtlFileName.substr(MaterialLibrary::GetDirectory(mtlFileName).size());
+	std::lock_guard<std::mutex> lock(reportedMutex);
+	if (reported.insert(name).second)
+		printf("Could not open mtl file: %s\n", mtlFileName.c_str());
+}
+
+static glm::vec3 ReadColour(const char* text, const char* end)
+{
+	glm::vec3 colour(0.0f);
+	text = TextParser::ParseFloat(text, end, colour.r);
+	text = TextParser::ParseFloat(text, end, colour.g);
+	TextParser::ParseFloat(text, end, colour.b);
+	return colour;
+}
+
+MaterialLibrary::MaterialLibrary()
+{
+
+}
+
+MaterialLibrary::~MaterialLibrary()
+{
+
+}
+
+std::string MaterialLibrary::GetDirectory(const std::string& fileName)
+{
+	size_t slash = fileName.find_last_of("/\\");
+	return slash == std::string::npos ? std::string() : fileName.substr(0, slash + 1);
+}
+
+bool MaterialLibrary::Load(const std::string& mtlFileName)
+{
+	MappedFile mtlFile;
+	if (!mtlFile.Open(mtlFileName))
+	{
+		ReportMissingLibrary(mtlFileName);
+		return false;
+	}
+
+	// Images are named relative to the MTL
+	std::string directory = GetDirectory(mtlFileName);
+	Material* current = nullptr;
+
+	const char* text = (const char*)mtlFile.GetData();
+	const char* end = text + mtlFile.GetSize();
+	while (text < end)
+	{
+		const char* lineEnd = TextParser::LineEnd(text, end);
+		const char* keyword = TextParser::SkipSpaces(text, lineEnd);
+		const char* keywordEnd = TextParser::WordEnd(keyword, lineEnd);
+		const char* rest = TextParser::SkipSpaces(keywordEnd, lineEnd);
+		text = TextParser::NextLine(lineEnd, end);
+
+		if (TextParser::IsWord(keyword, keywordEnd, "newmtl"))
+		{
+			Material material;
+			material.name.assign(rest, TextParser::WordEnd(rest, lineEnd));
+			materials.push_back(material);
+			current = &materials.back();
+			continue;
+		}
+
+		// Anything before the first newmtl doesn't belong to a material (comments included)
+		if (!current)
+			continue;
+
+		if (TextParser::IsWord(keyword, keywordEnd, "Ka"))
+			current->ambient = ReadColour(rest, lineEnd);
+		else if (TextParser::IsWord(keyword, keywordEnd, "Kd"))
+			current->diffuse = ReadColour(rest, lineEnd);
+		else if (TextParser::IsWord(keyword, keywordEnd, "Ks"))
+			current->specular = ReadColour(rest, lineEnd);
+		else if (TextParser::IsWord(keyword, keywordEnd, "Ke"))
+			current->emissive = ReadColour(rest, lineEnd);
+		else if (TextParser::IsWord(keyword, keywordEnd, "Ns"))
+			TextParser::ParseFloat(rest, lineEnd, current->shininess);
+		else if (TextParser::IsWord(keyword, keywordEnd, "d"))
+			TextParser::ParseFloat(rest, lineEnd, current->opacity);
+		else if (TextParser::IsWord(keyword, keywordEnd, "Tr"))
+		{
+			float transparency = 0.0f;
+			TextParser::ParseFloat(rest, lineEnd, transparency);
+			current->opacity = 1.0f - transparency;
+		}
+		else if (TextParser::IsWord(keyword, keywordEnd, "map_Kd"))
+		{
+			std::string fileName = ReadMapFileName(rest, lineEnd);
+			if (!fileName.empty())
+				current->diffuseMap = directory + fileName;
+		}
+		else if (TextParser::IsWord(keyword, keywordEnd, "map_Bump") || TextParser::IsWord(keyword, keywordEnd, "map_bump") ||
+				 TextParser::IsWord(keyword, keywordEnd, "bump") || TextParser::IsWord(keyword, keywordEnd, "norm"))
+		{
+			std::string fileName = ReadMapFileName(rest, lineEnd);
+			if (!fileName.empty())
+				current->normalMap = directory + fileName;
+		}
+	}
+	return true;
+}
+
+int MaterialLibrary::Find(const std::string& name) const
+{
+	for (size_t i = 0; i < materials.size(); i++)
+	{
+		if (materials[i].name == name)
+			return (int)i;
+	}
+	return -1;
+}
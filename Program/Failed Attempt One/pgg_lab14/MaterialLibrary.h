@@ -0,0 +1,56 @@
+/*!
+*  \brief     MaterialLibrary Class.
+*  \details   This class is to read the materials an OBJ uses out of its MTL files
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include "SDKS/glm/glm.hpp"
+
+/// One newmtl block - anything the file leaves out keeps the MTL default
+struct Material
+{
+	std::string name;
+
+	glm::vec3 ambient;		///< Ka
+	glm::vec3 diffuse;		///< Kd
+	glm::vec3 specular;		///< Ks
+	glm::vec3 emissive;		///< Ke
+	float shininess;		///< Ns
+	float opacity;			///< d (or 1 - Tr)
+
+	/// Image files, already relative to the working directory (empty if there isn't one)
+	std::string diffuseMap;	///< map_Kd
+	std::string normalMap;	///< map_Bump / bump / norm
+
+	Material() : ambient(0.2f), diffuse(0.8f), specular(1.0f), emissive(0.0f), shininess(0.0f), opacity(1.0f) {}
+};
+
+class MaterialLibrary
+{
+public:
+	///ctor / dtor
+	MaterialLibrary();
+	~MaterialLibrary();
+
+	/// Read every material in an MTL file, adding them to any already loaded - false if it couldn't be opened
+	bool Load(const std::string& mtlFileName);
+
+	/// Index of a material by name, -1 if there isn't one
+	int Find(const std::string& name) const;
+
+	/// Get the materials (move them out to keep them after the library is gone)
+	std::vector<Material>& GetMaterials() { return materials; }
+
+	/// Folder part of a path, with its slash ("Models/Rock.obj" -> "Models/", "Rock.obj" -> "")
+	static std::string GetDirectory(const std::string& fileName);
+
+private:
+	std::vector<Material> materials;
+};
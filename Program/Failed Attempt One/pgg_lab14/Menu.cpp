@@ -9,24 +9,35 @@
 
 #include "Menu.h"
 
+// How long the menu sleeps waiting for input - long when idle, short while anything is still streaming in
+static const int MENU_IDLE_WAIT_MS = 1000;
+static const int MENU_LOADING_WAIT_MS = 16;
+
 Menu::Menu()
 {
 	// Make New World and Setup Images
 	world = new GameWorld();
+	spriteBatch = new SpriteBatch(world->getRenderer());
 	setupImages();
 }
 
 void Menu::setupImages()
 {
-	// Load images in
-	Background = world->createImage("MenuBackground.bmp");
-	Title = world->createImage("DestinationOrigin.bmp");
-	ButtonSelected = world->createImage("NewGameSelected.bmp");
-	ButtonUnselected = world->createImage("NewGameUnselected.bmp");
-	Button2Selected = world->createImage("OptionsSelected.bmp");
-	Button2Unselected = world->createImage("OptionsUnselected.bmp");
-	Button3Selected = world->createImage("ExitSelected.bmp");
-	Button3Unselected = world->createImage("ExitUnselected.bmp");
+	// Load all of the images in the background as one atlas, the menu shows once it has arrived
+	// (same order as MenuImage)
+	std::vector<std::string> filenames;
+	filenames.push_back("MenuBackground.bmp");
+	filenames.push_back("DestinationOrigin.bmp");
+	filenames.push_back("NewGameSelected.bmp");
+	filenames.push_back("NewGameUnselected.bmp");
+	filenames.push_back("OptionsSelected.bmp");
+	filenames.push_back("OptionsUnselected.bmp");
+	filenames.push_back("ExitSelected.bmp");
+	filenames.push_back("ExitUnselected.bmp");
+
+	menuAtlas = nullptr;
+	menuDirty = true;
+	atlasTicket = world->requestAtlas(filenames);
 
 	// Initialise the positions of the images
 	// Name 			   |X||Y||W||Z|
@@ -39,9 +50,32 @@ void Menu::setupImages()
 
 Menu::~Menu()
 {
+	delete spriteBatch;
 	delete world;
 }
 
+bool Menu::updateStreamedImages()
+{
+	// Upload whatever the streamer has finished - the level and models carry on loading behind the menu,
+	// and the streamer can only hold so many finished ones before it has to wait for them to be taken
+	world->processStreamedAssets();
+	if (menuAtlas)
+		return false;
+
+	menuAtlas = world->getStreamedAtlas(atlasTicket, menuRegions);
+
+	// Something didn't load - leave the menu blank rather than draw the wrong bits of the atlas
+	if (menuAtlas && menuRegions.size() != (size_t)MenuImage::Count)
+		menuRegions.clear();
+	return menuAtlas != nullptr;
+}
+
+void Menu::drawImage(MenuImage image, const SDL_Rect& position)
+{
+	if ((size_t)image < menuRegions.size())
+		spriteBatch->draw(menuRegions[(size_t)image], position.x, position.y);
+}
+
 void Menu::limitMenuSelection(int8_t min, int8_t max)
 {
 	// Limit the menu selection in between a certain range.
@@ -53,92 +87,100 @@ void Menu::limitMenuSelection(int8_t min, int8_t max)
 
 void Menu::inputHandler()
 {
+	// Draw it once to start with, after that only when something changes
+	menuDirty = true;
+
 	while (stateSelector == 0)
 	{
-		// Ensures that the player will not go out of range
-		limitMenuSelection(1, 3);
-		
-		// Render the Menu
-		//					 |Image Name|      |Position of Image| |Clear Screen|
-		world->render2DImages(Background,		BackgroundPosition, false);
-		world->render2DImages(Title,			TitlePosition,		false);
-		changetoSelectedImage();
-		
-
-	
-		// Poll the incoming event
-		while (SDL_PollEvent(&incomingEvent))
+		// Swap in any images that have finished loading
+		if (updateStreamedImages())
+			menuDirty = true;
+
+		if (menuDirty)
+		{
+			// Render the Menu - every image comes from the atlas, so it all goes in one batch
+			spriteBatch->begin(menuAtlas);
+			drawImage(MenuImage::Background, BackgroundPosition);
+			drawImage(MenuImage::Title, TitlePosition);
+			changetoSelectedImage();
+			spriteBatch->end();
+			world->present2DImages();
+			menuDirty = false;
+		}
+
+		// Sleep until there's input - while anything is loading, wake up now and then to collect it
+		int timeout = (menuAtlas && !world->isStreaming()) ? MENU_IDLE_WAIT_MS : MENU_LOADING_WAIT_MS;
+		if (!SDL_WaitEventTimeout(&incomingEvent, timeout))
+			continue;
+
+		// Deal with that one and anything else that came in with it
+		do
 		{
-			switch (incomingEvent.type)
-			{
-			// Quit the game safely
-			case SDL_QUIT:
-				stateSelector = 3;
-				break;
-
-			// When the Key is down
-			case SDL_KEYDOWN:
-				switch (incomingEvent.key.keysym.sym)
-				{
-
-				// Exit game
-				case SDLK_ESCAPE:
-					stateSelector = 3;
-					break;
-
-				// Go down the Menu
-				case SDLK_DOWN:
-					selectedButtonIndex++;
-					break;
-
-				// Go up the Menu
-				case SDLK_UP:
-					selectedButtonIndex--;
-					break;
-
-				// Select the item that is selected
-				case SDLK_SPACE:
-					stateSelector = selectedButtonIndex;
-				}
-				break;
-			}
+			handleEvent();
 		}
+		while (SDL_PollEvent(&incomingEvent));
 	}
 }
 
-void Menu::changetoSelectedImage()
+void Menu::handleEvent()
 {
-	// If one is Highlighted.
-	if (selectedButtonIndex == 1)
-	{
-		world->render2DImages(ButtonSelected, ButtonPosition, false);
-	}
-	// If one is NOT Highlighted.
-	else
-	{
-		world->render2DImages(ButtonUnselected, ButtonPosition, false);
-	}
-	// If two is Highlighted.
-	if (selectedButtonIndex == 2)
-	{
-		world->render2DImages(Button2Selected, Button2Position, false);
-	}
-	// If two is NOT Highlighted.
-	else
-	{
-		world->render2DImages(Button2Unselected, Button2Position, false);
-	}
-	// If three is Highlighted.
-	if (selectedButtonIndex == 3)
-	{
-		world->render2DImages(Button3Selected, Button3Position, true);
-	}
-	// If three is NOT Highlighted.
-	else
+	int8_t previousIndex = selectedButtonIndex;
+
+	switch (incomingEvent.type)
 	{
-		world->render2DImages(Button3Unselected, Button3Position, true);
+	// Quit the game safely
+	case SDL_QUIT:
+		stateSelector = 3;
+		break;
+
+	// Covered up or resized - what was on screen may have gone
+	case SDL_WINDOWEVENT:
+		if (incomingEvent.window.event == SDL_WINDOWEVENT_EXPOSED || incomingEvent.window.event == SDL_WINDOWEVENT_SIZE_CHANGED)
+			menuDirty = true;
+		break;
+
+	// When the Key is down
+	case SDL_KEYDOWN:
+		switch (incomingEvent.key.keysym.sym)
+		{
+
+		// Exit game
+		case SDLK_ESCAPE:
+			stateSelector = 3;
+			break;
+
+		// Go down the Menu
+		case SDLK_DOWN:
+			selectedButtonIndex++;
+			break;
+
+		// Go up the Menu
+		case SDLK_UP:
+			selectedButtonIndex--;
+			break;
+
+		// Select the item that is selected
+		case SDLK_SPACE:
+			stateSelector = selectedButtonIndex;
+		}
+		break;
 	}
+
+	// Ensures that the player will not go out of range
+	limitMenuSelection(1, 3);
+
+	if (selectedButtonIndex != previousIndex)
+		menuDirty = true;
 }
+
+void Menu::changetoSelectedImage()
+{
+	// Highlight the button that is selected
+	drawImage(selectedButtonIndex == 1 ? MenuImage::NewGameSelected : MenuImage::NewGameUnselected, ButtonPosition);
+	drawImage(selectedButtonIndex == 2 ? MenuImage::OptionsSelected : MenuImage::OptionsUnselected, Button2Position);
+	drawImage(selectedButtonIndex == 3 ? MenuImage::ExitSelected : MenuImage::ExitUnselected, Button3Position);
+}
+
 void Menu::stateSelect()
 {
 	// Go to Game world if Quit is not called
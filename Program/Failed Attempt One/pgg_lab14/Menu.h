@@ -8,7 +8,23 @@
 */
 #pragma once
 
+#include <vector>
 #include "GameWorld.h"
+#include "SpriteBatch.h"
+
+/// Every image on the menu, in the order they're packed into the atlas
+enum class MenuImage : uint8_t
+{
+	Background,
+	Title,
+	NewGameSelected,
+	NewGameUnselected,
+	OptionsSelected,
+	OptionsUnselected,
+	ExitSelected,
+	ExitUnselected,
+	Count
+};
 
 class Menu
 {
@@ -20,18 +36,30 @@ public:
 	/// Setup the images before using
 	void setupImages();
 
+	/// Upload whatever has finished streaming, true the moment the atlas arrives
+	bool updateStreamedImages();
+
+	/// Queue one of the menu images in the batch
+	void drawImage(MenuImage image, const SDL_Rect& position);
+
 	/// Limit how far the menu can go
 	void limitMenuSelection(int8_t min, int8_t max);
 
-	/// Handle the input for the menu
+	/// Handle the input for the menu - sleeps until something happens, and only redraws when something changed
 	void inputHandler();
 
+	/// Deal with one event, marking the menu for a redraw if it changes what's on screen
+	void handleEvent();
+
 	/// Change to the image that is selected
 	void changetoSelectedImage();
 
 	/// Go to the selected state
 	void stateSelect();
 
+	/// New Game plays a generated track that never ends instead of the level
+	void enableEndlessMode(uint32_t seed) { world->enableEndlessMode(seed); }
+
 private:
 	// Game World Pointer
 	GameWorld* world;
@@ -39,27 +67,20 @@ private:
 	// Incoming input events
 	SDL_Event incomingEvent;
 
-	// Background Image
-	SDL_Texture * Background;
-	SDL_Rect BackgroundPosition;
+	// Every menu image packed into one texture, and where each one is in it
+	SDL_Texture* menuAtlas;
+	std::vector<AtlasRegion> menuRegions;
+	uint32_t atlasTicket;
 
-	// Title Image
-	SDL_Texture * Title;
-	SDL_Rect TitlePosition;
+	// Draws the whole menu in one go, but only when it has changed
+	SpriteBatch* spriteBatch;
+	bool menuDirty;
 
-	// Button Image (Both selected and unselected)
-	SDL_Texture* ButtonUnselected;
-	SDL_Texture* ButtonSelected;
+	// Where each image goes on screen
+	SDL_Rect BackgroundPosition;
+	SDL_Rect TitlePosition;
 	SDL_Rect ButtonPosition;
-
-	// Button Image (Both selected and unselected)
-	SDL_Texture* Button2Unselected;
-	SDL_Texture* Button2Selected;
 	SDL_Rect Button2Position;
-
-	// Button Image (Both selected and unselected)
-	SDL_Texture* Button3Unselected;
-	SDL_Texture* Button3Selected;
 	SDL_Rect Button3Position;
 
 	// Index of selection
@@ -0,0 +1,178 @@
+/*!
+*  \brief     MeshCache Class.
+*  \details   This class is to save and load a mesh with all of its levels of detail in a binary file next to the OBJ (or in the cache folder)
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "MeshCache.h"
+
+#include <cstdio>
+#include <filesystem>
+
+// "PGGM" then a version, bump the version whenever the layout below changes
+static const uint32_t CACHE_MAGIC = 0x4D474750;
+static const uint32_t CACHE_VERSION = 1;
+
+// Sanity limits so a damaged file can't ask for gigabytes
+static const uint32_t MAX_LODS = 16;
+static const uint32_t MAX_VERTICES = 1 << 24;
+
+template<typename T>
+static bool WriteValue(FILE* file, const T& value)
+{
+	return fwrite(&value, sizeof(T), 1, file) == 1;
+}
+
+template<typename T>
+static bool ReadValue(FILE* file, T& value)
+{
+	return fread(&value, sizeof(T), 1, file) == 1;
+}
+
+static bool WriteFloats(FILE* file, const std::vector<float>& values)
+{
+	return values.empty() || fwrite(values.data(), sizeof(float), values.size(), file) == values.size();
+}
+
+static bool ReadFloats(FILE* file, std::vector<float>& values, size_t count)
+{
+	values.resize(count);
+	return count == 0 || fread(values.data(), sizeof(float), count, file) == count;
+}
+
+std::string MeshCache::cacheDirectory;
+
+MeshCache::MeshCache()
+{
+	sourceSize = 0;
+	sourceTime = 0;
+}
+
+MeshCache::~MeshCache()
+{
+
+}
+
+std::string MeshCache::GetCacheFileName(const std::string& sourceFileName)
+{
+	size_t dot = sourceFileName.find_last_of('.');
+	size_t slash = sourceFileName.find_last_of("/\\");
+	std::string cacheFileName = (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+								? sourceFileName + ".pmesh" : sourceFileName.substr(0, dot) + ".pmesh";
+	if (cacheDirectory.empty())
+		return cacheFileName;
+
+	// Only the name goes in the folder - two OBJs with the same name just rebuild each other's (IsBuiltFrom tells them apart)
+	std::string name = slash == std::string::npos ? cacheFileName : cacheFileName.substr(slash + 1);
+	return cacheDirectory + "/" + name;
+}
+
+void MeshCache::GetSourceStamp(const std::string& sourceFileName, uint64_t& size, int64_t& time)
+{
+	std::error_code error;
+	size = 0;
+	time = 0;
+
+	uintmax_t fileSize = std::filesystem::file_size(sourceFileName, error);
+	if (error)
+		return;
+
+	std::filesystem::file_time_type writeTime = std::filesystem::last_write_time(sourceFileName, error);
+	if (error)
+		return;
+
+	size = (uint64_t)fileSize;
+	time = (int64_t)writeTime.time_since_epoch().count();
+}
+
+void MeshCache::SetSource(const std::string& sourceFileName, const std::vector<float>& ratios)
+{
+	GetSourceStamp(sourceFileName, sourceSize, sourceTime);
+	sourceRatios = ratios;
+}
+
+bool MeshCache::IsBuiltFrom(const std::string& sourceFileName, const std::vector<float>& ratios) const
+{
+	uint64_t size;
+	int64_t time;
+	GetSourceStamp(sourceFileName, size, time);
+
+	if (size == 0 || lods.empty())
+		return false;
+
+	return size == sourceSize && time == sourceTime && ratios == sourceRatios;
+}
+
+bool MeshCache::Save(const std::string& cacheFileName) const
+{
+	std::error_code error;
+	std::filesystem::path folder = std::filesystem::path(cacheFileName).parent_path();
+	if (!folder.empty())
+		std::filesystem::create_directories(folder, error);
+
+	FILE* file = fopen(cacheFileName.c_str(), "wb");
+	if (file == NULL)
+		return false;
+
+	bool ok = WriteValue(file, CACHE_MAGIC) && WriteValue(file, CACHE_VERSION) &&
+			  WriteValue(file, sourceSize) && WriteValue(file, sourceTime) &&
+			  WriteValue(file, (uint32_t)sourceRatios.size()) && WriteFloats(file, sourceRatios) &&
+			  WriteValue(file, (uint32_t)lods.size());
+
+	for (size_t i = 0; ok && i < lods.size(); i++)
+	{
+		const MeshLod& lod = lods[i];
+		ok = WriteValue(file, lod.ratio) && WriteValue(file, lod.error) &&
+			 WriteValue(file, (uint32_t)lod.mesh.GetVertexCount()) &&
+			 WriteFloats(file, lod.mesh.vertices) && WriteFloats(file, lod.mesh.normals);
+	}
+
+	ok = (fclose(file) == 0) && ok;
+
+	// Don't leave half a file behind to be picked up next time
+	if (!ok)
+		remove(cacheFileName.c_str());
+	return ok;
+}
+
+bool MeshCache::Load(const std::string& cacheFileName)
+{
+	lods.clear();
+
+	FILE* file = fopen(cacheFileName.c_str(), "rb");
+	if (file == NULL)
+		return false;
+
+	uint32_t magic = 0, version = 0, ratioCount = 0, lodCount = 0;
+	bool ok = ReadValue(file, magic) && ReadValue(file, version) &&
+			  magic == CACHE_MAGIC && version == CACHE_VERSION &&
+			  ReadValue(file, sourceSize) && ReadValue(file, sourceTime) &&
+			  ReadValue(file, ratioCount) && ratioCount <= MAX_LODS && ReadFloats(file, sourceRatios, ratioCount) &&
+			  ReadValue(file, lodCount) && lodCount <= MAX_LODS;
+
+	if (ok)
+		lods.resize(lodCount);
+
+	for (uint32_t i = 0; ok && i < lodCount; i++)
+	{
+		MeshLod& lod = lods[i];
+		uint32_t vertexCount = 0;
+		ok = ReadValue(file, lod.ratio) && ReadValue(file, lod.error) &&
+			 ReadValue(file, vertexCount) && vertexCount <= MAX_VERTICES &&
+			 ReadFloats(file, lod.mesh.vertices, vertexCount * 3) &&
+			 ReadFloats(file, lod.mesh.normals, vertexCount * 3);
+
+		// Cheap enough to work out again rather than store
+		if (ok)
+			lod.mesh.ComputeBounds();
+	}
+
+	fclose(file);
+
+	if (!ok)
+		lods.clear();
+	return ok;
+}
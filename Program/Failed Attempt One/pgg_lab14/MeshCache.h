@@ -0,0 +1,58 @@
+/*!
+*  \brief     MeshCache Class.
+*  \details   This class is to save and load a mesh with all of its levels of detail in a binary file next to the OBJ (or in the cache folder)
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "MeshData.h"
+
+class MeshCache
+{
+public:
+	///ctor / dtor
+	MeshCache();
+	~MeshCache();
+
+	/// Where the cache for an OBJ lives ("Rocket.obj" -> "Rocket.pmesh"), next to it unless a cache directory is set
+	static std::string GetCacheFileName(const std::string& sourceFileName);
+
+	/// Keep every cache in one folder instead (made when the first one is saved), empty for next to the OBJ
+	/// Set it once before anything loads - the streamer's threads read it without a lock
+	static void SetCacheDirectory(const std::string& directory) { cacheDirectory = directory; }
+	static const std::string& GetCacheDirectory() { return cacheDirectory; }
+
+	/// Read a cache file, false if it is missing, from an older version or cut short
+	bool Load(const std::string& cacheFileName);
+
+	/// Write the levels out, false if the file couldn't be written
+	bool Save(const std::string& cacheFileName) const;
+
+	/// Remember which OBJ (and which ratios) the levels were made from
+	void SetSource(const std::string& sourceFileName, const std::vector<float>& ratios);
+
+	/// True if the loaded cache was made from this OBJ as it is now, with the same ratios
+	bool IsBuiltFrom(const std::string& sourceFileName, const std::vector<float>& ratios) const;
+
+	/// Size and modification time of a source file, zero if it couldn't be found (the archive stamps its entries with it too)
+	static void GetSourceStamp(const std::string& sourceFileName, uint64_t& size, int64_t& time);
+
+	/// Get the levels, finest first (move them out to keep them after the cache is gone)
+	std::vector<MeshLod>& GetLods() { return lods; }
+
+private:
+	static std::string cacheDirectory;
+
+	uint64_t sourceSize;
+	int64_t sourceTime;
+	std::vector<float> sourceRatios;
+
+	std::vector<MeshLod> lods;
+};
@@ -0,0 +1,97 @@
+/*!
+*  \brief     MeshData Struct.
+*  \details   This struct is to hold a mesh on the CPU, ready to hand to OpenGL
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "MeshData.h"
+
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+// Exact bit pattern of a position, so welding never merges two points that only look close
+struct PositionKey
+{
+	uint32_t bits[3];
+
+	bool operator==(const PositionKey& other) const
+	{
+		return bits[0] == other.bits[0] && bits[1] == other.bits[1] && bits[2] == other.bits[2];
+	}
+};
+
+struct PositionKeyHash
+{
+	size_t operator()(const PositionKey& key) const
+	{
+		uint64_t hash = 14695981039346656037ull;
+		for (int i = 0; i < 3; i++)
+			hash = (hash ^ key.bits[i]) * 1099511628211ull;
+		return (size_t)hash;
+	}
+};
+
+void MeshData::ComputeBounds()
+{
+	bounds = MeshBounds();
+	size_t vertexCount = GetVertexCount();
+	if (vertexCount == 0)
+		return;
+
+	bounds.min = bounds.max = glm::vec3(vertices[0], vertices[1], vertices[2]);
+	for (size_t i = 1; i < vertexCount; i++)
+	{
+		glm::vec3 position(vertices[i * 3], vertices[i * 3 + 1], vertices[i * 3 + 2]);
+		bounds.min = glm::min(bounds.min, position);
+		bounds.max = glm::max(bounds.max, position);
+	}
+
+	// Centre on the box, then only go as far out as the furthest vertex (tighter than half the diagonal)
+	bounds.centre = (bounds.min + bounds.max) * 0.5f;
+	float radiusSq = 0.0f;
+	for (size_t i = 0; i < vertexCount; i++)
+	{
+		glm::vec3 offset = glm::vec3(vertices[i * 3], vertices[i * 3 + 1], vertices[i * 3 + 2]) - bounds.centre;
+		radiusSq = glm::max(radiusSq, glm::dot(offset, offset));
+	}
+	bounds.radius = sqrtf(radiusSq);
+}
+
+IndexedMesh WeldPositions(const MeshData& mesh)
+{
+	IndexedMesh result;
+	size_t vertexCount = mesh.GetVertexCount();
+
+	std::unordered_map<PositionKey, uint32_t, PositionKeyHash> lookup;
+	lookup.reserve(vertexCount);
+	result.indices.reserve(vertexCount);
+
+	for (size_t i = 0; i < vertexCount; i++)
+	{
+		const float* position = &mesh.vertices[i * 3];
+
+		// Adding zero turns -0 into +0, they're the same point but not the same bits
+		float canonical[3] = { position[0] + 0.0f, position[1] + 0.0f, position[2] + 0.0f };
+
+		PositionKey key;
+		memcpy(key.bits, canonical, sizeof(key.bits));
+
+		std::unordered_map<PositionKey, uint32_t, PositionKeyHash>::iterator found = lookup.find(key);
+		if (found == lookup.end())
+		{
+			uint32_t index = (uint32_t)result.positions.size();
+			result.positions.push_back(glm::vec3(position[0], position[1], position[2]));
+			lookup[key] = index;
+			result.indices.push_back(index);
+		}
+		else
+		{
+			result.indices.push_back(found->second);
+		}
+	}
+	return result;
+}
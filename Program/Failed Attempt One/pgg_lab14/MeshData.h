@@ -0,0 +1,96 @@
+/*!
+*  \brief     MeshData Struct.
+*  \details   This struct is to hold a mesh on the CPU, ready to hand to OpenGL
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+#include "SDKS/glm/glm.hpp"
+#include "MaterialLibrary.h"
+
+/// Box and sphere around a mesh in its own space, used to cull it
+struct MeshBounds
+{
+	glm::vec3 min;
+	glm::vec3 max;
+	glm::vec3 centre;
+	float radius;
+
+	MeshBounds() : min(0.0f), max(0.0f), centre(0.0f), radius(0.0f) {}
+};
+
+/// Run of vertices drawn with one material (-1 for the model's own colours)
+struct MeshSubset
+{
+	uint32_t firstVertex;
+	uint32_t vertexCount;
+	int32_t material;
+};
+
+/// Non-indexed triangle list, three floats per vertex in each stream
+/// texCoords (two floats per vertex), tangents (one packed per vertex, see TangentGenerator) and subsets are optional
+/// - no subsets means one draw in the model's own colours
+struct MeshData
+{
+	std::vector<float> vertices;
+	std::vector<float> normals;
+	std::vector<float> texCoords;
+	std::vector<uint32_t> tangents;
+	std::vector<MeshSubset> subsets;
+	std::vector<Material> materials;
+	MeshBounds bounds;
+
+	/// Number of vertices (three per triangle)
+	size_t GetVertexCount() const { return vertices.size() / 3; }
+
+	/// True if there is nothing to draw
+	bool IsEmpty() const { return vertices.empty(); }
+
+	/// True if there is a texture coordinate for every vertex
+	bool HasTexCoords() const { return !texCoords.empty() && texCoords.size() / 2 == GetVertexCount(); }
+
+	/// True if there is a tangent for every vertex
+	bool HasTangents() const { return !tangents.empty() && tangents.size() == GetVertexCount(); }
+
+	/// Empty every stream and forget the materials
+	void Clear()
+	{
+		vertices.clear();
+		normals.clear();
+		texCoords.clear();
+		tangents.clear();
+		subsets.clear();
+		materials.clear();
+		bounds = MeshBounds();
+	}
+
+	/// Fit bounds to the vertices (call again after changing them)
+	void ComputeBounds();
+};
+
+/// One level of detail - ratio is the fraction of the original triangles it kept
+/// and error is roughly how far (in model units) its surface moved from the original
+struct MeshLod
+{
+	float ratio;
+	float error;
+	MeshData mesh;
+};
+
+/// Triangle list that shares vertices - three indices per triangle
+struct IndexedMesh
+{
+	std::vector<glm::vec3> positions;
+	std::vector<uint32_t> indices;
+
+	size_t GetTriangleCount() const { return indices.size() / 3; }
+};
+
+/// Merge vertices that sit at exactly the same position
+IndexedMesh WeldPositions(const MeshData& mesh);
@@ -0,0 +1,298 @@
+/*!
+*  \brief     MeshFile Class.
+*  \details   This class is to read a cooked mesh (every stream and material, ready to upload) straight out of a mapped file
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "MeshFile.h"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <vector>
+
+// Every part starts on a boundary this big, so the streams can be loaded with aligned SSE straight from the mapping
+static const size_t SECTION_ALIGNMENT = 16;
+
+// Sanity limits so a damaged file can't ask for gigabytes
+static const uint32_t MAX_VERTICES = 1 << 24;
+static const uint32_t MAX_SUBSETS = 1 << 16;
+
+static size_t AlignUp(size_t offset)
+{
+	return (offset + SECTION_ALIGNMENT - 1) & ~(SECTION_ALIGNMENT - 1);
+}
+
+// Add a name to the string block, remembering where it went
+static void AddString(std::string& strings, const std::string& value, uint32_t& offset, uint32_t& length)
+{
+	offset = (uint32_t)strings.size();
+	length = (uint32_t)value.size();
+	strings += value;
+}
+
+// A map name relative to the cooked file's folder instead of the working directory (absolute names are left alone)
+static std::string MakeRelative(const std::string& fileName, const std::string& directory)
+{
+	std::filesystem::path path(fileName);
+	if (directory.empty() || fileName.empty() || path.is_absolute())
+		return fileName;
+	return path.lexically_relative(directory).generic_string();
+}
+
+// And back again
+static std::string MakeWorkingRelative(const std::string& fileName, const std::string& directory)
+{
+	if (fileName.empty() || std::filesystem::path(fileName).is_absolute())
+		return fileName;
+	return directory + fileName;
+}
+
+MeshFile::MeshFile()
+{
+	Close();
+}
+
+MeshFile::~MeshFile()
+{
+
+}
+
+std::string MeshFile::GetCookedFileName(const std::string& sourceFileName)
+{
+	size_t dot = sourceFileName.find_last_of('.');
+	size_t slash = sourceFileName.find_last_of("/\\");
+	if (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+		return sourceFileName + ".pmdl";
+
+	return sourceFileName.substr(0, dot) + ".pmdl";
+}
+
+bool MeshFile::IsCookedUpToDate(const std::string& cookedFileName, const std::string& sourceFileName)
+{
+	std::error_code error;
+	std::filesystem::file_time_type cookedTime = std::filesystem::last_write_time(cookedFileName, error);
+	if (error)
+		return false;
+
+	// Shipping without the OBJs is fine, the cooked file is all that's needed
+	std::filesystem::file_time_type sourceTime = std::filesystem::last_write_time(sourceFileName, error);
+	return error || sourceTime <= cookedTime;
+}
+
+MeshFile::Layout MeshFile::GetLayout(const MeshFileHeader& header)
+{
+	size_t vertexCount = header.vertexCount;
+	Layout layout;
+	layout.vertices = AlignUp(sizeof(MeshFileHeader));
+	layout.normals = AlignUp(layout.vertices + vertexCount * 3 * sizeof(float));
+	layout.texCoords = AlignUp(layout.normals + vertexCount * 3 * sizeof(float));
+
+	size_t texCoordSize = (header.flags & FLAG_TEX_COORDS) ? vertexCount * 2 * sizeof(float) : 0;
+	layout.tangents = AlignUp(layout.texCoords + texCoordSize);
+
+	size_t tangentSize = (header.flags & FLAG_TANGENTS) ? vertexCount * sizeof(uint32_t) : 0;
+	layout.subsets = AlignUp(layout.tangents + tangentSize);
+	layout.materials = AlignUp(layout.subsets + header.subsetCount * sizeof(MeshSubset));
+	layout.strings = AlignUp(layout.materials + header.materialCount * sizeof(MeshFileMaterial));
+	layout.size = layout.strings + header.stringSize;
+	return layout;
+}
+
+bool MeshFile::Save(const MeshData& mesh, const std::string& fileName)
+{
+	size_t vertexCount = mesh.GetVertexCount();
+	if (mesh.normals.size() != mesh.vertices.size() || vertexCount > MAX_VERTICES || mesh.subsets.size() > MAX_SUBSETS)
+		return false;
+
+	// Names and maps all go in one block at the end, the maps relative to this file
+	std::string directory = MaterialLibrary::GetDirectory(fileName);
+	std::string stringBlock;
+	std::vector<MeshFileMaterial> fileMaterials(mesh.materials.size());
+	for (size_t i = 0; i < mesh.materials.size(); i++)
+	{
+		const Material& material = mesh.materials[i];
+		MeshFileMaterial& fileMaterial = fileMaterials[i];
+		memcpy(fileMaterial.ambient, &material.ambient.x, sizeof(fileMaterial.ambient));
+		memcpy(fileMaterial.diffuse, &material.diffuse.x, sizeof(fileMaterial.diffuse));
+		memcpy(fileMaterial.specular, &material.specular.x, sizeof(fileMaterial.specular));
+		memcpy(fileMaterial.emissive, &material.emissive.x, sizeof(fileMaterial.emissive));
+		fileMaterial.shininess = material.shininess;
+		fileMaterial.opacity = material.opacity;
+
+		std::string diffuseMap = MakeRelative(material.diffuseMap, directory);
+		std::string normalMap = MakeRelative(material.normalMap, directory);
+
+		AddString(stringBlock, material.name, fileMaterial.nameOffset, fileMaterial.nameLength);
+		AddString(stringBlock, diffuseMap, fileMaterial.diffuseMapOffset, fileMaterial.diffuseMapLength);
+		AddString(stringBlock, normalMap, fileMaterial.normalMapOffset, fileMaterial.normalMapLength);
+	}
+
+	MeshFileHeader fileHeader;
+	memset(&fileHeader, 0, sizeof(fileHeader));
+	fileHeader.magic = MAGIC;
+	fileHeader.version = VERSION;
+	fileHeader.vertexCount = (uint32_t)vertexCount;
+	fileHeader.flags = (mesh.HasTexCoords() ? FLAG_TEX_COORDS : 0) | (mesh.HasTangents() ? FLAG_TANGENTS : 0);
+	fileHeader.subsetCount = (uint32_t)mesh.subsets.size();
+	fileHeader.materialCount = (uint32_t)fileMaterials.size();
+	fileHeader.stringSize = (uint32_t)stringBlock.size();
+	memcpy(fileHeader.boundsMin, &mesh.bounds.min.x, sizeof(fileHeader.boundsMin));
+	memcpy(fileHeader.boundsMax, &mesh.bounds.max.x, sizeof(fileHeader.boundsMax));
+	memcpy(fileHeader.boundsCentre, &mesh.bounds.centre.x, sizeof(fileHeader.boundsCentre));
+	fileHeader.boundsRadius = mesh.bounds.radius;
+
+	// Put the whole file together in memory (padding included) and write it in one go
+	Layout layout = GetLayout(fileHeader);
+	std::vector<uint8_t> bytes(layout.size, 0);
+	memcpy(&bytes[0], &fileHeader, sizeof(fileHeader));
+	if (vertexCount > 0)
+	{
+		memcpy(&bytes[layout.vertices], mesh.vertices.data(), mesh.vertices.size() * sizeof(float));
+		memcpy(&bytes[layout.normals], mesh.normals.data(), mesh.normals.size() * sizeof(float));
+	}
+	if (fileHeader.flags & FLAG_TEX_COORDS)
+		memcpy(&bytes[layout.texCoords], mesh.texCoords.data(), mesh.texCoords.size() * sizeof(float));
+	if (fileHeader.flags & FLAG_TANGENTS)
+		memcpy(&bytes[layout.tangents], mesh.tangents.data(), mesh.tangents.size() * sizeof(uint32_t));
+	if (!mesh.subsets.empty())
+		memcpy(&bytes[layout.subsets], mesh.subsets.data(), mesh.subsets.size() * sizeof(MeshSubset));
+	if (!fileMaterials.empty())
+		memcpy(&bytes[layout.materials], fileMaterials.data(), fileMaterials.size() * sizeof(MeshFileMaterial));
+	if (!stringBlock.empty())
+		memcpy(&bytes[layout.strings], stringBlock.data(), stringBlock.size());
+
+	FILE* file = fopen(fileName.c_str(), "wb");
+	if (file == NULL)
+		return false;
+
+	bool ok = fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+	ok = (fclose(file) == 0) && ok;
+
+	// Don't leave half a file behind to be picked up next time
+	if (!ok)
+		remove(fileName.c_str());
+	return ok;
+}
+
+bool MeshFile::Open(const std::string& fileName)
+{
+	Close();
+	if (!file.Open(fileName))
+		return false;
+
+	return Parse(file.GetData(), file.GetSize(), MaterialLibrary::GetDirectory(fileName));
+}
+
+bool MeshFile::Open(const uint8_t* data, size_t size, const std::string& directory)
+{
+	Close();
+	return Parse(data, size, directory);
+}
+
+bool MeshFile::Parse(const uint8_t* data, size_t size, const std::string& directory)
+{
+	if (size < sizeof(header))
+	{
+		Close();
+		return false;
+	}
+	memcpy(&header, data, sizeof(header));
+
+	// Every part has to be inside the file
+	Layout layout = GetLayout(header);
+	if (header.magic != MAGIC || header.version != VERSION || header.vertexCount > MAX_VERTICES ||
+		header.vertexCount % 3 != 0 || header.subsetCount > MAX_SUBSETS || header.materialCount > MAX_SUBSETS ||
+		layout.size > size)
+	{
+		Close();
+		return false;
+	}
+
+	vertexCount = header.vertexCount;
+	vertices = (const float*)(data + layout.vertices);
+	normals = (const float*)(data + layout.normals);
+	texCoords = (header.flags & FLAG_TEX_COORDS) ? (const float*)(data + layout.texCoords) : nullptr;
+	tangents = (header.flags & FLAG_TANGENTS) ? (const uint32_t*)(data + layout.tangents) : nullptr;
+	subsets = (const MeshSubset*)(data + layout.subsets);
+	materials = (const MeshFileMaterial*)(data + layout.materials);
+	strings = (const char*)(data + layout.strings);
+	this->directory = directory;
+
+	// Subsets and names mustn't point outside what they index
+	for (uint32_t i = 0; i < header.subsetCount; i++)
+	{
+		if (subsets[i].firstVertex > vertexCount || subsets[i].vertexCount > vertexCount - subsets[i].firstVertex ||
+			subsets[i].material >= (int32_t)header.materialCount)
+		{
+			Close();
+			return false;
+		}
+	}
+	for (uint32_t i = 0; i < header.materialCount; i++)
+	{
+		const MeshFileMaterial& material = materials[i];
+		if ((uint64_t)material.nameOffset + material.nameLength > header.stringSize ||
+			(uint64_t)material.diffuseMapOffset + material.diffuseMapLength > header.stringSize ||
+			(uint64_t)material.normalMapOffset + material.normalMapLength > header.stringSize)
+		{
+			Close();
+			return false;
+		}
+	}
+	return true;
+}
+
+void MeshFile::Close()
+{
+	file.Close();
+	memset(&header, 0, sizeof(header));
+	vertexCount = 0;
+	vertices = normals = texCoords = nullptr;
+	tangents = nullptr;
+	subsets = nullptr;
+	materials = nullptr;
+	strings = nullptr;
+}
+
+bool MeshFile::Read(MeshData& mesh) const
+{
+	mesh.Clear();
+	if (!vertices)
+		return false;
+
+	mesh.vertices.assign(vertices, vertices + vertexCount * 3);
+	mesh.normals.assign(normals, normals + vertexCount * 3);
+	if (texCoords)
+		mesh.texCoords.assign(texCoords, texCoords + vertexCount * 2);
+	if (tangents)
+		mesh.tangents.assign(tangents, tangents + vertexCount);
+	mesh.subsets.assign(subsets, subsets + header.subsetCount);
+
+	mesh.materials.resize(header.materialCount);
+	for (uint32_t i = 0; i < header.materialCount; i++)
+	{
+		const MeshFileMaterial& fileMaterial = materials[i];
+		Material& material = mesh.materials[i];
+		memcpy(&material.ambient.x, fileMaterial.ambient, sizeof(fileMaterial.ambient));
+		memcpy(&material.diffuse.x, fileMaterial.diffuse, sizeof(fileMaterial.diffuse));
+		memcpy(&material.specular.x, fileMaterial.specular, sizeof(fileMaterial.specular));
+		memcpy(&material.emissive.x, fileMaterial.emissive, sizeof(fileMaterial.emissive));
+		material.shininess = fileMaterial.shininess;
+		material.opacity = fileMaterial.opacity;
+		material.name.assign(strings + fileMaterial.nameOffset, fileMaterial.nameLength);
+
+		// Back to relative to the working directory, the way MaterialLibrary hands them out
+		material.diffuseMap = MakeWorkingRelative(std::string(strings + fileMaterial.diffuseMapOffset, fileMaterial.diffuseMapLength), directory);
+		material.normalMap = MakeWorkingRelative(std::string(strings + fileMaterial.normalMapOffset, fileMaterial.normalMapLength), directory);
+	}
+
+	memcpy(&mesh.bounds.min.x, header.boundsMin, sizeof(header.boundsMin));
+	memcpy(&mesh.bounds.max.x, header.boundsMax, sizeof(header.boundsMax));
+	memcpy(&mesh.bounds.centre.x, header.boundsCentre, sizeof(header.boundsCentre));
+	mesh.bounds.radius = header.boundsRadius;
+	return true;
+}
@@ -0,0 +1,116 @@
+/*!
+*  \brief     MeshFile Class.
+*  \details   This class is to read a cooked mesh (every stream and material, ready to upload) straight out of a mapped file
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+
+#include "MappedFile.h"
+#include "MeshData.h"
+
+/// File layout - a header, then vertices, normals, texCoords, tangents, subsets, materials and their strings,
+/// each on a 16 byte boundary (all little endian, streams the mesh doesn't have are left out)
+struct MeshFileHeader
+{
+	uint32_t magic;
+	uint32_t version;
+	uint32_t vertexCount;
+	uint32_t flags;
+	uint32_t subsetCount;
+	uint32_t materialCount;
+	uint32_t stringSize;
+	uint32_t reserved;
+	float boundsMin[3];
+	float boundsMax[3];
+	float boundsCentre[3];
+	float boundsRadius;
+};
+
+/// A Material with its names swapped for offsets into the string block
+struct MeshFileMaterial
+{
+	float ambient[3];
+	float diffuse[3];
+	float specular[3];
+	float emissive[3];
+	float shininess;
+	float opacity;
+	uint32_t nameOffset, nameLength;
+	uint32_t diffuseMapOffset, diffuseMapLength;
+	uint32_t normalMapOffset, normalMapLength;
+};
+
+class MeshFile
+{
+public:
+	/// "PMDL" then a version, bump the version whenever the layout above changes
+	static const uint32_t MAGIC = 0x4C444D50;
+	static const uint32_t VERSION = 1;
+
+	/// Which of the optional streams are there
+	static const uint32_t FLAG_TEX_COORDS = 1;
+	static const uint32_t FLAG_TANGENTS = 2;
+
+	///ctor / dtor
+	MeshFile();
+	~MeshFile();
+
+	/// Where the cooked mesh for an OBJ lives ("Rocket.obj" -> "Rocket.pmdl")
+	static std::string GetCookedFileName(const std::string& sourceFileName);
+
+	/// True if the cooked file is there and at least as new as the source (or the source has gone)
+	static bool IsCookedUpToDate(const std::string& cookedFileName, const std::string& sourceFileName);
+
+	/// Write a mesh out, false if it has no normals for its vertices or the file couldn't be written
+	/// Map names are stored relative to the file, so the folder can be moved
+	static bool Save(const MeshData& mesh, const std::string& fileName);
+
+	/// Map a cooked mesh and check it over, false if it is missing, from an older version or cut short
+	bool Open(const std::string& fileName);
+	void Close();
+
+	/// Same, for a cooked mesh that is already in memory (an archive entry) - it has to stay there while this is used
+	/// directory is where its map names are relative to, as the file's own folder would be
+	bool Open(const uint8_t* data, size_t size, const std::string& directory);
+
+	/// Streams point into the mapped file, texCoords and tangents are null if the mesh has none
+	size_t GetVertexCount() const { return vertexCount; }
+	const float* GetVertices() const { return vertices; }
+	const float* GetNormals() const { return normals; }
+	const float* GetTexCoords() const { return texCoords; }
+	const uint32_t* GetTangents() const { return tangents; }
+
+	/// Copy everything into a MeshData (materials get their map names back relative to the working directory)
+	bool Read(MeshData& mesh) const;
+
+private:
+	// Where each part starts, worked out from the header the same way for writing and reading
+	struct Layout
+	{
+		size_t vertices, normals, texCoords, tangents, subsets, materials, strings, size;
+	};
+	static Layout GetLayout(const MeshFileHeader& header);
+
+	// Check the header and every part over, pointing the streams into data
+	bool Parse(const uint8_t* data, size_t size, const std::string& directory);
+
+	MappedFile file;
+	MeshFileHeader header;
+	std::string directory;
+
+	size_t vertexCount;
+	const float* vertices;
+	const float* normals;
+	const float* texCoords;
+	const uint32_t* tangents;
+	const MeshSubset* subsets;
+	const MeshFileMaterial* materials;
+	const char* strings;
+};
@@ -0,0 +1,82 @@
+/*!
+*  \brief     MeshPipeline Class.
+*  \details   This class is to turn an OBJ into a set of levels of detail, reusing the cached copy when the OBJ hasn't changed
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "MeshPipeline.h"
+
+#include <iostream>
+#include "MeshCache.h"
+#include "MeshSimplifier.h"
+#include "ObjLoader.h"
+
+MeshPipeline::MeshPipeline()
+{
+	// Full detail, then half, a quarter and a tenth of the triangles
+	lodRatios.push_back(1.0f);
+	lodRatios.push_back(0.5f);
+	lodRatios.push_back(0.25f);
+	lodRatios.push_back(0.1f);
+
+	cacheEnabled = true;
+	loadedFromCache = false;
+	verbose = false;
+}
+
+MeshPipeline::~MeshPipeline()
+{
+
+}
+
+bool MeshPipeline::Load(const std::string& objFileName)
+{
+	// Skip the OBJ and the simplifier entirely if nothing has changed
+	if (LoadFromCache(objFileName))
+		return true;
+
+	ObjLoader loader;
+	if (!loader.Load(objFileName))
+		return false;
+
+	Build(objFileName, loader.GetMeshData());
+	return true;
+}
+
+bool MeshPipeline::LoadFromCache(const std::string& objFileName)
+{
+	lods.clear();
+	loadedFromCache = false;
+
+	MeshCache cache;
+	if (cacheEnabled && cache.Load(MeshCache::GetCacheFileName(objFileName)) && cache.IsBuiltFrom(objFileName, lodRatios))
+	{
+		lods = std::move(cache.GetLods());
+		loadedFromCache = true;
+	}
+	return loadedFromCache;
+}
+
+void MeshPipeline::Build(const std::string& objFileName, const MeshData& mesh)
+{
+	loadedFromCache = false;
+
+	MeshSimplifier simplifier;
+	simplifier.GenerateLods(mesh, lodRatios, lods);
+
+	for (size_t i = 0; verbose && i < lods.size(); i++)
+		std::cout << objFileName << " LOD" << i << ": " << lods[i].mesh.GetVertexCount() / 3 << " triangles, error " << lods[i].error << std::endl;
+
+	if (cacheEnabled)
+	{
+		MeshCache cache;
+		std::string cacheFileName = MeshCache::GetCacheFileName(objFileName);
+		cache.SetSource(objFileName, lodRatios);
+		cache.GetLods() = lods;
+		if (!cache.Save(cacheFileName))
+			std::cout << "Couldn't write mesh cache " << cacheFileName << std::endl;
+	}
+}
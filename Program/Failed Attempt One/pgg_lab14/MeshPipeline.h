@@ -0,0 +1,53 @@
+/*!
+*  \brief     MeshPipeline Class.
+*  \details   This class is to turn an OBJ into a set of levels of detail, reusing the cached copy when the OBJ hasn't changed
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include "MeshData.h"
+
+class MeshPipeline
+{
+public:
+	///ctor / dtor
+	MeshPipeline();
+	~MeshPipeline();
+
+	/// Fraction of the triangles each level keeps, finest first (1 is the original mesh)
+	void SetLodRatios(const std::vector<float>& ratios) { lodRatios = ratios; }
+	const std::vector<float>& GetLodRatios() const { return lodRatios; }
+
+	/// Turn the .pmesh cache off to always simplify from scratch
+	void SetUseCache(bool useCache) { cacheEnabled = useCache; }
+
+	/// Print each level's triangles and error as it is built (off by default)
+	void SetVerbose(bool verbose) { this->verbose = verbose; }
+
+	/// Load the OBJ and build its levels, false if the OBJ couldn't be loaded
+	bool Load(const std::string& objFileName);
+
+	/// The two halves of Load, for when the mesh comes from somewhere else (the cooked copy, say)
+	/// LoadFromCache is false if the OBJ has changed since the cache was built, then Build makes the levels from its mesh
+	bool LoadFromCache(const std::string& objFileName);
+	void Build(const std::string& objFileName, const MeshData& mesh);
+
+	/// Get the levels, finest first (move them out to keep them after the pipeline is gone)
+	std::vector<MeshLod>& GetLods() { return lods; }
+
+	/// True if the last Load came straight from the cache
+	bool WasLoadedFromCache() const { return loadedFromCache; }
+
+private:
+	std::vector<float> lodRatios;
+	std::vector<MeshLod> lods;
+	bool cacheEnabled;
+	bool loadedFromCache;
+	bool verbose;
+};
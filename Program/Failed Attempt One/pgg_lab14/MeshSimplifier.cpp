@@ -0,0 +1,452 @@
+/*!
+*  \brief     MeshSimplifier Class.
+*  \details   This class is to build lower detail versions of a mesh with quadric error metric edge collapses
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "MeshSimplifier.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <unordered_map>
+
+// Faces closer than this (about 60 degrees) share smoothed normals, anything sharper stays a hard edge
+static const double CREASE_COSINE = 0.5;
+
+// A collapse that tilts a neighbouring face further than this is treated as a flip
+static const double FLIP_COSINE = 0.2;
+
+Quadric::Quadric()
+	: a2(0.0), ab(0.0), ac(0.0), ad(0.0), b2(0.0), bc(0.0), bd(0.0), c2(0.0), cd(0.0), d2(0.0), weight(0.0)
+{
+
+}
+
+Quadric Quadric::FromPlane(double a, double b, double c, double d, double weight)
+{
+	Quadric quadric;
+	quadric.a2 = a * a * weight;
+	quadric.ab = a * b * weight;
+	quadric.ac = a * c * weight;
+	quadric.ad = a * d * weight;
+	quadric.b2 = b * b * weight;
+	quadric.bc = b * c * weight;
+	quadric.bd = b * d * weight;
+	quadric.c2 = c * c * weight;
+	quadric.cd = c * d * weight;
+	quadric.d2 = d * d * weight;
+	quadric.weight = weight;
+	return quadric;
+}
+
+Quadric& Quadric::operator+=(const Quadric& other)
+{
+	a2 += other.a2; ab += other.ab; ac += other.ac; ad += other.ad;
+	b2 += other.b2; bc += other.bc; bd += other.bd;
+	c2 += other.c2; cd += other.cd;
+	d2 += other.d2;
+	weight += other.weight;
+	return *this;
+}
+
+double Quadric::Evaluate(const glm::dvec3& p) const
+{
+	return a2 * p.x * p.x + 2.0 * ab * p.x * p.y + 2.0 * ac * p.x * p.z + 2.0 * ad * p.x
+		 + b2 * p.y * p.y + 2.0 * bc * p.y * p.z + 2.0 * bd * p.y
+		 + c2 * p.z * p.z + 2.0 * cd * p.z
+		 + d2;
+}
+
+bool Quadric::FindOptimal(glm::dvec3& point) const
+{
+	// Solve A x = -b with Cramer's rule, A being the top left 3x3
+	double det = a2 * (b2 * c2 - bc * bc) - ab * (ab * c2 - bc * ac) + ac * (ab * bc - b2 * ac);
+
+	// Flat or nearly flat neighbourhoods don't have a single best point
+	double scale = a2 * b2 * c2;
+	if (std::fabs(det) <= 1e-10 * std::max(scale, 1e-30))
+		return false;
+
+	double inv = 1.0 / det;
+	point.x = -inv * (ad * (b2 * c2 - bc * bc) - ab * (bd * c2 - bc * cd) + ac * (bd * bc - b2 * cd));
+	point.y = -inv * (a2 * (bd * c2 - cd * bc) - ad * (ab * c2 - bc * ac) + ac * (ab * cd - bd * ac));
+	point.z = -inv * (a2 * (b2 * cd - bc * bd) - ab * (ab * cd - bd * ac) + ad * (ab * bc - b2 * ac));
+	return true;
+}
+
+MeshSimplifier::MeshSimplifier()
+{
+	liveTriangles = 0;
+	maxError = 0.0;
+	boundaryWeight = 10.0f;
+}
+
+MeshSimplifier::~MeshSimplifier()
+{
+
+}
+
+void MeshSimplifier::GenerateLods(const MeshData& mesh, const std::vector<float>& ratios, std::vector<MeshLod>& lods)
+{
+	lods.clear();
+
+	IndexedMesh indexed = WeldPositions(mesh);
+	size_t originalTriangles = indexed.GetTriangleCount();
+
+	BuildTopology(indexed);
+	BuildQuadrics();
+
+	// Work from the finest level down so one pass of collapses makes all of them
+	std::vector<float> sortedRatios = ratios;
+	std::sort(sortedRatios.begin(), sortedRatios.end(), std::greater<float>());
+
+	for (size_t i = 0; i < sortedRatios.size(); i++)
+	{
+		MeshLod lod;
+
+		if (sortedRatios[i] >= 1.0f || originalTriangles == 0)
+		{
+			lod.ratio = 1.0f;
+			lod.error = 0.0f;
+			lod.mesh = mesh;
+			lods.push_back(lod);
+			continue;
+		}
+
+		size_t target = (size_t)(originalTriangles * std::max(sortedRatios[i], 0.0f));
+		while (liveTriangles > target && !heap.empty())
+		{
+			std::pop_heap(heap.begin(), heap.end(), std::greater<Collapse>());
+			Collapse collapse = heap.back();
+			heap.pop_back();
+			ApplyCollapse(collapse);
+		}
+
+		lod.ratio = (float)liveTriangles / (float)originalTriangles;
+		lod.error = (float)maxError;
+		ExtractMesh(lod.mesh);
+		lods.push_back(lod);
+	}
+
+	// Nothing left to keep around between meshes
+	heap.clear();
+	vertexTriangles.clear();
+}
+
+void MeshSimplifier::BuildTopology(const IndexedMesh& mesh)
+{
+	size_t vertexCount = mesh.positions.size();
+
+	positions.resize(vertexCount);
+	for (size_t i = 0; i < vertexCount; i++)
+		positions[i] = glm::dvec3(mesh.positions[i]);
+
+	triangles = mesh.indices;
+	liveTriangles = mesh.GetTriangleCount();
+	triangleRemoved.assign(liveTriangles, false);
+	vertexRemoved.assign(vertexCount, false);
+	vertexVersion.assign(vertexCount, 0);
+	vertexTriangles.assign(vertexCount, std::vector<uint32_t>());
+	maxError = 0.0;
+
+	for (size_t t = 0; t < liveTriangles; t++)
+	{
+		uint32_t a = triangles[t * 3], b = triangles[t * 3 + 1], c = triangles[t * 3 + 2];
+
+		// Triangles that welded down to a line or a point add nothing
+		if (a == b || b == c || a == c)
+		{
+			triangleRemoved[t] = true;
+			continue;
+		}
+
+		vertexTriangles[a].push_back((uint32_t)t);
+		vertexTriangles[b].push_back((uint32_t)t);
+		vertexTriangles[c].push_back((uint32_t)t);
+	}
+
+	liveTriangles = std::count(triangleRemoved.begin(), triangleRemoved.end(), false);
+}
+
+void MeshSimplifier::BuildQuadrics()
+{
+	quadrics.assign(positions.size(), Quadric());
+
+	// How many triangles use each edge, keyed on the pair of vertices (lowest first)
+	std::unordered_map<uint64_t, uint32_t> edgeUse;
+	std::unordered_map<uint64_t, uint32_t> edgeTriangle;
+
+	for (size_t t = 0; t < triangleRemoved.size(); t++)
+	{
+		if (triangleRemoved[t])
+			continue;
+
+		const uint32_t* corner = &triangles[t * 3];
+		glm::dvec3 p0 = positions[corner[0]];
+		glm::dvec3 cross = glm::cross(positions[corner[1]] - p0, positions[corner[2]] - p0);
+		double length = glm::length(cross);
+		if (length <= 0.0)
+			continue;
+
+		// Area weighted so big faces hold their shape better than slivers
+		glm::dvec3 normal = cross / length;
+		Quadric plane = Quadric::FromPlane(normal.x, normal.y, normal.z, -glm::dot(normal, p0), length * 0.5);
+
+		for (int i = 0; i < 3; i++)
+		{
+			quadrics[corner[i]] += plane;
+
+			uint32_t v0 = std::min(corner[i], corner[(i + 1) % 3]);
+			uint32_t v1 = std::max(corner[i], corner[(i + 1) % 3]);
+			uint64_t key = ((uint64_t)v0 << 32) | v1;
+			edgeUse[key]++;
+			edgeTriangle[key] = (uint32_t)t;
+		}
+	}
+
+	// Open edges get an extra plane standing up off the face so the outline doesn't shrink in
+	for (std::unordered_map<uint64_t, uint32_t>::iterator edge = edgeUse.begin(); edge != edgeUse.end(); ++edge)
+	{
+		if (edge->second != 1)
+			continue;
+
+		uint32_t v0 = (uint32_t)(edge->first >> 32);
+		uint32_t v1 = (uint32_t)(edge->first & 0xFFFFFFFF);
+		const uint32_t* corner = &triangles[edgeTriangle[edge->first] * 3];
+
+		glm::dvec3 p0 = positions[corner[0]];
+		glm::dvec3 faceNormal = glm::cross(positions[corner[1]] - p0, positions[corner[2]] - p0);
+		glm::dvec3 direction = positions[v1] - positions[v0];
+		glm::dvec3 normal = glm::cross(direction, faceNormal);
+		double length = glm::length(normal);
+		if (length <= 0.0)
+			continue;
+
+		normal /= length;
+		double edgeLengthSq = glm::dot(direction, direction);
+		Quadric plane = Quadric::FromPlane(normal.x, normal.y, normal.z, -glm::dot(normal, positions[v0]), edgeLengthSq * boundaryWeight);
+		quadrics[v0] += plane;
+		quadrics[v1] += plane;
+	}
+
+	// Every edge starts out as a candidate
+	heap.clear();
+	heap.reserve(edgeUse.size());
+	for (std::unordered_map<uint64_t, uint32_t>::iterator edge = edgeUse.begin(); edge != edgeUse.end(); ++edge)
+	{
+		Collapse collapse;
+		ComputeCollapse((uint32_t)(edge->first >> 32), (uint32_t)(edge->first & 0xFFFFFFFF), collapse);
+		heap.push_back(collapse);
+	}
+	std::make_heap(heap.begin(), heap.end(), std::greater<Collapse>());
+}
+
+void MeshSimplifier::ComputeCollapse(uint32_t v0, uint32_t v1, Collapse& collapse) const
+{
+	Quadric combined = quadrics[v0];
+	combined += quadrics[v1];
+
+	// Try the best point first, then fall back to the ends and the middle
+	glm::dvec3 candidates[4];
+	int candidateCount = 0;
+
+	glm::dvec3 optimal;
+	if (combined.FindOptimal(optimal))
+		candidates[candidateCount++] = optimal;
+	candidates[candidateCount++] = positions[v0];
+	candidates[candidateCount++] = positions[v1];
+	candidates[candidateCount++] = (positions[v0] + positions[v1]) * 0.5;
+
+	collapse.cost = -1.0;
+	for (int i = 0; i < candidateCount; i++)
+	{
+		double cost = std::max(combined.Evaluate(candidates[i]), 0.0);
+		if (collapse.cost < 0.0 || cost < collapse.cost)
+		{
+			collapse.cost = cost;
+			collapse.target = candidates[i];
+		}
+	}
+
+	collapse.v0 = v0;
+	collapse.v1 = v1;
+	collapse.version0 = vertexVersion[v0];
+	collapse.version1 = vertexVersion[v1];
+}
+
+bool MeshSimplifier::CollapseFlipsTriangle(uint32_t moving, uint32_t other, const glm::dvec3& target) const
+{
+	const std::vector<uint32_t>& around = vertexTriangles[moving];
+	for (size_t i = 0; i < around.size(); i++)
+	{
+		uint32_t t = around[i];
+		if (triangleRemoved[t])
+			continue;
+
+		const uint32_t* corner = &triangles[t * 3];
+
+		// These ones disappear with the edge
+		if (corner[0] == other || corner[1] == other || corner[2] == other)
+			continue;
+
+		glm::dvec3 before[3], after[3];
+		for (int c = 0; c < 3; c++)
+		{
+			before[c] = positions[corner[c]];
+			after[c] = corner[c] == moving ? target : before[c];
+		}
+
+		glm::dvec3 normalBefore = glm::cross(before[1] - before[0], before[2] - before[0]);
+		glm::dvec3 normalAfter = glm::cross(after[1] - after[0], after[2] - after[0]);
+		double lengthBefore = glm::length(normalBefore);
+		double lengthAfter = glm::length(normalAfter);
+		if (lengthBefore <= 0.0 || lengthAfter <= 0.0)
+			continue;
+
+		if (glm::dot(normalBefore, normalAfter) < FLIP_COSINE * lengthBefore * lengthAfter)
+			return true;
+	}
+	return false;
+}
+
+bool MeshSimplifier::ApplyCollapse(const Collapse& collapse)
+{
+	uint32_t v0 = collapse.v0;
+	uint32_t v1 = collapse.v1;
+
+	// Stale entry, one of the ends has moved or gone since it was queued
+	if (vertexRemoved[v0] || vertexRemoved[v1])
+		return false;
+	if (vertexVersion[v0] != collapse.version0 || vertexVersion[v1] != collapse.version1)
+		return false;
+
+	if (CollapseFlipsTriangle(v0, v1, collapse.target) || CollapseFlipsTriangle(v1, v0, collapse.target))
+		return false;
+
+	// Move v0 onto the target and hand it everything v1 had
+	positions[v0] = collapse.target;
+	quadrics[v0] += quadrics[v1];
+
+	std::vector<uint32_t>& kept = vertexTriangles[v0];
+	const std::vector<uint32_t>& merged = vertexTriangles[v1];
+	for (size_t i = 0; i < merged.size(); i++)
+	{
+		uint32_t t = merged[i];
+		if (triangleRemoved[t])
+			continue;
+
+		uint32_t* corner = &triangles[t * 3];
+		if (corner[0] == v0 || corner[1] == v0 || corner[2] == v0)
+		{
+			triangleRemoved[t] = true;
+			liveTriangles--;
+			continue;
+		}
+
+		for (int c = 0; c < 3; c++)
+		{
+			if (corner[c] == v1)
+				corner[c] = v0;
+		}
+		kept.push_back(t);
+	}
+
+	kept.erase(std::remove_if(kept.begin(), kept.end(), [this](uint32_t t) { return (bool)triangleRemoved[t]; }), kept.end());
+
+	vertexRemoved[v1] = true;
+	vertexTriangles[v1].clear();
+	vertexVersion[v0]++;
+
+	// Report the error as a distance rather than an area weighted squared distance
+	if (quadrics[v0].weight > 0.0)
+		maxError = std::max(maxError, std::sqrt(collapse.cost / quadrics[v0].weight));
+
+	PushEdgesAround(v0);
+	return true;
+}
+
+void MeshSimplifier::PushEdgesAround(uint32_t vertex)
+{
+	std::vector<uint32_t> neighbours;
+
+	const std::vector<uint32_t>& around = vertexTriangles[vertex];
+	for (size_t i = 0; i < around.size(); i++)
+	{
+		const uint32_t* corner = &triangles[around[i] * 3];
+		for (int c = 0; c < 3; c++)
+		{
+			if (corner[c] != vertex && std::find(neighbours.begin(), neighbours.end(), corner[c]) == neighbours.end())
+				neighbours.push_back(corner[c]);
+		}
+	}
+
+	for (size_t i = 0; i < neighbours.size(); i++)
+	{
+		Collapse collapse;
+		ComputeCollapse(vertex, neighbours[i], collapse);
+		heap.push_back(collapse);
+		std::push_heap(heap.begin(), heap.end(), std::greater<Collapse>());
+	}
+}
+
+void MeshSimplifier::ExtractMesh(MeshData& mesh) const
+{
+	mesh.Clear();
+	mesh.vertices.reserve(liveTriangles * 9);
+	mesh.normals.reserve(liveTriangles * 9);
+
+	// Area weighted face normals, worked out once
+	std::vector<glm::dvec3> faceNormals(triangleRemoved.size());
+	for (size_t t = 0; t < triangleRemoved.size(); t++)
+	{
+		if (triangleRemoved[t])
+			continue;
+
+		const uint32_t* corner = &triangles[t * 3];
+		glm::dvec3 p0 = positions[corner[0]];
+		faceNormals[t] = glm::cross(positions[corner[1]] - p0, positions[corner[2]] - p0);
+	}
+
+	for (size_t t = 0; t < triangleRemoved.size(); t++)
+	{
+		if (triangleRemoved[t])
+			continue;
+
+		const uint32_t* corner = &triangles[t * 3];
+		double faceLength = glm::length(faceNormals[t]);
+
+		for (int c = 0; c < 3; c++)
+		{
+			// Smooth across the faces around this corner that aren't on the far side of a crease
+			glm::dvec3 normal(0.0);
+			const std::vector<uint32_t>& around = vertexTriangles[corner[c]];
+			for (size_t i = 0; i < around.size(); i++)
+			{
+				const glm::dvec3& other = faceNormals[around[i]];
+				double otherLength = glm::length(other);
+				if (glm::dot(faceNormals[t], other) >= CREASE_COSINE * faceLength * otherLength)
+					normal += other;
+			}
+
+			double length = glm::length(normal);
+			if (length > 0.0)
+				normal /= length;
+			else if (faceLength > 0.0)
+				normal = faceNormals[t] / faceLength;
+
+			const glm::dvec3& position = positions[corner[c]];
+			mesh.vertices.push_back((float)position.x);
+			mesh.vertices.push_back((float)position.y);
+			mesh.vertices.push_back((float)position.z);
+			mesh.normals.push_back((float)normal.x);
+			mesh.normals.push_back((float)normal.y);
+			mesh.normals.push_back((float)normal.z);
+		}
+	}
+
+	mesh.ComputeBounds();
+}
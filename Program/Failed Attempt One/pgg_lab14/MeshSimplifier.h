@@ -0,0 +1,88 @@
+/*!
+*  \brief     MeshSimplifier Class.
+*  \details   This class is to build lower detail versions of a mesh with quadric error metric edge collapses
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+#include "SDKS/glm/glm.hpp"
+#include "MeshData.h"
+
+/// Sum of squared distances to a set of planes, stored as the upper half of a symmetric 4x4 matrix
+/// weight is the total area the planes stand for, so cost / weight is a mean squared distance
+struct Quadric
+{
+	double a2, ab, ac, ad, b2, bc, bd, c2, cd, d2;
+	double weight;
+
+	Quadric();
+
+	/// Quadric for the plane ax + by + cz + d = 0 (a, b, c normalised), scaled by weight
+	static Quadric FromPlane(double a, double b, double c, double d, double weight);
+
+	Quadric& operator+=(const Quadric& other);
+
+	/// Squared distance error of putting a vertex at this point
+	double Evaluate(const glm::dvec3& point) const;
+
+	/// The point with the least error, false if the planes don't pin one down
+	bool FindOptimal(glm::dvec3& point) const;
+};
+
+class MeshSimplifier
+{
+public:
+	///ctor / dtor
+	MeshSimplifier();
+	~MeshSimplifier();
+
+	/// Build one level per ratio (fraction of the original triangles to keep, largest first)
+	/// A ratio of 1 or more gives back the original mesh untouched
+	void GenerateLods(const MeshData& mesh, const std::vector<float>& ratios, std::vector<MeshLod>& lods);
+
+	/// How much more a boundary edge costs to move than an inside one
+	void SetBoundaryWeight(float weight) { boundaryWeight = weight; }
+
+private:
+	struct Collapse
+	{
+		double cost;
+		uint32_t v0, v1;
+		uint32_t version0, version1;
+		glm::dvec3 target;
+
+		bool operator>(const Collapse& other) const { return cost > other.cost; }
+	};
+
+	// Setup
+	void BuildTopology(const IndexedMesh& mesh);
+	void BuildQuadrics();
+
+	// Edge collapses
+	void ComputeCollapse(uint32_t v0, uint32_t v1, Collapse& collapse) const;
+	bool CollapseFlipsTriangle(uint32_t moving, uint32_t other, const glm::dvec3& target) const;
+	bool ApplyCollapse(const Collapse& collapse);
+	void PushEdgesAround(uint32_t vertex);
+
+	// Snapshot of the current live triangles as a drawable mesh
+	void ExtractMesh(MeshData& mesh) const;
+
+	std::vector<glm::dvec3> positions;
+	std::vector<Quadric> quadrics;
+	std::vector<uint32_t> triangles;
+	std::vector<bool> triangleRemoved;
+	std::vector<bool> vertexRemoved;
+	std::vector<uint32_t> vertexVersion;
+	std::vector<std::vector<uint32_t> > vertexTriangles;
+	std::vector<Collapse> heap;
+
+	size_t liveTriangles;
+	double maxError;
+	float boundaryWeight;
+};
@@ -0,0 +1,174 @@
+/*!
+*  \brief     NormalGenerator Class.
+*  \details   This class is to work out normals for a mesh that came without any, smooth or flat
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "NormalGenerator.h"
+
+#include <cmath>
+#include "Platform.h"
+
+#if PGG_USE_SSE
+#include <xmmintrin.h>
+#endif
+
+// Shorter than this counts as no normal at all
+static const float MIN_LENGTH_SQ = 1.0e-30f;
+
+static size_t RoundUpToFour(size_t count)
+{
+	return (count + 3) & ~(size_t)3;
+}
+
+NormalGenerator::NormalGenerator()
+{
+
+}
+
+NormalGenerator::~NormalGenerator()
+{
+
+}
+
+void NormalGenerator::Generate(MeshData& mesh, NormalMode mode, const std::vector<uint8_t>* missing)
+{
+	size_t vertexCount = mesh.GetVertexCount();
+	size_t triangleCount = vertexCount / 3;
+	mesh.normals.resize(vertexCount * 3, 0.0f);
+	if (triangleCount == 0)
+		return;
+
+	ComputeFaceNormals(mesh, triangleCount);
+
+	if (mode == NormalMode::Flat)
+	{
+		Normalise(&faceX[0], &faceY[0], &faceZ[0], faceX.size());
+		for (size_t vertex = 0; vertex < triangleCount * 3; vertex++)
+		{
+			if (missing && !(*missing)[vertex])
+				continue;
+
+			size_t triangle = vertex / 3;
+			mesh.normals[vertex * 3] = faceX[triangle];
+			mesh.normals[vertex * 3 + 1] = faceY[triangle];
+			mesh.normals[vertex * 3 + 2] = faceZ[triangle];
+		}
+		return;
+	}
+
+	// Corners at the same position share one sum, bigger triangles pull harder
+	IndexedMesh welded = WeldPositions(mesh);
+	size_t positionCount = RoundUpToFour(welded.positions.size());
+	sumX.assign(positionCount, 0.0f);
+	sumY.assign(positionCount, 0.0f);
+	sumZ.assign(positionCount, 0.0f);
+
+	for (size_t triangle = 0; triangle < triangleCount; triangle++)
+	{
+		for (int corner = 0; corner < 3; corner++)
+		{
+			uint32_t position = welded.indices[triangle * 3 + corner];
+			sumX[position] += faceX[triangle];
+			sumY[position] += faceY[triangle];
+			sumZ[position] += faceZ[triangle];
+		}
+	}
+
+	Normalise(&sumX[0], &sumY[0], &sumZ[0], positionCount);
+	for (size_t vertex = 0; vertex < triangleCount * 3; vertex++)
+	{
+		if (missing && !(*missing)[vertex])
+			continue;
+
+		uint32_t position = welded.indices[vertex];
+		mesh.normals[vertex * 3] = sumX[position];
+		mesh.normals[vertex * 3 + 1] = sumY[position];
+		mesh.normals[vertex * 3 + 2] = sumZ[position];
+	}
+}
+
+void NormalGenerator::ComputeFaceNormals(const MeshData& mesh, size_t triangleCount)
+{
+	size_t paddedCount = RoundUpToFour(triangleCount);
+	faceX.assign(paddedCount, 0.0f);
+	faceY.assign(paddedCount, 0.0f);
+	faceZ.assign(paddedCount, 0.0f);
+
+	const float* vertices = &mesh.vertices[0];
+	size_t triangle = 0;
+
+#if PGG_USE_SSE
+	// Gather four triangles' corners into one register per component, then it's three multiplies and subtracts for all four
+	for (; triangle + 4 <= triangleCount; triangle += 4)
+	{
+		const float* t = vertices + triangle * 9;
+		__m128 x0 = _mm_setr_ps(t[0], t[9], t[18], t[27]);
+		__m128 y0 = _mm_setr_ps(t[1], t[10], t[19], t[28]);
+		__m128 z0 = _mm_setr_ps(t[2], t[11], t[20], t[29]);
+		__m128 edge1X = _mm_sub_ps(_mm_setr_ps(t[3], t[12], t[21], t[30]), x0);
+		__m128 edge1Y = _mm_sub_ps(_mm_setr_ps(t[4], t[13], t[22], t[31]), y0);
+		__m128 edge1Z = _mm_sub_ps(_mm_setr_ps(t[5], t[14], t[23], t[32]), z0);
+		__m128 edge2X = _mm_sub_ps(_mm_setr_ps(t[6], t[15], t[24], t[33]), x0);
+		__m128 edge2Y = _mm_sub_ps(_mm_setr_ps(t[7], t[16], t[25], t[34]), y0);
+		__m128 edge2Z = _mm_sub_ps(_mm_setr_ps(t[8], t[17], t[26], t[35]), z0);
+
+		_mm_store_ps(&faceX[triangle], _mm_sub_ps(_mm_mul_ps(edge1Y, edge2Z), _mm_mul_ps(edge1Z, edge2Y)));
+		_mm_store_ps(&faceY[triangle], _mm_sub_ps(_mm_mul_ps(edge1Z, edge2X), _mm_mul_ps(edge1X, edge2Z)));
+		_mm_store_ps(&faceZ[triangle], _mm_sub_ps(_mm_mul_ps(edge1X, edge2Y), _mm_mul_ps(edge1Y, edge2X)));
+	}
+#endif
+
+	for (; triangle < triangleCount; triangle++)
+	{
+		const float* t = vertices + triangle * 9;
+		float edge1X = t[3] - t[0], edge1Y = t[4] - t[1], edge1Z = t[5] - t[2];
+		float edge2X = t[6] - t[0], edge2Y = t[7] - t[1], edge2Z = t[8] - t[2];
+		faceX[triangle] = edge1Y * edge2Z - edge1Z * edge2Y;
+		faceY[triangle] = edge1Z * edge2X - edge1X * edge2Z;
+		faceZ[triangle] = edge1X * edge2Y - edge1Y * edge2X;
+	}
+}
+
+void NormalGenerator::Normalise(float* x, float* y, float* z, size_t count)
+{
+	size_t i = 0;
+
+#if PGG_USE_SSE
+	__m128 minLengthSq = _mm_set1_ps(MIN_LENGTH_SQ);
+	__m128 one = _mm_set1_ps(1.0f);
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128 vx = _mm_load_ps(x + i), vy = _mm_load_ps(y + i), vz = _mm_load_ps(z + i);
+		__m128 lengthSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy)), _mm_mul_ps(vz, vz));
+
+		// A real divide rather than rsqrt, so the result matches the scalar path to the last bit or so
+		__m128 valid = _mm_cmpgt_ps(lengthSq, minLengthSq);
+		__m128 inverse = _mm_div_ps(one, _mm_sqrt_ps(_mm_max_ps(lengthSq, minLengthSq)));
+
+		_mm_store_ps(x + i, _mm_or_ps(_mm_and_ps(valid, _mm_mul_ps(vx, inverse)), _mm_andnot_ps(valid, one)));
+		_mm_store_ps(y + i, _mm_and_ps(valid, _mm_mul_ps(vy, inverse)));
+		_mm_store_ps(z + i, _mm_and_ps(valid, _mm_mul_ps(vz, inverse)));
+	}
+#endif
+
+	for (; i < count; i++)
+	{
+		float lengthSq = x[i] * x[i] + y[i] * y[i] + z[i] * z[i];
+		if (lengthSq > MIN_LENGTH_SQ)
+		{
+			float inverse = 1.0f / std::sqrt(lengthSq);
+			x[i] *= inverse;
+			y[i] *= inverse;
+			z[i] *= inverse;
+		}
+		else
+		{
+			x[i] = 1.0f;
+			y[i] = z[i] = 0.0f;
+		}
+	}
+}
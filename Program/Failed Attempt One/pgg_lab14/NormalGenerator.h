@@ -0,0 +1,45 @@
+/*!
+*  \brief     NormalGenerator Class.
+*  \details   This class is to work out normals for a mesh that came without any, smooth or flat
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+#include "AlignedAllocator.h"
+#include "MeshData.h"
+
+/// How normals are shared between triangles
+enum class NormalMode
+{
+	Smooth,	///< Every triangle touching a position adds its normal, weighted by its area
+	Flat	///< Each triangle's own normal on all three of its corners
+};
+
+class NormalGenerator
+{
+public:
+	///ctor / dtor
+	NormalGenerator();
+	~NormalGenerator();
+
+	/// Work out mesh.normals from the positions - when missing is given only the vertices flagged in it
+	/// are written (so the ones the file did have are kept), otherwise all of them are
+	void Generate(MeshData& mesh, NormalMode mode, const std::vector<uint8_t>* missing = nullptr);
+
+private:
+	// Cross product of each triangle's edges (twice its area long), four triangles at a time
+	void ComputeFaceNormals(const MeshData& mesh, size_t triangleCount);
+
+	// Make every vector unit length, ones with no length become the loader's old default of (1, 0, 0)
+	static void Normalise(float* x, float* y, float* z, size_t count);
+
+	// One component per array, padded to a multiple of four, kept between calls so loading many meshes doesn't reallocate
+	AlignedVector<float> faceX, faceY, faceZ;
+	AlignedVector<float> sumX, sumY, sumZ;
+};
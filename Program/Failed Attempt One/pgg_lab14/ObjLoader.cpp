@@ -8,151 +8,277 @@
 */
 
 #include "ObjLoader.h"
-#include <sstream>
+#include "MappedFile.h"
+#include "NormalGenerator.h"
+#include "TextParser.h"
+#include <cstdio>
+#include <cstring>
 
-ObjLoader::ObjLoader() {
+//reads up to count floats off a line, any that aren't there are left as they were
+static void ReadFloats(const char* text, const char* end, float* values, int count) {
+
+	for (int i = 0; i < count; i++)
+		text = TextParser::ParseFloat(text, end, values[i]);
+}
 
+ObjLoader::ObjLoader() {
+	currentMaterial = -1;
+	missingNormalCount = 0;
 }
 
 ObjLoader::~ObjLoader() {
 
 }
 
-void ObjLoader::Load(std::string objFileName) {
+bool ObjLoader::Load(std::string objFileName) {
 
-	FILE * objFile;
+	//the whole file is parsed straight out of memory
+	MappedFile objFile;
 
-	fopen_s(&objFile, objFileName.c_str(), "r");
+	if (!objFile.Open(objFileName)) {
+		printf("Could not open obj file: %s\n", objFileName.c_str());
+		return false;
+	}
 
-	if (NULL == objFile)
-		printf("Could not open obj file: %s\n", objFileName);
+	//mtllib and map names are relative to the obj, not the working directory
+	objDirectory = MaterialLibrary::GetDirectory(objFileName);
 
 	//rips the raw data out of the obj file and stores it in various std::vectors
-	ReadObjFileData(objFile);
+	const char* text = (const char*)objFile.GetData();
+	ReadObjFileData(text, text + objFile.GetSize());
 
 	//builds vertex and normal std::vectors based on the above
 	BuildMeshVertAndNormalLists();
 
-	fclose(objFile);
-}
+	//faces without "vn" get smooth normals, the ones the file gave are kept
+	if (missingNormalCount > 0) {
+		NormalGenerator normalGenerator;
+		normalGenerator.Generate(mesh, NormalMode::Smooth, missingNormalCount < missingNormals.size() ? &missingNormals : nullptr);
+	}
 
-void ObjLoader::ReadObjFileData(FILE* objFile) {
+	//the mesh keeps the materials its subsets point at
+	if (!mesh.subsets.empty())
+		mesh.materials = std::move(materials.GetMaterials());
 
-	char buffer[256];
+	//box and sphere for culling
+	mesh.ComputeBounds();
 
-	while (true)
-	{
+	return true;
+}
 
-		int read = fscanf_s(objFile, "%s", buffer, sizeof(buffer));
+void ObjLoader::ReadObjFileData(const char* text, const char* end) {
 
-		if (read == EOF) break;
+	while (text < end)
+	{
+		//one line at a time - the first word says what the rest of it is
+		const char* lineEnd = TextParser::LineEnd(text, end);
+		const char* keyword = TextParser::SkipSpaces(text, lineEnd);
+		const char* keywordEnd = TextParser::WordEnd(keyword, lineEnd);
+		const char* rest = TextParser::SkipSpaces(keywordEnd, lineEnd);
+		text = TextParser::NextLine(lineEnd, end);
 
 		//if first part of the line is "v"
-		if (strcmp(buffer, "v") == 0) {
-			//printf("Found a Vertex:\n");
-			glm::vec3 vert;
-			fscanf_s(objFile, "%f %f %f\n", &vert.x, &vert.y, &vert.z);
+		if (TextParser::IsWord(keyword, keywordEnd, "v")) {
+			glm::vec3 vert(0.0f);
+			ReadFloats(rest, lineEnd, &vert.x, 3);
 			objFileVerts.push_back(vert);
 		}
 
 		//if first part of the line is "vn"
-		else if (strcmp(buffer, "vn") == 0) {
-			//printf("Found a Vertex Normal:\n");
-			glm::vec3 normal;
-			fscanf_s(objFile, "%f %f %f\n", &normal.x, &normal.y, &normal.z);
+		else if (TextParser::IsWord(keyword, keywordEnd, "vn")) {
+			glm::vec3 normal(0.0f);
+			ReadFloats(rest, lineEnd, &normal.x, 3);
 			objFileNormals.push_back(normal);
 		}
 
-		//if first part of the line is "f"
-		else if (strcmp(buffer, "f") == 0) {
-			//printf("Found f:\n");
-
-			fscanf_s(objFile, "%256[^\n]", buffer, sizeof(buffer));
-			std::string s(buffer);
-			std::stringstream stream(s);
-
-			std::string split;
-			std::vector<std::string> splits;
-			while (stream >> split)
-				splits.push_back(split);
-
-			std::vector<FaceVertexData> tmpFaceVerts;
-			for (size_t i = 0; i < splits.size(); i++)
-				tmpFaceVerts.push_back(ExtractFaceVertexData(splits[i]));
-
-			size_t i = 0;
-			do {
-				faceVerts.push_back(tmpFaceVerts[0]);
-				faceVerts.push_back(tmpFaceVerts[i + 1]);
-				faceVerts.push_back(tmpFaceVerts[i + 2]);
-				i++;
-			} while (i < tmpFaceVerts.size() - 2);
+		//if first part of the line is "vt" (the optional w is ignored)
+		else if (TextParser::IsWord(keyword, keywordEnd, "vt")) {
+			glm::vec2 texCoord(0.0f);
+			ReadFloats(rest, lineEnd, &texCoord.x, 2);
 
+			//obj v goes up from the bottom of the image, the images are uploaded top row first
+			texCoord.y = 1.0f - texCoord.y;
+			objFileTexCoords.push_back(texCoord);
 		}
-		else {
+
+		//if first part of the line is "mtllib"
+		else if (TextParser::IsWord(keyword, keywordEnd, "mtllib")) {
+			const char* nameEnd = lineEnd;
+			while (nameEnd > rest && (nameEnd[-1] == ' ' || nameEnd[-1] == '\t'))
+				nameEnd--;
+
+			//carries on without it - faces using its materials get the model's own colours
+			if (nameEnd > rest)
+				materials.Load(objDirectory + std::string(rest, nameEnd));
+		}
+
+		//if first part of the line is "usemtl"
+		else if (TextParser::IsWord(keyword, keywordEnd, "usemtl")) {
+			currentMaterial = materials.Find(std::string(rest, TextParser::WordEnd(rest, lineEnd)));
+		}
+
+		//if first part of the line is "f"
+		else if (TextParser::IsWord(keyword, keywordEnd, "f")) {
+			ReadFace(rest, lineEnd);
 		}
 	}
 }
 
-void ObjLoader::BuildMeshVertAndNormalLists() {
+//turns a relative (negative) index into the one it counts back to, 0 if it's out of range
+static int ResolveIndex(int index, size_t count) {
 
-	for (size_t i = 0; i < faceVerts.size(); i++) {
-		//the ith vnp in the std::vector
-		FaceVertexData* vnp = &faceVerts[i];
+	if (index < 0)
+		index += (int)count + 1;
+	return (index > 0 && index <= (int)count) ? index : 0;
+}
 
-		//pack ith vnp's vertex data into the meshVertices list
-		if (vnp->Vertex > 0) {
-			meshVertices.push_back(objFileVerts[vnp->Vertex - 1].x);
-			meshVertices.push_back(objFileVerts[vnp->Vertex - 1].y);
-			meshVertices.push_back(objFileVerts[vnp->Vertex - 1].z);
-		}
+void ObjLoader::ReadFace(const char* text, const char* end) {
 
-		//pack ith vnp's normal data into the meshVertices list
-		if (vnp->Normal > 0) {
-			meshNormals.push_back(objFileVerts[vnp->Normal - 1].x);
-			meshNormals.push_back(objFileVerts[vnp->Normal - 1].y);
-			meshNormals.push_back(objFileVerts[vnp->Normal - 1].z);
-		}
-		else {
+	//every corner of the polygon, parsed in place - the buffers keep their memory from face to face
+	polygon.clear();
+	while (true) {
+		text = TextParser::SkipSpaces(text, end);
+		if (text == end || *text == '#')
+			break;
 
-			meshNormals.push_back(1);
-			meshNormals.push_back(0);
-			meshNormals.push_back(0);
-		}
+		const char* tokenEnd = TextParser::WordEnd(text, end);
+		FaceVertexData corner;
+
+		//a corner without a real position makes the whole face useless
+		if (!ExtractFaceVertexData(text, tokenEnd, corner))
+			return;
+
+		polygon.push_back(corner);
+		text = tokenEnd;
+	}
+
+	if (polygon.size() < 3)
+		return;
+
+	//triangles go straight in, anything bigger is fanned or ear clipped
+	if (polygon.size() == 3) {
+		faceVerts.insert(faceVerts.end(), polygon.begin(), polygon.end());
+		faceMaterials.push_back(currentMaterial);
+		return;
+	}
+
+	polygonCorners.clear();
+	for (size_t i = 0; i < polygon.size(); i++)
+		polygonCorners.push_back(objFileVerts[polygon[i].Vertex - 1]);
+
+	triangulator.Triangulate(&polygonCorners[0], polygonCorners.size(), polygonTriangles);
+	for (size_t i = 0; i < polygonTriangles.size(); i += 3) {
+		faceVerts.push_back(polygon[polygonTriangles[i]]);
+		faceVerts.push_back(polygon[polygonTriangles[i + 1]]);
+		faceVerts.push_back(polygon[polygonTriangles[i + 2]]);
+		faceMaterials.push_back(currentMaterial);
 	}
 }
 
-FaceVertexData ObjLoader::ExtractFaceVertexData(std::string& s) {
+void ObjLoader::BuildMeshVertAndNormalLists() {
 
-	int slashPos[2];
-	int slashCount = 0;
+	size_t triangleCount = faceVerts.size() / 3;
+
+	missingNormals.reserve(faceVerts.size());
+	mesh.vertices.reserve(faceVerts.size() * 3);
+	mesh.normals.reserve(faceVerts.size() * 3);
+	if (!objFileTexCoords.empty())
+		mesh.texCoords.reserve(faceVerts.size() * 2);
+
+	//count the triangles using each material (slot 0 is the ones without one)
+	size_t materialCount = materials.GetMaterials().size();
+	std::vector<uint32_t> slotStart(materialCount + 2, 0);
+	for (size_t i = 0; i < triangleCount; i++)
+		slotStart[faceMaterials[i] + 2]++;
+
+	//nothing has a material - keep the file order, the model draws it in one go
+	if (slotStart[1] == triangleCount) {
+		for (size_t i = 0; i < faceVerts.size(); i++)
+			AddMeshVertex(faceVerts[i]);
+		return;
+	}
 
-	for (size_t i = 0; i < s.size(); i++) {
-		if (s[i] == '/') {
-			slashPos[slashCount] = i;
-			slashCount++;
+	//put each material's triangles together so the model only switches material once per subset
+	for (size_t slot = 1; slot < slotStart.size(); slot++)
+		slotStart[slot] += slotStart[slot - 1];
+
+	std::vector<uint32_t> order(triangleCount);
+	std::vector<uint32_t> next(slotStart.begin(), slotStart.end() - 1);
+	for (size_t i = 0; i < triangleCount; i++)
+		order[next[faceMaterials[i] + 1]++] = (uint32_t)i;
+
+	for (size_t slot = 0; slot + 1 < slotStart.size(); slot++) {
+		uint32_t count = slotStart[slot + 1] - slotStart[slot];
+		if (count == 0)
+			continue;
+
+		MeshSubset subset;
+		subset.firstVertex = slotStart[slot] * 3;
+		subset.vertexCount = count * 3;
+		subset.material = (int32_t)slot - 1;
+		mesh.subsets.push_back(subset);
+
+		for (uint32_t i = slotStart[slot]; i < slotStart[slot + 1]; i++) {
+			AddMeshVertex(faceVerts[order[i] * 3]);
+			AddMeshVertex(faceVerts[order[i] * 3 + 1]);
+			AddMeshVertex(faceVerts[order[i] * 3 + 2]);
 		}
 	}
+}
 
-	FaceVertexData result;
+void ObjLoader::AddMeshVertex(const FaceVertexData& vnp) {
 
-	if (slashCount == 0) {
-	
-		result.Vertex = std::stoi(s); 
+	//pack the vnp's vertex data into the meshVertices list (ReadFace only keeps faces whose vertices are all there)
+	mesh.vertices.push_back(objFileVerts[vnp.Vertex - 1].x);
+	mesh.vertices.push_back(objFileVerts[vnp.Vertex - 1].y);
+	mesh.vertices.push_back(objFileVerts[vnp.Vertex - 1].z);
+
+	//pack the vnp's normal data into the meshNormals list
+	if (vnp.Normal > 0) {
+		mesh.normals.push_back(objFileNormals[vnp.Normal - 1].x);
+		mesh.normals.push_back(objFileNormals[vnp.Normal - 1].y);
+		mesh.normals.push_back(objFileNormals[vnp.Normal - 1].z);
+		missingNormals.push_back(0);
+	}
+	else {
+
+		//filled in from the triangles once the whole mesh is built
+		mesh.normals.push_back(0);
+		mesh.normals.push_back(0);
+		mesh.normals.push_back(0);
+		missingNormals.push_back(1);
+		missingNormalCount++;
 	}
-	else if (slashCount == 1) {
 
-		result.Vertex = std::stoi(s.substr(0, slashPos[0]));	
-		result.Normal = std::stoi(s.substr(slashPos[0] + 1));   
+	//texture coordinates only if the file has any, (0, 0) for a vertex without one
+	if (!objFileTexCoords.empty()) {
+		if (vnp.TexCoord > 0) {
+			mesh.texCoords.push_back(objFileTexCoords[vnp.TexCoord - 1].x);
+			mesh.texCoords.push_back(objFileTexCoords[vnp.TexCoord - 1].y);
+		}
+		else {
+			mesh.texCoords.push_back(0);
+			mesh.texCoords.push_back(0);
+		}
 	}
-	else if (slashCount == 2) {
+}
 
-		result.Vertex = std::stoi(s.substr(0, slashPos[0]));  
-		result.Normal = std::stoi(s.substr(slashPos[1] + 1)); 
+bool ObjLoader::ExtractFaceVertexData(const char* text, const char* end, FaceVertexData& result) {
 
-		std::string texCoordString = s.substr(slashPos[0] + 1, (slashPos[1] - (slashPos[0])) - 1);
-		if (texCoordString.size() > 0)
-			result.TexCoord = std::stoi(texCoordString);
+	//"v", "v/vt", "v//vn" or "v/vt/vn" - an index that isn't there stays 0
+	const char* next = TextParser::ParseInt(text, end, result.Vertex);
+	if (next == text)
+		return false;
+
+	if (next < end && *next == '/') {
+		next = TextParser::ParseInt(next + 1, end, result.TexCoord);
+		if (next < end && *next == '/')
+			TextParser::ParseInt(next + 1, end, result.Normal);
 	}
-	return result;
+
+	//negative indices count back from the last of their kind read so far
+	result.Vertex = ResolveIndex(result.Vertex, objFileVerts.size());
+	result.TexCoord = ResolveIndex(result.TexCoord, objFileTexCoords.size());
+	result.Normal = ResolveIndex(result.Normal, objFileNormals.size());
+	return result.Vertex > 0;
 }
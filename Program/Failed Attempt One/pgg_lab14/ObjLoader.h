@@ -13,6 +13,9 @@
 #include <string>
 #include "SDKS/glm/glm.hpp"
 #include <vector>
+#include "MeshData.h"
+#include "MaterialLibrary.h"
+#include "PolygonTriangulator.h"
 
 struct FaceVertexData {
 	int Vertex;
@@ -33,29 +36,59 @@ public:
 	ObjLoader();
 	~ObjLoader();
 
-	/// Load the Object in
-	void Load(std::string objFileName);
+	/// Load the Object in, false if the file couldn't be opened
+	bool Load(std::string objFileName);
 
 	/// Get the Mesh Verticies & normals
-	std::vector<float>& GetMeshVertices() { return meshVertices; }
-	std::vector<float>& GetMeshNormals() { return meshNormals; }
+	std::vector<float>& GetMeshVertices() { return mesh.vertices; }
+	std::vector<float>& GetMeshNormals() { return mesh.normals; }
+
+	/// Get the whole Mesh (move it out to keep it after the loader is gone)
+	/// Triangles come out grouped by material, with a subset for each run
+	MeshData& GetMeshData() { return mesh; }
 
 private:
 
 	//store raw data read out of a file
 	std::vector<glm::vec3> objFileVerts;
 	std::vector<glm::vec3> objFileNormals;
+	std::vector<glm::vec2> objFileTexCoords;
 	std::vector<FaceVertexData> faceVerts;
 
+	//material of each triangle in faceVerts (-1 if it has none, or it wasn't in any mtllib)
+	std::vector<int> faceMaterials;
+
+	//materials from every mtllib, and the one usemtl last picked
+	MaterialLibrary materials;
+	int currentMaterial;
+
+	//one per mesh vertex, set if its face vertex had no usable normal
+	std::vector<uint8_t> missingNormals;
+	size_t missingNormalCount;
+
+	//mtllib names are relative to the obj
+	std::string objDirectory;
+
 	//extracts bits of an obj file into the above std::vectors
-	void ReadObjFileData(FILE* objFile);
+	void ReadObjFileData(const char* text, const char* end);
 
 	void BuildMeshVertAndNormalLists();
 
-	std::vector<float> meshVertices;
-	std::vector<float> meshNormals;
+	//pack one face vertex onto the end of the mesh streams
+	void AddMeshVertex(const FaceVertexData& vnp);
+
+	MeshData mesh;
+
+	//reads a token like "3//5" into a VNP with 3 & 5 in it, false if it has no usable vertex
+	bool ExtractFaceVertexData(const char* text, const char* end, FaceVertexData& result);
+
+	//reads the corners after an "f" and adds the polygon as triangles
+	void ReadFace(const char* text, const char* end);
 
-	//reads a string like "3//5" and returns a VNP with 3 & 5 in it
-	FaceVertexData ExtractFaceVertexData(std::string& s);
+	//the face being read, kept so a polygon of any size costs no allocations once they've grown to fit
+	std::vector<FaceVertexData> polygon;
+	std::vector<glm::vec3> polygonCorners;
+	std::vector<uint32_t> polygonTriangles;
+	PolygonTriangulator triangulator;
 
 };
\ No newline at end of file
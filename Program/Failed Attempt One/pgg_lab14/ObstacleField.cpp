@@ -0,0 +1,84 @@
+/*!
+*  \brief     ObstacleField Class.
+*  \details   This class is to store the rows of obstacles and check the Rocket against them
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "ObstacleField.h"
+
+ObstacleField::ObstacleField()
+{
+	rowDepth = 10.0f;
+	finishLine = -1280.0f;
+}
+
+ObstacleField::~ObstacleField()
+{
+
+}
+
+void ObstacleField::loadDefaultLevel()
+{
+	clear();
+
+	// Row				 |Z|		|X|  |Width|
+	addRow(-165.0f,		{ { -116.10f, 43 }, { -57, 15 }, { -22, 15 }, { 11, 49 }, { 84, 16 } });
+	addRow(-255.0f,		{ { -83, 76 }, { 43, 76 } });
+	addRow(-333.0f,		{ { -116.10f, 22 }, { -59, 84 }, { 59.50f, 84 } });
+	addRow(-420.0f,		{ { -99, 74 }, { 9, 76 } });
+	addRow(-510.0f,		{ { -116.10f, 116 }, { 68, 90 } });
+	addRow(-606.0f,		{ { -116.10f, 136 }, { 60, 90 } });
+	addRow(-716.0f,		{ { -116.10f, 65 }, { 23, 90 } });
+	addRow(-815.0f,		{ { -116.10f, 126 }, { 68, 90 } });
+	addRow(-940.0f,		{ { -116.10f, 189 } });
+	addRow(-1070.0f,	{ { -116.10f, 80 }, { 41, 90 } });
+	addRow(-1190.0f,	{ { -116.10f, 98 }, { 6, 108 } });
+
+	finishLine = -1280.0f;
+}
+
+void ObstacleField::addRow(float z, const std::vector<Obstacle>& obstacles)
+{
+	ObstacleRow row;
+	row.z = z;
+	row.obstacles = obstacles;
+	rows.push_back(row);
+}
+
+void ObstacleField::clear()
+{
+	rows.clear();
+}
+
+bool hitsRow(const ObstacleRow& row, float rowDepth, const glm::vec3& position)
+{
+	// Only check the row the Rocket is inside of
+	if (position.z <= row.z || position.z >= row.z + rowDepth)
+		return false;
+
+	for (const Obstacle& obstacle : row.obstacles)
+	{
+		// Have you hit?
+		if (position.x > obstacle.x && position.x < obstacle.x + obstacle.width)
+			return true;
+	}
+	return false;
+}
+
+CollisionResult ObstacleField::checkCollisions(const glm::vec3& position) const
+{
+	for (const ObstacleRow& row : rows)
+	{
+		if (hitsRow(row, rowDepth, position))
+			return CollisionResult::Crashed;
+	}
+
+	// Have you won?
+	if (position.z < finishLine)
+		return CollisionResult::Finished;
+
+	return CollisionResult::None;
+}
@@ -0,0 +1,74 @@
+/*!
+*  \brief     ObstacleField Class.
+*  \details   This class is to store the rows of obstacles and check the Rocket against them
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#pragma once
+
+#include <vector>
+#include "SDKS/glm/glm.hpp"
+
+/// One obstacle in a row - it blocks X up to X + Width
+struct Obstacle
+{
+	float x;
+	float width;
+};
+
+/// A row of obstacles that all sit at the same Z
+struct ObstacleRow
+{
+	float z;
+	std::vector<Obstacle> obstacles;
+};
+
+/// True if the position is inside the row and hitting one of its obstacles
+bool hitsRow(const ObstacleRow& row, float rowDepth, const glm::vec3& position);
+
+/// What happened when the Rocket was checked against the field
+enum class CollisionResult
+{
+	None,
+	Crashed,
+	Finished
+};
+
+class ObstacleField
+{
+public:
+	/// Constructor and Destructor
+	ObstacleField();
+	~ObstacleField();
+
+	/// Fill the field with the hand placed rows of "Level Final.obj"
+	void loadDefaultLevel();
+
+	/// Add a row or empty the field
+	void addRow(float z, const std::vector<Obstacle>& obstacles);
+	void clear();
+
+	/// Check a position against every row and the finish line
+	CollisionResult checkCollisions(const glm::vec3& position) const;
+
+	/// Getters
+	const std::vector<ObstacleRow>& getRows() const { return rows; }
+	float getRowDepth() const { return rowDepth; }
+	float getFinishLine() const { return finishLine; }
+
+	/// Setters
+	void setFinishLine(float z) { finishLine = z; }
+
+private:
+	// Rows in the order they were added
+	std::vector<ObstacleRow> rows;
+
+	// How far along Z a row reaches
+	float rowDepth;
+
+	// Z the Rocket has to pass to win
+	float finishLine;
+};
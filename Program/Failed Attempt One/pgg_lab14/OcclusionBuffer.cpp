@@ -0,0 +1,243 @@
+/*!
+*  \brief     OcclusionBuffer Class.
+*  \details   This class is to draw the biggest blockers into a small depth buffer on the CPU so anything hidden behind them is never drawn
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "OcclusionBuffer.h"
+
+#include <algorithm>
+#include <cmath>
+
+// Anything this close to the eye (in clip w) is treated as crossing the near plane
+static const float MIN_CLIP_W = 1.0e-4f;
+
+// Faces of a box as corners (bit 0 = x, bit 1 = y, bit 2 = z set means max), anticlockwise from outside
+static const int BOX_FACES[6][4] =
+{
+	{ 0, 4, 6, 2 }, { 1, 3, 7, 5 },
+	{ 0, 1, 5, 4 }, { 2, 6, 7, 3 },
+	{ 0, 2, 3, 1 }, { 4, 5, 7, 6 }
+};
+
+OcclusionBuffer::OcclusionBuffer(int width, int height)
+	: width(std::max(1, width)), height(std::max(1, height))
+{
+	occluderCount = 0;
+	viewProjection = glm::mat4(1.0f);
+
+	// Halve (rounding up) down to a single texel
+	int levelWidth = this->width;
+	int levelHeight = this->height;
+	while (true)
+	{
+		DepthLevel level;
+		level.width = levelWidth;
+		level.height = levelHeight;
+		level.depth.assign((size_t)levelWidth * levelHeight, 1.0f);
+		levels.push_back(level);
+
+		if (levelWidth == 1 && levelHeight == 1)
+			break;
+
+		levelWidth = (levelWidth + 1) / 2;
+		levelHeight = (levelHeight + 1) / 2;
+	}
+}
+
+OcclusionBuffer::~OcclusionBuffer()
+{
+
+}
+
+void OcclusionBuffer::clear(const glm::mat4& viewProjection)
+{
+	this->viewProjection = viewProjection;
+	occluderCount = 0;
+
+	for (DepthLevel& level : levels)
+		std::fill(level.depth.begin(), level.depth.end(), 1.0f);
+}
+
+void OcclusionBuffer::addOccluder(const glm::vec3& boxMin, const glm::vec3& boxMax)
+{
+	// Corners in screen space - x and y in buffer pixels (y up), z as depth from 0 to 1
+	glm::vec3 corners[8];
+	bool allLeft = true, allRight = true, allBelow = true, allAbove = true;
+	for (int i = 0; i < 8; i++)
+	{
+		glm::vec4 clip = viewProjection * glm::vec4((i & 1) ? boxMax.x : boxMin.x,
+													(i & 2) ? boxMax.y : boxMin.y,
+													(i & 4) ? boxMax.z : boxMin.z, 1.0f);
+
+		// Clipping isn't worth it for a blocker, just leave out the ones the camera is inside
+		if (clip.w < MIN_CLIP_W)
+			return;
+
+		glm::vec3 ndc = glm::vec3(clip) / clip.w;
+		corners[i] = glm::vec3((ndc.x * 0.5f + 0.5f) * width, (ndc.y * 0.5f + 0.5f) * height, ndc.z * 0.5f + 0.5f);
+
+		allLeft = allLeft && corners[i].x < 0.0f;
+		allRight = allRight && corners[i].x > (float)width;
+		allBelow = allBelow && corners[i].y < 0.0f;
+		allAbove = allAbove && corners[i].y > (float)height;
+	}
+
+	if (allLeft || allRight || allBelow || allAbove)
+		return;
+
+	for (const int* face : BOX_FACES)
+	{
+		drawTriangle(corners[face[0]], corners[face[1]], corners[face[2]]);
+		drawTriangle(corners[face[0]], corners[face[2]], corners[face[3]]);
+	}
+	occluderCount++;
+}
+
+void OcclusionBuffer::drawTriangle(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c)
+{
+	// Back faces are behind the front ones anyway
+	float area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+	if (area <= 0.0f)
+		return;
+
+	int minX = std::max(0, (int)std::floor(std::min(a.x, std::min(b.x, c.x))));
+	int maxX = std::min(width - 1, (int)std::ceil(std::max(a.x, std::max(b.x, c.x))));
+	int minY = std::max(0, (int)std::floor(std::min(a.y, std::min(b.y, c.y))));
+	int maxY = std::min(height - 1, (int)std::ceil(std::max(a.y, std::max(b.y, c.y))));
+	if (minX > maxX || minY > maxY)
+		return;
+
+	// Edge functions at the first pixel centre, and how much they change per pixel along x and y
+	float startX = minX + 0.5f, startY = minY + 0.5f;
+	float rowBC = (c.x - b.x) * (startY - b.y) - (c.y - b.y) * (startX - b.x);
+	float rowCA = (a.x - c.x) * (startY - c.y) - (a.y - c.y) * (startX - c.x);
+	float rowAB = (b.x - a.x) * (startY - a.y) - (b.y - a.y) * (startX - a.x);
+	float stepXBC = -(c.y - b.y), stepXCA = -(a.y - c.y), stepXAB = -(b.y - a.y);
+	float stepYBC = c.x - b.x, stepYCA = a.x - c.x, stepYAB = b.x - a.x;
+
+	// Depth is linear across the screen, so it's just the edge functions weighted
+	float inverseArea = 1.0f / area;
+
+	std::vector<float>& depth = levels[0].depth;
+	for (int y = minY; y <= maxY; y++)
+	{
+		float edgeBC = rowBC, edgeCA = rowCA, edgeAB = rowAB;
+		float* row = &depth[(size_t)y * width];
+
+		for (int x = minX; x <= maxX; x++)
+		{
+			if (edgeBC >= 0.0f && edgeCA >= 0.0f && edgeAB >= 0.0f)
+			{
+				float z = (edgeBC * a.z + edgeCA * b.z + edgeAB * c.z) * inverseArea;
+				if (z < row[x])
+					row[x] = z;
+			}
+
+			edgeBC += stepXBC;
+			edgeCA += stepXCA;
+			edgeAB += stepXAB;
+		}
+
+		rowBC += stepYBC;
+		rowCA += stepYCA;
+		rowAB += stepYAB;
+	}
+}
+
+void OcclusionBuffer::buildPyramid()
+{
+	// Each texel keeps the farthest of the four below it, so a test against it is never too eager
+	for (size_t l = 1; l < levels.size(); l++)
+	{
+		const DepthLevel& below = levels[l - 1];
+		DepthLevel& level = levels[l];
+
+		for (int y = 0; y < level.height; y++)
+		{
+			int y0 = y * 2;
+			int y1 = std::min(y0 + 1, below.height - 1);
+
+			for (int x = 0; x < level.width; x++)
+			{
+				int x0 = x * 2;
+				int x1 = std::min(x0 + 1, below.width - 1);
+
+				float farthest = std::max(std::max(below.depth[(size_t)y0 * below.width + x0], below.depth[(size_t)y0 * below.width + x1]),
+										  std::max(below.depth[(size_t)y1 * below.width + x0], below.depth[(size_t)y1 * below.width + x1]));
+				level.depth[(size_t)y * level.width + x] = farthest;
+			}
+		}
+	}
+}
+
+bool OcclusionBuffer::isBoxOccluded(const glm::vec3& boxMin, const glm::vec3& boxMax) const
+{
+	// Screen rectangle and nearest depth of the box
+	float minX = 0.0f, maxX = 0.0f, minY = 0.0f, maxY = 0.0f, nearest = 0.0f;
+	for (int i = 0; i < 8; i++)
+	{
+		glm::vec4 clip = viewProjection * glm::vec4((i & 1) ? boxMax.x : boxMin.x,
+													(i & 2) ? boxMax.y : boxMin.y,
+													(i & 4) ? boxMax.z : boxMin.z, 1.0f);
+
+		// Right up against the camera, it can't be behind anything
+		if (clip.w < MIN_CLIP_W)
+			return false;
+
+		glm::vec3 ndc = glm::vec3(clip) / clip.w;
+		float x = (ndc.x * 0.5f + 0.5f) * width;
+		float y = (ndc.y * 0.5f + 0.5f) * height;
+		float z = ndc.z * 0.5f + 0.5f;
+
+		minX = i == 0 ? x : std::min(minX, x);
+		maxX = i == 0 ? x : std::max(maxX, x);
+		minY = i == 0 ? y : std::min(minY, y);
+		maxY = i == 0 ? y : std::max(maxY, y);
+		nearest = i == 0 ? z : std::min(nearest, z);
+	}
+
+	// Off screen is the frustum's job
+	if (maxX < 0.0f || maxY < 0.0f || minX > (float)width || minY > (float)height)
+		return false;
+
+	int x0 = std::max(0, (int)std::floor(minX));
+	int x1 = std::min(width - 1, (int)std::floor(maxX));
+	int y0 = std::max(0, (int)std::floor(minY));
+	int y1 = std::min(height - 1, (int)std::floor(maxY));
+
+	// Go up the pyramid until the rectangle is at most two texels each way
+	int level = 0;
+	while (level + 1 < (int)levels.size() && ((x1 >> level) - (x0 >> level) > 1 || (y1 >> level) - (y0 >> level) > 1))
+		level++;
+
+	float farthest = 0.0f;
+	for (int y = y0 >> level; y <= (y1 >> level); y++)
+	{
+		for (int x = x0 >> level; x <= (x1 >> level); x++)
+			farthest = std::max(farthest, getDepth(level, x, y));
+	}
+
+	// Nothing drawn there at all, don't hide things past the far plane
+	if (farthest >= 1.0f)
+		return false;
+
+	return nearest > farthest;
+}
+
+void OcclusionBuffer::getInnerBox(const glm::vec3& boxMin, const glm::vec3& boxMax, const glm::vec3& lowFraction, const glm::vec3& highFraction,
+								   glm::vec3& innerMin, glm::vec3& innerMax)
+{
+	glm::vec3 size = boxMax - boxMin;
+	innerMin = boxMin + size * lowFraction;
+	innerMax = boxMin + size * highFraction;
+}
+
+float OcclusionBuffer::getDepth(int level, int x, int y) const
+{
+	const DepthLevel& depthLevel = levels[level];
+	return depthLevel.depth[(size_t)y * depthLevel.width + x];
+}
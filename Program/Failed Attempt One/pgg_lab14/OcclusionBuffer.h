@@ -0,0 +1,69 @@
+/*!
+*  \brief     OcclusionBuffer Class.
+*  \details   This class is to draw the biggest blockers into a small depth buffer on the CPU so anything hidden behind them is never drawn
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#pragma once
+
+#include <vector>
+#include "SDKS/glm/glm.hpp"
+
+/// The hierarchical-Z here is built from proxy boxes rasterised on the CPU, not from the depth pre-pass
+/// The draw list is built on the CPU before anything is drawn, so a pyramid made from the GPU's depth would have to be
+/// read back (a stall, or a frame late) before it could throw anything out
+class OcclusionBuffer
+{
+public:
+	/// Constructor and Destructor (a tiny buffer is plenty, blockers are big and misses only cost a draw)
+	OcclusionBuffer(int width = 128, int height = 72);
+	~OcclusionBuffer();
+
+	/// Start a new frame - everything goes back to the far plane
+	void clear(const glm::mat4& viewProjection);
+
+	/// Draw a solid box into the depth buffer
+	/// Must be completely inside whatever it stands for, or things behind the gaps get hidden by mistake
+	void addOccluder(const glm::vec3& boxMin, const glm::vec3& boxMax);
+
+	/// Build the hierarchical-Z levels, call once after the last addOccluder
+	void buildPyramid();
+
+	/// True if the whole box is behind what has been drawn (anything crossing the near plane never is)
+	bool isBoxOccluded(const glm::vec3& boxMin, const glm::vec3& boxMax) const;
+
+	/// Part of a box as fractions of its size along each axis (0 = min, 1 = max), handy for a blocker inside a model's bounds
+	static void getInnerBox(const glm::vec3& boxMin, const glm::vec3& boxMax, const glm::vec3& lowFraction, const glm::vec3& highFraction,
+							glm::vec3& innerMin, glm::vec3& innerMax);
+
+	/// Getters
+	int getWidth() const { return width; }
+	int getHeight() const { return height; }
+	int getLevelCount() const { return (int)levels.size(); }
+	int getOccluderCount() const { return occluderCount; }
+
+	/// Farthest depth (0 near to 1 far) in a texel of a pyramid level, level 0 is the full buffer
+	float getDepth(int level, int x, int y) const;
+
+private:
+	/// One level of the pyramid, each texel holds the farthest depth of the four below it
+	struct DepthLevel
+	{
+		int width;
+		int height;
+		std::vector<float> depth;
+	};
+
+	void drawTriangle(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c);
+
+	int width;
+	int height;
+	int occluderCount;
+	glm::mat4 viewProjection;
+
+	// Level 0 is drawn into, the rest are made by buildPyramid
+	std::vector<DepthLevel> levels;
+};
@@ -0,0 +1,159 @@
+/*!
+*  \brief     OverdrawCounter Class.
+*  \details   This class is to count how many fragments get shaded at every pixel and show it as a heat map, so changes to draw order can be measured
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "OverdrawCounter.h"
+
+#include <algorithm>
+#include <iostream>
+#include "GameModel.h"
+
+OverdrawCounter::OverdrawCounter()
+{
+	width = 0;
+	height = 0;
+	countProgramReady = false;
+
+	countTexture = 0;
+	clearFramebuffer = 0;
+	heatMapProgram = 0;
+	emptyVAO = 0;
+
+	fragmentCount = 0;
+	coveredPixels = 0;
+	maxCount = 0;
+}
+
+OverdrawCounter::~OverdrawCounter()
+{
+	release();
+}
+
+bool OverdrawCounter::initialise(int width, int height)
+{
+	release();
+
+	if (!GLEW_VERSION_4_2 && !GLEW_ARB_shader_image_load_store)
+	{
+		std::cerr << "WARNING: Overdraw view needs image load / store (OpenGL 4.2)" << std::endl;
+		return false;
+	}
+
+	this->width = width;
+	this->height = height;
+
+	// Counts live in an integer texture the Overdraw pass adds to
+	glGenTextures(1, &countTexture);
+	glBindTexture(GL_TEXTURE_2D, countTexture);
+	glTexStorage2D(GL_TEXTURE_2D, 1, GL_R32UI, width, height);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	glGenFramebuffers(1, &clearFramebuffer);
+	glBindFramebuffer(GL_FRAMEBUFFER, clearFramebuffer);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, countTexture, 0);
+	bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+	// Full screen triangle made from the vertex index, so it needs no buffers
+	const GLchar* vertexText = "#version 430 core\n\
+							   void main()\n\
+							   {\n\
+									vec2 corner = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);\n\
+									gl_Position = vec4(corner * 2.0 - 1.0, 0.0, 1.0);\n\
+							   }";
+
+	const GLchar* fragmentText = "#version 430 core\n\
+								 layout(r32ui, binding = 0) uniform readonly uimage2D overdrawCounts;\n\
+								 \n\
+								 out vec4 fragColour;\n\
+								 \n\
+								 void main()\n\
+								 {\n\
+									uint count = imageLoad( overdrawCounts, ivec2(gl_FragCoord.xy) ).r;\n\
+									const vec3 ramp[6] = vec3[6]( vec3(0,0,0), vec3(0,0,1), vec3(0,1,0), vec3(1,1,0), vec3(1,0.5,0), vec3(1,0,0) );\n\
+									fragColour = vec4( ramp[min(count, 5u)], 1.0 );\n\
+								 }";
+
+	heatMapProgram = BuildShaderProgram(vertexText, fragmentText);
+	glGenVertexArrays(1, &emptyVAO);
+
+	countProgramReady = complete && heatMapProgram != 0;
+	if (!countProgramReady)
+	{
+		std::cerr << "WARNING: Overdraw view could not be set up" << std::endl;
+		release();
+		return false;
+	}
+
+	counts.resize((size_t)width * height);
+	return true;
+}
+
+void OverdrawCounter::release()
+{
+	glDeleteTextures(1, &countTexture);
+	glDeleteFramebuffers(1, &clearFramebuffer);
+	glDeleteProgram(heatMapProgram);
+	glDeleteVertexArrays(1, &emptyVAO);
+
+	countTexture = 0;
+	clearFramebuffer = 0;
+	heatMapProgram = 0;
+	emptyVAO = 0;
+	countProgramReady = false;
+}
+
+void OverdrawCounter::begin()
+{
+	if (!countProgramReady)
+		return;
+
+	const GLuint zero[4] = { 0, 0, 0, 0 };
+	glBindFramebuffer(GL_FRAMEBUFFER, clearFramebuffer);
+	glClearBufferuiv(GL_COLOR, 0, zero);
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+	glBindImageTexture(0, countTexture, 0, GL_FALSE, 0, GL_READ_WRITE, GL_R32UI);
+
+	// Only the count matters, the heat map covers the colour afterwards
+	glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+}
+
+void OverdrawCounter::end()
+{
+	if (!countProgramReady)
+		return;
+
+	glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+
+	// Every atomic add has to land before the counts are read
+	glMemoryBarrier(GL_TEXTURE_UPDATE_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+
+	glBindTexture(GL_TEXTURE_2D, countTexture);
+	glGetTexImage(GL_TEXTURE_2D, 0, GL_RED_INTEGER, GL_UNSIGNED_INT, counts.data());
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	fragmentCount = 0;
+	coveredPixels = 0;
+	maxCount = 0;
+	for (GLuint count : counts)
+	{
+		fragmentCount += count;
+		coveredPixels += count > 0 ? 1 : 0;
+		maxCount = std::max(maxCount, (unsigned int)count);
+	}
+
+	// Heat map over everything, no depth test
+	glDisable(GL_DEPTH_TEST);
+	glUseProgram(heatMapProgram);
+	glBindVertexArray(emptyVAO);
+	glDrawArrays(GL_TRIANGLES, 0, 3);
+	glBindVertexArray(0);
+	glUseProgram(0);
+	glEnable(GL_DEPTH_TEST);
+}
@@ -0,0 +1,61 @@
+/*!
+*  \brief     OverdrawCounter Class.
+*  \details   This class is to count how many fragments get shaded at every pixel and show it as a heat map, so changes to draw order can be measured
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#pragma once
+
+#include <vector>
+#include "glew.h"
+
+class OverdrawCounter
+{
+public:
+	/// Constructor and Destructor
+	OverdrawCounter();
+	~OverdrawCounter();
+
+	/// Make the count image and heat map shader for a drawable this size (in pixels, call it again when that changes)
+	/// False if the driver can't do it (needs image load / store from OpenGL 4.2)
+	bool initialise(int width, int height);
+	bool isAvailable() const { return countProgramReady; }
+	int getWidth() const { return width; }
+	int getHeight() const { return height; }
+
+	/// Zero every pixel's count and bind the image for DrawPass::Overdraw
+	void begin();
+
+	/// Read the counts back and cover the screen with them as a heat map
+	/// Black is nothing, then blue, green, yellow and red for five or more fragments
+	void end();
+
+	/// Totals from the last end()
+	size_t getFragmentCount() const { return fragmentCount; }
+	size_t getCoveredPixels() const { return coveredPixels; }
+	unsigned int getMaxCount() const { return maxCount; }
+
+private:
+	void release();
+
+	int width;
+	int height;
+	bool countProgramReady;
+
+	// One unsigned count per pixel, with a framebuffer so it can be cleared in one call
+	GLuint countTexture;
+	GLuint clearFramebuffer;
+
+	// Full screen triangle to draw the heat map with
+	GLuint heatMapProgram;
+	GLuint emptyVAO;
+
+	// Read back every frame the view is on
+	std::vector<GLuint> counts;
+	size_t fragmentCount;
+	size_t coveredPixels;
+	unsigned int maxCount;
+};
@@ -0,0 +1,54 @@
+/*!
+*  \brief     Platform Helpers.
+*  \details   This file is to hide the compiler specific bits (aligned memory) from the rest of the game
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+
+#if defined(_MSC_VER)
+#include <malloc.h>
+#endif
+
+/// SSE is there on every x86 target we build for (x64 always has it, 32-bit needs /arch:SSE or -msse)
+/// Define PGG_USE_SSE as 0 on the command line to build the plain C++ paths anyway (the tests check both)
+#if !defined(PGG_USE_SSE)
+#if defined(__SSE__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define PGG_USE_SSE 1
+#else
+#define PGG_USE_SSE 0
+#endif
+#endif
+
+/// Allocate memory on an alignment boundary (alignment must be a power of two)
+inline void* pggAlignedMalloc(size_t size, size_t alignment)
+{
+#if defined(_MSC_VER)
+	return _aligned_malloc(size, alignment);
+#else
+	// posix_memalign needs at least the alignment of a pointer
+	if (alignment < sizeof(void*))
+		alignment = sizeof(void*);
+
+	void* memory = nullptr;
+	if (posix_memalign(&memory, alignment, size) != 0)
+		return nullptr;
+	return memory;
+#endif
+}
+
+/// Free memory that came from pggAlignedMalloc
+inline void pggAlignedFree(void* memory)
+{
+#if defined(_MSC_VER)
+	_aligned_free(memory);
+#else
+	free(memory);
+#endif
+}
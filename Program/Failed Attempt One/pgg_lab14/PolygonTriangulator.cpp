@@ -0,0 +1,150 @@
+/*!
+*  \brief     PolygonTriangulator Class.
+*  \details   This class is to split the polygons of a mesh file into triangles, fanning convex ones and ear clipping the rest
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "PolygonTriangulator.h"
+
+PolygonTriangulator::PolygonTriangulator()
+{
+	earClippedCount = 0;
+}
+
+PolygonTriangulator::~PolygonTriangulator()
+{
+
+}
+
+float PolygonTriangulator::Cross(const glm::vec2& a, const glm::vec2& b, const glm::vec2& c)
+{
+	return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+}
+
+bool PolygonTriangulator::IsInside(const glm::vec2& point, const glm::vec2& a, const glm::vec2& b, const glm::vec2& c)
+{
+	return Cross(a, b, point) >= 0.0f && Cross(b, c, point) >= 0.0f && Cross(c, a, point) >= 0.0f;
+}
+
+void PolygonTriangulator::Fan(size_t cornerCount, std::vector<uint32_t>& triangles)
+{
+	for (size_t i = 1; i + 1 < cornerCount; i++)
+	{
+		triangles.push_back(0);
+		triangles.push_back((uint32_t)i);
+		triangles.push_back((uint32_t)i + 1);
+	}
+}
+
+void PolygonTriangulator::Triangulate(const glm::vec3* corners, size_t cornerCount, std::vector<uint32_t>& triangles)
+{
+	triangles.clear();
+	if (cornerCount < 3)
+		return;
+
+	if (cornerCount == 3)
+	{
+		Fan(cornerCount, triangles);
+		return;
+	}
+
+	// Newell's normal - works for any simple polygon, even one that isn't quite flat
+	glm::vec3 normal(0.0f);
+	for (size_t i = 0; i < cornerCount; i++)
+	{
+		const glm::vec3& current = corners[i];
+		const glm::vec3& next = corners[(i + 1) % cornerCount];
+		normal.x += (current.y - next.y) * (current.z + next.z);
+		normal.y += (current.z - next.z) * (current.x + next.x);
+		normal.z += (current.x - next.x) * (current.y + next.y);
+	}
+
+	// Flatten by dropping the biggest axis, swapping the other two if needed so the polygon comes out counter clockwise
+	glm::vec3 size = glm::abs(normal);
+	int dropped = (size.x >= size.y && size.x >= size.z) ? 0 : (size.y >= size.z ? 1 : 2);
+	if (size[dropped] <= 0.0f)
+	{
+		// No area to speak of - nothing to go wrong with a fan
+		Fan(cornerCount, triangles);
+		return;
+	}
+
+	int uAxis = (dropped + 1) % 3, vAxis = (dropped + 2) % 3;
+	if (normal[dropped] < 0.0f)
+	{
+		int swap = uAxis;
+		uAxis = vAxis;
+		vAxis = swap;
+	}
+
+	projected.resize(cornerCount);
+	for (size_t i = 0; i < cornerCount; i++)
+		projected[i] = glm::vec2(corners[i][uAxis], corners[i][vAxis]);
+
+	// Every corner turning the same way means it's convex, and a fan is already right
+	bool convex = true;
+	for (size_t i = 0; i < cornerCount && convex; i++)
+		convex = Cross(projected[(i + cornerCount - 1) % cornerCount], projected[i], projected[(i + 1) % cornerCount]) >= 0.0f;
+
+	if (convex)
+	{
+		Fan(cornerCount, triangles);
+		return;
+	}
+
+	// Ear clipping - cut off a corner that points outwards and has no other corner inside it, until three are left
+	earClippedCount++;
+	remaining.resize(cornerCount);
+	for (size_t i = 0; i < cornerCount; i++)
+		remaining[i] = (uint32_t)i;
+
+	size_t misses = 0;
+	size_t current = 0;
+	while (remaining.size() > 3)
+	{
+		size_t count = remaining.size();
+		uint32_t previous = remaining[(current + count - 1) % count];
+		uint32_t corner = remaining[current];
+		uint32_t next = remaining[(current + 1) % count];
+
+		bool isEar = Cross(projected[previous], projected[corner], projected[next]) > 0.0f;
+		for (size_t i = 0; i < count && isEar; i++)
+		{
+			uint32_t other = remaining[i];
+			if (other != previous && other != corner && other != next)
+				isEar = !IsInside(projected[other], projected[previous], projected[corner], projected[next]);
+		}
+
+		if (isEar)
+		{
+			triangles.push_back(previous);
+			triangles.push_back(corner);
+			triangles.push_back(next);
+			remaining.erase(remaining.begin() + current);
+			current = current % remaining.size();
+			misses = 0;
+		}
+		else if (++misses >= count)
+		{
+			// Twisted or self crossing - no ear anywhere, so fan what's left rather than loop forever
+			for (size_t i = 1; i + 1 < remaining.size(); i++)
+			{
+				triangles.push_back(remaining[0]);
+				triangles.push_back(remaining[i]);
+				triangles.push_back(remaining[i + 1]);
+			}
+			return;
+		}
+		else
+		{
+			current = (current + 1) % count;
+		}
+	}
+
+	triangles.push_back(remaining[0]);
+	triangles.push_back(remaining[1]);
+	triangles.push_back(remaining[2]);
+}
@@ -0,0 +1,45 @@
+/*!
+*  \brief     PolygonTriangulator Class.
+*  \details   This class is to split the polygons of a mesh file into triangles, fanning convex ones and ear clipping the rest
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+#include "SDKS/glm/glm.hpp"
+
+class PolygonTriangulator
+{
+public:
+	///ctor / dtor
+	PolygonTriangulator();
+	~PolygonTriangulator();
+
+	/// Replace triangles with three corner numbers per triangle, wound the same way as the polygon
+	/// Working space is kept between calls, so once it has seen the biggest polygon it never allocates again
+	void Triangulate(const glm::vec3* corners, size_t cornerCount, std::vector<uint32_t>& triangles);
+
+	/// How many polygons so far weren't convex and had to be ear clipped
+	size_t GetEarClippedCount() const { return earClippedCount; }
+
+private:
+	// Corner is 'left' of the line from previous to next in the polygon's own plane (counter clockwise = positive)
+	static float Cross(const glm::vec2& a, const glm::vec2& b, const glm::vec2& c);
+
+	// True if point is inside or on triangle abc (which is counter clockwise)
+	static bool IsInside(const glm::vec2& point, const glm::vec2& a, const glm::vec2& b, const glm::vec2& c);
+
+	// Triangles all share the first corner
+	static void Fan(size_t cornerCount, std::vector<uint32_t>& triangles);
+
+	// Corners flattened onto the polygon's plane, and the ones not clipped off yet
+	std::vector<glm::vec2> projected;
+	std::vector<uint32_t> remaining;
+
+	size_t earClippedCount;
+};
@@ -0,0 +1,38 @@
+#version 430 core
+in vec3 lightDirV;
+in vec3 vNormalV;
+in vec2 vTexCoordV;
+in vec4 vTangentV;
+
+uniform vec3 lightColour = {1,1,1};
+uniform vec3 emissiveColour = {0.0,0,0.1};
+uniform vec3 ambientColour  = {0.1f,0.3f,0.2f};
+uniform vec3 diffuseColour  = {0.2f,0.6f,0.5f};
+uniform vec3 specularColour = {0.3f,0.3f,0.3f};
+uniform float shininess     = 200.0f;
+uniform float alpha         = 2.0f;
+
+uniform sampler2D diffuseMap;
+uniform bool hasDiffuseMap  = false;
+uniform sampler2D normalMap;
+uniform bool hasNormalMap   = false;
+
+out vec4 fragColour;
+
+void main()
+{
+	vec3 lightDir = normalize( lightDirV );
+	vec3 vNormal = normalize( vNormalV );
+	if ( hasNormalMap && dot( vTangentV.xyz, vTangentV.xyz ) > 0.0 )
+	{
+		vec3 tangent = normalize( vTangentV.xyz - vNormal * dot( vNormal, vTangentV.xyz ) );
+		vec3 bitangent = cross( vNormal, tangent ) * vTangentV.w;
+		vec3 mapped = texture( normalMap, vTexCoordV ).rgb * 2.0 - 1.0;
+		vNormal = normalize( mat3( tangent, bitangent, vNormal ) * mapped );
+	}
+	vec3 surface = hasDiffuseMap ? texture( diffuseMap, vTexCoordV ).rgb : vec3(1);
+
+	vec3 diffuse = diffuseColour * surface * lightColour * max( dot( vNormal, lightDir ), 0);
+
+	fragColour = vec4( emissiveColour + ambientColour * surface + diffuse, alpha);
+}
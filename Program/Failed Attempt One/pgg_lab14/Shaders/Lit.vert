@@ -0,0 +1,33 @@
+#version 430 core
+layout(location = 0) in vec4 vPosition;
+layout(location = 1) in vec3 vNormalIn;
+layout(location = 2) in vec2 vTexCoordIn;
+layout(location = 3) in vec4 vTangentIn;
+
+uniform mat4 modelMat;
+uniform mat4 invModelMat;
+uniform mat4 viewMat;
+uniform mat4 projMat;
+
+uniform vec4 worldSpaceLightPos = {1000,400,-3000,0};
+
+out vec3 vNormalV;
+out vec3 lightDirV;
+out vec2 vTexCoordV;
+out vec4 vTangentV;
+
+invariant gl_Position;
+
+void main()
+{
+	gl_Position = projMat * viewMat * modelMat * vPosition;
+
+	vec4 eyeSpaceVertPos = viewMat * modelMat * vPosition;
+	vec4 eyeSpaceLightPos = viewMat * worldSpaceLightPos;
+
+	lightDirV =  normalize( vec3(eyeSpaceLightPos) - vec3(eyeSpaceVertPos) );
+
+	vNormalV = mat3(viewMat * modelMat) * vNormalIn;
+	vTexCoordV = vTexCoordIn;
+	vTangentV = vec4( mat3(viewMat * modelMat) * vTangentIn.xyz, vTangentIn.w );
+}
@@ -0,0 +1,134 @@
+/*!
+*  \brief     Simulation Class.
+*  \details   This class is to move the Rocket and check it against the level, without any window or GPU
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "Simulation.h"
+
+#include "EndlessTrack.h"
+
+Simulation::Simulation()
+{
+	MAX_SPINAMOUNT = 27.0f;
+	SPIN_ACCELERATION = 1.3f;
+	MAX_SPEED = 38.5f;
+
+	numberOfTries = 0;
+	endlessTrack = nullptr;
+
+	// Load the level
+	obstacles.loadDefaultLevel();
+
+	reset();
+}
+
+Simulation::~Simulation()
+{
+
+}
+
+void Simulation::reset()
+{
+	// Rocket points down the track
+	rocketPosition = glm::vec3(0, 0, 0);
+	rocketRotation = glm::vec3(-1.57f, 0, 0);
+
+	spinAmount = 0.0f;
+	currentSpeed = 0.0f;
+}
+
+void Simulation::setEndlessTrack(EndlessTrack* track)
+{
+	endlessTrack = track;
+	reset();
+
+	if (endlessTrack)
+		endlessTrack->restart(rocketPosition.z);
+}
+
+void Simulation::spinLeft()
+{
+	spinAmount -= SPIN_ACCELERATION;
+}
+
+void Simulation::spinRight()
+{
+	spinAmount += SPIN_ACCELERATION;
+}
+
+CollisionResult Simulation::update(float deltaTime)
+{
+	// Limit Speed
+	if (spinAmount > MAX_SPINAMOUNT)
+		spinAmount = MAX_SPINAMOUNT - 0.10f;
+	if (spinAmount < -MAX_SPINAMOUNT)
+		spinAmount = -MAX_SPINAMOUNT + 0.10f;
+
+	// Update the model, to make it rotate
+	setRoll(spinAmount, deltaTime);
+
+	// Accelerate to MAX SPEED!
+	if (currentSpeed < MAX_SPEED)
+	{
+		currentSpeed += 0.1f;
+	}
+
+	// Send the Velocity to the Rocket!
+	setForwardVelocity(currentSpeed, deltaTime);
+	setSidewaysVelocity((-spinAmount / 1.3f), deltaTime);
+
+	// Check the Rocket against the level (keeping the endless track ahead of it first)
+	CollisionResult result;
+	if (endlessTrack)
+	{
+		endlessTrack->update(rocketPosition.z);
+		result = endlessTrack->checkCollisions(rocketPosition);
+	}
+	else
+	{
+		result = obstacles.checkCollisions(rocketPosition);
+	}
+
+	if (result == CollisionResult::Crashed)
+	{
+		// If you crash, Increment Tries and move to start
+		numberOfTries++;
+		rocketPosition.z = 100;
+
+		if (endlessTrack)
+			endlessTrack->restart(rocketPosition.z);
+	}
+	else if (result == CollisionResult::Finished)
+	{
+		rocketPosition.z = 0;
+	}
+
+	return result;
+}
+
+void Simulation::setForwardVelocity(float velocity, float deltaTime)
+{
+	rocketPosition.z -= velocity * deltaTime;
+}
+
+void Simulation::setSidewaysVelocity(float velocity, float deltaTime)
+{
+	// Times the velocity by delta to get sideways speed up
+	rocketPosition.x -= velocity * deltaTime;
+
+	// Set Boundries of the Level
+	if (rocketPosition.x > 110.01f)
+		rocketPosition.x = 110.00f;
+	if (rocketPosition.x < -116.01f)
+		rocketPosition.x = -116.00f;
+}
+
+void Simulation::setRoll(float angle, float deltaTime)
+{
+	// update the rotation angle of the Rocket
+	rocketRotation.y += deltaTime * angle;
+}
@@ -0,0 +1,70 @@
+/*!
+*  \brief     Simulation Class.
+*  \details   This class is to move the Rocket and check it against the level, without any window or GPU
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include "SDKS/glm/glm.hpp"
+#include "ObstacleField.h"
+
+class EndlessTrack;
+
+class Simulation
+{
+public:
+	/// Constructor and Destructor
+	Simulation();
+	~Simulation();
+
+	/// Put the Rocket back on the start line
+	void reset();
+
+	/// Input
+	void spinLeft();
+	void spinRight();
+
+	/// Move the Rocket on by deltaTime seconds and tell the caller what it hit
+	CollisionResult update(float deltaTime);
+
+	/// Getters
+	glm::vec3 getRocketPosition() const { return rocketPosition; }
+	glm::vec3 getRocketRotation() const { return rocketRotation; }
+	uint16_t getNumberOfTries() const { return numberOfTries; }
+	ObstacleField& getObstacleField() { return obstacles; }
+	EndlessTrack* getEndlessTrack() const { return endlessTrack; }
+
+	/// Fly down a generated track instead of the level (null to go back), the caller keeps ownership
+	void setEndlessTrack(EndlessTrack* track);
+
+private:
+	// Movement
+	void setForwardVelocity(float velocity, float deltaTime);
+	void setSidewaysVelocity(float velocity, float deltaTime);
+	void setRoll(float angle, float deltaTime);
+
+	// Level the Rocket flies through
+	ObstacleField obstacles;
+
+	// Endless mode track, used instead of obstacles when it's set
+	EndlessTrack* endlessTrack;
+
+	// Rocket Transform
+	glm::vec3 rocketPosition;
+	glm::vec3 rocketRotation;
+
+	// Rocket Speed
+	float spinAmount;
+	float currentSpeed;
+	float MAX_SPINAMOUNT;
+	float SPIN_ACCELERATION;
+	float MAX_SPEED;
+
+	// How many times the player has crashed
+	uint16_t numberOfTries;
+};
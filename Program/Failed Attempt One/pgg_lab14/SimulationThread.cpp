@@ -0,0 +1,116 @@
+/*!
+*  \brief     SimulationThread Class.
+*  \details   This class is to run the Simulation on its own thread and hand the renderer a copy of each finished step
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "SimulationThread.h"
+
+SimulationThread::SimulationThread(Simulation& simulation)
+	: simulation(simulation), stepsRun(0), running(false)
+{
+	simulatedTime = 0.0;
+	finishes = 0;
+	stepSeconds = 1.0f / 60.0f;
+
+	// So the renderer has something to draw before the first step
+	publishSnapshot();
+	snapshots.update();
+}
+
+SimulationThread::~SimulationThread()
+{
+	stop();
+}
+
+void SimulationThread::start(float stepSeconds)
+{
+	if (isRunning())
+		return;
+
+	this->stepSeconds = stepSeconds;
+	running.store(true, std::memory_order_release);
+	worker = std::thread(&SimulationThread::workerLoop, this);
+}
+
+void SimulationThread::stop()
+{
+	if (!isRunning())
+		return;
+
+	running.store(false, std::memory_order_release);
+	worker.join();
+}
+
+void SimulationThread::step(float deltaTime)
+{
+	if (isRunning())
+		return;
+
+	runStep(deltaTime);
+}
+
+SimulationThread::Clock::time_point SimulationThread::getNextStepTime(Clock::time_point nextStep, Clock::time_point now,
+																	 Clock::duration stepLength)
+{
+	nextStep += stepLength;
+	if (now - nextStep > stepLength * MAX_CATCH_UP_STEPS)
+		return now;
+	return nextStep;
+}
+
+void SimulationThread::workerLoop()
+{
+	const Clock::duration stepLength = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(stepSeconds));
+
+	Clock::time_point nextStep = Clock::now();
+	while (running.load(std::memory_order_acquire))
+	{
+		runStep(stepSeconds);
+
+		// Fixed steps, sleeping in between rather than spinning
+		nextStep = getNextStepTime(nextStep, Clock::now(), stepLength);
+		std::this_thread::sleep_until(nextStep);
+	}
+}
+
+void SimulationThread::runStep(float deltaTime)
+{
+	// Input that came in since the last step
+	SimulationInput input;
+	while (inputs.pop(input))
+	{
+		switch (input)
+		{
+		case SimulationInput::SpinLeft:
+			simulation.spinLeft();
+			break;
+
+		case SimulationInput::SpinRight:
+			simulation.spinRight();
+			break;
+		}
+	}
+
+	if (simulation.update(deltaTime) == CollisionResult::Finished)
+		finishes++;
+
+	simulatedTime += deltaTime;
+	stepsRun.fetch_add(1, std::memory_order_relaxed);
+	publishSnapshot();
+}
+
+void SimulationThread::publishSnapshot()
+{
+	FrameSnapshot& snapshot = snapshots.getWriteBuffer();
+	snapshot.step = stepsRun.load(std::memory_order_relaxed);
+	snapshot.time = simulatedTime;
+	snapshot.rocketPosition = simulation.getRocketPosition();
+	snapshot.rocketRotation = simulation.getRocketRotation();
+	snapshot.numberOfTries = simulation.getNumberOfTries();
+	snapshot.finishes = finishes;
+	snapshots.publish();
+}
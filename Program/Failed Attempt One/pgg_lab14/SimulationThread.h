@@ -0,0 +1,101 @@
+/*!
+*  \brief     SimulationThread Class.
+*  \details   This class is to run the Simulation on its own thread and hand the renderer a copy of each finished step
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <stdint.h>
+#include <thread>
+#include "SDKS/glm/glm.hpp"
+
+#include "Simulation.h"
+#include "SpscQueue.h"
+#include "TripleBuffer.h"
+
+/// Everything the renderer needs from one step, copied out so it never has to touch the Simulation
+struct FrameSnapshot
+{
+	/// Steps run and seconds simulated when this was taken
+	uint64_t step;
+	double time;
+
+	/// Rocket Transform
+	glm::vec3 rocketPosition;
+	glm::vec3 rocketRotation;
+
+	/// Counters rather than events, so a snapshot the renderer never sees can't lose a crash
+	uint16_t numberOfTries;
+	uint32_t finishes;
+};
+
+/// Player input, queued up and applied before the next step
+enum class SimulationInput : uint8_t
+{
+	SpinLeft,
+	SpinRight
+};
+
+class SimulationThread
+{
+public:
+	/// If the thread falls this many steps behind (a debugger break, a slow machine) it gives up catching up
+	static const int MAX_CATCH_UP_STEPS = 5;
+
+	typedef std::chrono::steady_clock Clock;
+
+	/// Constructor takes a snapshot of where the Simulation is now, Destructor stops the thread
+	SimulationThread(Simulation& simulation);
+	~SimulationThread();
+
+	SimulationThread(const SimulationThread&) = delete;
+	SimulationThread& operator=(const SimulationThread&) = delete;
+
+	/// Run a step every stepSeconds on a new thread, the Simulation mustn't be touched anywhere else until stop
+	void start(float stepSeconds = 1.0f / 60.0f);
+	void stop();
+	bool isRunning() const { return worker.joinable(); }
+
+	/// When it isn't running - step on the calling thread instead (same input and snapshots either way)
+	void step(float deltaTime);
+
+	/// Input thread - false if the queue is full and the input was dropped
+	bool sendInput(SimulationInput input) { return inputs.push(input); }
+
+	/// Render thread - pick up the newest finished step, false (keeping the last one) if there isn't a new one
+	bool updateSnapshot() { return snapshots.update(); }
+	const FrameSnapshot& getSnapshot() const { return snapshots.getReadBuffer(); }
+
+	/// Steps run so far (any thread)
+	uint64_t getStepsRun() const { return stepsRun.load(std::memory_order_relaxed); }
+
+	/// When the step after one due at nextStep should run, given it finished at now - straight away while catching up,
+	/// or now (dropping the steps it missed) once it is more than MAX_CATCH_UP_STEPS behind
+	static Clock::time_point getNextStepTime(Clock::time_point nextStep, Clock::time_point now, Clock::duration stepLength);
+
+private:
+	void workerLoop();
+	void runStep(float deltaTime);
+	void publishSnapshot();
+
+	Simulation& simulation;
+
+	// Input one way, finished steps the other - neither side ever locks
+	SpscQueue<SimulationInput, 64> inputs;
+	TripleBuffer<FrameSnapshot> snapshots;
+
+	// Only touched by whichever thread is stepping
+	double simulatedTime;
+	uint32_t finishes;
+
+	float stepSeconds;
+	std::atomic<uint64_t> stepsRun;
+	std::atomic<bool> running;
+	std::thread worker;
+};
@@ -0,0 +1,97 @@
+/*!
+*  \brief     SpriteBatch Class.
+*  \details   This class is to collect 2D sprites from one atlas and draw them all in a single submission
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "SpriteBatch.h"
+
+SpriteBatch::SpriteBatch(SDL_Renderer* renderer)
+{
+	this->renderer = renderer;
+	texture = nullptr;
+	textureWidth = 0;
+	textureHeight = 0;
+	spriteCount = 0;
+	submissions = 0;
+}
+
+SpriteBatch::~SpriteBatch()
+{
+
+}
+
+void SpriteBatch::begin(SDL_Texture* atlas)
+{
+	texture = atlas;
+	textureWidth = textureHeight = 0;
+	if (texture)
+		SDL_QueryTexture(texture, NULL, NULL, &textureWidth, &textureHeight);
+
+	spriteCount = 0;
+	submissions = 0;
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+	vertices.clear();
+	indices.clear();
+#else
+	sources.clear();
+	destinations.clear();
+#endif
+}
+
+void SpriteBatch::draw(const AtlasRegion& region, int x, int y)
+{
+	// Nothing to draw from until the atlas has arrived
+	if (!texture || textureWidth == 0 || textureHeight == 0)
+		return;
+
+	spriteCount++;
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+	// Two triangles per sprite, texture coordinates into the atlas
+	float left = (float)region.x / textureWidth;
+	float top = (float)region.y / textureHeight;
+	float right = (float)(region.x + region.width) / textureWidth;
+	float bottom = (float)(region.y + region.height) / textureHeight;
+	SDL_Color white = { 0xFF, 0xFF, 0xFF, 0xFF };
+
+	int first = (int)vertices.size();
+	SDL_Vertex corners[4] =
+	{
+		{ { (float)x, (float)y }, white, { left, top } },
+		{ { (float)(x + region.width), (float)y }, white, { right, top } },
+		{ { (float)(x + region.width), (float)(y + region.height) }, white, { right, bottom } },
+		{ { (float)x, (float)(y + region.height) }, white, { left, bottom } }
+	};
+	vertices.insert(vertices.end(), corners, corners + 4);
+
+	int quad[6] = { first, first + 1, first + 2, first, first + 2, first + 3 };
+	indices.insert(indices.end(), quad, quad + 6);
+#else
+	SDL_Rect source = { region.x, region.y, region.width, region.height };
+	SDL_Rect destination = { x, y, region.width, region.height };
+	sources.push_back(source);
+	destinations.push_back(destination);
+#endif
+}
+
+void SpriteBatch::end()
+{
+	if (spriteCount == 0)
+		return;
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+	// Every sprite in one go
+	SDL_RenderGeometry(renderer, texture, &vertices[0], (int)vertices.size(), &indices[0], (int)indices.size());
+	submissions = 1;
+#else
+	// Older SDL has no geometry call, but every copy is from the same texture so nothing gets rebound in between
+	for (size_t i = 0; i < sources.size(); i++)
+		SDL_RenderCopy(renderer, texture, &sources[i], &destinations[i]);
+	submissions = sources.size();
+#endif
+}
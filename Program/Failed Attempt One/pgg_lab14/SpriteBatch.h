@@ -0,0 +1,54 @@
+/*!
+*  \brief     SpriteBatch Class.
+*  \details   This class is to collect 2D sprites from one atlas and draw them all in a single submission
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#pragma once
+
+#include <SDL.h>
+#include <vector>
+
+#include "TextureAtlas.h"
+
+class SpriteBatch
+{
+public:
+	/// Constructor and Destructor
+	SpriteBatch(SDL_Renderer* renderer);
+	~SpriteBatch();
+
+	/// Start a new batch, every sprite in it comes from this texture
+	void begin(SDL_Texture* atlas);
+
+	/// Queue a region of the atlas at its own size, top left at x, y
+	void draw(const AtlasRegion& region, int x, int y);
+
+	/// Send everything queued since begin to the renderer
+	void end();
+
+	/// Sprites and renderer calls in the last batch
+	size_t getSpriteCount() const { return spriteCount; }
+	size_t getSubmissions() const { return submissions; }
+
+private:
+	SDL_Renderer* renderer;
+	SDL_Texture* texture;
+	int textureWidth;
+	int textureHeight;
+
+	// Kept between frames so a steady menu never allocates
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+	std::vector<SDL_Vertex> vertices;
+	std::vector<int> indices;
+#else
+	std::vector<SDL_Rect> sources;
+	std::vector<SDL_Rect> destinations;
+#endif
+
+	size_t spriteCount;
+	size_t submissions;
+};
@@ -0,0 +1,65 @@
+/*!
+*  \brief     SpscQueue Class.
+*  \details   This class is a lock-free ring buffer for handing items from exactly one thread to exactly one other
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+/// Single producer / single consumer queue, Capacity must be a power of two
+template <typename T, size_t Capacity>
+class SpscQueue
+{
+	static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "SpscQueue capacity must be a power of two");
+
+public:
+	SpscQueue() : head(0), tail(0) {}
+
+	SpscQueue(const SpscQueue&) = delete;
+	SpscQueue& operator=(const SpscQueue&) = delete;
+
+	/// Producer only - false if the queue is full
+	bool push(T item)
+	{
+		size_t currentTail = tail.load(std::memory_order_relaxed);
+		if (currentTail - head.load(std::memory_order_acquire) == Capacity)
+			return false;
+
+		slots[currentTail & (Capacity - 1)] = std::move(item);
+		tail.store(currentTail + 1, std::memory_order_release);
+		return true;
+	}
+
+	/// Consumer only - false if there is nothing to take
+	bool pop(T& item)
+	{
+		size_t currentHead = head.load(std::memory_order_relaxed);
+		if (currentHead == tail.load(std::memory_order_acquire))
+			return false;
+
+		item = std::move(slots[currentHead & (Capacity - 1)]);
+		head.store(currentHead + 1, std::memory_order_release);
+		return true;
+	}
+
+	/// Either thread - only a snapshot, it can change straight after
+	size_t size() const
+	{
+		return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+	}
+
+	bool empty() const { return size() == 0; }
+
+private:
+	// Keep the two ends on their own cache lines so the threads don't fight over them
+	alignas(64) std::atomic<size_t> head;
+	alignas(64) std::atomic<size_t> tail;
+	alignas(64) T slots[Capacity];
+};
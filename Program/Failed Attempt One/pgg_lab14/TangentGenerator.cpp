@@ -0,0 +1,247 @@
+/*!
+*  \brief     TangentGenerator Class.
+*  \details   This class is to work out a tangent frame for every vertex of a mesh once, when it is loaded, for normal mapping
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "TangentGenerator.h"
+
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+#include "JobSystem.h"
+
+// Triangles handed to each job
+static const size_t TRIANGLE_BATCH_SIZE = 1024;
+
+// Everything that has to match for two corners to share a tangent - bit patterns, so nothing merges that only looks close
+struct TangentKey
+{
+	uint32_t bits[9];
+
+	bool operator==(const TangentKey& other) const
+	{
+		return memcmp(bits, other.bits, sizeof(bits)) == 0;
+	}
+};
+
+struct TangentKeyHash
+{
+	size_t operator()(const TangentKey& key) const
+	{
+		uint64_t hash = 14695981039346656037ull;
+		for (int i = 0; i < 9; i++)
+			hash = (hash ^ key.bits[i]) * 1099511628211ull;
+		return (size_t)hash;
+	}
+};
+
+// Normals aren't always unit length in the file
+static glm::vec3 UnitNormal(const glm::vec3& normal)
+{
+	float lengthSq = glm::dot(normal, normal);
+	return lengthSq > 0.0f ? normal / std::sqrt(lengthSq) : normal;
+}
+
+// Take out the part along the normal, zero if nothing is left
+static glm::vec3 ProjectOntoPlane(const glm::vec3& direction, const glm::vec3& normal)
+{
+	glm::vec3 projected = direction - normal * glm::dot(normal, direction);
+	float lengthSq = glm::dot(projected, projected);
+	return lengthSq > 1.0e-20f ? projected / std::sqrt(lengthSq) : glm::vec3(0.0f);
+}
+
+// Angle between the two edges leaving a corner
+static float CornerAngle(const glm::vec3& corner, const glm::vec3& next, const glm::vec3& previous)
+{
+	glm::vec3 a = next - corner, b = previous - corner;
+	float lengths = std::sqrt(glm::dot(a, a) * glm::dot(b, b));
+	if (lengths <= 0.0f)
+		return 0.0f;
+	float cosine = glm::dot(a, b) / lengths;
+	return std::acos(cosine < -1.0f ? -1.0f : (cosine > 1.0f ? 1.0f : cosine));
+}
+
+static int32_t PackSnorm10(float value)
+{
+	value = value < -1.0f ? -1.0f : (value > 1.0f ? 1.0f : value);
+	return (int32_t)std::floor(value * 511.0f + 0.5f);
+}
+
+static float UnpackSnorm(int32_t value, float scale)
+{
+	float unpacked = value / scale;
+	return unpacked < -1.0f ? -1.0f : unpacked;
+}
+
+TangentGenerator::TangentGenerator(JobSystem* jobSystem)
+{
+	this->jobSystem = jobSystem;
+}
+
+TangentGenerator::~TangentGenerator()
+{
+
+}
+
+bool TangentGenerator::IsNeeded(const MeshData& mesh)
+{
+	if (!mesh.HasTexCoords())
+		return false;
+
+	for (const Material& material : mesh.materials)
+	{
+		if (!material.normalMap.empty())
+			return true;
+	}
+	return false;
+}
+
+uint32_t TangentGenerator::PackTangent(const glm::vec3& tangent, float sign)
+{
+	uint32_t x = (uint32_t)PackSnorm10(tangent.x) & 0x3FF;
+	uint32_t y = (uint32_t)PackSnorm10(tangent.y) & 0x3FF;
+	uint32_t z = (uint32_t)PackSnorm10(tangent.z) & 0x3FF;
+	uint32_t w = sign < 0.0f ? 0x3 : 0x1;
+	return x | (y << 10) | (z << 20) | (w << 30);
+}
+
+glm::vec4 TangentGenerator::UnpackTangent(uint32_t packed)
+{
+	// Shift each field to the top of the word and back down again to sign extend it
+	int32_t x = (int32_t)(packed << 22) >> 22;
+	int32_t y = (int32_t)(packed << 12) >> 22;
+	int32_t z = (int32_t)(packed << 2) >> 22;
+	int32_t w = (int32_t)packed >> 30;
+	return glm::vec4(UnpackSnorm(x, 511.0f), UnpackSnorm(y, 511.0f), UnpackSnorm(z, 511.0f), UnpackSnorm(w, 1.0f));
+}
+
+bool TangentGenerator::Generate(MeshData& mesh) const
+{
+	mesh.tangents.clear();
+	if (!mesh.HasTexCoords() || mesh.normals.size() != mesh.vertices.size())
+		return false;
+
+	size_t vertexCount = mesh.GetVertexCount();
+	size_t triangleCount = vertexCount / 3;
+	const glm::vec3* positions = (const glm::vec3*)&mesh.vertices[0];
+	const glm::vec3* normals = (const glm::vec3*)&mesh.normals[0];
+	const glm::vec2* texCoords = (const glm::vec2*)&mesh.texCoords[0];
+
+	// Each corner's share of its triangle's tangent and bitangent (already weighted by the corner's angle)
+	std::vector<glm::vec3> cornerTangents(vertexCount), cornerBitangents(vertexCount);
+	std::vector<uint8_t> mirrored(triangleCount);
+
+	auto triangleTangents = [&](size_t begin, size_t end)
+	{
+		for (size_t triangle = begin; triangle < end; triangle++)
+		{
+			size_t first = triangle * 3;
+			glm::vec3 edge1 = positions[first + 1] - positions[first];
+			glm::vec3 edge2 = positions[first + 2] - positions[first];
+			glm::vec2 uv1 = texCoords[first + 1] - texCoords[first];
+			glm::vec2 uv2 = texCoords[first + 2] - texCoords[first];
+
+			// Which way round the UVs go - mirrored halves of a model mustn't share tangents
+			float uvArea = uv1.x * uv2.y - uv2.x * uv1.y;
+			mirrored[triangle] = uvArea < 0.0f;
+
+			// Directions of +u and +v across the triangle, the size doesn't matter as they get normalised per corner
+			glm::vec3 uDirection = edge1 * uv2.y - edge2 * uv1.y;
+			glm::vec3 vDirection = edge2 * uv1.x - edge1 * uv2.x;
+			if (uvArea < 0.0f)
+			{
+				uDirection = -uDirection;
+				vDirection = -vDirection;
+			}
+
+			// All three UVs on a line - this triangle can't say which way anything goes
+			if (std::fabs(uvArea) < 1.0e-12f)
+				uDirection = vDirection = glm::vec3(0.0f);
+
+			for (int corner = 0; corner < 3; corner++)
+			{
+				size_t vertex = first + corner;
+				glm::vec3 normal = UnitNormal(normals[vertex]);
+				float angle = CornerAngle(positions[vertex], positions[first + (corner + 1) % 3], positions[first + (corner + 2) % 3]);
+
+				cornerTangents[vertex] = ProjectOntoPlane(uDirection, normal) * angle;
+				cornerBitangents[vertex] = ProjectOntoPlane(vDirection, normal) * angle;
+			}
+		}
+	};
+
+	// Every triangle on its own, so they can go wide
+	if (jobSystem)
+		jobSystem->parallelFor(triangleCount, TRIANGLE_BATCH_SIZE, triangleTangents);
+	else
+		triangleTangents(0, triangleCount);
+
+	// Group the corners that are really the same vertex and add up their shares
+	std::unordered_map<TangentKey, uint32_t, TangentKeyHash> groups;
+	groups.reserve(vertexCount);
+	std::vector<uint32_t> vertexGroups(vertexCount);
+	std::vector<glm::vec3> groupTangents, groupBitangents;
+	groupTangents.reserve(vertexCount);
+	groupBitangents.reserve(vertexCount);
+
+	for (size_t vertex = 0; vertex < triangleCount * 3; vertex++)
+	{
+		TangentKey key;
+		memcpy(&key.bits[0], &positions[vertex], sizeof(glm::vec3));
+		memcpy(&key.bits[3], &normals[vertex], sizeof(glm::vec3));
+		memcpy(&key.bits[6], &texCoords[vertex], sizeof(glm::vec2));
+		key.bits[8] = mirrored[vertex / 3];
+
+		std::pair<std::unordered_map<TangentKey, uint32_t, TangentKeyHash>::iterator, bool> inserted =
+			groups.insert(std::make_pair(key, (uint32_t)groupTangents.size()));
+		if (inserted.second)
+		{
+			groupTangents.push_back(glm::vec3(0.0f));
+			groupBitangents.push_back(glm::vec3(0.0f));
+		}
+
+		uint32_t group = inserted.first->second;
+		vertexGroups[vertex] = group;
+		groupTangents[group] += cornerTangents[vertex];
+		groupBitangents[group] += cornerBitangents[vertex];
+	}
+
+	// Make each one square to its normal and pack it
+	mesh.tangents.resize(vertexCount);
+	auto packTangents = [&](size_t begin, size_t end)
+	{
+		for (size_t vertex = begin; vertex < end; vertex++)
+		{
+			glm::vec3 normal = UnitNormal(normals[vertex]);
+			if (vertex >= triangleCount * 3)
+			{
+				mesh.tangents[vertex] = PackTangent(glm::vec3(1.0f, 0.0f, 0.0f), 1.0f);
+				continue;
+			}
+
+			uint32_t group = vertexGroups[vertex];
+			glm::vec3 tangent = ProjectOntoPlane(groupTangents[group], normal);
+
+			// No usable UVs here - any direction across the surface will do
+			if (glm::dot(tangent, tangent) == 0.0f)
+			{
+				tangent = ProjectOntoPlane(std::fabs(normal.x) < 0.9f ? glm::vec3(1.0f, 0.0f, 0.0f) : glm::vec3(0.0f, 1.0f, 0.0f), normal);
+				if (glm::dot(tangent, tangent) == 0.0f)
+					tangent = glm::vec3(1.0f, 0.0f, 0.0f);
+			}
+
+			float sign = glm::dot(glm::cross(normal, tangent), groupBitangents[group]) < 0.0f ? -1.0f : 1.0f;
+			mesh.tangents[vertex] = PackTangent(tangent, sign);
+		}
+	};
+
+	if (jobSystem)
+		jobSystem->parallelFor(vertexCount, TRIANGLE_BATCH_SIZE * 3, packTangents);
+	else
+		packTangents(0, vertexCount);
+	return true;
+}
@@ -0,0 +1,38 @@
+/*!
+*  \brief     TangentGenerator Class.
+*  \details   This class is to work out a tangent frame for every vertex of a mesh once, when it is loaded, for normal mapping
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include "MeshData.h"
+
+class JobSystem;
+
+/// Tangents follow the MikkTSpace conventions - the tangent points along +u, corners that share a position, normal,
+/// texture coordinate and winding of the UVs get the same one, and the bitangent is cross(normal, tangent) * w
+class TangentGenerator
+{
+public:
+	///ctor / dtor - the triangles are spread over the job system's threads when there is one
+	TangentGenerator(JobSystem* jobSystem = nullptr);
+	~TangentGenerator();
+
+	/// Fill mesh.tangents, one packed tangent per vertex - false if the mesh has no texture coordinates
+	bool Generate(MeshData& mesh) const;
+
+	/// True if a material on the mesh has a normal map and there are texture coordinates to map it with
+	static bool IsNeeded(const MeshData& mesh);
+
+	/// xyz in the low 30 bits as signed 10 bit values, the bitangent sign in the top 2 (GL_INT_2_10_10_10_REV)
+	static uint32_t PackTangent(const glm::vec3& tangent, float sign);
+	static glm::vec4 UnpackTangent(uint32_t packed);
+
+private:
+	JobSystem* jobSystem;
+};
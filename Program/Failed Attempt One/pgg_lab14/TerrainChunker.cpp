@@ -0,0 +1,153 @@
+/*!
+*  \brief     TerrainChunker Class.
+*  \details   This class is to slice a level mesh into sections along the track so each one can be culled and streamed on its own
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "TerrainChunker.h"
+
+#include <algorithm>
+#include <cmath>
+
+// A triangle clipped by a slab has at most five corners
+static const int MAX_CLIPPED_CORNERS = 5;
+
+struct ClipVertex
+{
+	glm::vec3 position;
+	glm::vec3 normal;
+};
+
+// Keep the part of the polygon on the kept side of z = plane (above it if keepAbove), returns the new corner count
+static int ClipPolygon(const ClipVertex* in, int count, float plane, bool keepAbove, ClipVertex* out)
+{
+	int outCount = 0;
+	for (int i = 0; i < count; i++)
+	{
+		const ClipVertex& current = in[i];
+		const ClipVertex& next = in[(i + 1) % count];
+		float currentSide = keepAbove ? current.position.z - plane : plane - current.position.z;
+		float nextSide = keepAbove ? next.position.z - plane : plane - next.position.z;
+
+		if (currentSide >= 0.0f)
+			out[outCount++] = current;
+
+		// Edge crosses the plane - add the point where it does
+		if ((currentSide >= 0.0f) != (nextSide >= 0.0f))
+		{
+			float t = currentSide / (currentSide - nextSide);
+			ClipVertex cut;
+			cut.position = glm::mix(current.position, next.position, t);
+			cut.position.z = plane;
+			cut.normal = glm::mix(current.normal, next.normal, t);
+			float length = glm::length(cut.normal);
+			cut.normal = length > 0.0f ? cut.normal / length : current.normal;
+			out[outCount++] = cut;
+		}
+	}
+	return outCount;
+}
+
+static void AddVertex(MeshData& mesh, const ClipVertex& vertex)
+{
+	mesh.vertices.push_back(vertex.position.x);
+	mesh.vertices.push_back(vertex.position.y);
+	mesh.vertices.push_back(vertex.position.z);
+	mesh.normals.push_back(vertex.normal.x);
+	mesh.normals.push_back(vertex.normal.y);
+	mesh.normals.push_back(vertex.normal.z);
+}
+
+TerrainChunker::TerrainChunker()
+{
+	chunkDepth = 128.0f;
+}
+
+TerrainChunker::~TerrainChunker()
+{
+
+}
+
+void TerrainChunker::Slice(const MeshData& mesh, std::vector<TerrainChunk>& chunks) const
+{
+	chunks.clear();
+	if (mesh.IsEmpty() || chunkDepth <= 0.0f)
+		return;
+
+	float levelMinZ = mesh.vertices[2], levelMaxZ = mesh.vertices[2];
+	for (size_t i = 2; i < mesh.vertices.size(); i += 3)
+	{
+		levelMinZ = std::min(levelMinZ, mesh.vertices[i]);
+		levelMaxZ = std::max(levelMaxZ, mesh.vertices[i]);
+	}
+
+	// Slices run from the far end of the track (lowest z) so slice i is [levelMinZ + i * depth, levelMinZ + (i + 1) * depth]
+	int chunkCount = std::max(1, (int)std::ceil((levelMaxZ - levelMinZ) / chunkDepth));
+	std::vector<MeshData> slices(chunkCount);
+
+	size_t triangleCount = mesh.GetVertexCount() / 3;
+	for (size_t t = 0; t < triangleCount; t++)
+	{
+		ClipVertex triangle[3];
+		float lowest = 0.0f, highest = 0.0f;
+		for (int c = 0; c < 3; c++)
+		{
+			size_t index = (t * 3 + c) * 3;
+			triangle[c].position = glm::vec3(mesh.vertices[index], mesh.vertices[index + 1], mesh.vertices[index + 2]);
+			triangle[c].normal = glm::vec3(mesh.normals[index], mesh.normals[index + 1], mesh.normals[index + 2]);
+			lowest = c == 0 ? triangle[c].position.z : std::min(lowest, triangle[c].position.z);
+			highest = c == 0 ? triangle[c].position.z : std::max(highest, triangle[c].position.z);
+		}
+
+		int first = std::min(chunkCount - 1, (int)((lowest - levelMinZ) / chunkDepth));
+		int last = std::min(chunkCount - 1, (int)((highest - levelMinZ) / chunkDepth));
+
+		// Most triangles fit inside one slice
+		if (first == last)
+		{
+			for (int c = 0; c < 3; c++)
+				AddVertex(slices[first], triangle[c]);
+			continue;
+		}
+
+		// Long ones (the floor of the track) get cut up at every boundary they cross
+		for (int slice = first; slice <= last; slice++)
+		{
+			float sliceMin = levelMinZ + slice * chunkDepth;
+			float sliceMax = sliceMin + chunkDepth;
+
+			ClipVertex above[MAX_CLIPPED_CORNERS + 1], clipped[MAX_CLIPPED_CORNERS + 1];
+			int count = ClipPolygon(triangle, 3, sliceMin, true, above);
+			count = ClipPolygon(above, count, sliceMax, false, clipped);
+
+			for (int c = 1; c + 1 < count; c++)
+			{
+				// Skip slivers where the cut runs along an edge
+				glm::vec3 cross = glm::cross(clipped[c].position - clipped[0].position, clipped[c + 1].position - clipped[0].position);
+				if (glm::dot(cross, cross) <= 0.0f)
+					continue;
+
+				AddVertex(slices[slice], clipped[0]);
+				AddVertex(slices[slice], clipped[c]);
+				AddVertex(slices[slice], clipped[c + 1]);
+			}
+		}
+	}
+
+	// Start of the track first, as that is the order they come into view
+	for (int slice = chunkCount - 1; slice >= 0; slice--)
+	{
+		if (slices[slice].IsEmpty())
+			continue;
+
+		TerrainChunk chunk;
+		chunk.minZ = levelMinZ + slice * chunkDepth;
+		chunk.maxZ = chunk.minZ + chunkDepth;
+		chunk.mesh = std::move(slices[slice]);
+		chunk.mesh.ComputeBounds();
+		chunks.push_back(std::move(chunk));
+	}
+}
@@ -0,0 +1,40 @@
+/*!
+*  \brief     TerrainChunker Class.
+*  \details   This class is to slice a level mesh into sections along the track so each one can be culled and streamed on its own
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#pragma once
+
+#include <vector>
+#include "MeshData.h"
+
+/// One slice of the level, everything in it sits between minZ and maxZ (model space)
+struct TerrainChunk
+{
+	float minZ;
+	float maxZ;
+	MeshData mesh;
+};
+
+class TerrainChunker
+{
+public:
+	///ctor / dtor
+	TerrainChunker();
+	~TerrainChunker();
+
+	/// How long each slice is along z
+	void SetChunkDepth(float depth) { chunkDepth = depth; }
+	float GetChunkDepth() const { return chunkDepth; }
+
+	/// Cut the mesh into slices, nearest the start of the track (highest z) first
+	/// Triangles crossing a slice boundary are clipped so no chunk reaches into its neighbours
+	void Slice(const MeshData& mesh, std::vector<TerrainChunk>& chunks) const;
+
+private:
+	float chunkDepth;
+};
@@ -0,0 +1,28 @@
+/*!
+*  \brief     TerrainWindow Class.
+*  \details   This class is to decide which terrain chunks should be on the GPU from where the camera is on the track
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "TerrainWindow.h"
+
+TerrainWindow::TerrainWindow()
+{
+	// Just behind the chase camera, out to the Camera's far plane
+	keepBehind = 50.0f;
+	loadAhead = 1000.0f;
+}
+
+TerrainWindow::~TerrainWindow()
+{
+
+}
+
+bool TerrainWindow::contains(float minZ, float maxZ, float eyeZ) const
+{
+	// Anything overlapping [eye - ahead, eye + behind] is wanted
+	return minZ <= eyeZ + keepBehind && maxZ >= eyeZ - loadAhead;
+}
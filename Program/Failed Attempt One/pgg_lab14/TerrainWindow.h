@@ -0,0 +1,33 @@
+/*!
+*  \brief     TerrainWindow Class.
+*  \details   This class is to decide which terrain chunks should be on the GPU from where the camera is on the track
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#pragma once
+
+class TerrainWindow
+{
+public:
+	/// Constructor and Destructor
+	TerrainWindow();
+	~TerrainWindow();
+
+	/// How far behind the eye to keep chunks, and how far ahead (the far plane) to load them
+	void setRange(float behind, float ahead) { keepBehind = behind; loadAhead = ahead; }
+
+	/// True if a chunk covering minZ..maxZ (world space) should be resident with the eye at eyeZ
+	/// The track runs towards -z so ahead is lower z
+	bool contains(float minZ, float maxZ, float eyeZ) const;
+
+	/// Getters
+	float getBehind() const { return keepBehind; }
+	float getAhead() const { return loadAhead; }
+
+private:
+	float keepBehind;
+	float loadAhead;
+};
@@ -0,0 +1,90 @@
+/*!
+*  \brief     AlignedArena Tests.
+*  \details   This file is to check aligned containers, the arena and the frame arena hand out memory SIMD code can use
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "TestRunner.h"
+
+#include <cstdint>
+
+#include "AlignedArena.h"
+#include "FrameArena.h"
+#include "SDKS/glm/glm.hpp"
+
+static bool isAligned(const void* memory)
+{
+	return ((uintptr_t)memory & (SIMD_ALIGNMENT - 1)) == 0;
+}
+
+static void testAlignedVector()
+{
+	for (size_t count = 1; count < 64; count += 7)
+	{
+		AlignedVector<glm::mat4> matrices(count, glm::mat4(1.0f));
+		PGG_CHECK(isAligned(matrices.data()));
+		PGG_CHECK(matrices[count - 1] == glm::mat4(1.0f));
+	}
+}
+
+static void testArena()
+{
+	AlignedArena arena;
+	glm::mat4* first[3] = { nullptr, nullptr, nullptr };
+	size_t reserved[3] = { 0, 0, 0 };
+	for (int round = 0; round < 3; round++)
+	{
+		arena.reset();
+		for (int i = 0; i < 1024; i++)
+		{
+			// Odd sized allocations in between mustn't knock the matrices out of line
+			arena.allocate(3, 1);
+			glm::mat4* matrix = arena.create<glm::mat4>(2.0f);
+			PGG_CHECK(isAligned(matrix));
+			PGG_CHECK((*matrix)[3][3] == 2.0f);
+			first[round] = i == 0 ? matrix : first[round];
+		}
+		reserved[round] = arena.getBytesReserved();
+	}
+
+	// The first reset swaps the blocks for one big enough, after that the same memory is used every time
+	PGG_CHECK(first[2] == first[1]);
+	PGG_CHECK(reserved[2] == reserved[1]);
+}
+
+static void testFrameArena()
+{
+	FrameArena frameArena(4096);
+	size_t reserved = 0;
+	for (int frame = 0; frame < 4; frame++)
+	{
+		frameArena.beginFrame();
+		FrameVector<glm::vec4> drawList(&frameArena);
+		FrameString status(&frameArena);
+		for (int i = 0; i < 512; i++)
+			drawList.push_back(glm::vec4((float)i));
+		status = "-------Tries-------- frame " + std::to_string(frame);
+
+		PGG_CHECK(isAligned(drawList.data()));
+		PGG_CHECK(drawList[511].x == 511.0f);
+		PGG_CHECK(frameArena.getBytesUsed() >= drawList.size() * sizeof(glm::vec4));
+
+		// After the first frame it has all the memory it needs
+		if (frame == 1)
+			reserved = frameArena.getBytesReserved();
+		if (frame > 1)
+			PGG_CHECK(frameArena.getBytesReserved() == reserved);
+	}
+	PGG_CHECK(frameArena.getFrameNumber() == 4);
+	PGG_CHECK(frameArena.getPeakBytesUsed() >= 512 * sizeof(glm::vec4));
+}
+
+void testAlignedArena()
+{
+	testAlignedVector();
+	testArena();
+	testFrameArena();
+}
@@ -0,0 +1,68 @@
+/*!
+*  \brief     AllocationCounter Tests.
+*  \details   This file is to check every allocation is counted, and that each thread only sees its own
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "TestRunner.h"
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "AllocationCounter.h"
+
+static void testCounts()
+{
+	size_t globalBefore = getGlobalAllocationCount();
+	size_t threadBefore = getThreadAllocationCount();
+	std::unique_ptr<int> single(new int(1));
+	std::unique_ptr<int[]> array(new int[16]);
+	size_t globalAllocations = getGlobalAllocationCount() - globalBefore;
+	size_t threadAllocations = getThreadAllocationCount() - threadBefore;
+
+	// Nothing else runs here, so both see the two
+	PGG_CHECK(threadAllocations == 2);
+	PGG_CHECK(globalAllocations == 2);
+}
+
+static void testOtherThreads()
+{
+	// Another thread's allocations show up in the global count but not in this thread's
+	size_t globalBefore = getGlobalAllocationCount();
+	size_t threadBefore = getThreadAllocationCount();
+	size_t otherAllocations = 0;
+	std::thread other([&otherAllocations]
+	{
+		size_t before = getThreadAllocationCount();
+		std::vector<std::unique_ptr<int>> values;
+		values.reserve(100);
+		for (int i = 0; i < 100; i++)
+			values.emplace_back(new int(i));
+		otherAllocations = getThreadAllocationCount() - before;
+	});
+	other.join();
+	size_t threadAllocations = getThreadAllocationCount() - threadBefore;
+
+	PGG_CHECK(otherAllocations == 101);
+	PGG_CHECK(getGlobalAllocationCount() - globalBefore >= otherAllocations);
+
+	// Starting the thread may allocate here, but nothing like what it did itself
+	PGG_CHECK(threadAllocations < otherAllocations);
+}
+
+void testAllocationCounter()
+{
+	// Release builds without PGG_COUNT_ALLOCATIONS have nothing to check
+	if (!isAllocationCountingEnabled())
+	{
+		PGG_CHECK(getGlobalAllocationCount() == 0 && getThreadAllocationCount() == 0);
+		return;
+	}
+
+	testCounts();
+	testOtherThreads();
+}
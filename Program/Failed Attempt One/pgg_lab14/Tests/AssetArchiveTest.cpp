@@ -0,0 +1,152 @@
+/*!
+*  \brief     AssetArchive Tests.
+*  \details   This file is to check packed files come back out of the archive byte for byte, stored or LZ4 compressed
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "TestRunner.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include "AssetArchive.h"
+#include "Lz4Codec.h"
+#include "MappedFile.h"
+
+static void testLz4RoundTrip()
+{
+	// Text that repeats, noise that doesn't, and the tiny and empty edge cases
+	std::vector<std::vector<uint8_t>> blocks(4);
+	const char* line = "v 0.500000 -0.500000 0.500000\n";
+	for (int i = 0; i < 2000; i++)
+		blocks[0].insert(blocks[0].end(), line, line + 30);
+	uint32_t seed = 99;
+	for (int i = 0; i < 50000; i++)
+	{
+		seed = seed * 1664525u + 1013904223u;
+		blocks[1].push_back((uint8_t)(seed >> 24));
+	}
+	blocks[2] = { 1, 2, 3 };
+
+	for (const std::vector<uint8_t>& block : blocks)
+	{
+		std::vector<uint8_t> compressed;
+		Lz4Codec::Compress(block.data(), block.size(), compressed);
+		PGG_CHECK(compressed.size() <= Lz4Codec::GetMaxCompressedSize(block.size()));
+
+		std::vector<uint8_t> unpacked(block.size());
+		PGG_CHECK(Lz4Codec::Decompress(compressed.data(), compressed.size(), unpacked.data(), unpacked.size()));
+		PGG_CHECK(unpacked == block);
+	}
+
+	// Repeated text packs down a long way
+	std::vector<uint8_t> compressed;
+	Lz4Codec::Compress(blocks[0].data(), blocks[0].size(), compressed);
+	PGG_CHECK(compressed.size() < blocks[0].size() / 10);
+
+	// Cut short or told the wrong size fails rather than reading off the end
+	std::vector<uint8_t> unpacked(blocks[0].size());
+	PGG_CHECK(!Lz4Codec::Decompress(compressed.data(), compressed.size() / 2, unpacked.data(), unpacked.size()));
+	PGG_CHECK(!Lz4Codec::Decompress(compressed.data(), compressed.size(), unpacked.data(), unpacked.size() - 1));
+}
+
+static void testArchiveRoundTrip(bool compress)
+{
+	const char* files[] = { "Rocket.obj", "cube.obj", "Duhduhduh.mtl", "ExitSelected.bmp", "teapot.obj" };
+
+	std::vector<ArchiveSource> sources;
+	for (const char* file : files)
+	{
+		ArchiveSource source = { std::string("Meshes/") + file, getTestAssetDir() + "/" + file, compress };
+		sources.push_back(source);
+	}
+	std::string archiveFileName = (std::filesystem::temp_directory_path() / "pgg_archive_test.pak").string();
+	PGG_CHECK(AssetArchive::Write(archiveFileName, sources));
+
+	AssetArchive archive;
+	PGG_CHECK(archive.Open(archiveFileName));
+	PGG_CHECK(archive.GetEntryCount() == sources.size());
+	for (size_t i = 1; i < archive.GetEntryCount(); i++)
+		PGG_CHECK(archive.GetEntryName(archive.GetEntry(i - 1)) < archive.GetEntryName(archive.GetEntry(i)));
+
+	std::vector<uint8_t> buffer;
+	for (const ArchiveSource& source : sources)
+	{
+		MappedFile loose;
+		PGG_CHECK(loose.Open(source.fileName));
+
+		const ArchiveEntry* entry = archive.Find(source.name);
+		const uint8_t* data = nullptr;
+		size_t size = 0;
+		PGG_CHECK(entry != nullptr && archive.Read(*entry, data, size, buffer));
+		PGG_CHECK(size == loose.GetSize() && std::equal(data, data + size, loose.GetData()));
+
+		// Stored entries sit on a 16 byte boundary so they can be used where they are
+		if (entry && entry->compression == (uint32_t)ArchiveCompression::None)
+			PGG_CHECK(((uintptr_t)data & 15) == 0);
+	}
+	PGG_CHECK(archive.Find("Meshes/no such file.obj") == nullptr);
+	PGG_CHECK(archive.Find(AssetArchive::NormaliseName("./Meshes\\cube.obj")) != nullptr);
+
+	archive.Close();
+	std::filesystem::remove(archiveFileName);
+}
+
+static void testDuplicateNames()
+{
+	std::vector<ArchiveSource> sources = { { "cube.obj", getTestAssetDir() + "/cube.obj", false },
+										   { "cube.obj", getTestAssetDir() + "/cube.obj", false } };
+	std::string archiveFileName = (std::filesystem::temp_directory_path() / "pgg_archive_duplicate.pak").string();
+	PGG_CHECK(!AssetArchive::Write(archiveFileName, sources));
+	std::filesystem::remove(archiveFileName);
+}
+
+static void testStaleEntries()
+{
+	std::filesystem::path scratch = std::filesystem::temp_directory_path() / "pgg_archive_stale";
+	std::filesystem::remove_all(scratch);
+	std::filesystem::create_directories(scratch);
+	std::string sourceFileName = (scratch / "source.obj").string();
+	std::ofstream(sourceFileName) << "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n";
+
+	std::vector<ArchiveSource> sources = { { "stamped.obj", sourceFileName, false, sourceFileName },
+										   { "unstamped.obj", sourceFileName, false } };
+	std::string archiveFileName = (scratch / "stale.pak").string();
+	PGG_CHECK(AssetArchive::Write(archiveFileName, sources));
+
+	AssetArchive archive;
+	PGG_CHECK(archive.Open(archiveFileName));
+	const ArchiveEntry* stamped = archive.Find("stamped.obj");
+	const ArchiveEntry* unstamped = archive.Find("unstamped.obj");
+	PGG_CHECK(stamped != nullptr && unstamped != nullptr);
+	if (stamped && unstamped)
+	{
+		PGG_CHECK(AssetArchive::IsUpToDate(*stamped, sourceFileName));
+
+		// Edited after packing - the entry is stale, unless it never recorded where it came from
+		std::ofstream(sourceFileName, std::ios::app) << "f 3 2 1\n";
+		PGG_CHECK(!AssetArchive::IsUpToDate(*stamped, sourceFileName));
+		PGG_CHECK(AssetArchive::IsUpToDate(*unstamped, sourceFileName));
+
+		// Shipped without its source, the archive is all there is
+		std::filesystem::remove(sourceFileName);
+		PGG_CHECK(AssetArchive::IsUpToDate(*stamped, sourceFileName));
+	}
+
+	archive.Close();
+	std::filesystem::remove_all(scratch);
+}
+
+void testAssetArchive()
+{
+	testLz4RoundTrip();
+	testArchiveRoundTrip(false);
+	testArchiveRoundTrip(true);
+	testDuplicateNames();
+	testStaleEntries();
+}
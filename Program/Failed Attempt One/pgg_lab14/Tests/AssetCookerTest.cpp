@@ -0,0 +1,109 @@
+/*!
+*  \brief     AssetCooker Tests.
+*  \details   This file is to check cooked meshes read back the same as the OBJ they came from, and only changed files are cooked again
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "TestRunner.h"
+
+#include <filesystem>
+#include <fstream>
+
+#include "AssetCooker.h"
+#include "MeshFile.h"
+#include "ObjLoader.h"
+#include "TangentGenerator.h"
+
+// A scratch copy of a few assets, so cooking never writes next to the real ones
+static std::filesystem::path makeScratchAssets()
+{
+	const char* files[] = { "Rocket.obj", "Duhduhduh.obj", "Duhduhduh.mtl", "teapot.obj", "ExitSelected.bmp" };
+
+	std::filesystem::path scratch = std::filesystem::temp_directory_path() / "pgg_cooker_test";
+	std::filesystem::remove_all(scratch);
+	std::filesystem::create_directories(scratch);
+	for (const char* file : files)
+		std::filesystem::copy_file(std::filesystem::path(getTestAssetDir()) / file, scratch / file);
+	return scratch;
+}
+
+static size_t countResults(const AssetCooker& cooker, CookResult result)
+{
+	size_t count = 0;
+	for (const CookedAsset& asset : cooker.GetAssets())
+		count += asset.result == result;
+	return count;
+}
+
+static void testSameMesh(const std::filesystem::path& scratch)
+{
+	for (const char* mesh : { "Rocket.obj", "Duhduhduh.obj", "teapot.obj" })
+	{
+		std::string source = (scratch / mesh).string();
+		ObjLoader loader;
+		PGG_CHECK(loader.Load(source));
+		MeshData parsed = std::move(loader.GetMeshData());
+		if (TangentGenerator::IsNeeded(parsed))
+			TangentGenerator().Generate(parsed);
+
+		MeshFile cooked;
+		MeshData read;
+		PGG_CHECK(cooked.Open(MeshFile::GetCookedFileName(source)));
+		PGG_CHECK(cooked.Read(read));
+
+		PGG_CHECK(read.vertices == parsed.vertices);
+		PGG_CHECK(read.normals == parsed.normals);
+		PGG_CHECK(read.texCoords == parsed.texCoords);
+		PGG_CHECK(read.tangents == parsed.tangents);
+		PGG_CHECK(read.subsets.size() == parsed.subsets.size());
+		PGG_CHECK(read.materials.size() == parsed.materials.size());
+		for (size_t i = 0; i < read.materials.size() && i < parsed.materials.size(); i++)
+		{
+			PGG_CHECK(read.materials[i].name == parsed.materials[i].name);
+			PGG_CHECK(read.materials[i].diffuseMap == parsed.materials[i].diffuseMap);
+		}
+	}
+}
+
+static void testIncremental(const std::filesystem::path& scratch)
+{
+	// Nothing changed, nothing cooked
+	AssetCooker cooker;
+	PGG_CHECK(cooker.Cook(scratch.string()));
+	PGG_CHECK(countResults(cooker, CookResult::UpToDate) == cooker.GetAssets().size());
+
+	// Edit one file and only that one is cooked again
+	std::ofstream(scratch / "Rocket.obj", std::ios::app) << "\n# edited\n";
+	PGG_CHECK(cooker.Cook(scratch.string()));
+	PGG_CHECK(countResults(cooker, CookResult::Cooked) == 1);
+	for (const CookedAsset& asset : cooker.GetAssets())
+		PGG_CHECK((asset.result == CookResult::Cooked) == (std::filesystem::path(asset.sourceFileName).filename() == "Rocket.obj"));
+
+	// A cooked file that went missing is made again
+	std::filesystem::remove(MeshFile::GetCookedFileName((scratch / "teapot.obj").string()));
+	PGG_CHECK(cooker.Cook(scratch.string()));
+	PGG_CHECK(countResults(cooker, CookResult::Cooked) == 1);
+
+	// Forced cooks everything
+	PGG_CHECK(cooker.Cook(scratch.string(), true));
+	PGG_CHECK(countResults(cooker, CookResult::Cooked) == cooker.GetAssets().size());
+}
+
+void testAssetCooker()
+{
+	std::filesystem::path scratch = makeScratchAssets();
+
+	AssetCooker cooker;
+	PGG_CHECK(cooker.Cook(scratch.string()));
+	PGG_CHECK(cooker.GetAssets().size() == 4);
+	PGG_CHECK(countResults(cooker, CookResult::Cooked) == 4);
+	PGG_CHECK(std::filesystem::exists(scratch / AssetCooker::MANIFEST_FILE_NAME));
+
+	testSameMesh(scratch);
+	testIncremental(scratch);
+
+	std::filesystem::remove_all(scratch);
+}
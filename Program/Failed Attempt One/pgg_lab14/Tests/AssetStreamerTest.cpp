@@ -0,0 +1,131 @@
+/*!
+*  \brief     AssetStreamer Tests.
+*  \details   This file is to check the streamer takes meshes out of the archive only while their source hasn't been edited,
+*             and hands back everything it was asked for even when it has to wait for room
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "TestRunner.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "AssetArchive.h"
+#include "AssetCooker.h"
+#include "AssetStreamer.h"
+#include "MeshCache.h"
+#include "MeshFile.h"
+#include "ObjLoader.h"
+
+// Wait for one asset to come back (a few seconds at most, so a stuck worker fails rather than hangs)
+static std::unique_ptr<StreamedAsset> waitForAsset(AssetStreamer& streamer)
+{
+	std::unique_ptr<StreamedAsset> asset;
+	auto start = std::chrono::steady_clock::now();
+	while (!streamer.pollCompleted(asset) && std::chrono::steady_clock::now() - start < std::chrono::seconds(10))
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	return asset;
+}
+
+static size_t streamMesh(const AssetArchive& archive, const std::string& fileName, MeshProcessing processing)
+{
+	AssetStreamer streamer(nullptr, &archive);
+	streamer.requestMesh(fileName, AssetPriority::High, processing);
+	std::unique_ptr<StreamedAsset> asset = waitForAsset(streamer);
+	PGG_CHECK(asset && asset->loaded);
+	if (!asset || !asset->loaded)
+		return 0;
+
+	if (processing == MeshProcessing::GenerateLods)
+		return asset->lods.empty() ? 0 : asset->lods[0].mesh.GetVertexCount();
+	return asset->mesh.GetVertexCount();
+}
+
+static void testStaleArchive(MeshProcessing processing)
+{
+	// A cube cooked and packed, in a scratch folder so nothing is written next to the real assets
+	std::filesystem::path scratch = std::filesystem::temp_directory_path() / "pgg_streamer_test";
+	std::filesystem::remove_all(scratch);
+	std::filesystem::create_directories(scratch);
+	std::string sourceFileName = (scratch / "cube.obj").string();
+	std::filesystem::copy_file(std::filesystem::path(getTestAssetDir()) / "cube.obj", sourceFileName);
+
+	ObjLoader loader;
+	PGG_CHECK(loader.Load(sourceFileName));
+	size_t cubeVertices = loader.GetMeshData().GetVertexCount();
+
+	AssetCooker cooker;
+	PGG_CHECK(cooker.Cook(scratch.string()));
+	std::string cookedFileName = MeshFile::GetCookedFileName(sourceFileName);
+	std::vector<ArchiveSource> sources = { { cookedFileName, cookedFileName, true, sourceFileName } };
+	std::string archiveFileName = (scratch / "assets.pak").string();
+	PGG_CHECK(AssetArchive::Write(archiveFileName, sources));
+
+	AssetArchive archive;
+	PGG_CHECK(archive.Open(archiveFileName));
+	PGG_CHECK(streamMesh(archive, sourceFileName, processing) == cubeVertices);
+
+	// Edited after packing - the edit wins over the packed cube (and the loose cooked one)
+	std::ofstream(sourceFileName) << "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n";
+	std::filesystem::remove(MeshCache::GetCacheFileName(sourceFileName));
+	PGG_CHECK(streamMesh(archive, sourceFileName, processing) == 3);
+
+	// No source and no loose cooked file, only the archive has it
+	std::filesystem::remove(sourceFileName);
+	std::filesystem::remove(cookedFileName);
+	std::filesystem::remove(MeshCache::GetCacheFileName(sourceFileName));
+	PGG_CHECK(streamMesh(archive, sourceFileName, processing) == cubeVertices);
+
+	archive.Close();
+	std::filesystem::remove(MeshCache::GetCacheFileName(sourceFileName));
+	std::filesystem::remove_all(scratch);
+}
+
+static void testFullQueue()
+{
+	// More than the finished queue holds, so the worker has to wait for room part way through
+	const int REQUESTS = 200;
+	std::string fileName = getTestAssetDir() + "/cube.obj";
+	{
+		AssetStreamer streamer;
+		for (int i = 0; i < REQUESTS; i++)
+			streamer.requestText(fileName);
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+		int collected = 0;
+		uint32_t lastTicket = 0;
+		while (collected < REQUESTS)
+		{
+			std::unique_ptr<StreamedAsset> asset = waitForAsset(streamer);
+			if (!asset)
+				break;
+			PGG_CHECK(asset->loaded && asset->ticket > lastTicket);
+			lastTicket = asset->ticket;
+			collected++;
+		}
+		PGG_CHECK(collected == REQUESTS);
+		PGG_CHECK(streamer.getPendingCount() == 0);
+	}
+
+	// Stopped while it waits for room - has to wake up and finish rather than hang
+	{
+		AssetStreamer streamer;
+		for (int i = 0; i < REQUESTS; i++)
+			streamer.requestText(fileName);
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	}
+}
+
+void testAssetStreamer()
+{
+	testStaleArchive(MeshProcessing::None);
+	testStaleArchive(MeshProcessing::GenerateLods);
+	testFullQueue();
+}
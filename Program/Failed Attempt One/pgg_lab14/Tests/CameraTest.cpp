@@ -0,0 +1,52 @@
+/*!
+*  \brief     Camera Tests.
+*  \details   This file is to check the Camera keeps the Rocket in view as it follows it down the track
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "TestRunner.h"
+
+#include <cstdint>
+
+#include "Camera.h"
+
+static void testFollowRocket()
+{
+	Camera* camera = new Camera();
+
+	// However far down the track, the Rocket is in front of the eye and on screen
+	for (float z = 0.0f; z > -2000.0f; z -= 250.0f)
+	{
+		glm::vec3 rocket(0.0f, 0.0f, z);
+		camera->followRocket(rocket);
+		camera->update();
+
+		glm::vec4 eye = camera->getView() * glm::vec4(rocket, 1.0f);
+		glm::vec4 clip = camera->getProjection() * eye;
+		PGG_CHECK(eye.z < 0.0f);
+		PGG_CHECK(clip.w > 0.0f && glm::abs(clip.x) <= clip.w && glm::abs(clip.y) <= clip.w);
+		PGG_CHECK(camera->getPosition().z > z);
+	}
+
+	delete camera;
+}
+
+static void testAlignment()
+{
+	// Cameras hold SIMD matrices, so they have to come back aligned from new
+	for (int i = 0; i < 64; i++)
+	{
+		Camera* camera = new Camera();
+		PGG_CHECK(((uintptr_t)camera & (SIMD_ALIGNMENT - 1)) == 0);
+		delete camera;
+	}
+}
+
+void testCamera()
+{
+	testFollowRocket();
+	testAlignment();
+}
@@ -0,0 +1,123 @@
+/*!
+*  \brief     Frustum Tests.
+*  \details   This file is to check spheres and boxes inside, outside and across each of the six planes come out the way they should
+*             (built a second time without SSE, so both versions are checked)
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "TestRunner.h"
+
+#include <cmath>
+
+#include "SDKS/glm/gtc/matrix_transform.hpp"
+
+#include "Frustum.h"
+
+// Eye at z = 10 looking down -z, 90 degrees each way, near at z = 9 and far at z = -91
+static glm::mat4 getViewProjection()
+{
+	glm::mat4 projection = glm::frustum(-1.0f, 1.0f, -1.0f, 1.0f, 1.0f, 101.0f);
+	glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 0.0f, 10.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+	return projection * view;
+}
+
+// A point on each plane and its normal pointing in, in getPlane order - left, right, bottom, top, near, far
+// The side planes are checked 50 in front of the eye, where the view is 100 across
+struct PlaneCase
+{
+	glm::vec3 point;
+	glm::vec3 inwards;
+};
+
+static const float HALF_ROOT_TWO = 0.70710678f;
+
+static const PlaneCase PLANES[6] =
+{
+	{ glm::vec3(-50.0f, 0.0f, -40.0f), glm::vec3(HALF_ROOT_TWO, 0.0f, -HALF_ROOT_TWO) },
+	{ glm::vec3(50.0f, 0.0f, -40.0f), glm::vec3(-HALF_ROOT_TWO, 0.0f, -HALF_ROOT_TWO) },
+	{ glm::vec3(0.0f, -50.0f, -40.0f), glm::vec3(0.0f, HALF_ROOT_TWO, -HALF_ROOT_TWO) },
+	{ glm::vec3(0.0f, 50.0f, -40.0f), glm::vec3(0.0f, -HALF_ROOT_TWO, -HALF_ROOT_TWO) },
+	{ glm::vec3(0.0f, 0.0f, 9.0f), glm::vec3(0.0f, 0.0f, -1.0f) },
+	{ glm::vec3(0.0f, 0.0f, -91.0f), glm::vec3(0.0f, 0.0f, 1.0f) }
+};
+
+static bool isNear(const glm::vec4& a, const glm::vec4& b)
+{
+	return std::fabs(a.x - b.x) < 1.0e-4f && std::fabs(a.y - b.y) < 1.0e-4f && std::fabs(a.z - b.z) < 1.0e-4f &&
+		   std::fabs(a.w - b.w) < 1.0e-3f;
+}
+
+static void testPlanes()
+{
+	// Nothing is culled before there are any planes
+	Frustum* frustum = new Frustum();
+	PGG_CHECK(frustum->isSphereVisible(glm::vec3(0.0f, 0.0f, 1.0e6f), 1.0f));
+	PGG_CHECK(frustum->isBoxVisible(glm::vec3(1.0e6f), glm::vec3(1.0e6f + 1.0f)));
+
+	// Unit normals pointing in, in the right order
+	frustum->extractPlanes(getViewProjection());
+	for (int i = 0; i < 6; i++)
+	{
+		glm::vec4 expected(PLANES[i].inwards, -glm::dot(PLANES[i].inwards, PLANES[i].point));
+		PGG_CHECK(isNear(frustum->getPlane(i), expected));
+	}
+
+	delete frustum;
+}
+
+static void testSpheres()
+{
+	Frustum* frustum = new Frustum();
+	frustum->extractPlanes(getViewProjection());
+
+	PGG_CHECK(frustum->isSphereVisible(glm::vec3(0.0f, 0.0f, -40.0f), 1.0f));
+
+	for (const PlaneCase& plane : PLANES)
+	{
+		// Just inside, across the plane, just outside, and outside but big enough to reach back in
+		PGG_CHECK(frustum->isSphereVisible(plane.point + plane.inwards * 2.0f, 1.0f));
+		PGG_CHECK(frustum->isSphereVisible(plane.point, 1.0f));
+		PGG_CHECK(!frustum->isSphereVisible(plane.point - plane.inwards * 2.0f, 1.0f));
+		PGG_CHECK(frustum->isSphereVisible(plane.point - plane.inwards * 2.0f, 3.0f));
+	}
+
+	delete frustum;
+}
+
+static void testBoxes()
+{
+	Frustum* frustum = new Frustum();
+	frustum->extractPlanes(getViewProjection());
+	const glm::vec3 halfSize(1.0f);
+
+	PGG_CHECK(frustum->isBoxVisible(glm::vec3(-1.0f, -1.0f, -41.0f), glm::vec3(1.0f, 1.0f, -39.0f)));
+
+	for (const PlaneCase& plane : PLANES)
+	{
+		// A unit box reaches at most root three from its centre, so 2 is across the plane and 4 is clear of it
+		glm::vec3 inside = plane.point + plane.inwards * 4.0f;
+		glm::vec3 outside = plane.point - plane.inwards * 4.0f;
+		PGG_CHECK(frustum->isBoxVisible(inside - halfSize, inside + halfSize));
+		PGG_CHECK(frustum->isBoxVisible(plane.point - halfSize, plane.point + halfSize));
+		PGG_CHECK(!frustum->isBoxVisible(outside - halfSize, outside + halfSize));
+	}
+
+	// Round the back of the eye and past the far plane, where only one plane can throw them out
+	PGG_CHECK(!frustum->isBoxVisible(glm::vec3(-1.0f, -1.0f, 20.0f), glm::vec3(1.0f, 1.0f, 22.0f)));
+	PGG_CHECK(!frustum->isBoxVisible(glm::vec3(-1.0f, -1.0f, -200.0f), glm::vec3(1.0f, 1.0f, -198.0f)));
+
+	// Bigger than the whole view
+	PGG_CHECK(frustum->isBoxVisible(glm::vec3(-500.0f), glm::vec3(500.0f)));
+
+	delete frustum;
+}
+
+void testFrustum()
+{
+	testPlanes();
+	testSpheres();
+	testBoxes();
+}
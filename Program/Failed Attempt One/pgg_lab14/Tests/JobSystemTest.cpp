@@ -0,0 +1,152 @@
+/*!
+*  \brief     JobSystem Tests.
+*  \details   This file is to check every job runs exactly once, children before their parent finishes and continuations in order
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "TestRunner.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "JobSystem.h"
+
+struct MarkJobData
+{
+	std::atomic<int>* marks;
+	int index;
+};
+
+static void markJob(Job&, const void* data)
+{
+	const MarkJobData& mark = *(const MarkJobData*)data;
+	mark.marks[mark.index].fetch_add(1, std::memory_order_relaxed);
+}
+
+struct OrderJobData
+{
+	std::atomic<int>* next;
+	int* order;
+	int index;
+};
+
+static void orderJob(Job&, const void* data)
+{
+	const OrderJobData& step = *(const OrderJobData*)data;
+	step.order[step.next->fetch_add(1, std::memory_order_relaxed)] = step.index;
+}
+
+static bool allMarkedOnce(const std::atomic<int>* marks, size_t count)
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		if (marks[i].load(std::memory_order_relaxed) != 1)
+			return false;
+	}
+	return true;
+}
+
+static void testParallelFor(JobSystem& jobSystem)
+{
+	// Every index once, including counts that don't divide by the batch and batches bigger than the count
+	const size_t count = 10007;
+	const size_t batchSizes[] = { 0, 1, 7, 256, 4096, 20000 };
+	for (size_t batchSize : batchSizes)
+	{
+		std::unique_ptr<std::atomic<int>[]> marks(new std::atomic<int>[count]);
+		for (size_t i = 0; i < count; i++)
+			marks[i].store(0, std::memory_order_relaxed);
+
+		jobSystem.parallelFor(count, batchSize, [&marks](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; i++)
+				marks[i].fetch_add(1, std::memory_order_relaxed);
+		});
+		PGG_CHECK(allMarkedOnce(marks.get(), count));
+	}
+
+	// Nothing to do is fine
+	bool called = false;
+	jobSystem.parallelFor(0, 16, [&called](size_t, size_t) { called = true; });
+	PGG_CHECK(!called);
+}
+
+static void testChildren(JobSystem& jobSystem, int children)
+{
+	// More than MAX_JOBS_PER_THREAD of them means the ring has to wrap while the root is still waiting
+	std::unique_ptr<std::atomic<int>[]> marks(new std::atomic<int>[children]);
+	for (int i = 0; i < children; i++)
+		marks[i].store(0, std::memory_order_relaxed);
+
+	Job* root = jobSystem.createJob(nullptr);
+	for (int i = 0; i < children; i++)
+	{
+		MarkJobData data = { marks.get(), i };
+		jobSystem.run(jobSystem.createJob(&markJob, data, root));
+	}
+	jobSystem.run(root);
+	jobSystem.wait(root);
+
+	PGG_CHECK(jobSystem.isFinished(root));
+	PGG_CHECK(allMarkedOnce(marks.get(), children));
+}
+
+static void testContinuations(JobSystem& jobSystem)
+{
+	const int chainLength = 200;
+	std::vector<int> order(chainLength, -1);
+	std::atomic<int> next(0);
+
+	OrderJobData data = { &next, order.data(), 0 };
+	Job* first = jobSystem.createJob(&orderJob, data);
+	Job* previous = first;
+	for (int i = 1; i < chainLength; i++)
+	{
+		data.index = i;
+		Job* step = jobSystem.createJob(&orderJob, data);
+		PGG_CHECK(jobSystem.addContinuation(previous, step));
+		previous = step;
+	}
+	jobSystem.run(first);
+	jobSystem.wait(previous);
+
+	PGG_CHECK(next.load() == chainLength);
+	bool inOrder = true;
+	for (int i = 0; i < chainLength; i++)
+		inOrder = inOrder && order[i] == i;
+	PGG_CHECK(inOrder);
+
+	// Only MAX_CONTINUATIONS fit on one job
+	Job* full = jobSystem.createJob(nullptr);
+	Job* waiting[Job::MAX_CONTINUATIONS + 1];
+	for (int i = 0; i <= Job::MAX_CONTINUATIONS; i++)
+	{
+		waiting[i] = jobSystem.createJob(nullptr);
+		PGG_CHECK(jobSystem.addContinuation(full, waiting[i]) == (i < Job::MAX_CONTINUATIONS));
+	}
+	jobSystem.run(full);
+	for (int i = 0; i < Job::MAX_CONTINUATIONS; i++)
+		jobSystem.wait(waiting[i]);
+	jobSystem.run(waiting[Job::MAX_CONTINUATIONS]);
+	jobSystem.wait(waiting[Job::MAX_CONTINUATIONS]);
+}
+
+void testJobSystem()
+{
+	const int workerCounts[] = { 0, 1, 3 };
+	for (int workers : workerCounts)
+	{
+		JobSystem jobSystem(workers);
+		PGG_CHECK(jobSystem.getWorkerCount() == workers);
+		PGG_CHECK(jobSystem.isThreadRegistered());
+
+		testParallelFor(jobSystem);
+		testChildren(jobSystem, 100);
+		testChildren(jobSystem, (int)JobSystem::MAX_JOBS_PER_THREAD * 3 + 5);
+		testContinuations(jobSystem);
+	}
+}
@@ -0,0 +1,115 @@
+/*!
+*  \brief     LodGroup Tests.
+*  \details   This file is to check levels are picked by distance, and that hysteresis only holds an instance on its level
+*             while it is near the edge of its band
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "TestRunner.h"
+
+#include "LodGroup.h"
+
+// Level 0 out to 100, level 1 out to 200, level 2 beyond that, switching 10% past each edge
+static void makeGroup(LodGroup& group)
+{
+	group.addLevel(100.0f);
+	group.addLevel(200.0f);
+	group.addLevel(1000.0f);
+	group.setHysteresis(0.1f);
+}
+
+static void testNewInstance()
+{
+	LodGroup group;
+	makeGroup(group);
+	PGG_CHECK(group.getLevelCount() == 3);
+
+	// Nothing to hold on to, so just the band it is in
+	PGG_CHECK(group.selectLevel(0.0f) == 0);
+	PGG_CHECK(group.selectLevel(99.9f) == 0);
+	PGG_CHECK(group.selectLevel(100.0f) == 1);
+	PGG_CHECK(group.selectLevel(105.0f, -1) == 1);
+	PGG_CHECK(group.selectLevel(200.0f, -1) == 2);
+	PGG_CHECK(group.selectLevel(5000.0f, -1) == 2);
+}
+
+static void testHysteresis()
+{
+	LodGroup group;
+	makeGroup(group);
+
+	// Inside 10% either side of 100 it stays on whichever level it was on
+	PGG_CHECK(group.selectLevel(105.0f, 0) == 0);
+	PGG_CHECK(group.selectLevel(109.9f, 0) == 0);
+	PGG_CHECK(group.selectLevel(95.0f, 1) == 1);
+	PGG_CHECK(group.selectLevel(90.0f, 1) == 1);
+
+	// Past it, it moves
+	PGG_CHECK(group.selectLevel(110.0f, 0) == 1);
+	PGG_CHECK(group.selectLevel(89.9f, 1) == 0);
+
+	// Same at the next edge up
+	PGG_CHECK(group.selectLevel(215.0f, 1) == 1);
+	PGG_CHECK(group.selectLevel(185.0f, 2) == 2);
+	PGG_CHECK(group.selectLevel(220.0f, 1) == 2);
+	PGG_CHECK(group.selectLevel(179.0f, 2) == 1);
+
+	// Without any it pops right at the edge
+	group.setHysteresis(0.0f);
+	PGG_CHECK(group.selectLevel(100.0f, 0) == 1);
+	PGG_CHECK(group.selectLevel(99.9f, 1) == 0);
+}
+
+static void testBigMoves()
+{
+	LodGroup group;
+	makeGroup(group);
+
+	// A camera cut can move it more than one level in a call, either way
+	PGG_CHECK(group.selectLevel(500.0f, 0) == 2);
+	PGG_CHECK(group.selectLevel(10.0f, 2) == 0);
+
+	// Across the first edge but inside 10% of the second, it stops on the middle level
+	PGG_CHECK(group.selectLevel(210.0f, 0) == 1);
+	PGG_CHECK(group.selectLevel(95.0f, 2) == 1);
+}
+
+static void testOutOfRange()
+{
+	LodGroup group;
+	makeGroup(group);
+
+	// A level the group hasn't got is treated like a new instance
+	PGG_CHECK(group.selectLevel(150.0f, 7) == 1);
+	PGG_CHECK(group.selectLevel(105.0f, 3) == 1);
+	PGG_CHECK(group.selectLevel(50.0f, -5) == 0);
+}
+
+static void testFewLevels()
+{
+	// One level, or none at all, is always level 0
+	LodGroup single;
+	single.addLevel(100.0f);
+	single.setHysteresis(0.1f);
+	PGG_CHECK(single.getLevelCount() == 1);
+	PGG_CHECK(single.selectLevel(50.0f) == 0);
+	PGG_CHECK(single.selectLevel(5000.0f, 0) == 0);
+	PGG_CHECK(single.selectLevel(5000.0f, 3) == 0);
+
+	LodGroup empty;
+	PGG_CHECK(empty.getLevelCount() == 0);
+	PGG_CHECK(empty.selectLevel(50.0f) == 0);
+	PGG_CHECK(empty.selectLevel(50.0f, 2) == 0);
+}
+
+void testLodGroup()
+{
+	testNewInstance();
+	testHysteresis();
+	testBigMoves();
+	testOutOfRange();
+	testFewLevels();
+}
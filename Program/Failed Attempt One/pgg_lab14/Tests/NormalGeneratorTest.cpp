@@ -0,0 +1,236 @@
+/*!
+*  \brief     NormalGenerator Tests.
+*  \details   This file is to check generated normals against a plain double precision version, in both modes
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "TestRunner.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <map>
+#include <vector>
+
+#include "NormalGenerator.h"
+#include "ObjLoader.h"
+#include "SDKS/glm/gtc/type_ptr.hpp"
+
+// Furthest a generated normal may point from the reference on a well shaped triangle - float against double, nothing more
+static const double MAX_ANGLE_DEGREES = 0.01;
+
+static double toDegrees(double radians)
+{
+	return radians * 180.0 / 3.14159265358979;
+}
+
+// Straightforward normals in double precision, one triangle at a time, no welding or SIMD
+// tolerance is how far off each one may be - slivers are long and thin enough that float rounding of their
+// edges alone turns the cross product by about FLT_EPSILON * longest edge squared / its length radians
+static void referenceNormals(const MeshData& mesh, NormalMode mode, std::vector<glm::dvec3>& normals, std::vector<double>& tolerance)
+{
+	std::map<std::vector<float>, glm::dvec3> sums;
+	std::vector<glm::dvec3> faces;
+	std::vector<double> faceTolerance;
+	size_t triangleCount = mesh.GetVertexCount() / 3;
+	for (size_t triangle = 0; triangle < triangleCount; triangle++)
+	{
+		glm::dvec3 corners[3];
+		for (int c = 0; c < 3; c++)
+			corners[c] = glm::dvec3(glm::make_vec3(&mesh.vertices[(triangle * 3 + c) * 3]));
+
+		glm::dvec3 face = glm::cross(corners[1] - corners[0], corners[2] - corners[0]);
+		faces.push_back(face);
+		for (int c = 0; c < 3; c++)
+		{
+			const float* position = &mesh.vertices[(triangle * 3 + c) * 3];
+			sums[std::vector<float>(position, position + 3)] += face;
+		}
+
+		double longest = std::max(glm::length(corners[1] - corners[0]), std::max(glm::length(corners[2] - corners[0]), glm::length(corners[2] - corners[1])));
+		double rounding = 4.0 * FLT_EPSILON * longest * longest / std::max(glm::length(face), 1.0e-30);
+		faceTolerance.push_back(MAX_ANGLE_DEGREES + toDegrees(rounding));
+	}
+
+	// No length at all is the loader's old default of (1, 0, 0)
+	normals.resize(triangleCount * 3);
+	tolerance.resize(triangleCount * 3);
+	for (size_t vertex = 0; vertex < triangleCount * 3; vertex++)
+	{
+		const float* position = &mesh.vertices[vertex * 3];
+		glm::dvec3 sum = mode == NormalMode::Flat ? faces[vertex / 3] : sums[std::vector<float>(position, position + 3)];
+		normals[vertex] = glm::dot(sum, sum) > 1.0e-30 ? glm::normalize(sum) : glm::dvec3(1.0, 0.0, 0.0);
+		tolerance[vertex] = mode == NormalMode::Flat ? faceTolerance[vertex / 3] : MAX_ANGLE_DEGREES;
+	}
+}
+
+// Degrees between a generated normal and the reference, anything not unit length or not finite counts as 180
+static double angleFrom(const MeshData& mesh, size_t vertex, const glm::dvec3& reference)
+{
+	glm::dvec3 normal(glm::make_vec3(&mesh.normals[vertex * 3]));
+	double length = glm::length(normal);
+	if (!std::isfinite(length) || std::fabs(length - 1.0) > 1.0e-5)
+		return 180.0;
+
+	return toDegrees(std::acos(glm::clamp(glm::dot(normal, reference) / length, -1.0, 1.0)));
+}
+
+// True if every normal is within its tolerance of the reference
+static bool matchesReference(const MeshData& mesh, NormalMode mode)
+{
+	std::vector<glm::dvec3> reference;
+	std::vector<double> tolerance;
+	referenceNormals(mesh, mode, reference, tolerance);
+
+	size_t wrong = 0;
+	for (size_t vertex = 0; vertex < reference.size(); vertex++)
+		wrong += angleFrom(mesh, vertex, reference[vertex]) > tolerance[vertex];
+	return wrong == 0 && mesh.normals.size() == reference.size() * 3;
+}
+
+static void addTriangle(MeshData& mesh, const glm::vec3& a, const glm::vec3& b, const glm::vec3& c)
+{
+	for (const glm::vec3& corner : { a, b, c })
+	{
+		mesh.vertices.push_back(corner.x);
+		mesh.vertices.push_back(corner.y);
+		mesh.vertices.push_back(corner.z);
+	}
+}
+
+static void testMeshes()
+{
+	// None of these have any "vn", so every normal is generated - smooth by the loader, then both modes again here
+	NormalGenerator generator;
+	for (const char* name : { "teapot.obj", "airboat.obj", "cessna.obj" })
+	{
+		ObjLoader loader;
+		PGG_CHECK(loader.Load(getTestAssetDir() + "/" + name));
+		MeshData& mesh = loader.GetMeshData();
+		PGG_CHECK(mesh.GetVertexCount() > 0);
+		PGG_CHECK(matchesReference(mesh, NormalMode::Smooth));
+
+		generator.Generate(mesh, NormalMode::Flat);
+		PGG_CHECK(matchesReference(mesh, NormalMode::Flat));
+
+		generator.Generate(mesh, NormalMode::Smooth);
+		PGG_CHECK(matchesReference(mesh, NormalMode::Smooth));
+	}
+}
+
+static void testFlat()
+{
+	// A ridge - two slopes meeting along the top, smooth bends the ridge normals up and flat keeps each slope's own
+	MeshData mesh;
+	addTriangle(mesh, glm::vec3(0, 0, 0), glm::vec3(0, 0, 1), glm::vec3(1, 1, 0));
+	addTriangle(mesh, glm::vec3(1, 1, 0), glm::vec3(0, 0, 1), glm::vec3(1, 1, 1));
+	addTriangle(mesh, glm::vec3(1, 1, 0), glm::vec3(1, 1, 1), glm::vec3(2, 0, 0));
+	addTriangle(mesh, glm::vec3(2, 0, 0), glm::vec3(1, 1, 1), glm::vec3(2, 0, 1));
+	addTriangle(mesh, glm::vec3(5, 0, 0), glm::vec3(5, 0, 2), glm::vec3(6, 0, 0));
+
+	NormalGenerator generator;
+	generator.Generate(mesh, NormalMode::Flat);
+	PGG_CHECK(matchesReference(mesh, NormalMode::Flat));
+
+	// All three corners of a triangle the same, and the two sides of the ridge different
+	for (size_t triangle = 0; triangle < 5; triangle++)
+	{
+		const float* first = &mesh.normals[triangle * 9];
+		PGG_CHECK(first[0] == first[3] && first[3] == first[6]);
+		PGG_CHECK(first[1] == first[4] && first[4] == first[7]);
+		PGG_CHECK(first[2] == first[5] && first[5] == first[8]);
+	}
+	PGG_CHECK(mesh.normals[0] < 0.0f && mesh.normals[18] > 0.0f);
+
+	generator.Generate(mesh, NormalMode::Smooth);
+	PGG_CHECK(matchesReference(mesh, NormalMode::Smooth));
+	PGG_CHECK(mesh.normals[6 * 3 + 1] > 0.75f);
+}
+
+static void testMissing()
+{
+	// The cube's file has every "vn" - pretend every third one was left out
+	ObjLoader loader;
+	PGG_CHECK(loader.Load(getTestAssetDir() + "/cube.obj"));
+	MeshData mesh = loader.GetMeshData();
+	std::vector<float> fromFile = mesh.normals;
+
+	std::vector<uint8_t> missing(mesh.GetVertexCount(), 0);
+	for (size_t vertex = 0; vertex < missing.size(); vertex += 3)
+	{
+		missing[vertex] = 1;
+		mesh.normals[vertex * 3] = mesh.normals[vertex * 3 + 1] = mesh.normals[vertex * 3 + 2] = 0.0f;
+	}
+
+	for (NormalMode mode : { NormalMode::Smooth, NormalMode::Flat })
+	{
+		NormalGenerator generator;
+		generator.Generate(mesh, mode, &missing);
+
+		std::vector<glm::dvec3> reference;
+		std::vector<double> tolerance;
+		referenceNormals(mesh, mode, reference, tolerance);
+		for (size_t vertex = 0; vertex < missing.size(); vertex++)
+		{
+			// Only the flagged ones are written, the rest are still exactly what the file said
+			if (missing[vertex])
+			{
+				PGG_CHECK(angleFrom(mesh, vertex, reference[vertex]) <= tolerance[vertex]);
+			}
+			else
+			{
+				PGG_CHECK(mesh.normals[vertex * 3] == fromFile[vertex * 3]);
+				PGG_CHECK(mesh.normals[vertex * 3 + 1] == fromFile[vertex * 3 + 1]);
+				PGG_CHECK(mesh.normals[vertex * 3 + 2] == fromFile[vertex * 3 + 2]);
+			}
+		}
+	}
+}
+
+static void testZeroArea()
+{
+	// Exporters leave these behind - a point, a line, one too small to measure, and one collinear with a real triangle
+	MeshData mesh;
+	addTriangle(mesh, glm::vec3(3, 3, 3), glm::vec3(3, 3, 3), glm::vec3(3, 3, 3));
+	addTriangle(mesh, glm::vec3(0, 5, 0), glm::vec3(1, 5, 0), glm::vec3(2, 5, 0));
+	addTriangle(mesh, glm::vec3(7, 0, 0), glm::vec3(7.0f + 1.0e-20f, 0, 0), glm::vec3(7, 1.0e-20f, 0));
+	addTriangle(mesh, glm::vec3(0, 0, 0), glm::vec3(1, 0, 0), glm::vec3(0, 1, 0));
+	addTriangle(mesh, glm::vec3(0, 0, 0), glm::vec3(0.5f, 0, 0), glm::vec3(1, 0, 0));
+
+	for (NormalMode mode : { NormalMode::Smooth, NormalMode::Flat })
+	{
+		NormalGenerator generator;
+		generator.Generate(mesh, mode);
+		PGG_CHECK(mesh.normals.size() == mesh.vertices.size());
+		PGG_CHECK(matchesReference(mesh, mode));
+
+		// Nothing to go on gives (1, 0, 0) rather than NaN
+		for (size_t vertex = 0; vertex < 9; vertex++)
+			PGG_CHECK(mesh.normals[vertex * 3] == 1.0f && mesh.normals[vertex * 3 + 1] == 0.0f && mesh.normals[vertex * 3 + 2] == 0.0f);
+	}
+
+	// Smooth - the flat triangle sharing corners with the real one adds nothing, so they keep the real one's normal
+	NormalGenerator generator;
+	generator.Generate(mesh, NormalMode::Smooth);
+	for (size_t vertex = 12; vertex < 15; vertex++)
+	{
+		if (vertex != 13)
+			PGG_CHECK(mesh.normals[vertex * 3 + 2] == 1.0f);
+	}
+
+	// And a mesh with no triangles at all is left empty
+	MeshData empty;
+	generator.Generate(empty, NormalMode::Smooth);
+	PGG_CHECK(empty.normals.empty());
+}
+
+void testNormalGenerator()
+{
+	testMeshes();
+	testFlat();
+	testMissing();
+	testZeroArea();
+}
@@ -0,0 +1,109 @@
+/*!
+*  \brief     ObjLoader Tests.
+*  \details   This file is to check OBJ files load into the triangles, normals and bounds they describe
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "TestRunner.h"
+
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+
+#include "ObjLoader.h"
+
+static void testCube()
+{
+	ObjLoader loader;
+	PGG_CHECK(loader.Load(getTestAssetDir() + "/cube.obj"));
+
+	// 12 triangles, every corner with a unit normal from its "vn"
+	const MeshData& mesh = loader.GetMeshData();
+	PGG_CHECK(mesh.GetVertexCount() == 36);
+	PGG_CHECK(mesh.normals.size() == mesh.vertices.size());
+	for (size_t i = 0; i + 2 < mesh.normals.size(); i += 3)
+	{
+		float length = std::sqrt(mesh.normals[i] * mesh.normals[i] + mesh.normals[i + 1] * mesh.normals[i + 1] +
+								 mesh.normals[i + 2] * mesh.normals[i + 2]);
+		PGG_CHECK(std::fabs(length - 1.0f) < 1.0e-5f);
+	}
+
+	PGG_CHECK(mesh.bounds.min == glm::vec3(-0.5f));
+	PGG_CHECK(mesh.bounds.max == glm::vec3(0.5f));
+}
+
+static void testMissingFile()
+{
+	ObjLoader loader;
+	PGG_CHECK(!loader.Load(getTestAssetDir() + "/no such file.obj"));
+	PGG_CHECK(loader.GetMeshData().GetVertexCount() == 0);
+}
+
+static void testLevel()
+{
+	// The level the game is played on, all quads
+	ObjLoader loader;
+	PGG_CHECK(loader.Load(getTestAssetDir() + "/Level Final.obj"));
+	const MeshData& mesh = loader.GetMeshData();
+	PGG_CHECK(mesh.GetVertexCount() > 0 && mesh.GetVertexCount() % 3 == 0);
+	PGG_CHECK(mesh.bounds.max.z - mesh.bounds.min.z > 1000.0f);
+}
+
+static bool loadText(const std::string& text, MeshData& mesh)
+{
+	std::string fileName = (std::filesystem::temp_directory_path() / "pgg_objloader_test.obj").string();
+	FILE* file = fopen(fileName.c_str(), "wb");
+	fwrite(text.data(), 1, text.size(), file);
+	fclose(file);
+
+	ObjLoader loader;
+	bool loaded = loader.Load(fileName);
+	mesh = std::move(loader.GetMeshData());
+	std::remove(fileName.c_str());
+	return loaded;
+}
+
+static void testNegativeIndices()
+{
+	// The same two quads, once counted from the start and once back from the end
+	const std::string vertices = "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\nvn 0 0 1\n";
+	MeshData absolute, relative;
+	PGG_CHECK(loadText(vertices + "f 1//1 2//1 3//1 4//1\nv 0 2 0\nv 1 2 0\nf 4//1 3//1 6//1 5//1\n", absolute));
+	PGG_CHECK(loadText(vertices + "f -4//-1 -3//-1 -2//-1 -1//-1\nv 0 2 0\nv 1 2 0\nf -3//-1 -4//-1 -1//-1 -2//-1\n", relative));
+	PGG_CHECK(absolute.GetVertexCount() == 12);
+	PGG_CHECK(relative.vertices == absolute.vertices);
+	PGG_CHECK(relative.normals == absolute.normals);
+}
+
+static void testConcavePolygon()
+{
+	// An L shape - fanning from the first corner would put a triangle outside it
+	MeshData mesh;
+	PGG_CHECK(loadText("v 0 0 0\nv 2 0 0\nv 2 1 0\nv 1 1 0\nv 1 2 0\nv 0 2 0\nf 1 2 3 4 5 6\n", mesh));
+	PGG_CHECK(mesh.GetVertexCount() == 12);
+
+	// Four triangles that cover the three unit squares exactly, all facing the same way
+	float area = 0.0f;
+	for (size_t i = 0; i + 8 < mesh.vertices.size(); i += 9)
+	{
+		glm::vec3 a(mesh.vertices[i], mesh.vertices[i + 1], mesh.vertices[i + 2]);
+		glm::vec3 b(mesh.vertices[i + 3], mesh.vertices[i + 4], mesh.vertices[i + 5]);
+		glm::vec3 c(mesh.vertices[i + 6], mesh.vertices[i + 7], mesh.vertices[i + 8]);
+		float signedArea = 0.5f * ((b.x - a.x) * (c.y - a.y) - (c.x - a.x) * (b.y - a.y));
+		PGG_CHECK(signedArea > 0.0f);
+		area += signedArea;
+	}
+	PGG_CHECK(std::fabs(area - 3.0f) < 1.0e-5f);
+}
+
+void testObjLoader()
+{
+	testCube();
+	testMissingFile();
+	testLevel();
+	testNegativeIndices();
+	testConcavePolygon();
+}
@@ -0,0 +1,108 @@
+/*!
+*  \brief     OcclusionBuffer Tests.
+*  \details   This file is to check the occlusion buffer only hides boxes that are really behind a blocker
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "TestRunner.h"
+
+#include "SDKS/glm/gtc/matrix_transform.hpp"
+
+#include "OcclusionBuffer.h"
+
+// Eye at the origin looking down -z, 90 degrees each way, near at 1 and far at 100
+static glm::mat4 getViewProjection()
+{
+	return glm::frustum(-1.0f, 1.0f, -1.0f, 1.0f, 1.0f, 100.0f);
+}
+
+// A 10 x 10 wall straight ahead, 20 units away
+static void drawWall(OcclusionBuffer& occlusion)
+{
+	occlusion.clear(getViewProjection());
+	occlusion.addOccluder(glm::vec3(-5.0f, -5.0f, -21.0f), glm::vec3(5.0f, 5.0f, -20.0f));
+	occlusion.buildPyramid();
+}
+
+static void testPyramid()
+{
+	OcclusionBuffer occlusion(128, 72);
+	PGG_CHECK(occlusion.getLevelCount() == 8);
+
+	drawWall(occlusion);
+	PGG_CHECK(occlusion.getOccluderCount() == 1);
+
+	// The middle of the screen is the wall, the corner is still far away, and the top keeps the farthest of the lot
+	PGG_CHECK(occlusion.getDepth(0, 64, 36) < 1.0f);
+	PGG_CHECK(occlusion.getDepth(0, 0, 0) == 1.0f);
+	PGG_CHECK(occlusion.getDepth(occlusion.getLevelCount() - 1, 0, 0) == 1.0f);
+}
+
+static void testBehind()
+{
+	OcclusionBuffer occlusion;
+	drawWall(occlusion);
+
+	// Right behind the wall, and even past the far plane as long as the wall is in front of it
+	PGG_CHECK(occlusion.isBoxOccluded(glm::vec3(-1.0f, -1.0f, -40.0f), glm::vec3(1.0f, 1.0f, -38.0f)));
+	PGG_CHECK(occlusion.isBoxOccluded(glm::vec3(-1.0f, -1.0f, -150.0f), glm::vec3(1.0f, 1.0f, -140.0f)));
+
+	// Cleared for a new frame, nothing hides it any more
+	occlusion.clear(getViewProjection());
+	occlusion.buildPyramid();
+	PGG_CHECK(!occlusion.isBoxOccluded(glm::vec3(-1.0f, -1.0f, -40.0f), glm::vec3(1.0f, 1.0f, -38.0f)));
+}
+
+static void testNotBehind()
+{
+	OcclusionBuffer occlusion;
+	drawWall(occlusion);
+
+	// In front of the wall
+	PGG_CHECK(!occlusion.isBoxOccluded(glm::vec3(-1.0f, -1.0f, -10.0f), glm::vec3(1.0f, 1.0f, -8.0f)));
+
+	// Beside it, and only half behind it
+	PGG_CHECK(!occlusion.isBoxOccluded(glm::vec3(15.0f, -1.0f, -40.0f), glm::vec3(17.0f, 1.0f, -38.0f)));
+	PGG_CHECK(!occlusion.isBoxOccluded(glm::vec3(5.0f, -1.0f, -40.0f), glm::vec3(15.0f, 1.0f, -38.0f)));
+
+	// Past the far plane with nothing drawn in front of it
+	PGG_CHECK(!occlusion.isBoxOccluded(glm::vec3(40.0f, -1.0f, -150.0f), glm::vec3(45.0f, 1.0f, -140.0f)));
+}
+
+static void testNearPlane()
+{
+	OcclusionBuffer occlusion;
+	drawWall(occlusion);
+
+	// Reaching from behind the wall to in front of the near plane, and on past the eye
+	PGG_CHECK(!occlusion.isBoxOccluded(glm::vec3(-1.0f, -1.0f, -40.0f), glm::vec3(1.0f, 1.0f, -0.5f)));
+	PGG_CHECK(!occlusion.isBoxOccluded(glm::vec3(-1.0f, -1.0f, -40.0f), glm::vec3(1.0f, 1.0f, 2.0f)));
+
+	// A blocker the eye is inside is left out rather than covering the whole screen
+	occlusion.clear(getViewProjection());
+	occlusion.addOccluder(glm::vec3(-5.0f, -5.0f, -21.0f), glm::vec3(5.0f, 5.0f, 1.0f));
+	occlusion.buildPyramid();
+	PGG_CHECK(occlusion.getOccluderCount() == 0);
+	PGG_CHECK(!occlusion.isBoxOccluded(glm::vec3(-1.0f, -1.0f, -40.0f), glm::vec3(1.0f, 1.0f, -38.0f)));
+}
+
+static void testInnerBox()
+{
+	glm::vec3 innerMin, innerMax;
+	OcclusionBuffer::getInnerBox(glm::vec3(-10.0f, 0.0f, 10.0f), glm::vec3(10.0f, 4.0f, 30.0f), glm::vec3(0.25f, 0.0f, 0.5f),
+								 glm::vec3(0.75f, 0.5f, 1.0f), innerMin, innerMax);
+	PGG_CHECK(innerMin == glm::vec3(-5.0f, 0.0f, 20.0f));
+	PGG_CHECK(innerMax == glm::vec3(5.0f, 2.0f, 30.0f));
+}
+
+void testOcclusionBuffer()
+{
+	testPyramid();
+	testBehind();
+	testNotBehind();
+	testNearPlane();
+	testInnerBox();
+}
@@ -0,0 +1,88 @@
+/*!
+*  \brief     Simulation Tests.
+*  \details   This file is to check the Rocket moves, crashes and finishes the way the game expects
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "TestRunner.h"
+
+#include "ObstacleField.h"
+#include "Simulation.h"
+
+static void testHitsRow()
+{
+	ObstacleRow row;
+	row.z = -100.0f;
+	row.obstacles = { { -50.0f, 40.0f }, { 20.0f, 30.0f } };
+	const float depth = 10.0f;
+
+	// Inside an obstacle, in the gap, and either side of the row along z
+	PGG_CHECK(hitsRow(row, depth, glm::vec3(-30.0f, 0.0f, -95.0f)));
+	PGG_CHECK(hitsRow(row, depth, glm::vec3(25.0f, 0.0f, -95.0f)));
+	PGG_CHECK(!hitsRow(row, depth, glm::vec3(0.0f, 0.0f, -95.0f)));
+	PGG_CHECK(!hitsRow(row, depth, glm::vec3(-30.0f, 0.0f, -100.0f)));
+	PGG_CHECK(!hitsRow(row, depth, glm::vec3(-30.0f, 0.0f, -89.0f)));
+}
+
+static void testObstacleField()
+{
+	ObstacleField field;
+	field.clear();
+	field.addRow(-100.0f, { { -50.0f, 40.0f } });
+	field.setFinishLine(-200.0f);
+
+	PGG_CHECK(field.checkCollisions(glm::vec3(-30.0f, 0.0f, -95.0f)) == CollisionResult::Crashed);
+	PGG_CHECK(field.checkCollisions(glm::vec3(0.0f, 0.0f, -95.0f)) == CollisionResult::None);
+	PGG_CHECK(field.checkCollisions(glm::vec3(0.0f, 0.0f, -201.0f)) == CollisionResult::Finished);
+}
+
+static void testRocketMovement()
+{
+	Simulation simulation;
+	PGG_CHECK(simulation.getRocketPosition() == glm::vec3(0.0f));
+
+	// No input flies straight down the track (towards -z)
+	for (int i = 0; i < 60; i++)
+		simulation.update(1.0f / 60.0f);
+	PGG_CHECK(simulation.getRocketPosition().z < 0.0f);
+	PGG_CHECK(simulation.getRocketPosition().x == 0.0f);
+
+	// Spinning left drifts left, and the walls stop it
+	simulation.reset();
+	for (int i = 0; i < 30; i++)
+		simulation.spinLeft();
+	simulation.update(1.0f / 60.0f);
+	PGG_CHECK(simulation.getRocketPosition().x < 0.0f);
+	for (int i = 0; i < 60 * 20; i++)
+		simulation.update(1.0f / 60.0f);
+	PGG_CHECK(simulation.getRocketPosition().x >= -116.01f);
+}
+
+static void testCrash()
+{
+	// Straight down the middle clears the first two rows of the level and hits the third, at -333
+	Simulation simulation;
+	CollisionResult result = CollisionResult::None;
+	float crashZ = 0.0f;
+	for (int i = 0; i < 60 * 60 && result != CollisionResult::Crashed; i++)
+	{
+		crashZ = simulation.getRocketPosition().z;
+		result = simulation.update(1.0f / 60.0f);
+	}
+
+	PGG_CHECK(result == CollisionResult::Crashed);
+	PGG_CHECK(crashZ < -320.0f && crashZ > -335.0f);
+	PGG_CHECK(simulation.getNumberOfTries() == 1);
+	PGG_CHECK(simulation.getRocketPosition().z == 100.0f);
+}
+
+void testSimulation()
+{
+	testHitsRow();
+	testObstacleField();
+	testRocketMovement();
+	testCrash();
+}
@@ -0,0 +1,206 @@
+/*!
+*  \brief     SimulationThread Tests.
+*  \details   This file is to check the lock-free hand overs between the simulation and render threads, and that the
+*             simulation thread starts, stops and catches up the way it should
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "TestRunner.h"
+
+#include <atomic>
+#include <chrono>
+#include <stdint.h>
+#include <thread>
+
+#include "Simulation.h"
+#include "SimulationThread.h"
+#include "SpscQueue.h"
+#include "TripleBuffer.h"
+
+// Every word the same, so a reader that saw half of one publish and half of another would notice
+struct Stamp
+{
+	uint64_t words[16];
+};
+
+static void testTripleBuffer()
+{
+	const uint64_t PUBLISHES = 100000;
+	TripleBuffer<Stamp> buffer;
+
+	std::thread writer([&buffer, PUBLISHES]
+	{
+		for (uint64_t value = 1; value <= PUBLISHES; value++)
+		{
+			Stamp& stamp = buffer.getWriteBuffer();
+			for (uint64_t& word : stamp.words)
+				word = value;
+			buffer.publish();
+		}
+	});
+
+	// Each update that says there is something new has to be newer than the last, and whole
+	uint64_t last = 0;
+	bool newer = true, whole = true;
+	while (last < PUBLISHES)
+	{
+		if (!buffer.update())
+		{
+			std::this_thread::yield();
+			continue;
+		}
+
+		const Stamp& stamp = buffer.getReadBuffer();
+		newer = newer && stamp.words[0] > last;
+		for (uint64_t word : stamp.words)
+			whole = whole && word == stamp.words[0];
+		last = stamp.words[0];
+	}
+	writer.join();
+
+	PGG_CHECK(newer);
+	PGG_CHECK(whole);
+	PGG_CHECK(last == PUBLISHES);
+
+	// Nothing published since, so nothing new and the last one stays put
+	PGG_CHECK(!buffer.update());
+	PGG_CHECK(buffer.getReadBuffer().words[0] == PUBLISHES);
+}
+
+static void testSpscQueue()
+{
+	// Filling one up on a single thread
+	SpscQueue<int, 4> small;
+	for (int i = 0; i < 4; i++)
+		PGG_CHECK(small.push(i));
+	PGG_CHECK(!small.push(4));
+	PGG_CHECK(small.size() == 4);
+	int item = -1;
+	PGG_CHECK(small.pop(item) && item == 0);
+	PGG_CHECK(small.push(4));
+	for (int i = 1; i <= 4; i++)
+		PGG_CHECK(small.pop(item) && item == i);
+	PGG_CHECK(!small.pop(item) && small.empty());
+
+	// A small ring and a fast producer, so it is full most of the time and wraps thousands of times
+	const uint32_t ITEMS = 100000;
+	SpscQueue<uint32_t, 8> queue;
+	std::thread producer([&queue, ITEMS]
+	{
+		for (uint32_t i = 0; i < ITEMS; i++)
+		{
+			while (!queue.push(i))
+				std::this_thread::yield();
+		}
+	});
+
+	// Has to come out in order with nothing missing or repeated
+	uint32_t expected = 0;
+	bool inOrder = true;
+	while (expected < ITEMS)
+	{
+		uint32_t value;
+		if (!queue.pop(value))
+		{
+			std::this_thread::yield();
+			continue;
+		}
+
+		inOrder = inOrder && value == expected;
+		expected++;
+	}
+	producer.join();
+
+	PGG_CHECK(inOrder);
+	PGG_CHECK(queue.empty());
+}
+
+static void testCatchUp()
+{
+	typedef SimulationThread::Clock Clock;
+	const Clock::duration step = std::chrono::milliseconds(10);
+	const Clock::time_point due = Clock::time_point() + std::chrono::seconds(100);
+
+	// On time, or a little behind, waits for (or runs straight away) the next step on the fixed grid
+	PGG_CHECK(SimulationThread::getNextStepTime(due, due, step) == due + step);
+	PGG_CHECK(SimulationThread::getNextStepTime(due, due + step * 3, step) == due + step);
+
+	// Exactly at the limit still catches up, one step past it gives up and starts again from now
+	Clock::time_point limit = due + step + step * SimulationThread::MAX_CATCH_UP_STEPS;
+	PGG_CHECK(SimulationThread::getNextStepTime(due, limit, step) == due + step);
+	PGG_CHECK(SimulationThread::getNextStepTime(due, limit + step, step) == limit + step);
+}
+
+static void testStartStop()
+{
+	Simulation simulation;
+	SimulationThread simulationThread(simulation);
+	PGG_CHECK(!simulationThread.isRunning());
+	PGG_CHECK(simulationThread.getSnapshot().step == 0);
+
+	// Stepping on the calling thread when it isn't running
+	simulationThread.step(1.0f / 60.0f);
+	PGG_CHECK(simulationThread.getStepsRun() == 1);
+	PGG_CHECK(simulationThread.updateSnapshot() && simulationThread.getSnapshot().step == 1);
+
+	// Started and stopped a few times - each time it steps, never goes backwards and stops dead
+	const float stepSeconds = 1.0f / 1000.0f;
+	uint64_t lastSeen = 1;
+	bool forwards = true;
+	for (int run = 0; run < 3; run++)
+	{
+		uint64_t before = simulationThread.getStepsRun();
+		simulationThread.start(stepSeconds);
+		simulationThread.start(stepSeconds);
+		PGG_CHECK(simulationThread.isRunning());
+
+		// Ignored while the thread owns the Simulation
+		simulationThread.step(1.0f / 60.0f);
+
+		auto start = std::chrono::steady_clock::now();
+		while (std::chrono::steady_clock::now() - start < std::chrono::milliseconds(50))
+		{
+			simulationThread.sendInput(run % 2 == 0 ? SimulationInput::SpinLeft : SimulationInput::SpinRight);
+			if (simulationThread.updateSnapshot())
+			{
+				forwards = forwards && simulationThread.getSnapshot().step > lastSeen;
+				lastSeen = simulationThread.getSnapshot().step;
+			}
+			std::this_thread::sleep_for(std::chrono::microseconds(200));
+		}
+		simulationThread.stop();
+		simulationThread.stop();
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		PGG_CHECK(!simulationThread.isRunning());
+
+		// Fixed steps never get ahead of the clock by more than the catch up allows
+		uint64_t steps = simulationThread.getStepsRun() - before;
+		PGG_CHECK(steps > 0);
+		PGG_CHECK(steps <= (uint64_t)(seconds / stepSeconds) + SimulationThread::MAX_CATCH_UP_STEPS + 2);
+
+		// Nothing steps once it is stopped, and the last step is there to pick up
+		uint64_t stopped = simulationThread.getStepsRun();
+		std::this_thread::sleep_for(std::chrono::milliseconds(5));
+		PGG_CHECK(simulationThread.getStepsRun() == stopped);
+		simulationThread.updateSnapshot();
+		PGG_CHECK(simulationThread.getSnapshot().step == stopped);
+		lastSeen = stopped;
+	}
+	PGG_CHECK(forwards);
+
+	// And the calling thread can step again afterwards
+	uint64_t stopped = simulationThread.getStepsRun();
+	simulationThread.step(1.0f / 60.0f);
+	PGG_CHECK(simulationThread.getStepsRun() == stopped + 1);
+}
+
+void testSimulationThread()
+{
+	testTripleBuffer();
+	testSpscQueue();
+	testCatchUp();
+	testStartStop();
+}
@@ -0,0 +1,132 @@
+/*!
+*  \brief     TerrainChunker Tests.
+*  \details   This file is to check slicing the level keeps every bit of it in the right chunk and loses nothing at the cuts,
+*             and which chunks the window keeps around the eye
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "TestRunner.h"
+
+#include <cmath>
+#include <vector>
+
+#include "TerrainChunker.h"
+#include "TerrainWindow.h"
+
+static void addTriangle(MeshData& mesh, const glm::vec3& a, const glm::vec3& b, const glm::vec3& c)
+{
+	for (const glm::vec3& corner : { a, b, c })
+	{
+		mesh.vertices.insert(mesh.vertices.end(), { corner.x, corner.y, corner.z });
+		mesh.normals.insert(mesh.normals.end(), { 0.0f, 1.0f, 0.0f });
+	}
+}
+
+static double getArea(const MeshData& mesh)
+{
+	double area = 0.0;
+	for (size_t i = 0; i + 8 < mesh.vertices.size(); i += 9)
+	{
+		glm::dvec3 a(mesh.vertices[i], mesh.vertices[i + 1], mesh.vertices[i + 2]);
+		glm::dvec3 b(mesh.vertices[i + 3], mesh.vertices[i + 4], mesh.vertices[i + 5]);
+		glm::dvec3 c(mesh.vertices[i + 6], mesh.vertices[i + 7], mesh.vertices[i + 8]);
+		area += glm::length(glm::cross(b - a, c - a)) * 0.5;
+	}
+	return area;
+}
+
+static void testSlice()
+{
+	// A long floor triangle from z = 0 to z = -300, and two small rocks that each sit inside one slice
+	MeshData level;
+	addTriangle(level, glm::vec3(-20.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, -300.0f), glm::vec3(20.0f, 0.0f, 0.0f));
+	addTriangle(level, glm::vec3(-5.0f, 1.0f, -10.0f), glm::vec3(5.0f, 1.0f, -10.0f), glm::vec3(0.0f, 6.0f, -15.0f));
+	addTriangle(level, glm::vec3(-5.0f, 1.0f, -250.0f), glm::vec3(5.0f, 1.0f, -250.0f), glm::vec3(0.0f, 6.0f, -260.0f));
+
+	// 300 deep in 128 slices is three of them, [-300, -172], [-172, -44] and [-44, 84]
+	TerrainChunker chunker;
+	chunker.SetChunkDepth(128.0f);
+	std::vector<TerrainChunk> chunks;
+	chunker.Slice(level, chunks);
+	PGG_CHECK(chunks.size() == 3);
+
+	// Highest z first, each one slice deep and meeting the next
+	bool ordered = true;
+	for (size_t i = 0; i < chunks.size(); i++)
+	{
+		ordered = ordered && chunks[i].maxZ - chunks[i].minZ == 128.0f;
+		if (i + 1 < chunks.size())
+			ordered = ordered && chunks[i].minZ == chunks[i + 1].maxZ;
+	}
+	PGG_CHECK(ordered);
+
+	// Every vertex inside its own chunk, and nothing lost or doubled up at the cuts
+	double area = 0.0;
+	bool inside = true, normals = true;
+	for (const TerrainChunk& chunk : chunks)
+	{
+		const MeshData& mesh = chunk.mesh;
+		PGG_CHECK(!mesh.IsEmpty() && mesh.GetVertexCount() % 3 == 0);
+		normals = normals && mesh.normals.size() == mesh.vertices.size();
+		for (size_t i = 2; i < mesh.vertices.size(); i += 3)
+			inside = inside && mesh.vertices[i] >= chunk.minZ && mesh.vertices[i] <= chunk.maxZ;
+		area += getArea(mesh);
+	}
+	PGG_CHECK(inside);
+	PGG_CHECK(normals);
+	PGG_CHECK(std::fabs(area - getArea(level)) < getArea(level) * 1.0e-5);
+
+	// The floor alone ends up in all three, clipped to each
+	MeshData floor;
+	addTriangle(floor, glm::vec3(-20.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, -300.0f), glm::vec3(20.0f, 0.0f, 0.0f));
+	chunker.Slice(floor, chunks);
+	PGG_CHECK(chunks.size() == 3);
+	area = 0.0;
+	for (const TerrainChunk& chunk : chunks)
+	{
+		PGG_CHECK(!chunk.mesh.IsEmpty());
+		area += getArea(chunk.mesh);
+	}
+	PGG_CHECK(std::fabs(area - getArea(floor)) < getArea(floor) * 1.0e-5);
+
+	// Nothing to slice
+	chunker.Slice(MeshData(), chunks);
+	PGG_CHECK(chunks.empty());
+}
+
+static void testWindow()
+{
+	// Default range - 50 behind the eye, 1000 ahead (towards -z)
+	TerrainWindow window;
+	PGG_CHECK(window.getBehind() == 50.0f && window.getAhead() == 1000.0f);
+
+	// Around the eye, and bigger than the whole window
+	PGG_CHECK(window.contains(-10.0f, 10.0f, 0.0f));
+	PGG_CHECK(window.contains(-5000.0f, 5000.0f, 0.0f));
+
+	// Just touching either end still counts, a hair past it doesn't
+	PGG_CHECK(window.contains(50.0f, 100.0f, 0.0f));
+	PGG_CHECK(!window.contains(50.5f, 100.0f, 0.0f));
+	PGG_CHECK(window.contains(-1100.0f, -1000.0f, 0.0f));
+	PGG_CHECK(!window.contains(-1100.0f, -1000.5f, 0.0f));
+
+	// Moves with the eye
+	PGG_CHECK(window.contains(-1100.0f, -1050.0f, -100.0f));
+	PGG_CHECK(!window.contains(0.0f, 20.0f, -100.0f));
+
+	// No range at all keeps only what the eye is in
+	window.setRange(0.0f, 0.0f);
+	PGG_CHECK(window.contains(-1.0f, 1.0f, 0.0f));
+	PGG_CHECK(window.contains(0.0f, 1.0f, 0.0f));
+	PGG_CHECK(!window.contains(1.0f, 2.0f, 0.0f));
+	PGG_CHECK(!window.contains(-2.0f, -1.0f, 0.0f));
+}
+
+void testTerrainChunker()
+{
+	testSlice();
+	testWindow();
+}
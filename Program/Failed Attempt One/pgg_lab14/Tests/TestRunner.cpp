@@ -0,0 +1,111 @@
+/*!
+*  \brief     Test Runner.
+*  \details   This file is to check the headless core gives the right answers, one suite per module, with no window or GPU
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "TestRunner.h"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "MeshCache.h"
+
+struct TestSuite
+{
+	const char* name;
+	void (*run)();
+};
+
+// Every suite, in the order they run when none are named
+static const TestSuite testSuites[] =
+{
+	{ "AlignedArena", testAlignedArena },
+	{ "AllocationCounter", testAllocationCounter },
+	{ "AssetArchive", testAssetArchive },
+	{ "AssetCooker", testAssetCooker },
+	{ "AssetStreamer", testAssetStreamer },
+	{ "Camera", testCamera },
+	{ "Frustum", testFrustum },
+	{ "JobSystem", testJobSystem },
+	{ "LodGroup", testLodGroup },
+	{ "NormalGenerator", testNormalGenerator },
+	{ "ObjLoader", testObjLoader },
+	{ "OcclusionBuffer", testOcclusionBuffer },
+	{ "Simulation", testSimulation },
+	{ "SimulationThread", testSimulationThread },
+	{ "TerrainChunker", testTerrainChunker },
+	{ "TextParser", testTextParser },
+	{ "TextureAtlas", testTextureAtlas },
+	{ "TextureFile", testTextureFile },
+	{ "TrackGenerator", testTrackGenerator },
+};
+
+static std::string testAssetDir = PGG_ASSET_DIR;
+static size_t checkFailures = 0;
+
+bool pggCheck(bool passed, const char* condition, const char* file, int line)
+{
+	if (!passed)
+	{
+		printf("  FAILED %s:%d  %s\n", file, line, condition);
+		checkFailures++;
+	}
+	return passed;
+}
+
+const std::string& getTestAssetDir()
+{
+	return testAssetDir;
+}
+
+// pgg_core_tests [--assets folder] [suite...]
+int main(int argc, char** argv)
+{
+	// Anything built from the assets goes in the build folder, never next to them
+	MeshCache::SetCacheDirectory(PGG_CACHE_DIR);
+
+	std::vector<const TestSuite*> suites;
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--assets") == 0 && i + 1 < argc)
+		{
+			testAssetDir = argv[++i];
+			continue;
+		}
+
+		const TestSuite* found = nullptr;
+		for (const TestSuite& suite : testSuites)
+			found = strcmp(suite.name, argv[i]) == 0 ? &suite : found;
+		if (!found)
+		{
+			printf("No test suite called %s\n", argv[i]);
+			return 2;
+		}
+		suites.push_back(found);
+	}
+	if (suites.empty())
+	{
+		for (const TestSuite& suite : testSuites)
+			suites.push_back(&suite);
+	}
+
+	size_t failedSuites = 0;
+	for (const TestSuite* suite : suites)
+	{
+		size_t failuresBefore = checkFailures;
+		suite->run();
+
+		size_t failures = checkFailures - failuresBefore;
+		printf("%-30s %s\n", suite->name, failures == 0 ? "ok" : "FAILED");
+		failedSuites += failures == 0 ? 0 : 1;
+	}
+
+	if (failedSuites > 0)
+		printf("%zu of %zu suites failed\n", failedSuites, suites.size());
+	return failedSuites == 0 ? 0 : 1;
+}
@@ -0,0 +1,41 @@
+/*!
+*  \brief     Test Runner.
+*  \details   This file is to check the headless core gives the right answers, one suite per module, with no window or GPU
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#pragma once
+
+#include <string>
+
+/// Record a failure (and where it was) if the condition doesn't hold - the suite carries on so every failure is seen
+#define PGG_CHECK(condition) pggCheck((condition), #condition, __FILE__, __LINE__)
+
+bool pggCheck(bool passed, const char* condition, const char* file, int line);
+
+/// Where the sample assets are - the source folder unless the runner was told otherwise with --assets
+const std::string& getTestAssetDir();
+
+/// Suites, each in Tests/<Module>Test.cpp and run by name (ctest runs each one on its own)
+void testAlignedArena();
+void testAllocationCounter();
+void testAssetArchive();
+void testAssetCooker();
+void testAssetStreamer();
+void testCamera();
+void testFrustum();
+void testJobSystem();
+void testLodGroup();
+void testNormalGenerator();
+void testObjLoader();
+void testOcclusionBuffer();
+void testSimulation();
+void testSimulationThread();
+void testTerrainChunker();
+void testTextParser();
+void testTextureAtlas();
+void testTextureFile();
+void testTrackGenerator();
@@ -0,0 +1,69 @@
+/*!
+*  \brief     TextParser Tests.
+*  \details   This file is to check numbers are read in place the same as the C library reads them
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "TestRunner.h"
+
+#include <cstdlib>
+#include <cstring>
+
+#include "TextParser.h"
+
+static void testParseFloat()
+{
+	// The sort of numbers an OBJ is made of, plus the odd ones exporters write
+	const char* numbers[] = { "0.000000", "-0.500000", "1.250000", "123.456001", "-999.999023", "+2.25", "1e3", "-1.5E-2",
+							  "0.1", "3" };
+	for (const char* number : numbers)
+	{
+		float value = -1.0f;
+		const char* end = number + strlen(number);
+		PGG_CHECK(TextParser::ParseFloat(number, end, value) == end);
+		PGG_CHECK(value == strtof(number, nullptr));
+	}
+
+	// Leading spaces are skipped, and it stops at the next one
+	const char* line = "  4.5 6.5";
+	const char* lineEnd = line + strlen(line);
+	float value = 0.0f;
+	const char* next = TextParser::ParseFloat(line, lineEnd, value);
+	PGG_CHECK(value == 4.5f && next == line + 5);
+	next = TextParser::ParseFloat(next, lineEnd, value);
+	PGG_CHECK(value == 6.5f && next == lineEnd);
+
+	// Not a number at all hands back where it started
+	const char* word = "usemtl";
+	PGG_CHECK(TextParser::ParseFloat(word, word + strlen(word), value) == word);
+}
+
+static void testParseInt()
+{
+	const char* numbers[] = { "1", "42", "-7", "+3", "50000", "-2147483647" };
+	for (const char* number : numbers)
+	{
+		int value = 0;
+		const char* end = number + strlen(number);
+		PGG_CHECK(TextParser::ParseInt(number, end, value) == end);
+		PGG_CHECK(value == (int)strtol(number, nullptr, 10));
+	}
+
+	// Face corners - it stops at the slash
+	const char* corner = "12/5/7";
+	int vertex = 0;
+	PGG_CHECK(TextParser::ParseInt(corner, corner + strlen(corner), vertex) == corner + 2);
+	PGG_CHECK(vertex == 12);
+
+	const char* slash = "/5";
+	PGG_CHECK(TextParser::ParseInt(slash, slash + 2, vertex) == slash);
+}
+
+void testTextParser()
+{
+	testParseFloat();
+	testParseInt();
+}
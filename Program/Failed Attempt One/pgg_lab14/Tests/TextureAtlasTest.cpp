@@ -0,0 +1,83 @@
+/*!
+*  \brief     TextureAtlas Tests.
+*  \details   This file is to check the menu images pack into one texture without overlapping and come out unchanged
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "TestRunner.h"
+
+#include <cstring>
+#include <vector>
+
+#include "TextureAtlas.h"
+
+static void testMenuAtlas()
+{
+	const char* images[] = { "MenuBackground.bmp", "DestinationOrigin.bmp", "NewGameSelected.bmp", "NewGameUnselected.bmp",
+							 "OptionsSelected.bmp", "OptionsUnselected.bmp", "ExitSelected.bmp", "ExitUnselected.bmp" };
+
+	TextureAtlas atlas;
+	std::vector<ImageData> originals;
+	for (const char* image : images)
+	{
+		BmpLoader loader;
+		PGG_CHECK(loader.Load(getTestAssetDir() + "/" + image));
+		originals.push_back(loader.GetImage());
+		atlas.AddImage(image, std::move(loader.GetImage()));
+	}
+
+	PGG_CHECK(atlas.Build());
+	const ImageData& packed = atlas.GetImage();
+	const std::vector<AtlasRegion>& regions = atlas.GetRegions();
+	PGG_CHECK(regions.size() == originals.size());
+	PGG_CHECK(atlas.GetFillRatio() > 0.0f && atlas.GetFillRatio() <= 1.0f);
+
+	for (size_t i = 0; i < regions.size(); i++)
+	{
+		const AtlasRegion& region = regions[i];
+		PGG_CHECK(region.name == images[i]);
+		PGG_CHECK(region.width == originals[i].width && region.height == originals[i].height);
+		PGG_CHECK(region.x >= 0 && region.y >= 0 && region.x + region.width <= packed.width && region.y + region.height <= packed.height);
+
+		// No two images share a pixel
+		for (size_t j = i + 1; j < regions.size(); j++)
+		{
+			const AtlasRegion& other = regions[j];
+			bool apart = region.x + region.width <= other.x || other.x + other.width <= region.x ||
+						 region.y + region.height <= other.y || other.y + other.height <= region.y;
+			PGG_CHECK(apart);
+		}
+
+		// Every row copied across as it was
+		bool same = true;
+		size_t rowBytes = (size_t)region.width * 4;
+		for (int y = 0; same && y < region.height; y++)
+		{
+			const uint8_t* from = &originals[i].pixels[(size_t)y * rowBytes];
+			const uint8_t* to = &packed.pixels[((size_t)(region.y + y) * packed.width + region.x) * 4];
+			same = memcmp(from, to, rowBytes) == 0;
+		}
+		PGG_CHECK(same);
+	}
+}
+
+static void testTooSmall()
+{
+	// Too big to fit keeps the images so it can be tried again bigger
+	TextureAtlas atlas;
+	BmpLoader loader;
+	PGG_CHECK(loader.Load(getTestAssetDir() + "/MenuBackground.bmp"));
+	atlas.AddImage("MenuBackground.bmp", std::move(loader.GetImage()));
+	PGG_CHECK(!atlas.Build(64, 64));
+	PGG_CHECK(atlas.Build());
+	PGG_CHECK(atlas.GetRegions().size() == 1);
+}
+
+void testTextureAtlas()
+{
+	testMenuAtlas();
+	testTooSmall();
+}
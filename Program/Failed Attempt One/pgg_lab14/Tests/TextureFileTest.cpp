@@ -0,0 +1,227 @@
+/*!
+*  \brief     TextureFile Tests.
+*  \details   This file is to check BC1 blocks decode to what was encoded, keyed pixels and all, and that a cooked texture
+*             reads back with the header and levels it was written with
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "TestRunner.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdint.h>
+#include <vector>
+
+#include "TextureConverter.h"
+#include "TextureFile.h"
+
+static uint16_t getColour(const uint8_t* block, int which)
+{
+	return (uint16_t)(block[which * 2] | (block[which * 2 + 1] << 8));
+}
+
+// Near enough to the original after squeezing it into 5:6:5 and picking from four colours
+static bool isClose(const uint8_t* decoded, const uint8_t* original, int tolerance)
+{
+	for (int channel = 0; channel < 3; channel++)
+	{
+		if (std::abs(decoded[channel] - original[channel]) > tolerance)
+			return false;
+	}
+	return true;
+}
+
+static void setPixel(uint8_t* pixels, int i, uint8_t r, uint8_t g, uint8_t b, uint8_t a)
+{
+	pixels[i * 4 + 0] = r;
+	pixels[i * 4 + 1] = g;
+	pixels[i * 4 + 2] = b;
+	pixels[i * 4 + 3] = a;
+}
+
+static void testOpaqueBlocks()
+{
+	uint8_t pixels[16 * 4], block[8], decoded[16 * 4];
+
+	// A gradient - four colour mode, and every pixel solid and within half a step of the palette
+	for (int i = 0; i < 16; i++)
+		setPixel(pixels, i, (uint8_t)(100 + i * 4), (uint8_t)(160 - i * 3), 90, 255);
+	TextureConverter::EncodeBc1Block(pixels, block);
+	TextureFile::DecodeBc1Block(block, decoded);
+	PGG_CHECK(getColour(block, 0) > getColour(block, 1));
+
+	bool solid = true, close = true;
+	for (int i = 0; i < 16; i++)
+	{
+		solid = solid && decoded[i * 4 + 3] == 255;
+		close = close && isClose(&decoded[i * 4], &pixels[i * 4], 16);
+	}
+	PGG_CHECK(solid);
+	PGG_CHECK(close);
+
+	// One colour all over, including black and white at the ends of the range
+	const uint8_t colours[3][3] = { { 200, 100, 50 }, { 0, 0, 0 }, { 255, 255, 255 } };
+	for (const uint8_t* colour : colours)
+	{
+		for (int i = 0; i < 16; i++)
+			setPixel(pixels, i, colour[0], colour[1], colour[2], 255);
+		TextureConverter::EncodeBc1Block(pixels, block);
+		TextureFile::DecodeBc1Block(block, decoded);
+		PGG_CHECK(getColour(block, 0) > getColour(block, 1));
+
+		solid = true, close = true;
+		for (int i = 0; i < 16; i++)
+		{
+			solid = solid && decoded[i * 4 + 3] == 255;
+			close = close && isClose(&decoded[i * 4], colour, 4);
+		}
+		PGG_CHECK(solid);
+		PGG_CHECK(close);
+	}
+}
+
+static void testKeyedBlocks()
+{
+	uint8_t pixels[16 * 4], block[8], decoded[16 * 4];
+
+	// A checkerboard of keyed and solid, the solid ones in two colours
+	for (int i = 0; i < 16; i++)
+	{
+		bool keyed = ((i & 3) + (i >> 2)) % 2 == 0;
+		if (keyed)
+			setPixel(pixels, i, 0, 255, 255, 0);
+		else if (i < 8)
+			setPixel(pixels, i, 250, 30, 30, 255);
+		else
+			setPixel(pixels, i, 30, 30, 250, 255);
+	}
+	TextureConverter::EncodeBc1Block(pixels, block);
+	TextureFile::DecodeBc1Block(block, decoded);
+	PGG_CHECK(getColour(block, 0) <= getColour(block, 1));
+
+	bool alphaKept = true, close = true;
+	for (int i = 0; i < 16; i++)
+	{
+		alphaKept = alphaKept && decoded[i * 4 + 3] == pixels[i * 4 + 3];
+		if (pixels[i * 4 + 3] == 255)
+			close = close && isClose(&decoded[i * 4], &pixels[i * 4], 8);
+	}
+	PGG_CHECK(alphaKept);
+	PGG_CHECK(close);
+
+	// Nothing but key
+	for (int i = 0; i < 16; i++)
+		setPixel(pixels, i, 0, 255, 255, 0);
+	TextureConverter::EncodeBc1Block(pixels, block);
+	TextureFile::DecodeBc1Block(block, decoded);
+
+	bool allClear = true;
+	for (int i = 0; i < 16; i++)
+		allClear = allClear && decoded[i * 4 + 3] == 0;
+	PGG_CHECK(allClear);
+}
+
+// A keyed border round a gradient, sizes that don't divide into blocks
+static ImageData makeImage(int width, int height)
+{
+	ImageData image;
+	image.width = width;
+	image.height = height;
+	image.pixels.resize((size_t)width * height * 4);
+	for (int y = 0; y < height; y++)
+	{
+		for (int x = 0; x < width; x++)
+		{
+			bool keyed = x == 0 || y == 0;
+			setPixel(image.pixels.data(), y * width + x, (uint8_t)(x * 255 / width), (uint8_t)(y * 255 / height), 128,
+					 keyed ? 0 : 255);
+		}
+	}
+	return image;
+}
+
+static void testRoundTrip(TextureFormat format)
+{
+	std::filesystem::path fileName = std::filesystem::temp_directory_path() / "pgg_texture_test.ptex";
+	ImageData image = makeImage(22, 13);
+
+	TextureConverter converter;
+	converter.Convert(image, format, true, true);
+	PGG_CHECK(converter.Save(fileName.string()));
+
+	// 22x13, 11x6, 5x3, 2x1, 1x1
+	const int sizes[5][2] = { { 22, 13 }, { 11, 6 }, { 5, 3 }, { 2, 1 }, { 1, 1 } };
+	PGG_CHECK(converter.GetLevelCount() == 5);
+
+	TextureFile texture;
+	PGG_CHECK(texture.Open(fileName.string()));
+	PGG_CHECK(texture.GetFormat() == format);
+	PGG_CHECK(texture.GetFlags() == TextureFile::FLAG_COLOUR_KEYED);
+	PGG_CHECK(texture.GetLevelCount() == 5);
+
+	size_t dataSize = 0;
+	for (int level = 0; level < texture.GetLevelCount() && level < 5; level++)
+	{
+		const TextureLevel& textureLevel = texture.GetLevel(level);
+		PGG_CHECK(textureLevel.width == sizes[level][0] && textureLevel.height == sizes[level][1]);
+		PGG_CHECK(textureLevel.size == TextureFile::GetLevelSize(format, sizes[level][0], sizes[level][1]));
+		dataSize += textureLevel.size;
+	}
+	PGG_CHECK(dataSize == converter.GetDataSize());
+
+	// Header and level table as written - every level on a 16 byte boundary, in order, inside the file and not overlapping
+	std::ifstream in(fileName, std::ios::binary);
+	std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+	in.close();
+	TextureFileHeader header;
+	PGG_CHECK(bytes.size() >= sizeof(header));
+	if (bytes.size() < sizeof(header))
+		return;
+	memcpy(&header, bytes.data(), sizeof(header));
+	PGG_CHECK(header.magic == TextureFile::MAGIC && header.version == TextureFile::VERSION);
+	PGG_CHECK(header.format == (uint32_t)format && header.width == 22 && header.height == 13 && header.levelCount == 5);
+
+	uint64_t end = sizeof(header) + header.levelCount * sizeof(TextureFileLevel);
+	bool bounded = bytes.size() >= end;
+	for (uint32_t i = 0; bounded && i < header.levelCount; i++)
+	{
+		TextureFileLevel entry;
+		memcpy(&entry, bytes.data() + sizeof(header) + i * sizeof(TextureFileLevel), sizeof(entry));
+		bounded = entry.offset % 16 == 0 && entry.offset >= end && entry.offset + entry.size <= bytes.size();
+		end = entry.offset + entry.size;
+	}
+	PGG_CHECK(bounded);
+
+	// The full size level decodes to the keyed border and a solid middle
+	ImageData decoded;
+	PGG_CHECK(texture.DecodeLevel(0, decoded));
+	PGG_CHECK(decoded.width == 22 && decoded.height == 13 && decoded.pixels.size() == image.pixels.size());
+	bool alphaKept = decoded.pixels.size() == image.pixels.size();
+	for (size_t i = 3; alphaKept && i < image.pixels.size(); i += 4)
+		alphaKept = decoded.pixels[i] == image.pixels[i];
+	PGG_CHECK(alphaKept);
+	if (format == TextureFormat::Rgba8)
+		PGG_CHECK(decoded.pixels == image.pixels);
+
+	// Cut short, it has to be turned away rather than read past the end
+	std::filesystem::path shortFileName = std::filesystem::temp_directory_path() / "pgg_texture_short.ptex";
+	std::ofstream(shortFileName, std::ios::binary).write((const char*)bytes.data(), (std::streamsize)bytes.size() - 1);
+	TextureFile shortened;
+	PGG_CHECK(!shortened.Open(shortFileName.string()));
+
+	std::filesystem::remove(shortFileName);
+	std::filesystem::remove(fileName);
+}
+
+void testTextureFile()
+{
+	testOpaqueBlocks();
+	testKeyedBlocks();
+	testRoundTrip(TextureFormat::Bc1);
+	testRoundTrip(TextureFormat::Rgba8);
+}
@@ -0,0 +1,188 @@
+/*!
+*  \brief     TrackGenerator Tests.
+*  \details   This file is to check endless track segments come out the same for a seed, whatever order they are made in
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "TestRunner.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "Simulation.h"
+#include "TrackGenerator.h"
+
+// Where the Rocket is kept, the widest way through a row has to be inside it
+static const float ROCKET_LEFT = -116.0f;
+static const float ROCKET_RIGHT = 110.0f;
+
+// Every row of the first segmentCount segments, nearest the start first
+static std::vector<ObstacleRow> collectRows(const TrackGenerator& generator, int segmentCount)
+{
+	std::vector<ObstacleRow> rows;
+	TrackSegment segment;
+	for (int index = 0; index < segmentCount; index++)
+	{
+		generator.generate(index, segment);
+		rows.insert(rows.end(), segment.rows.begin(), segment.rows.begin() + segment.rowCount);
+	}
+	return rows;
+}
+
+// Middle of the widest stretch of a row with nothing in it
+static float widestGapCentre(const ObstacleRow& row)
+{
+	std::vector<Obstacle> obstacles = row.obstacles;
+	std::sort(obstacles.begin(), obstacles.end(), [](const Obstacle& a, const Obstacle& b) { return a.x < b.x; });
+
+	float left = ROCKET_LEFT, bestWidth = -1.0f, bestCentre = 0.0f;
+	for (size_t i = 0; i <= obstacles.size(); i++)
+	{
+		float right = i < obstacles.size() ? obstacles[i].x : ROCKET_RIGHT;
+		if (right - left > bestWidth)
+		{
+			bestWidth = right - left;
+			bestCentre = (left + right) * 0.5f;
+		}
+		if (i < obstacles.size())
+			left = std::max(left, obstacles[i].x + obstacles[i].width);
+	}
+	return bestCentre;
+}
+
+static bool sameSegment(const TrackSegment& a, const TrackSegment& b)
+{
+	if (a.index != b.index || a.topZ != b.topZ || a.bottomZ != b.bottomZ || a.rowCount != b.rowCount ||
+		a.mesh.vertices != b.mesh.vertices)
+		return false;
+
+	for (size_t i = 0; i < a.rowCount; i++)
+	{
+		if (a.rows[i].z != b.rows[i].z || a.rows[i].obstacles.size() != b.rows[i].obstacles.size())
+			return false;
+		for (size_t j = 0; j < a.rows[i].obstacles.size(); j++)
+		{
+			if (a.rows[i].obstacles[j].x != b.rows[i].obstacles[j].x || a.rows[i].obstacles[j].width != b.rows[i].obstacles[j].width)
+				return false;
+		}
+	}
+	return true;
+}
+
+static void testRepeatable()
+{
+	// Same seed, same segment, even when the memory being reused held a different one
+	TrackGenerator generator(1234);
+	TrackSegment first, second;
+	generator.generate(50, first);
+	generator.generate(3, second);
+	generator.generate(50, second);
+	PGG_CHECK(sameSegment(first, second));
+
+	// Another generator with the same seed agrees
+	TrackGenerator other(1234);
+	TrackSegment third;
+	other.generate(50, third);
+	PGG_CHECK(sameSegment(first, third));
+
+	// A different seed gives a different track
+	other.setSeed(4321);
+	other.generate(50, third);
+	PGG_CHECK(!sameSegment(first, third));
+}
+
+static void testSegments()
+{
+	TrackGenerator generator(7);
+	for (int index = 0; index < 100; index++)
+	{
+		TrackSegment segment;
+		generator.generate(index, segment);
+
+		// Segments butt up against each other, and every row is inside its own
+		PGG_CHECK(segment.topZ == generator.getSegmentTop(index));
+		PGG_CHECK(segment.bottomZ == generator.getSegmentTop(index + 1));
+		PGG_CHECK(generator.getSegmentIndex((segment.topZ + segment.bottomZ) * 0.5f) == index);
+		PGG_CHECK(segment.rowCount <= segment.rows.size());
+		if (index >= 2)
+			PGG_CHECK(segment.rowCount > 0);
+		for (size_t i = 0; i < segment.rowCount; i++)
+			PGG_CHECK(segment.rows[i].z <= segment.topZ && segment.rows[i].z >= segment.bottomZ);
+		PGG_CHECK(!segment.mesh.vertices.empty());
+	}
+}
+
+static void testRowSpacing()
+{
+	// Across joins too, whichever order the segments were made in
+	TrackGenerator generator(99);
+	std::vector<ObstacleRow> rows = collectRows(generator, 60);
+	PGG_CHECK(rows.size() > 60);
+
+	size_t tooClose = 0;
+	for (size_t i = 1; i < rows.size(); i++)
+		tooClose += rows[i - 1].z - rows[i].z < generator.getRowSpacingMin();
+	PGG_CHECK(tooClose == 0);
+}
+
+static void testPassable()
+{
+	// Fly the real Rocket down the track, steering for the middle of the next gap the way a player would,
+	// past the point where the gaps stop narrowing - it must never crash
+	for (uint32_t seed : { 1u, 1234u, 99u, 31337u })
+	{
+		TrackGenerator generator(seed);
+		std::vector<ObstacleRow> rows = collectRows(generator, 60);
+
+		Simulation simulation;
+		ObstacleField& field = simulation.getObstacleField();
+		field.clear();
+		for (const ObstacleRow& row : rows)
+			field.addRow(row.z, row.obstacles);
+		field.setFinishLine(rows.back().z - 100.0f);
+
+		const float deltaTime = 1.0f / 60.0f;
+		const float maxSideways = 27.0f / 1.3f;
+		float spin = 0.0f;
+		size_t nextRow = 0;
+		bool finished = false;
+		for (int step = 0; step < 60 * 1000 && !finished; step++)
+		{
+			glm::vec3 position = simulation.getRocketPosition();
+			while (nextRow < rows.size() && position.z < rows[nextRow].z)
+				nextRow++;
+
+			// Ease the sideways speed towards the target, spin only changes a step at a time
+			float target = nextRow < rows.size() ? widestGapCentre(rows[nextRow]) : 0.0f;
+			float wantedSpin = std::max(-maxSideways, std::min(maxSideways, (target - position.x) * 4.0f)) * 1.3f;
+			if (spin < wantedSpin - 0.65f)
+			{
+				simulation.spinRight();
+				spin += 1.3f;
+			}
+			else if (spin > wantedSpin + 0.65f)
+			{
+				simulation.spinLeft();
+				spin -= 1.3f;
+			}
+			spin = std::max(-26.9f, std::min(26.9f, spin));
+
+			CollisionResult result = simulation.update(deltaTime);
+			finished = result == CollisionResult::Finished;
+		}
+
+		PGG_CHECK(finished);
+		PGG_CHECK(simulation.getNumberOfTries() == 0);
+	}
+}
+
+void testTrackGenerator()
+{
+	testRepeatable();
+	testSegments();
+	testRowSpacing();
+	testPassable();
+}
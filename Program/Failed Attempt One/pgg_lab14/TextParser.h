@@ -0,0 +1,96 @@
+/*!
+*  \brief     TextParser Class.
+*  \details   This class is to pick words and numbers out of a text file that is already in memory, without copying or allocating
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#pragma once
+
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+
+/// Everything works on [text, end) and hands back where it stopped, so a whole file can be walked with one pointer
+/// (nothing needs the text to be null terminated, so a MappedFile can be parsed in place)
+class TextParser
+{
+public:
+	/// Past any spaces and tabs (line ends are left alone)
+	static const char* SkipSpaces(const char* text, const char* end)
+	{
+		while (text < end && (*text == ' ' || *text == '\t'))
+			text++;
+		return text;
+	}
+
+	/// The '\n' ending this line (or end), less a '\r' before it
+	static const char* LineEnd(const char* text, const char* end)
+	{
+		const char* newLine = (const char*)memchr(text, '\n', end - text);
+		const char* lineEnd = newLine ? newLine : end;
+		return (lineEnd > text && lineEnd[-1] == '\r') ? lineEnd - 1 : lineEnd;
+	}
+
+	/// Start of the next line, or end if this is the last one
+	static const char* NextLine(const char* text, const char* end)
+	{
+		const char* newLine = (const char*)memchr(text, '\n', end - text);
+		return newLine ? newLine + 1 : end;
+	}
+
+	/// End of the word starting at text (it runs up to a space, tab or line end)
+	static const char* WordEnd(const char* text, const char* end)
+	{
+		while (text < end && *text != ' ' && *text != '\t' && *text != '\r' && *text != '\n')
+			text++;
+		return text;
+	}
+
+	/// True if [text, wordEnd) is exactly word
+	static bool IsWord(const char* text, const char* wordEnd, const char* word)
+	{
+		size_t length = strlen(word);
+		return (size_t)(wordEnd - text) == length && memcmp(text, word, length) == 0;
+	}
+
+	/// Read a decimal float (leading spaces are skipped) - returns just past it, or text if there isn't one and value is left alone
+	static const char* ParseFloat(const char* text, const char* end, float& value)
+	{
+		const char* start = SkipSpaces(text, end);
+		const char* number = (start < end && *start == '+') ? start + 1 : start;
+
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+		// Eisel-Lemire in the standard library, correctly rounded and no locale
+		std::from_chars_result result = std::from_chars(number, end, value);
+		return result.ec == std::errc() ? result.ptr : text;
+#else
+		// strtof needs a terminator, so copy the number out first
+		char buffer[64];
+		size_t length = 0;
+		while (number + length < end && length + 1 < sizeof(buffer) && strchr("0123456789+-.eEinfatyINFATY", number[length]))
+			length++;
+		memcpy(buffer, number, length);
+		buffer[length] = '\0';
+
+		char* parsed = nullptr;
+		float converted = strtof(buffer, &parsed);
+		if (parsed == buffer)
+			return text;
+		value = converted;
+		return number + (parsed - buffer);
+#endif
+	}
+
+	/// Read a decimal int (leading spaces are skipped) - returns just past it, or text if there isn't one and value is left alone
+	static const char* ParseInt(const char* text, const char* end, int& value)
+	{
+		const char* start = SkipSpaces(text, end);
+		const char* number = (start < end && *start == '+') ? start + 1 : start;
+
+		std::from_chars_result result = std::from_chars(number, end, value);
+		return result.ec == std::errc() ? result.ptr : text;
+	}
+};
@@ -0,0 +1,102 @@
+/*!
+*  \brief     TextureAtlas Class.
+*  \details   This class is to pack lots of small images into one, so they can all be drawn from a single texture
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "TextureAtlas.h"
+
+#include <algorithm>
+#include <cstring>
+
+TextureAtlas::TextureAtlas()
+{
+
+}
+
+TextureAtlas::~TextureAtlas()
+{
+
+}
+
+int TextureAtlas::AddImage(const std::string& name, ImageData image)
+{
+	AtlasRegion region = { name, 0, 0, image.width, image.height };
+	regions.push_back(region);
+	sources.push_back(std::move(image));
+	return (int)regions.size() - 1;
+}
+
+bool TextureAtlas::Build(int maxWidth, int maxHeight, int padding)
+{
+	// Tallest first, then lay them out left to right in shelves - fine for a handful of UI images
+	std::vector<size_t> order(regions.size());
+	for (size_t i = 0; i < order.size(); i++)
+		order[i] = i;
+	std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) { return regions[a].height > regions[b].height; });
+
+	int shelfX = 0, shelfY = 0, shelfHeight = 0;
+	int usedWidth = 0;
+	for (size_t index : order)
+	{
+		AtlasRegion& region = regions[index];
+		int paddedWidth = region.width + padding * 2;
+		int paddedHeight = region.height + padding * 2;
+		if (paddedWidth > maxWidth)
+			return false;
+
+		// Start a new shelf when this one is full
+		if (shelfX + paddedWidth > maxWidth)
+		{
+			shelfY += shelfHeight;
+			shelfX = 0;
+			shelfHeight = 0;
+		}
+
+		region.x = shelfX + padding;
+		region.y = shelfY + padding;
+		shelfX += paddedWidth;
+		shelfHeight = std::max(shelfHeight, paddedHeight);
+		usedWidth = std::max(usedWidth, shelfX);
+	}
+
+	int usedHeight = shelfY + shelfHeight;
+	if (usedHeight > maxHeight)
+		return false;
+
+	// Copy each image in a row at a time, the gaps stay clear
+	image.width = usedWidth;
+	image.height = usedHeight;
+	image.pixels.assign((size_t)usedWidth * usedHeight * 4, 0);
+	for (size_t i = 0; i < regions.size(); i++)
+	{
+		const AtlasRegion& region = regions[i];
+		const ImageData& source = sources[i];
+		if (source.IsEmpty())
+			continue;
+
+		for (int row = 0; row < region.height; row++)
+		{
+			memcpy(&image.pixels[((size_t)(region.y + row) * usedWidth + region.x) * 4],
+				   &source.pixels[(size_t)row * source.width * 4], (size_t)source.width * 4);
+		}
+	}
+
+	// They're all in the atlas now
+	sources.clear();
+	return true;
+}
+
+float TextureAtlas::GetFillRatio() const
+{
+	if (image.IsEmpty())
+		return 0.0f;
+
+	size_t covered = 0;
+	for (const AtlasRegion& region : regions)
+		covered += (size_t)region.width * region.height;
+	return (float)covered / ((float)image.width * image.height);
+}
@@ -0,0 +1,55 @@
+/*!
+*  \brief     TextureAtlas Class.
+*  \details   This class is to pack lots of small images into one, so they can all be drawn from a single texture
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "BmpLoader.h"
+
+/// Where one of the packed images ended up, in pixels
+struct AtlasRegion
+{
+	std::string name;
+	int x;
+	int y;
+	int width;
+	int height;
+};
+
+class TextureAtlas
+{
+public:
+	///ctor / dtor
+	TextureAtlas();
+	~TextureAtlas();
+
+	/// Add an image to be packed, the index is where its region will be in GetRegions
+	int AddImage(const std::string& name, ImageData image);
+
+	/// Pack everything added so far, false (keeping the images to try again) if it won't fit in maxWidth x maxHeight
+	/// padding is clear pixels left around each image so filtering never picks up its neighbours
+	bool Build(int maxWidth = 2048, int maxHeight = 2048, int padding = 1);
+
+	/// Get the packed image (move it out to keep it after the atlas is gone)
+	ImageData& GetImage() { return image; }
+
+	/// Get the regions, in the order the images were added
+	std::vector<AtlasRegion>& GetRegions() { return regions; }
+
+	/// How much of the packed image is covered by images rather than padding and gaps (0 - 1)
+	float GetFillRatio() const;
+
+private:
+	std::vector<ImageData> sources;
+	std::vector<AtlasRegion> regions;
+	ImageData image;
+};
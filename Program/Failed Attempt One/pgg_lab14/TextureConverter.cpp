@@ -0,0 +1,371 @@
+/*!
+*  \brief     TextureConverter Class.
+*  \details   This class is to cook an image offline - key it, build its mip chain, compress it and save it as a TextureFile
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "TextureConverter.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+// Level data starts on this boundary, so it can be handed straight to an upload
+static const size_t LEVEL_ALIGNMENT = 16;
+
+static size_t AlignUp(size_t value)
+{
+	return (value + LEVEL_ALIGNMENT - 1) & ~(LEVEL_ALIGNMENT - 1);
+}
+
+static uint16_t PackRgb565(const float* rgb)
+{
+	int red = (int)(rgb[0] * 31.0f / 255.0f + 0.5f);
+	int green = (int)(rgb[1] * 63.0f / 255.0f + 0.5f);
+	int blue = (int)(rgb[2] * 31.0f / 255.0f + 0.5f);
+	red = red < 0 ? 0 : (red > 31 ? 31 : red);
+	green = green < 0 ? 0 : (green > 63 ? 63 : green);
+	blue = blue < 0 ? 0 : (blue > 31 ? 31 : blue);
+	return (uint16_t)((red << 11) | (green << 5) | blue);
+}
+
+TextureConverter::TextureConverter()
+{
+	format = TextureFormat::Rgba8;
+	flags = 0;
+}
+
+TextureConverter::~TextureConverter()
+{
+
+}
+
+void TextureConverter::Convert(const ImageData& image, TextureFormat format, bool generateMips, bool colourKeyed)
+{
+	this->format = format;
+	flags = colourKeyed ? TextureFile::FLAG_COLOUR_KEYED : 0;
+	levels.clear();
+
+	if (image.IsEmpty())
+		return;
+
+	// Each level from the one before, down to 1x1
+	ImageData current = image;
+	while (true)
+	{
+		Level level;
+		level.width = current.width;
+		level.height = current.height;
+
+		if (format == TextureFormat::Rgba8)
+		{
+			level.data = current.pixels;
+		}
+		else
+		{
+			// Blocks hanging off the edge repeat the last row and column
+			int blocksWide = (current.width + 3) / 4;
+			int blocksHigh = (current.height + 3) / 4;
+			level.data.resize((size_t)blocksWide * blocksHigh * 8);
+
+			uint8_t blockPixels[16 * 4];
+			for (int blockY = 0; blockY < blocksHigh; blockY++)
+			{
+				for (int blockX = 0; blockX < blocksWide; blockX++)
+				{
+					for (int i = 0; i < 16; i++)
+					{
+						int x = blockX * 4 + (i & 3);
+						int y = blockY * 4 + (i >> 2);
+						x = x < current.width ? x : current.width - 1;
+						y = y < current.height ? y : current.height - 1;
+						memcpy(&blockPixels[i * 4], &current.pixels[((size_t)y * current.width + x) * 4], 4);
+					}
+					EncodeBc1Block(blockPixels, &level.data[((size_t)blockY * blocksWide + blockX) * 8]);
+				}
+			}
+		}
+		levels.push_back(std::move(level));
+
+		if (!generateMips || (current.width == 1 && current.height == 1) || levels.size() >= TextureFile::MAX_LEVELS)
+			break;
+
+		ImageData smaller;
+		Downsample(current, smaller);
+		current = std::move(smaller);
+	}
+}
+
+size_t TextureConverter::GetDataSize() const
+{
+	size_t size = 0;
+	for (const Level& level : levels)
+		size += level.data.size();
+	return size;
+}
+
+bool TextureConverter::Save(const std::string& fileName) const
+{
+	if (levels.empty())
+		return false;
+
+	TextureFileHeader header;
+	memset(&header, 0, sizeof(header));
+	header.magic = TextureFile::MAGIC;
+	header.version = TextureFile::VERSION;
+	header.format = (uint32_t)format;
+	header.width = (uint32_t)levels[0].width;
+	header.height = (uint32_t)levels[0].height;
+	header.levelCount = (uint32_t)levels.size();
+	header.flags = flags;
+
+	// Work out where every level goes first, then write it all in order
+	std::vector<TextureFileLevel> table(levels.size());
+	size_t offset = AlignUp(sizeof(header) + table.size() * sizeof(TextureFileLevel));
+	for (size_t i = 0; i < levels.size(); i++)
+	{
+		table[i].width = (uint32_t)levels[i].width;
+		table[i].height = (uint32_t)levels[i].height;
+		table[i].offset = offset;
+		table[i].size = levels[i].data.size();
+		offset = AlignUp(offset + levels[i].data.size());
+	}
+
+	FILE* file = fopen(fileName.c_str(), "wb");
+	if (file == NULL)
+		return false;
+
+	static const uint8_t padding[LEVEL_ALIGNMENT] = {};
+	size_t written = 0;
+	bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+			  fwrite(table.data(), sizeof(TextureFileLevel), table.size(), file) == table.size();
+	written = sizeof(header) + table.size() * sizeof(TextureFileLevel);
+
+	for (size_t i = 0; ok && i < levels.size(); i++)
+	{
+		size_t gap = (size_t)table[i].offset - written;
+		ok = (gap == 0 || fwrite(padding, 1, gap, file) == gap) &&
+			 fwrite(levels[i].data.data(), 1, levels[i].data.size(), file) == levels[i].data.size();
+		written = (size_t)table[i].offset + levels[i].data.size();
+	}
+
+	ok = (fclose(file) == 0) && ok;
+
+	// Don't leave half a file behind to be picked up next time
+	if (!ok)
+		remove(fileName.c_str());
+	return ok;
+}
+
+void TextureConverter::Downsample(const ImageData& source, ImageData& destination)
+{
+	destination.width = source.width > 1 ? source.width / 2 : 1;
+	destination.height = source.height > 1 ? source.height / 2 : 1;
+	destination.pixels.resize((size_t)destination.width * destination.height * 4);
+
+	for (int y = 0; y < destination.height; y++)
+	{
+		for (int x = 0; x < destination.width; x++)
+		{
+			// Colour weighted by alpha, so the cyan under see-through pixels never shows up round the edges
+			float colour[3] = { 0.0f, 0.0f, 0.0f };
+			float alpha = 0.0f;
+			for (int i = 0; i < 4; i++)
+			{
+				int sourceX = x * 2 + (i & 1);
+				int sourceY = y * 2 + (i >> 1);
+				sourceX = sourceX < source.width ? sourceX : source.width - 1;
+				sourceY = sourceY < source.height ? sourceY : source.height - 1;
+
+				const uint8_t* pixel = &source.pixels[((size_t)sourceY * source.width + sourceX) * 4];
+				float weight = pixel[3] / 255.0f;
+				colour[0] += pixel[0] * weight;
+				colour[1] += pixel[1] * weight;
+				colour[2] += pixel[2] * weight;
+				alpha += weight;
+			}
+
+			uint8_t* out = &destination.pixels[((size_t)y * destination.width + x) * 4];
+			for (int channel = 0; channel < 3; channel++)
+				out[channel] = alpha > 0.0f ? (uint8_t)(colour[channel] / alpha + 0.5f) : 0;
+			out[3] = (uint8_t)(alpha * 255.0f / 4.0f + 0.5f);
+		}
+	}
+}
+
+void TextureConverter::EncodeBc1Block(const uint8_t* pixels, uint8_t* block)
+{
+	// Only the solid pixels decide the colours
+	float mean[3] = { 0.0f, 0.0f, 0.0f };
+	int solid = 0;
+	for (int i = 0; i < 16; i++)
+	{
+		if (pixels[i * 4 + 3] < 128)
+			continue;
+		mean[0] += pixels[i * 4 + 0];
+		mean[1] += pixels[i * 4 + 1];
+		mean[2] += pixels[i * 4 + 2];
+		solid++;
+	}
+
+	bool seeThrough = solid < 16;
+	if (solid == 0)
+	{
+		// Equal colours means three colour mode, and index 3 in that is see-through
+		memset(block, 0, 4);
+		memset(block + 4, 0xFF, 4);
+		return;
+	}
+
+	for (int channel = 0; channel < 3; channel++)
+		mean[channel] /= (float)solid;
+
+	// Covariance of the solid pixels, then the line they spread along most (a few rounds of power iteration)
+	float covariance[6] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+	for (int i = 0; i < 16; i++)
+	{
+		if (pixels[i * 4 + 3] < 128)
+			continue;
+		float r = pixels[i * 4 + 0] - mean[0];
+		float g = pixels[i * 4 + 1] - mean[1];
+		float b = pixels[i * 4 + 2] - mean[2];
+		covariance[0] += r * r;
+		covariance[1] += r * g;
+		covariance[2] += r * b;
+		covariance[3] += g * g;
+		covariance[4] += g * b;
+		covariance[5] += b * b;
+	}
+
+	// Start from the longest row of the covariance, it already lies in the spread - a fixed guess like (1, 1, 1) can be
+	// square on to it (red against blue) and come straight back as nothing
+	float rows[3][3] =
+	{
+		{ covariance[0], covariance[1], covariance[2] },
+		{ covariance[1], covariance[3], covariance[4] },
+		{ covariance[2], covariance[4], covariance[5] }
+	};
+	int longest = 0;
+	float longestLength = 0.0f;
+	for (int row = 0; row < 3; row++)
+	{
+		float rowLength = rows[row][0] * rows[row][0] + rows[row][1] * rows[row][1] + rows[row][2] * rows[row][2];
+		if (rowLength > longestLength)
+		{
+			longestLength = rowLength;
+			longest = row;
+		}
+	}
+
+	float axis[3] = { 1.0f, 1.0f, 1.0f };
+	if (longestLength > 0.0f)
+	{
+		for (int channel = 0; channel < 3; channel++)
+			axis[channel] = rows[longest][channel];
+	}
+
+	for (int iteration = 0; iteration < 4; iteration++)
+	{
+		float next[3] =
+		{
+			covariance[0] * axis[0] + covariance[1] * axis[1] + covariance[2] * axis[2],
+			covariance[1] * axis[0] + covariance[3] * axis[1] + covariance[4] * axis[2],
+			covariance[2] * axis[0] + covariance[4] * axis[1] + covariance[5] * axis[2]
+		};
+		float largest = std::fmax(std::fabs(next[0]), std::fmax(std::fabs(next[1]), std::fabs(next[2])));
+
+		// All one colour - any line will do
+		if (largest < 1.0e-6f)
+			break;
+
+		for (int channel = 0; channel < 3; channel++)
+			axis[channel] = next[channel] / largest;
+	}
+
+	float length = std::sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+	for (int channel = 0; channel < 3; channel++)
+		axis[channel] /= length;
+
+	// The two ends of the line are the block's colours
+	float lowest = 0.0f, highest = 0.0f;
+	for (int i = 0; i < 16; i++)
+	{
+		if (pixels[i * 4 + 3] < 128)
+			continue;
+		float along = (pixels[i * 4 + 0] - mean[0]) * axis[0] + (pixels[i * 4 + 1] - mean[1]) * axis[1] +
+					  (pixels[i * 4 + 2] - mean[2]) * axis[2];
+		lowest = std::fmin(lowest, along);
+		highest = std::fmax(highest, along);
+	}
+
+	float high[3], low[3];
+	for (int channel = 0; channel < 3; channel++)
+	{
+		high[channel] = mean[channel] + axis[channel] * highest;
+		low[channel] = mean[channel] + axis[channel] * lowest;
+	}
+
+	uint16_t colour0 = PackRgb565(high);
+	uint16_t colour1 = PackRgb565(low);
+
+	// The order picks the mode - colour0 > colour1 for four colours, otherwise three and see-through
+	if ((seeThrough && colour0 > colour1) || (!seeThrough && colour0 < colour1))
+	{
+		uint16_t swap = colour0;
+		colour0 = colour1;
+		colour1 = swap;
+	}
+
+	// One colour all over packs to two equal ends, which would be three colour mode - move one end so a solid block stays solid
+	if (!seeThrough && colour0 == colour1)
+	{
+		if (colour1 > 0)
+			colour1--;
+		else
+			colour0++;
+	}
+
+	block[0] = (uint8_t)(colour0 & 0xFF);
+	block[1] = (uint8_t)(colour0 >> 8);
+	block[2] = (uint8_t)(colour1 & 0xFF);
+	block[3] = (uint8_t)(colour1 >> 8);
+
+	// Decode a block using each index once to get exactly the palette the GPU will see
+	uint8_t palette[16 * 4];
+	block[4] = 0xE4;
+	block[5] = block[6] = block[7] = 0;
+	TextureFile::DecodeBc1Block(block, palette);
+
+	int colourCount = colour0 > colour1 ? 4 : 3;
+	uint32_t indices = 0;
+	for (int i = 0; i < 16; i++)
+	{
+		const uint8_t* pixel = &pixels[i * 4];
+		uint32_t best = 3;
+		if (pixel[3] >= 128)
+		{
+			int bestDistance = 0x7FFFFFFF;
+			for (int entry = 0; entry < colourCount; entry++)
+			{
+				int r = pixel[0] - palette[entry * 4 + 0];
+				int g = pixel[1] - palette[entry * 4 + 1];
+				int b = pixel[2] - palette[entry * 4 + 2];
+				int distance = r * r + g * g + b * b;
+				if (distance < bestDistance)
+				{
+					bestDistance = distance;
+					best = (uint32_t)entry;
+				}
+			}
+		}
+		indices |= best << (i * 2);
+	}
+
+	block[4] = (uint8_t)(indices & 0xFF);
+	block[5] = (uint8_t)((indices >> 8) & 0xFF);
+	block[6] = (uint8_t)((indices >> 16) & 0xFF);
+	block[7] = (uint8_t)(indices >> 24);
+}
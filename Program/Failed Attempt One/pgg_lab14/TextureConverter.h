@@ -0,0 +1,54 @@
+/*!
+*  \brief     TextureConverter Class.
+*  \details   This class is to cook an image offline - key it, build its mip chain, compress it and save it as a TextureFile
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "BmpLoader.h"
+#include "TextureFile.h"
+
+class TextureConverter
+{
+public:
+	///ctor / dtor
+	TextureConverter();
+	~TextureConverter();
+
+	/// Build the levels from an image that has already been colour keyed (if it needs it)
+	/// Every level down to 1x1 when generateMips is set, otherwise just the one
+	void Convert(const ImageData& image, TextureFormat format, bool generateMips, bool colourKeyed);
+
+	/// Write the levels out, false if the file couldn't be written
+	bool Save(const std::string& fileName) const;
+
+	/// Level count and bytes of pixel data (what the file holds, less the header)
+	int GetLevelCount() const { return (int)levels.size(); }
+	size_t GetDataSize() const;
+
+	/// Halve an image, see-through pixels don't bleed their colour into the ones next to them
+	static void Downsample(const ImageData& source, ImageData& destination);
+
+	/// Pack 16 RGBA pixels into a BC1 block (pixels with alpha under half become see-through)
+	static void EncodeBc1Block(const uint8_t* pixels, uint8_t* block);
+
+private:
+	struct Level
+	{
+		int width;
+		int height;
+		std::vector<uint8_t> data;
+	};
+
+	TextureFormat format;
+	uint32_t flags;
+	std::vector<Level> levels;
+};
@@ -0,0 +1,184 @@
+/*!
+*  \brief     TextureFile Class.
+*  \details   This class is to read a cooked texture (every mip level, ready to upload) straight out of a mapped file
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "TextureFile.h"
+
+#include <cstring>
+#include <filesystem>
+
+// 5:6:5 back to 8 bits a channel, copying the top bits down so white stays white
+static void UnpackRgb565(uint16_t colour, uint8_t* rgb)
+{
+	uint8_t red = (uint8_t)((colour >> 11) & 31);
+	uint8_t green = (uint8_t)((colour >> 5) & 63);
+	uint8_t blue = (uint8_t)(colour & 31);
+	rgb[0] = (uint8_t)((red << 3) | (red >> 2));
+	rgb[1] = (uint8_t)((green << 2) | (green >> 4));
+	rgb[2] = (uint8_t)((blue << 3) | (blue >> 2));
+}
+
+TextureFile::TextureFile()
+{
+	format = TextureFormat::Rgba8;
+	flags = 0;
+}
+
+TextureFile::~TextureFile()
+{
+
+}
+
+std::string TextureFile::GetCookedFileName(const std::string& sourceFileName)
+{
+	size_t dot = sourceFileName.find_last_of('.');
+	size_t slash = sourceFileName.find_last_of("/\\");
+	if (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+		return sourceFileName + ".ptex";
+
+	return sourceFileName.substr(0, dot) + ".ptex";
+}
+
+bool TextureFile::IsCookedUpToDate(const std::string& cookedFileName, const std::string& sourceFileName)
+{
+	std::error_code error;
+	std::filesystem::file_time_type cookedTime = std::filesystem::last_write_time(cookedFileName, error);
+	if (error)
+		return false;
+
+	// Shipping without the BMPs is fine, the cooked file is all that's needed
+	std::filesystem::file_time_type sourceTime = std::filesystem::last_write_time(sourceFileName, error);
+	return error || sourceTime <= cookedTime;
+}
+
+size_t TextureFile::GetLevelSize(TextureFormat format, int width, int height)
+{
+	if (format == TextureFormat::Bc1)
+		return (size_t)((width + 3) / 4) * ((height + 3) / 4) * 8;
+	return (size_t)width * height * 4;
+}
+
+bool TextureFile::Open(const std::string& fileName)
+{
+	levels.clear();
+	if (!file.Open(fileName))
+		return false;
+
+	return Parse(file.GetData(), file.GetSize());
+}
+
+bool TextureFile::Open(const uint8_t* data, size_t size)
+{
+	levels.clear();
+	file.Close();
+	return Parse(data, size);
+}
+
+bool TextureFile::Parse(const uint8_t* data, size_t size)
+{
+	TextureFileHeader header;
+	if (size < sizeof(header))
+		return false;
+	memcpy(&header, data, sizeof(header));
+
+	if (header.magic != MAGIC || header.version != VERSION || header.levelCount == 0 || header.levelCount > MAX_LEVELS ||
+		header.format > (uint32_t)TextureFormat::Bc1)
+		return false;
+
+	if (size < sizeof(header) + header.levelCount * sizeof(TextureFileLevel))
+		return false;
+
+	// Every level has to be the size it says and inside the file
+	format = (TextureFormat)header.format;
+	flags = header.flags;
+	for (uint32_t i = 0; i < header.levelCount; i++)
+	{
+		TextureFileLevel entry;
+		memcpy(&entry, data + sizeof(header) + i * sizeof(TextureFileLevel), sizeof(entry));
+
+		if (entry.width == 0 || entry.height == 0 || entry.width > 16384 || entry.height > 16384 ||
+			entry.size != GetLevelSize(format, (int)entry.width, (int)entry.height) ||
+			entry.offset > size || entry.size > size - entry.offset)
+		{
+			levels.clear();
+			return false;
+		}
+
+		TextureLevel level = { (int)entry.width, (int)entry.height, data + entry.offset, (size_t)entry.size };
+		levels.push_back(level);
+	}
+	return true;
+}
+
+bool TextureFile::DecodeLevel(int level, ImageData& image) const
+{
+	if (level < 0 || level >= (int)levels.size())
+		return false;
+
+	const TextureLevel& source = levels[level];
+	image.width = source.width;
+	image.height = source.height;
+
+	if (format == TextureFormat::Rgba8)
+	{
+		image.pixels.assign(source.data, source.data + source.size);
+		return true;
+	}
+
+	// BC1 - a block at a time, the ones hanging off the edge only write what's inside the image
+	image.pixels.resize((size_t)source.width * source.height * 4);
+	int blocksWide = (source.width + 3) / 4;
+	int blocksHigh = (source.height + 3) / 4;
+	uint8_t blockPixels[16 * 4];
+	for (int blockY = 0; blockY < blocksHigh; blockY++)
+	{
+		for (int blockX = 0; blockX < blocksWide; blockX++)
+		{
+			DecodeBc1Block(source.data + ((size_t)blockY * blocksWide + blockX) * 8, blockPixels);
+
+			for (int y = 0; y < 4 && blockY * 4 + y < source.height; y++)
+			{
+				int width = source.width - blockX * 4 < 4 ? source.width - blockX * 4 : 4;
+				memcpy(&image.pixels[((size_t)(blockY * 4 + y) * source.width + blockX * 4) * 4], &blockPixels[y * 16], (size_t)width * 4);
+			}
+		}
+	}
+	return true;
+}
+
+void TextureFile::DecodeBc1Block(const uint8_t* block, uint8_t* pixels)
+{
+	uint16_t colour0 = (uint16_t)(block[0] | (block[1] << 8));
+	uint16_t colour1 = (uint16_t)(block[2] | (block[3] << 8));
+	uint32_t indices = (uint32_t)(block[4] | (block[5] << 8) | (block[6] << 16) | ((uint32_t)block[7] << 24));
+
+	uint8_t palette[4][4];
+	UnpackRgb565(colour0, palette[0]);
+	UnpackRgb565(colour1, palette[1]);
+	palette[0][3] = palette[1][3] = 255;
+
+	// Four colours when colour0 > colour1, otherwise three and see-through
+	for (int channel = 0; channel < 3; channel++)
+	{
+		if (colour0 > colour1)
+		{
+			palette[2][channel] = (uint8_t)((2 * palette[0][channel] + palette[1][channel] + 1) / 3);
+			palette[3][channel] = (uint8_t)((palette[0][channel] + 2 * palette[1][channel] + 1) / 3);
+		}
+		else
+		{
+			palette[2][channel] = (uint8_t)((palette[0][channel] + palette[1][channel]) / 2);
+			palette[3][channel] = 0;
+		}
+	}
+	palette[2][3] = 255;
+	palette[3][3] = colour0 > colour1 ? 255 : 0;
+
+	for (int i = 0; i < 16; i++)
+		memcpy(&pixels[i * 4], palette[(indices >> (i * 2)) & 3], 4);
+}
@@ -0,0 +1,105 @@
+/*!
+*  \brief     TextureFile Class.
+*  \details   This class is to read a cooked texture (every mip level, ready to upload) straight out of a mapped file
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "BmpLoader.h"
+#include "MappedFile.h"
+
+/// How the pixels of every level are stored
+enum class TextureFormat : uint32_t
+{
+	Rgba8 = 0,	///< 4 bytes a pixel, top row first - same as ImageData
+	Bc1 = 1		///< 8 bytes a 4x4 block (DXT1), with 1 bit alpha
+};
+
+/// One mip level, pointing into the mapped file
+struct TextureLevel
+{
+	int width;
+	int height;
+	const uint8_t* data;
+	size_t size;
+};
+
+/// File layout - a header, a table of levels, then each level's data on a 16 byte boundary (all little endian)
+struct TextureFileHeader
+{
+	uint32_t magic;
+	uint32_t version;
+	uint32_t format;
+	uint32_t width;
+	uint32_t height;
+	uint32_t levelCount;
+	uint32_t flags;
+	uint32_t reserved;
+};
+
+struct TextureFileLevel
+{
+	uint32_t width;
+	uint32_t height;
+	uint64_t offset;
+	uint64_t size;
+};
+
+class TextureFile
+{
+public:
+	/// "PTEX" then a version, bump the version whenever the layout above changes
+	static const uint32_t MAGIC = 0x58455450;
+	static const uint32_t VERSION = 1;
+	static const uint32_t MAX_LEVELS = 16;
+
+	/// The colour key has already been applied, so it mustn't be applied again
+	static const uint32_t FLAG_COLOUR_KEYED = 1;
+
+	///ctor / dtor
+	TextureFile();
+	~TextureFile();
+
+	/// Where the cooked texture for an image lives ("MenuBackground.bmp" -> "MenuBackground.ptex")
+	static std::string GetCookedFileName(const std::string& sourceFileName);
+
+	/// True if the cooked file is there and at least as new as the source (or the source has gone)
+	static bool IsCookedUpToDate(const std::string& cookedFileName, const std::string& sourceFileName);
+
+	/// Bytes a level of this size takes up
+	static size_t GetLevelSize(TextureFormat format, int width, int height);
+
+	/// Map a cooked texture and check it over, false if it is missing, from an older version or cut short
+	bool Open(const std::string& fileName);
+
+	/// Same, for a cooked texture that is already in memory (an archive entry) - it has to stay there while this is used
+	bool Open(const uint8_t* data, size_t size);
+
+	TextureFormat GetFormat() const { return format; }
+	uint32_t GetFlags() const { return flags; }
+	int GetLevelCount() const { return (int)levels.size(); }
+	const TextureLevel& GetLevel(int level) const { return levels[level]; }
+
+	/// Unpack a level to RGBA (for anything that can't take the stored format as it is)
+	bool DecodeLevel(int level, ImageData& image) const;
+
+	/// Unpack one BC1 block to 16 RGBA pixels
+	static void DecodeBc1Block(const uint8_t* block, uint8_t* pixels);
+
+private:
+	// Check the header and every level over, pointing the levels into data
+	bool Parse(const uint8_t* data, size_t size);
+
+	MappedFile file;
+	TextureFormat format;
+	uint32_t flags;
+	std::vector<TextureLevel> levels;
+};
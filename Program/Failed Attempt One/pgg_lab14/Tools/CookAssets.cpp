@@ -0,0 +1,85 @@
+/*!
+*  \brief     Cook Assets.
+*  \details   This program is to cook every mesh and image in the asset folder that has changed since it was last cooked
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+
+#include "AssetCooker.h"
+#include "JobSystem.h"
+
+static void printUsage()
+{
+	printf("usage: pgg_cook_assets [--force] [--workers n] folder...\n");
+	printf("  --force      cook everything, even if it hasn't changed\n");
+	printf("  --workers n  threads to cook with besides this one (default one per core)\n");
+	printf("Every .obj becomes a .pmdl and every .bmp a .ptex next to it, listed in %s\n", AssetCooker::MANIFEST_FILE_NAME);
+}
+
+int main(int argc, char** argv)
+{
+	bool force = false;
+	int workerCount = -1;
+	int folders = 0;
+	bool ok = true;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--force") == 0)
+		{
+			force = true;
+			continue;
+		}
+		if (strcmp(argv[i], "--workers") == 0 && i + 1 < argc)
+		{
+			workerCount = atoi(argv[++i]);
+			continue;
+		}
+
+		auto start = std::chrono::steady_clock::now();
+		JobSystem jobSystem(workerCount);
+		AssetCooker cooker(&jobSystem);
+		ok = cooker.Cook(argv[i], force) && ok;
+		double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		folders++;
+
+		int cooked = 0, upToDate = 0, failed = 0;
+		for (const CookedAsset& asset : cooker.GetAssets())
+		{
+			std::string name = std::filesystem::path(asset.sourceFileName).filename().string();
+			if (asset.result == CookResult::Cooked)
+			{
+				printf("%-32s -> %-32s %10llu bytes %9.2f ms\n", name.c_str(),
+					   std::filesystem::path(asset.cookedFileName).filename().string().c_str(),
+					   (unsigned long long)asset.cookedSize, asset.milliseconds);
+				cooked++;
+			}
+			else if (asset.result == CookResult::Failed)
+			{
+				printf("%-32s could not be cooked\n", name.c_str());
+				failed++;
+			}
+			else
+			{
+				upToDate++;
+			}
+		}
+		printf("%s: %d cooked, %d up to date, %d failed in %.1f ms\n", argv[i], cooked, upToDate, failed, ms);
+	}
+
+	if (folders == 0)
+	{
+		printUsage();
+		return 1;
+	}
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,90 @@
+/*!
+*  \brief     Cook Textures.
+*  \details   This program is to convert BMPs offline into TextureFiles the game can map and upload without decoding
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+
+#include "BmpLoader.h"
+#include "TextureConverter.h"
+#include "TextureFile.h"
+
+static void printUsage()
+{
+	printf("usage: pgg_cook_textures [--rgba] [--no-mips] [--no-key] image.bmp...\n");
+	printf("  --rgba     keep every pixel as it is instead of compressing to BC1\n");
+	printf("  --no-mips  only the full size level (fine for images only ever drawn 1:1)\n");
+	printf("  --no-key   don't make the cyan pixels see-through\n");
+	printf("Each image is written next to itself as a .ptex\n");
+}
+
+int main(int argc, char** argv)
+{
+	TextureFormat format = TextureFormat::Bc1;
+	bool generateMips = true;
+	bool colourKey = true;
+	int converted = 0, failed = 0;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--rgba") == 0)
+		{
+			format = TextureFormat::Rgba8;
+			continue;
+		}
+		if (strcmp(argv[i], "--no-mips") == 0)
+		{
+			generateMips = false;
+			continue;
+		}
+		if (strcmp(argv[i], "--no-key") == 0)
+		{
+			colourKey = false;
+			continue;
+		}
+
+		std::string sourceFileName = argv[i];
+		BmpLoader loader;
+		if (!loader.Load(sourceFileName))
+		{
+			failed++;
+			continue;
+		}
+
+		// Same key the game used to apply every time it loaded one
+		if (colourKey)
+			loader.ApplyColourKey(0, 0xFF, 0xFF);
+
+		TextureConverter converter;
+		converter.Convert(loader.GetImage(), format, generateMips, colourKey);
+
+		std::string cookedFileName = TextureFile::GetCookedFileName(sourceFileName);
+		if (!converter.Save(cookedFileName))
+		{
+			printf("Could not write %s\n", cookedFileName.c_str());
+			failed++;
+			continue;
+		}
+
+		std::error_code error;
+		uintmax_t sourceSize = std::filesystem::file_size(sourceFileName, error);
+		uintmax_t cookedSize = std::filesystem::file_size(cookedFileName, error);
+		printf("%-30s %4d x %-4d %2d levels %10llu -> %10llu bytes\n", cookedFileName.c_str(), loader.GetImage().width,
+			   loader.GetImage().height, converter.GetLevelCount(), (unsigned long long)sourceSize, (unsigned long long)cookedSize);
+		converted++;
+	}
+
+	if (converted == 0 && failed == 0)
+	{
+		printUsage();
+		return 1;
+	}
+	return failed == 0 ? 0 : 1;
+}
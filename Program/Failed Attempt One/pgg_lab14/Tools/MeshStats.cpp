@@ -0,0 +1,269 @@
+/*!
+*  \brief     Mesh Stats.
+*  \details   This program is to load meshes the way the game does and print what each one costs, and anything wrong with it
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "JobSystem.h"
+#include "MeshData.h"
+#include "ObjLoader.h"
+
+// Everything a vertex is made of - two vertices are only shared in an index buffer if all of it matches
+struct VertexKey
+{
+	uint32_t bits[9];
+
+	bool operator==(const VertexKey& other) const { return memcmp(bits, other.bits, sizeof(bits)) == 0; }
+};
+
+struct VertexKeyHash
+{
+	size_t operator()(const VertexKey& key) const
+	{
+		// FNV-1a over the words
+		uint32_t hash = 2166136261u;
+		for (uint32_t word : key.bits)
+			hash = (hash ^ word) * 16777619u;
+		return hash;
+	}
+};
+
+// What one file came to
+struct MeshStats
+{
+	std::string fileName;
+	bool loaded;
+	double loadMs;
+	size_t triangles;
+	size_t vertices;
+	size_t uniqueVertices;
+	size_t uniquePositions;
+	size_t degenerateTriangles;
+	size_t nonFiniteVertices;
+	size_t subsets;
+	size_t materials;
+	size_t vertexStride;
+	size_t nonIndexedBytes;
+	size_t indexedBytes;
+	MeshBounds bounds;
+};
+
+static void printUsage()
+{
+	printf("usage: pgg_mesh_stats [--workers n] mesh.obj|folder...\n");
+	printf("  --workers n  threads to load with besides this one (default one per core)\n");
+	printf("A folder means every .obj directly in it (not in subfolders, where the compiler's .obj files live)\n");
+}
+
+// Same layout GameModel uploads - float3 position and normal, float2 uv and a packed tangent when the mesh has them
+static size_t GetVertexStride(const MeshData& mesh)
+{
+	size_t stride = 3 * sizeof(float) + 3 * sizeof(float);
+	if (mesh.HasTexCoords())
+		stride += 2 * sizeof(float);
+	if (mesh.HasTangents())
+		stride += sizeof(uint32_t);
+	return stride;
+}
+
+static uint32_t FloatBits(float value)
+{
+	// Adding zero turns -0 into +0, they're the same value but not the same bits
+	value += 0.0f;
+	uint32_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+	return bits;
+}
+
+static size_t CountUniqueVertices(const MeshData& mesh)
+{
+	size_t vertexCount = mesh.GetVertexCount();
+	bool hasNormals = mesh.normals.size() == mesh.vertices.size();
+	bool hasTexCoords = mesh.HasTexCoords();
+	bool hasTangents = mesh.HasTangents();
+
+	std::unordered_map<VertexKey, uint32_t, VertexKeyHash> lookup;
+	lookup.reserve(vertexCount);
+	for (size_t i = 0; i < vertexCount; i++)
+	{
+		VertexKey key = {};
+		for (int c = 0; c < 3; c++)
+		{
+			key.bits[c] = FloatBits(mesh.vertices[i * 3 + c]);
+			key.bits[3 + c] = hasNormals ? FloatBits(mesh.normals[i * 3 + c]) : 0;
+		}
+		key.bits[6] = hasTexCoords ? FloatBits(mesh.texCoords[i * 2]) : 0;
+		key.bits[7] = hasTexCoords ? FloatBits(mesh.texCoords[i * 2 + 1]) : 0;
+		key.bits[8] = hasTangents ? mesh.tangents[i] : 0;
+		lookup.emplace(key, (uint32_t)lookup.size());
+	}
+	return lookup.size();
+}
+
+static MeshStats MeasureMesh(const std::string& fileName)
+{
+	MeshStats stats = {};
+	stats.fileName = fileName;
+
+	auto start = std::chrono::steady_clock::now();
+	ObjLoader loader;
+	stats.loaded = loader.Load(fileName);
+	stats.loadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	if (!stats.loaded)
+		return stats;
+
+	const MeshData& mesh = loader.GetMeshData();
+	stats.vertices = mesh.GetVertexCount();
+	stats.triangles = stats.vertices / 3;
+	stats.subsets = mesh.subsets.size();
+	stats.materials = mesh.materials.size();
+	stats.bounds = mesh.bounds;
+
+	for (float value : mesh.vertices)
+	{
+		if (!std::isfinite(value))
+			stats.nonFiniteVertices++;
+	}
+	stats.nonFiniteVertices /= 3;
+
+	// Degenerate - two corners at the same spot, or all three in a line, so it covers no pixels
+	IndexedMesh welded = WeldPositions(mesh);
+	stats.uniquePositions = welded.positions.size();
+	for (size_t triangle = 0; triangle < stats.triangles; triangle++)
+	{
+		const uint32_t* corners = &welded.indices[triangle * 3];
+		if (corners[0] == corners[1] || corners[1] == corners[2] || corners[2] == corners[0])
+		{
+			stats.degenerateTriangles++;
+			continue;
+		}
+
+		glm::vec3 a = welded.positions[corners[0]], b = welded.positions[corners[1]], c = welded.positions[corners[2]];
+		glm::vec3 edge1 = b - a, edge2 = c - a;
+		glm::vec3 normal = glm::cross(edge1, edge2);
+
+		// Sine of the angle between the edges under about 1e-6 counts as a line
+		if (glm::dot(normal, normal) <= 1.0e-12f * glm::dot(edge1, edge1) * glm::dot(edge2, edge2))
+			stats.degenerateTriangles++;
+	}
+
+	// The GPU side - the streams as they are now, or shared vertices plus 16 bit indices if they'd do
+	stats.uniqueVertices = CountUniqueVertices(mesh);
+	stats.vertexStride = GetVertexStride(mesh);
+	stats.nonIndexedBytes = stats.vertices * stats.vertexStride;
+	size_t indexSize = stats.uniqueVertices <= 0xFFFF ? sizeof(uint16_t) : sizeof(uint32_t);
+	stats.indexedBytes = stats.uniqueVertices * stats.vertexStride + stats.vertices * indexSize;
+	return stats;
+}
+
+static void AddMeshFiles(const std::string& path, std::vector<std::string>& fileNames)
+{
+	std::error_code error;
+	if (!std::filesystem::is_directory(path, error))
+	{
+		fileNames.push_back(path);
+		return;
+	}
+
+	std::vector<std::string> found;
+	for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(path, error))
+	{
+		std::string extension = entry.path().extension().string();
+		std::transform(extension.begin(), extension.end(), extension.begin(), [](char c) { return (char)tolower((unsigned char)c); });
+		if (entry.is_regular_file(error) && extension == ".obj")
+			found.push_back(entry.path().string());
+	}
+	std::sort(found.begin(), found.end());
+	fileNames.insert(fileNames.end(), found.begin(), found.end());
+}
+
+int main(int argc, char** argv)
+{
+	int workerCount = -1;
+	std::vector<std::string> fileNames;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--workers") == 0 && i + 1 < argc)
+		{
+			workerCount = atoi(argv[++i]);
+			continue;
+		}
+		AddMeshFiles(argv[i], fileNames);
+	}
+
+	if (fileNames.empty())
+	{
+		printUsage();
+		return 1;
+	}
+
+	// One file per job - they're all independent, and printed afterwards so the order doesn't depend on the threads
+	std::vector<MeshStats> results(fileNames.size());
+	auto start = std::chrono::steady_clock::now();
+	{
+		JobSystem jobSystem(workerCount);
+		jobSystem.parallelFor(fileNames.size(), 1, [&](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; i++)
+				results[i] = MeasureMesh(fileNames[i]);
+		});
+	}
+	double totalMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	printf("%-32s %9s %9s %9s %9s %6s %11s %11s %9s\n", "mesh", "triangles", "vertices", "unique", "positions",
+		   "degen", "flat KB", "indexed KB", "load ms");
+
+	size_t totalTriangles = 0, totalNonIndexed = 0, totalIndexed = 0;
+	int failed = 0, warnings = 0;
+	for (const MeshStats& stats : results)
+	{
+		std::string name = std::filesystem::path(stats.fileName).filename().string();
+		if (!stats.loaded)
+		{
+			printf("%-32s could not be loaded\n", name.c_str());
+			failed++;
+			continue;
+		}
+
+		printf("%-32s %9zu %9zu %9zu %9zu %6zu %11.1f %11.1f %9.2f\n", name.c_str(), stats.triangles, stats.vertices,
+			   stats.uniqueVertices, stats.uniquePositions, stats.degenerateTriangles, stats.nonIndexedBytes / 1024.0,
+			   stats.indexedBytes / 1024.0, stats.loadMs);
+		printf("%-32s bounds (%.3f, %.3f, %.3f) - (%.3f, %.3f, %.3f), radius %.3f, %zu bytes / vertex, %zu subsets, %zu materials\n",
+			   "", stats.bounds.min.x, stats.bounds.min.y, stats.bounds.min.z, stats.bounds.max.x, stats.bounds.max.y,
+			   stats.bounds.max.z, stats.bounds.radius, stats.vertexStride, stats.subsets, stats.materials);
+
+		// Things worth fixing before the mesh goes into a level
+		if (stats.triangles == 0)
+			printf("%-32s warning: no triangles\n", "");
+		if (stats.degenerateTriangles > 0)
+			printf("%-32s warning: %zu degenerate triangles\n", "", stats.degenerateTriangles);
+		if (stats.nonFiniteVertices > 0)
+			printf("%-32s warning: %zu vertices that aren't finite numbers\n", "", stats.nonFiniteVertices);
+		if (stats.triangles == 0 || stats.degenerateTriangles > 0 || stats.nonFiniteVertices > 0)
+			warnings++;
+
+		totalTriangles += stats.triangles;
+		totalNonIndexed += stats.nonIndexedBytes;
+		totalIndexed += stats.indexedBytes;
+	}
+
+	printf("%-32s %9zu %9s %9s %9s %6s %11.1f %11.1f %9.2f\n", "total", totalTriangles, "", "", "", "",
+		   totalNonIndexed / 1024.0, totalIndexed / 1024.0, totalMs);
+	printf("%zu meshes, %d could not be loaded, %d with warnings\n", results.size(), failed, warnings);
+	return failed == 0 ? 0 : 1;
+}
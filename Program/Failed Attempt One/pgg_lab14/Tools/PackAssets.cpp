@@ -0,0 +1,98 @@
+/*!
+*  \brief     Pack Assets.
+*  \details   This program is to pack every cooked asset in a folder into one archive the game maps at startup
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "AssetArchive.h"
+#include "AssetCooker.h"
+#include "JobSystem.h"
+
+static void printUsage()
+{
+	printf("usage: pgg_pack_assets [--store] archive.pak folder\n");
+	printf("  --store  keep every entry as it is, even where LZ4 would make it smaller\n");
+	printf("Cooks whatever in the folder has changed, then packs every .pmdl and .ptex with the date of its source,\n");
+	printf("so the game reads the source instead of an entry that has gone stale\n");
+}
+
+int main(int argc, char** argv)
+{
+	bool compress = true;
+	std::vector<std::string> paths;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--store") == 0)
+			compress = false;
+		else
+			paths.push_back(argv[i]);
+	}
+
+	if (paths.size() != 2)
+	{
+		printUsage();
+		return 1;
+	}
+
+	// Only the folder itself, named the way the game asks for them (relative to the working directory)
+	// Cooking first means nothing stale goes in, the cooker skips whatever is already up to date
+	JobSystem jobSystem;
+	AssetCooker cooker(&jobSystem);
+	if (!cooker.Cook(paths[1]))
+		printf("Some of %s could not be cooked, packing the rest\n", paths[1].c_str());
+
+	std::error_code error;
+	std::vector<ArchiveSource> sources;
+	for (const CookedAsset& asset : cooker.GetAssets())
+	{
+		if (asset.result == CookResult::Failed)
+			continue;
+
+		std::filesystem::path cookedPath(asset.cookedFileName);
+		ArchiveSource source = { cookedPath.filename().string(), cookedPath.string(), compress, asset.sourceFileName };
+		sources.push_back(source);
+	}
+
+	if (sources.empty())
+	{
+		printf("No cooked assets in %s\n", paths[1].c_str());
+		return 1;
+	}
+
+	if (!AssetArchive::Write(paths[0], sources))
+	{
+		printf("Could not write %s\n", paths[0].c_str());
+		return 1;
+	}
+
+	// Read it back, both to check it and to show what went in
+	AssetArchive archive;
+	if (!archive.Open(paths[0]))
+	{
+		printf("Could not open %s after writing it\n", paths[0].c_str());
+		return 1;
+	}
+
+	uint64_t totalSize = 0, totalStored = 0;
+	for (size_t i = 0; i < archive.GetEntryCount(); i++)
+	{
+		const ArchiveEntry& entry = archive.GetEntry(i);
+		printf("%-32s %10llu -> %10llu bytes %s\n", archive.GetEntryName(entry).c_str(), (unsigned long long)entry.size,
+			   (unsigned long long)entry.storedSize, entry.compression == (uint32_t)ArchiveCompression::Lz4 ? "lz4" : "stored");
+		totalSize += entry.size;
+		totalStored += entry.storedSize;
+	}
+	printf("%zu files, %llu -> %llu bytes, %llu byte archive\n", archive.GetEntryCount(), (unsigned long long)totalSize,
+		   (unsigned long long)totalStored, (unsigned long long)std::filesystem::file_size(paths[0], error));
+	return 0;
+}
@@ -0,0 +1,203 @@
+/*!
+*  \brief     TrackGenerator Class.
+*  \details   This class is to make endless track segments (floor mesh and obstacle rows) from a seed
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#include "TrackGenerator.h"
+
+#include <algorithm>
+#include <cmath>
+
+// Same width and floor height as "Level Final.obj" once it has been placed in the world
+static const float TRACK_LEFT = -130.57f;
+static const float TRACK_RIGHT = 128.40f;
+static const float FLOOR_TOP = -8.4f;
+static const float FLOOR_BOTTOM = -21.6f;
+static const float RAIL_WIDTH = 4.0f;
+static const float RAIL_HEIGHT = 10.0f;
+
+// Where obstacles can go - the Rocket is kept between -116 and 110
+static const float LANE_LEFT = -116.10f;
+static const float LANE_RIGHT = 116.0f;
+
+// Every row leaves at least one gap this wide, the first segments leave more
+static const float GAP_MIN = 26.0f;
+static const float GAP_START = 60.0f;
+
+// Same as ObstacleField's rowDepth
+static const float ROW_DEPTH = 10.0f;
+
+// How far sideways the Rocket can get for each unit forward - full spin is 27 / 1.3 = 20.8 units a second against
+// 38.5 forward (0.54), plan on less so there's time to build the spin up and take it off again
+static const float SIDEWAYS_PER_FORWARD = 0.4f;
+
+// Where the gap is at each join between segments, so segments made in any order still line up
+// Kept near the middle so any two joins are in reach of each other over one segment
+static const float JOIN_LANE_RANGE = 50.0f;
+
+// Small fixed random number generator, std distributions differ between compilers
+struct SegmentRandom
+{
+	uint64_t state;
+
+	explicit SegmentRandom(uint64_t seed) : state(seed) {}
+
+	// splitmix64
+	uint64_t next()
+	{
+		uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		return z ^ (z >> 31);
+	}
+
+	// Uniform between low and high
+	float range(float low, float high)
+	{
+		return low + (high - low) * (float)((next() >> 40) * (1.0 / 16777216.0));
+	}
+};
+
+static void addFace(MeshData& mesh, const glm::vec3& a, const glm::vec3& b, const glm::vec3& c, const glm::vec3& d, const glm::vec3& normal)
+{
+	const glm::vec3 corners[6] = { a, b, c, a, c, d };
+	for (const glm::vec3& corner : corners)
+	{
+		mesh.vertices.push_back(corner.x);
+		mesh.vertices.push_back(corner.y);
+		mesh.vertices.push_back(corner.z);
+		mesh.normals.push_back(normal.x);
+		mesh.normals.push_back(normal.y);
+		mesh.normals.push_back(normal.z);
+	}
+}
+
+// Axis aligned box with outward normals, wound anticlockwise from outside
+static void addBox(MeshData& mesh, const glm::vec3& lo, const glm::vec3& hi)
+{
+	addFace(mesh, glm::vec3(lo.x, hi.y, hi.z), glm::vec3(hi.x, hi.y, hi.z), glm::vec3(hi.x, hi.y, lo.z), glm::vec3(lo.x, hi.y, lo.z), glm::vec3(0, 1, 0));
+	addFace(mesh, glm::vec3(lo.x, lo.y, lo.z), glm::vec3(hi.x, lo.y, lo.z), glm::vec3(hi.x, lo.y, hi.z), glm::vec3(lo.x, lo.y, hi.z), glm::vec3(0, -1, 0));
+	addFace(mesh, glm::vec3(lo.x, lo.y, hi.z), glm::vec3(hi.x, lo.y, hi.z), glm::vec3(hi.x, hi.y, hi.z), glm::vec3(lo.x, hi.y, hi.z), glm::vec3(0, 0, 1));
+	addFace(mesh, glm::vec3(hi.x, lo.y, lo.z), glm::vec3(lo.x, lo.y, lo.z), glm::vec3(lo.x, hi.y, lo.z), glm::vec3(hi.x, hi.y, lo.z), glm::vec3(0, 0, -1));
+	addFace(mesh, glm::vec3(hi.x, lo.y, hi.z), glm::vec3(hi.x, lo.y, lo.z), glm::vec3(hi.x, hi.y, lo.z), glm::vec3(hi.x, hi.y, hi.z), glm::vec3(1, 0, 0));
+	addFace(mesh, glm::vec3(lo.x, lo.y, lo.z), glm::vec3(lo.x, lo.y, hi.z), glm::vec3(lo.x, hi.y, hi.z), glm::vec3(lo.x, hi.y, lo.z), glm::vec3(-1, 0, 0));
+}
+
+TrackGenerator::TrackGenerator(uint32_t seed)
+	: seed(seed)
+{
+	// Start far enough back to cover where the Rocket is put after a crash (z = 100)
+	startZ = 160.0f;
+	segmentLength = 256.0f;
+
+	// The hand made level has rows 90 - 130 apart
+	rowSpacingMin = 90.0f;
+	rowSpacingMax = 130.0f;
+
+	// Nothing in the way until the same place as the first row of the hand made level
+	clearRunUp = 325.0f;
+}
+
+TrackGenerator::~TrackGenerator()
+{
+
+}
+
+int TrackGenerator::getSegmentIndex(float z) const
+{
+	return (int)std::floor((startZ - z) / segmentLength);
+}
+
+float TrackGenerator::getJoinLane(int index) const
+{
+	// Its own stream, separate from the segments either side
+	SegmentRandom random(~(((uint64_t)seed << 32) ^ (uint64_t)(uint32_t)index));
+	return random.range(-JOIN_LANE_RANGE, JOIN_LANE_RANGE);
+}
+
+void TrackGenerator::generate(int index, TrackSegment& segment) const
+{
+	segment.index = index;
+	segment.topZ = getSegmentTop(index);
+	segment.bottomZ = segment.topZ - segmentLength;
+
+	// Every segment gets its own stream so they can be made in any order
+	SegmentRandom random(((uint64_t)seed << 32) ^ (uint64_t)(uint32_t)index);
+
+	// Rows - keep half the minimum spacing clear at each end, so rows never bunch up across a join
+	segment.rowCount = 0;
+	float edge = rowSpacingMin * 0.5f;
+	float z = segment.topZ - edge - random.range(0.0f, rowSpacingMax - rowSpacingMin);
+
+	// Gaps narrow the further down the track you get
+	float gap = std::max(GAP_MIN, GAP_START - index * 2.0f);
+
+	// Every gap is in reach of the last one, and leaves the Rocket able to get to the lane at the far join in time
+	// (the first gap is reached from the lane at this segment's join)
+	float lastX = getJoinLane(index);
+	float lastZ = segment.topZ;
+	float nextLane = getJoinLane(index + 1);
+
+	while (z - ROW_DEPTH > segment.bottomZ + edge)
+	{
+		if (startZ - z < clearRunUp)
+		{
+			z -= rowSpacingMin;
+			continue;
+		}
+
+		if (segment.rows.size() <= segment.rowCount)
+			segment.rows.resize(segment.rowCount + 1);
+
+		ObstacleRow& row = segment.rows[segment.rowCount++];
+		row.z = z - ROW_DEPTH;
+		row.obstacles.clear();
+
+		float reach = (lastZ - row.z) * SIDEWAYS_PER_FORWARD;
+		float reachToJoin = (row.z - segment.bottomZ) * SIDEWAYS_PER_FORWARD;
+		float low = std::max(LANE_LEFT + gap * 0.5f, std::max(lastX - reach, nextLane - reachToJoin));
+		float high = std::min(LANE_RIGHT - gap * 0.5f, std::min(lastX + reach, nextLane + reachToJoin));
+		float centre = random.range(low, std::max(low, high));
+		float gapStart = centre - gap * 0.5f;
+		float gapEnd = gapStart + gap;
+		lastX = centre;
+		lastZ = row.z;
+
+		// Fill either side of the gap with one or two obstacles, leaving small holes between them
+		float sides[2][2] = { { LANE_LEFT, gapStart }, { gapEnd, LANE_RIGHT } };
+		for (int side = 0; side < 2; side++)
+		{
+			float left = sides[side][0];
+			float right = sides[side][1];
+			if (right - left < 12.0f)
+				continue;
+
+			if (random.range(0.0f, 1.0f) < 0.5f || right - left < 60.0f)
+			{
+				Obstacle whole = { left, right - left };
+				row.obstacles.push_back(whole);
+			}
+			else
+			{
+				float split = random.range(left + 20.0f, right - 35.0f);
+				Obstacle first = { left, split - left };
+				Obstacle second = { split + 15.0f, right - split - 15.0f };
+				row.obstacles.push_back(first);
+				row.obstacles.push_back(second);
+			}
+		}
+
+		z -= random.range(rowSpacingMin, rowSpacingMax);
+	}
+
+	// Floor and the two side rails
+	segment.mesh.Clear();
+	addBox(segment.mesh, glm::vec3(TRACK_LEFT, FLOOR_BOTTOM, segment.bottomZ), glm::vec3(TRACK_RIGHT, FLOOR_TOP, segment.topZ));
+	addBox(segment.mesh, glm::vec3(TRACK_LEFT - RAIL_WIDTH, FLOOR_BOTTOM, segment.bottomZ), glm::vec3(TRACK_LEFT, FLOOR_TOP + RAIL_HEIGHT, segment.topZ));
+	addBox(segment.mesh, glm::vec3(TRACK_RIGHT, FLOOR_BOTTOM, segment.bottomZ), glm::vec3(TRACK_RIGHT + RAIL_WIDTH, FLOOR_TOP + RAIL_HEIGHT, segment.topZ));
+	segment.mesh.ComputeBounds();
+}
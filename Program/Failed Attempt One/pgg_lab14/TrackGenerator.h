@@ -0,0 +1,69 @@
+/*!
+*  \brief     TrackGenerator Class.
+*  \details   This class is to make endless track segments (floor mesh and obstacle rows) from a seed
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+#include "MeshData.h"
+#include "ObstacleField.h"
+
+/// One stretch of endless track - it runs from topZ down to bottomZ (the Rocket flies towards -z)
+struct TrackSegment
+{
+	int index;
+	uint32_t epoch;
+	float topZ;
+	float bottomZ;
+
+	/// Rows in this stretch, only the first rowCount are used (the rest are kept to reuse their memory)
+	std::vector<ObstacleRow> rows;
+	size_t rowCount;
+
+	/// Floor and side rails in world space
+	MeshData mesh;
+};
+
+class TrackGenerator
+{
+public:
+	/// Constructor and Destructor
+	TrackGenerator(uint32_t seed = 1);
+	~TrackGenerator();
+
+	/// The same seed and index always give the same segment, on any machine
+	void setSeed(uint32_t newSeed) { seed = newSeed; }
+	uint32_t getSeed() const { return seed; }
+
+	/// Fill in segment number index, reusing whatever memory it already has
+	void generate(int index, TrackSegment& segment) const;
+
+	/// Where segment index starts and how long each one is
+	float getSegmentTop(int index) const { return startZ - index * segmentLength; }
+	float getSegmentLength() const { return segmentLength; }
+
+	/// Segment covering z (can be negative if z is before the start)
+	int getSegmentIndex(float z) const;
+
+	/// Middle of the gap the Rocket is steered to where segment index starts, rows either side are in reach of it
+	float getJoinLane(int index) const;
+
+	/// Rows are never closer together than this, even across a join
+	float getRowSpacingMin() const { return rowSpacingMin; }
+
+private:
+	uint32_t seed;
+
+	// Track layout
+	float startZ;
+	float segmentLength;
+	float rowSpacingMin;
+	float rowSpacingMax;
+	float clearRunUp;
+};
@@ -0,0 +1,59 @@
+/*!
+*  \brief     TripleBuffer Class.
+*  \details   This class is a lock-free hand over of whole values from one thread to another, the reader always gets the newest one
+*  \author    James Robertson
+*  \version   1.0a
+*  \date      2015
+*  \copyright GNU Public License.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+
+/// One writer, one reader - neither ever waits for the other
+/// The writer fills one buffer, the reader looks at another, and the third sits in the middle holding the newest finished one
+template <typename T>
+class TripleBuffer
+{
+public:
+	TripleBuffer() : middle(1), writeIndex(0), readIndex(2) {}
+
+	TripleBuffer(const TripleBuffer&) = delete;
+	TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+	/// Writer only - the buffer to fill in next (it holds whatever was in it last time round)
+	T& getWriteBuffer() { return buffers[writeIndex]; }
+
+	/// Writer only - swap the filled buffer into the middle, anything the reader hadn't picked up yet is replaced
+	void publish()
+	{
+		uint8_t previous = middle.exchange((uint8_t)(writeIndex | FRESH), std::memory_order_acq_rel);
+		writeIndex = previous & INDEX_MASK;
+	}
+
+	/// Reader only - take the newest published buffer, false (keeping the old one) if nothing new has arrived
+	bool update()
+	{
+		if ((middle.load(std::memory_order_relaxed) & FRESH) == 0)
+			return false;
+
+		uint8_t previous = middle.exchange(readIndex, std::memory_order_acq_rel);
+		readIndex = previous & INDEX_MASK;
+		return true;
+	}
+
+	/// Reader only - the buffer update last picked up
+	const T& getReadBuffer() const { return buffers[readIndex]; }
+
+private:
+	static const uint8_t INDEX_MASK = 3;
+	static const uint8_t FRESH = 4;
+
+	// Keep the shared index and each side's own index on their own cache lines
+	alignas(64) std::atomic<uint8_t> middle;
+	alignas(64) uint8_t writeIndex;
+	alignas(64) uint8_t readIndex;
+	alignas(64) T buffers[3];
+};